@@ -110,7 +110,9 @@ sksl_skvm_tests_sources = sksl_rte_tests + sksl_rte_error_tests
 
 sksl_stage_tests_sources = sksl_rte_tests
 
-sksl_minify_tests_sources = sksl_rte_tests + sksl_folding_tests`
+sksl_minify_tests_sources = sksl_rte_tests + sksl_folding_tests
+
+sksl_native_kernel_tests_sources = sksl_native_kernel_tests`
 
 // The footer written to modules/skshaper/skshaper.gni.
 const skshaperFooter = `
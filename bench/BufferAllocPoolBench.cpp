@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/mock/GrMockTypes.h"
+#include "src/gpu/ganesh/GrBufferAllocPool.h"
+#include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+
+// Simulates the vertex uploads of many small draws per flush. Each loop is one flush with a fresh
+// pool, as in GrOpFlushState, so this measures the cost of getting the pool's buffers each time.
+class BufferAllocPoolBench : public Benchmark {
+public:
+    BufferAllocPoolBench(bool useGpuBufferCache) : fUseGpuBufferCache(useGpuBufferCache) {
+        fName.printf("buffer_alloc_pool_%s", useGpuBufferCache ? "ring" : "resource_cache");
+    }
+
+private:
+    static constexpr int kDrawsPerFlush = 64;
+    static constexpr size_t kVertexSize = 16;
+    static constexpr int kVerticesPerDraw = 128;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        GrMockOptions mockOptions;
+        mockOptions.fMapBufferFlags = GrCaps::kCanMap_MapFlag;
+        fContext = GrDirectContext::MakeMock(&mockOptions, GrContextOptions());
+        fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(6);
+        if (fUseGpuBufferCache) {
+            fGpuBufferCache = GrBufferAllocPool::GpuBufferCache::Make(4);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        GrGpu* gpu = fContext->priv().getGpu();
+        for (int i = 0; i < loops; ++i) {
+            GrVertexBufferAllocPool pool(gpu, fCpuBufferCache, fGpuBufferCache);
+            for (int j = 0; j < kDrawsPerFlush; ++j) {
+                sk_sp<const GrBuffer> buffer;
+                int startVertex;
+                void* vertices = pool.makeSpace(kVertexSize, kVerticesPerDraw, &buffer,
+                                                &startVertex);
+                if (!vertices) {
+                    SK_ABORT("Failed to allocate vertices");
+                }
+                memset(vertices, j, kVertexSize * kVerticesPerDraw);
+            }
+            pool.unmap();
+            pool.reset();
+        }
+    }
+
+    const bool fUseGpuBufferCache;
+    SkString fName;
+    sk_sp<GrDirectContext> fContext;
+    sk_sp<GrBufferAllocPool::CpuBufferCache> fCpuBufferCache;
+    sk_sp<GrBufferAllocPool::GpuBufferCache> fGpuBufferCache;
+};
+
+DEF_BENCH(return new BufferAllocPoolBench(false);)
+DEF_BENCH(return new BufferAllocPoolBench(true);)
@@ -23,6 +23,7 @@ struct Rec {
     int                         fLoops;
     const SkFont&               fFont;
     const SkUnichar*            fText;
+    const char*                 fASCII;
     int                         fCount;
 };
 }  // namespace
@@ -38,6 +39,15 @@ static void textToGlyphs_proc(const Rec& r) {
     }
 }
 
+static void textToGlyphsUTF8_proc(const Rec& r) {
+    uint16_t glyphs[NGLYPHS];
+    SkASSERT(r.fCount <= NGLYPHS);
+
+    for (int i = 0; i < r.fLoops; ++i) {
+        r.fFont.textToGlyphs(r.fASCII, r.fCount, SkTextEncoding::kUTF8, glyphs, NGLYPHS);
+    }
+}
+
 static void charsToGlyphs_proc(const Rec& r) {
     uint16_t glyphs[NGLYPHS];
     SkASSERT(r.fCount <= NGLYPHS);
@@ -65,10 +75,20 @@ static void findcache_proc(const Rec& r) {
     }
 }
 
+static void findglyphs_proc(const Rec& r) {
+    uint16_t glyphs[NGLYPHS];
+    SkASSERT(r.fCount <= NGLYPHS);
+
+    for (int loop = 0; loop < r.fLoops; ++loop) {
+        r.fCache.findGlyphs(r.fText, r.fCount, glyphs);
+    }
+}
+
 class CMAPBench : public Benchmark {
     TypefaceProc fProc;
     SkString     fName;
     SkUnichar    fText[NGLYPHS];
+    char         fASCII[NGLYPHS];
     SkFont       fFont;
     SkCharToGlyphCache fCache;
     int          fCount;
@@ -85,6 +105,7 @@ public:
         for (int i = 0; i < count; ++i) {
             fText[i] = rand.nextU() & 0xFFFF;
             fCache.addCharAndGlyph(fText[i], i);
+            fASCII[i] = ' ' + rand.nextULessThan(95);
         }
         fFont.setTypeface(SkTypeface::MakeDefault());
     }
@@ -99,7 +120,7 @@ protected:
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        fProc({fCache, loops, fFont, fText, fCount});
+        fProc({fCache, loops, fFont, fText, fASCII, fCount});
     }
 
 private:
@@ -115,6 +136,8 @@ DEF_BENCH( return new CMAPBench(textToGlyphs_proc, "font_charToGlyph", SMALL); )
 DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", SMALL); )
 DEF_BENCH( return new CMAPBench(addcache_proc, "addcache_charToGlyph", SMALL); )
 DEF_BENCH( return new CMAPBench(findcache_proc, "findcache_charToGlyph", SMALL); )
+DEF_BENCH( return new CMAPBench(textToGlyphsUTF8_proc, "font_utf8ToGlyph", SMALL); )
+DEF_BENCH( return new CMAPBench(findglyphs_proc, "findglyphs_charToGlyph", SMALL); )
 
 constexpr int BIG = 100;
 
@@ -122,3 +145,5 @@ DEF_BENCH( return new CMAPBench(textToGlyphs_proc, "font_charToGlyph", BIG); )
 DEF_BENCH( return new CMAPBench(charsToGlyphs_proc, "face_charToGlyph", BIG); )
 DEF_BENCH( return new CMAPBench(addcache_proc, "addcache_charToGlyph", BIG); )
 DEF_BENCH( return new CMAPBench(findcache_proc, "findcache_charToGlyph", BIG); )
+DEF_BENCH( return new CMAPBench(textToGlyphsUTF8_proc, "font_utf8ToGlyph", BIG); )
+DEF_BENCH( return new CMAPBench(findglyphs_proc, "findglyphs_charToGlyph", BIG); )
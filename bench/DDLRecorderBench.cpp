@@ -9,10 +9,16 @@
 
 #include "bench/Benchmark.h"
 
+#include "include/core/SkBlurTypes.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkDeferredDisplayListRecorder.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkString.h"
 #include "include/core/SkSurfaceCharacterization.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/core/SkTaskGroup.h"
 
 static SkSurfaceCharacterization create_characterization(GrDirectContext* direct) {
     size_t maxResourceBytes = direct->getResourceCacheLimit();
@@ -92,3 +98,80 @@ private:
 };
 
 DEF_BENCH(return new DDLRecorderBench();)
+
+// Records the same work as DDLRecorderBench, split across a recorder per thread. The recorders
+// share their context's thread safe cache, so this shows how recording scales with threads.
+class ThreadedDDLRecorderBench : public Benchmark {
+public:
+    ThreadedDDLRecorderBench(int numThreads)
+            : fNumThreads(numThreads)
+            , fName(SkStringPrintf("DDLRecorder_%dthreads", numThreads)) {}
+
+protected:
+    bool isSuitableFor(Backend backend) override { return kGPU_Backend == backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* origCanvas) override {
+        if (fRecorders.empty()) {
+            return;
+        }
+
+        SkTaskGroup(*fExecutor).batch(fNumThreads, [&](int t) {
+            std::vector<sk_sp<SkDeferredDisplayList>>& ddls = fDDLs[t];
+            for (int i = t; i < loops; i += fNumThreads) {
+                SkCanvas* recordingCanvas = fRecorders[t]->getCanvas();
+
+                // Vary the blur so the recorders also exercise the thread safe cache.
+                SkPaint paint;
+                paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 1 + (i & 7)));
+                recordingCanvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeWH(32, 32), 4, 4),
+                                           paint);
+
+                ddls.emplace_back(fRecorders[t]->detach());
+            }
+        });
+    }
+
+private:
+    void onPerCanvasPreDraw(SkCanvas* origCanvas) override {
+        auto context = origCanvas->recordingContext()->asDirectContext();
+        if (!context) {
+            return;
+        }
+
+        SkSurfaceCharacterization c = create_characterization(context);
+
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fNumThreads);
+        fDDLs.resize(fNumThreads);
+        for (int t = 0; t < fNumThreads; ++t) {
+            fRecorders.push_back(std::make_unique<SkDeferredDisplayListRecorder>(c));
+        }
+    }
+
+    // We defer the clean up of the DDLs so it is done outside of the timing loop
+    void onPostDraw(SkCanvas*) override {
+        for (auto& ddls : fDDLs) {
+            ddls.clear();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fRecorders.clear();
+        fDDLs.clear();
+        fExecutor.reset();
+    }
+
+    const int                                                   fNumThreads;
+    SkString                                                    fName;
+    std::unique_ptr<SkExecutor>                                 fExecutor;
+    std::vector<std::unique_ptr<SkDeferredDisplayListRecorder>> fRecorders;
+    std::vector<std::vector<sk_sp<SkDeferredDisplayList>>>      fDDLs;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new ThreadedDDLRecorderBench(1);)
+DEF_BENCH(return new ThreadedDDLRecorderBench(4);)
+DEF_BENCH(return new ThreadedDDLRecorderBench(16);)
+DEF_BENCH(return new ThreadedDDLRecorderBench(32);)
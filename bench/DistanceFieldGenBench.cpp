@@ -0,0 +1,96 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkMask.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+// Generates the distance fields of a page of A8 glyphs, one at a time or as a batch.
+class DistanceFieldGenBench : public Benchmark {
+public:
+    DistanceFieldGenBench(int size, bool batch) : fSize(size), fBatch(batch) {
+        fName.printf("distance_field_gen_%d%s", size, batch ? "_batch" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    static constexpr int kGlyphCount = 32;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        // A ring, with a soft edge, stands in for a glyph.
+        fImage.resize(fSize * fSize);
+        float center = (fSize - 1) * 0.5f, outer = fSize * 0.45f, inner = fSize * 0.25f;
+        for (int y = 0; y < fSize; ++y) {
+            for (int x = 0; x < fSize; ++x) {
+                float d = SkPoint::Length(x - center, y - center);
+                float coverage = std::min(std::clamp(outer - d + 0.5f, 0.f, 1.f),
+                                          std::clamp(d - inner + 0.5f, 0.f, 1.f));
+                fImage[y * fSize + x] = (uint8_t)(coverage * 255 + 0.5f);
+            }
+        }
+
+        SkMask mask;
+        mask.fImage = fImage.data();
+        mask.fBounds = SkIRect::MakeWH(fSize, fSize);
+        mask.fRowBytes = fSize;
+        mask.fFormat = SkMask::kA8_Format;
+        int fieldSize = fSize + 2 * SK_DistanceFieldPad;
+        fFields.resize(kGlyphCount * fieldSize * fieldSize);
+        for (int i = 0; i < kGlyphCount; ++i) {
+            fJobs.push_back({fFields.data() + i * fieldSize * fieldSize, mask});
+        }
+        if (fBatch) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fBatch) {
+                SkGenerateDistanceFields(fJobs, fExecutor.get());
+            } else {
+                for (const SkDistanceFieldJob& job : fJobs) {
+                    SkGenerateDistanceFieldFromMask(job.fDistanceField, job.fMask);
+                }
+            }
+        }
+    }
+
+private:
+    int fSize;
+    bool fBatch;
+    SkString fName;
+    std::vector<uint8_t> fImage;
+    std::vector<uint8_t> fFields;
+    std::vector<SkDistanceFieldJob> fJobs;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new DistanceFieldGenBench(16, false);)
+DEF_BENCH(return new DistanceFieldGenBench(32, false);)
+DEF_BENCH(return new DistanceFieldGenBench(64, false);)
+DEF_BENCH(return new DistanceFieldGenBench(128, false);)
+DEF_BENCH(return new DistanceFieldGenBench(32, true);)
+DEF_BENCH(return new DistanceFieldGenBench(128, true);)
+
+#endif // !defined(SK_DISABLE_SDF_TEXT)
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "src/base/SkRandom.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrDrawOpAtlas.h"
+#include "src/gpu/ganesh/text/GrAtlasManager.h"
+#include "tools/ToolUtils.h"
+
+#include <vector>
+
+// Draws runs of glyphs at many sizes through the smallest single-page glyph atlas, cycling through
+// more glyphs than fit so that plots are continually evicted and refilled. Compares the skyline
+// and MaxRects plot rectanizers. With --gpuStatsDump it also reports the A8 atlas's occupancy and
+// the bytes uploaded to it per glyph drawn.
+class GlyphAtlasChurnBench : public Benchmark {
+public:
+    GlyphAtlasChurnBench(bool maxRects) : fMaxRects(maxRects) {
+        fName.printf("glyph_atlas_churn_%s", maxRects ? "maxrects" : "skyline");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kGPU_Backend; }
+
+    void modifyGrContextOptions(GrContextOptions* options) override {
+        options->fGlyphCacheTextureMaximumBytes = 0;
+        options->fAllowMultipleGlyphCacheTextures = GrContextOptions::Enable::kNo;
+        options->fUseMaxRectsGlyphAtlas = fMaxRects;
+    }
+
+    void getGpuStats(SkCanvas* canvas,
+                     SkTArray<SkString>* keys,
+                     SkTArray<double>* values) override {
+        auto dContext = GrAsDirectContext(canvas->recordingContext());
+        if (!dContext) {
+            return;
+        }
+        const GrDrawOpAtlas* atlas =
+                dContext->priv().getAtlasManager()->peekAtlas(skgpu::MaskFormat::kA8);
+        if (!atlas || !fGlyphsDrawn) {
+            return;
+        }
+        keys->push_back(SkString("atlas_occupancy"));
+        values->push_back(atlas->occupancy());
+        keys->push_back(SkString("atlas_upload_bytes_per_glyph"));
+        values->push_back((double)(atlas->uploadedBytes() - fStartUploadedBytes) / fGlyphsDrawn);
+    }
+
+protected:
+    static constexpr int kRunCount = 256;
+    static constexpr int kRunsPerFrame = 32;
+    static constexpr int kGlyphsPerRun = 16;
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fTypeface = ToolUtils::create_portable_typeface();
+        int glyphCount = fTypeface->countGlyphs();
+        SkRandom rand;
+        for (int i = 0; i < kRunCount; ++i) {
+            Run& run = fRuns.push_back();
+            run.fSize = (float)(8 + rand.nextULessThan(41));
+            for (int j = 0; j < kGlyphsPerRun; ++j) {
+                run.fGlyphs[j] = (SkGlyphID)(1 + rand.nextULessThan(glyphCount - 1));
+                run.fPositions[j] = {j * run.fSize, 0};
+            }
+        }
+    }
+
+    void onPerCanvasPreDraw(SkCanvas* canvas) override {
+        auto dContext = GrAsDirectContext(canvas->recordingContext());
+        const GrDrawOpAtlas* atlas =
+                dContext ? dContext->priv().getAtlasManager()->peekAtlas(skgpu::MaskFormat::kA8)
+                         : nullptr;
+        fStartUploadedBytes = atlas ? atlas->uploadedBytes() : 0;
+        fGlyphsDrawn = 0;
+        fNextRun = 0;
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        auto dContext = GrAsDirectContext(canvas->recordingContext());
+        SkFont font(fTypeface);
+        SkPaint paint;
+        for (int i = 0; i < loops; ++i) {
+            // Each frame draws the next window of runs, so the working set keeps moving.
+            for (int j = 0; j < kRunsPerFrame; ++j) {
+                const Run& run = fRuns[fNextRun];
+                fNextRun = (fNextRun + 1) % kRunCount;
+                font.setSize(run.fSize);
+                SkPoint origin = {8, 8 + (j % 16) * 60.f};
+                canvas->drawGlyphs(kGlyphsPerRun, run.fGlyphs, run.fPositions, origin, font,
+                                   paint);
+                fGlyphsDrawn += kGlyphsPerRun;
+            }
+            if (dContext) {
+                dContext->flushAndSubmit();
+            }
+        }
+    }
+
+private:
+    struct Run {
+        float fSize;
+        SkGlyphID fGlyphs[kGlyphsPerRun];
+        SkPoint fPositions[kGlyphsPerRun];
+    };
+
+    bool fMaxRects;
+    SkString fName;
+    sk_sp<SkTypeface> fTypeface;
+    SkTArray<Run> fRuns;
+    int fNextRun = 0;
+    size_t fStartUploadedBytes = 0;
+    int64_t fGlyphsDrawn = 0;
+};
+
+DEF_BENCH(return new GlyphAtlasChurnBench(false);)
+DEF_BENCH(return new GlyphAtlasChurnBench(true);)
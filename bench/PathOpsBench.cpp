@@ -6,12 +6,16 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/pathops/SkPathOps.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkRandom.h"
+#include "src/pathops/SkPathOpsLinear.h"
+
+#include <memory>
 
 class PathOpsBench : public Benchmark {
     SkString    fName;
@@ -94,6 +98,129 @@ static SkPath makerects() {
 }
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
 
+// Overlapping, mostly non-convex polygons on a grid, like the building outlines on a map tile.
+static SkTArray<SkPath> makebuildings(int count) {
+    SkRandom rand;
+    SkTArray<SkPath> paths;
+    int columns = SkScalarCeilToInt(SkScalarSqrt(count));
+    for (int i = 0; i < count; ++i) {
+        SkScalar cx = (i % columns) * 20 + rand.nextRangeScalar(-6, 6);
+        SkScalar cy = (i / columns) * 20 + rand.nextRangeScalar(-6, 6);
+        int sides = 4 + rand.nextULessThan(8);
+        SkPath& path = paths.push_back();
+        for (int side = 0; side < sides; ++side) {
+            SkScalar angle = side * 2 * SK_ScalarPI / sides;
+            SkScalar radius = rand.nextRangeScalar(6, 14);
+            SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+            if (side == 0) {
+                path.moveTo(pt);
+            } else {
+                path.lineTo(pt);
+            }
+        }
+        path.close();
+    }
+    return paths;
+}
+
+static SkPath makebuildingspath(int count) {
+    SkPath path;
+    for (const SkPath& building : makebuildings(count)) {
+        path.addPath(building);
+    }
+    return path;
+}
+DEF_BENCH( return new PathOpsSimplifyBench("buildings", makebuildingspath(100)); )
+
+// Simplifies a line-only path with the snap rounding engine, or with the general one for contrast.
+class PathOpsLinearBench : public Benchmark {
+    SkString    fName;
+    SkPath      fPath;
+    bool        fLinear;
+
+public:
+    PathOpsLinearBench(int count, bool linear)
+            : fPath(makebuildingspath(count)), fLinear(linear) {
+        fName.printf("pathops_simplify_buildings_%d_%s", count, linear ? "linear" : "general");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkPath result;
+            if (fLinear) {
+                SnapRoundedSimplify(fPath, &result);
+            } else {
+                Simplify(fPath, &result);
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsLinearBench(2000, false); )
+DEF_BENCH( return new PathOpsLinearBench(2000, true); )
+
+class PathOpsBuilderBench : public Benchmark {
+    SkString                    fName;
+    int                         fCount;
+    bool                        fParallel;
+    SkTArray<SkPath>            fPaths;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+public:
+    PathOpsBuilderBench(int count, bool parallel) : fCount(count), fParallel(parallel) {
+        fName.printf("pathops_builder_buildings_%d%s", count, parallel ? "_parallel" : "");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fPaths = makebuildings(fCount);
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            if (fParallel) {
+                builder.resolveParallel(&result, fExecutor.get());
+            } else {
+                builder.resolve(&result);
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsBuilderBench(64, false); )
+DEF_BENCH( return new PathOpsBuilderBench(64, true); )
+DEF_BENCH( return new PathOpsBuilderBench(256, false); )
+DEF_BENCH( return new PathOpsBuilderBench(256, true); )
+
 #include "include/core/SkPathBuilder.h"
 
 template <size_t N> struct ArrayPath {
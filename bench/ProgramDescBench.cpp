@@ -0,0 +1,124 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/gpu/GrDirectContext.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/gpu/ganesh/GrAppliedClip.h"
+#include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrDefaultGeoProcFactory.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrDstProxyView.h"
+#include "src/gpu/ganesh/GrFragmentProcessor.h"
+#include "src/gpu/ganesh/GrProgramDesc.h"
+#include "src/gpu/ganesh/GrProgramInfo.h"
+#include "src/gpu/ganesh/SurfaceDrawContext.h"
+#include "tools/gpu/ProxyUtils.h"
+
+// Measures building the program key of a draw whose coverage is a deep FP tree, as the backends do
+// each time they bind a program.
+//
+// kRepeatKey keys the same pipeline over and over. kFirstKey builds a fresh pipeline for every key,
+// as most draws do, and kBuildOnly builds the pipelines without keying them; the difference between
+// the two is the cost of a pipeline's first key.
+class ProgramDescBench : public Benchmark {
+public:
+    enum class Mode { kRepeatKey, kFirstKey, kBuildOnly };
+
+    ProgramDescBench(int depth, Mode mode) : fDepth(depth), fMode(mode) {
+        static const char* kSuffixes[] = {"", "_first_key", "_build_only"};
+        fName.printf("program_desc_fp_depth_%d%s", depth, kSuffixes[(int)mode]);
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        GrMockOptions mockOptions;
+        fContext = GrDirectContext::MakeMock(&mockOptions, GrContextOptions());
+        fSDC = skgpu::v1::SurfaceDrawContext::Make(fContext.get(),
+                                                   GrColorType::kRGBA_8888,
+                                                   nullptr,
+                                                   SkBackingFit::kExact,
+                                                   {64, 64},
+                                                   SkSurfaceProps(),
+                                                   /*label=*/"ProgramDescBench");
+        if (fMode == Mode::kRepeatKey) {
+            fProgramInfo = this->makeProgramInfo(&fArena);
+        }
+    }
+
+    GrProgramInfo* makeProgramInfo(SkArenaAlloc* arena) {
+        auto fp = GrFragmentProcessor::MakeColor({1, 1, 1, 1});
+        for (int i = 0; i < fDepth; ++i) {
+            float c = (float)i / fDepth;
+            fp = GrFragmentProcessor::Compose(std::move(fp),
+                                              GrFragmentProcessor::MakeColor({c, c, c, 1}));
+        }
+        GrAppliedClip clip(fSDC->dimensions());
+        clip.addCoverageFP(std::move(fp));
+
+        using namespace GrDefaultGeoProcFactory;
+        GrGeometryProcessor* geomProc =
+                GrDefaultGeoProcFactory::Make(arena,
+                                              Color::kPremulGrColorAttribute_Type,
+                                              Coverage::kSolid_Type,
+                                              LocalCoords::kUnused_Type,
+                                              SkMatrix::I());
+        return sk_gpu_test::CreateProgramInfo(fContext->priv().caps(),
+                                              arena,
+                                              fSDC->writeSurfaceView(),
+                                              /*usesMSAASurface=*/false,
+                                              std::move(clip),
+                                              GrDstProxyView(),
+                                              geomProc,
+                                              SkBlendMode::kSrcOver,
+                                              GrPrimitiveType::kTriangles,
+                                              GrXferBarrierFlags::kNone,
+                                              GrLoadOp::kLoad);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const GrCaps* caps = fContext->priv().caps();
+        for (int i = 0; i < loops; ++i) {
+            GrProgramInfo* programInfo = fProgramInfo;
+            SkSTArenaAlloc<4096> arena;
+            if (fMode != Mode::kRepeatKey) {
+                programInfo = this->makeProgramInfo(&arena);
+            }
+            if (fMode == Mode::kBuildOnly) {
+                continue;
+            }
+            GrProgramDesc desc = caps->makeDesc(/*renderTarget=*/nullptr, *programInfo);
+            if (!desc.isValid()) {
+                SK_ABORT("Failed to build program desc");
+            }
+        }
+    }
+
+    const int fDepth;
+    const Mode fMode;
+    SkString fName;
+    sk_sp<GrDirectContext> fContext;
+    std::unique_ptr<skgpu::v1::SurfaceDrawContext> fSDC;
+    SkSTArenaAlloc<4096> fArena;
+    GrProgramInfo* fProgramInfo = nullptr;
+};
+
+DEF_BENCH(return new ProgramDescBench(4, ProgramDescBench::Mode::kRepeatKey);)
+DEF_BENCH(return new ProgramDescBench(16, ProgramDescBench::Mode::kRepeatKey);)
+DEF_BENCH(return new ProgramDescBench(4, ProgramDescBench::Mode::kFirstKey);)
+DEF_BENCH(return new ProgramDescBench(16, ProgramDescBench::Mode::kFirstKey);)
+DEF_BENCH(return new ProgramDescBench(4, ProgramDescBench::Mode::kBuildOnly);)
+DEF_BENCH(return new ProgramDescBench(16, ProgramDescBench::Mode::kBuildOnly);)
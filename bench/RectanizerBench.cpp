@@ -12,6 +12,7 @@
 #include "include/private/base/SkTDArray.h"
 #include "src/base/SkRandom.h"
 
+#include "src/gpu/RectanizerMaxRects.h"
 #include "src/gpu/RectanizerPow2.h"
 #include "src/gpu/RectanizerSkyline.h"
 
@@ -22,10 +23,12 @@ using namespace skgpu;
  * rectanizers:
  *      Pow2 Rectanizer
  *      Skyline Rectanizer
+ *      MaxRects Rectanizer
  * in the following cases:
  *      random rects (e.g., pull-save-layers forward use case)
  *      random power of two rects
  *      small constant sized power of 2 rects (e.g., glyph cache use case)
+ *      small random rects (e.g., glyph cache with mixed sizes)
  */
 class RectanizerBench : public Benchmark {
 public:
@@ -35,12 +38,14 @@ public:
     enum RectanizerType {
         kPow2_RectanizerType,
         kSkyline_RectanizerType,
+        kMaxRects_RectanizerType,
     };
 
     enum RectType {
         kRand_RectType,
         kRandPow2_RectType,
-        kSmallPow2_RectType
+        kSmallPow2_RectType,
+        kSmallRand_RectType
     };
 
     RectanizerBench(RectanizerType rectanizerType, RectType rectType)
@@ -50,18 +55,22 @@ public:
 
         if (kPow2_RectanizerType == fRectanizerType) {
             fName.append("pow2_");
-        } else {
-            SkASSERT(kSkyline_RectanizerType == fRectanizerType);
+        } else if (kSkyline_RectanizerType == fRectanizerType) {
             fName.append("skyline_");
+        } else {
+            SkASSERT(kMaxRects_RectanizerType == fRectanizerType);
+            fName.append("maxrects_");
         }
 
         if (kRand_RectType == fRectType) {
             fName.append("rand");
         } else if (kRandPow2_RectType == fRectType) {
             fName.append("rand2");
-        } else {
-            SkASSERT(kSmallPow2_RectType == fRectType);
+        } else if (kSmallPow2_RectType == fRectType) {
             fName.append("sm2");
+        } else {
+            SkASSERT(kSmallRand_RectType == fRectType);
+            fName.append("smrand");
         }
     }
 
@@ -79,9 +88,11 @@ protected:
 
         if (kPow2_RectanizerType == fRectanizerType) {
             fRectanizer = std::make_unique<RectanizerPow2>(kWidth, kHeight);
-        } else {
-            SkASSERT(kSkyline_RectanizerType == fRectanizerType);
+        } else if (kSkyline_RectanizerType == fRectanizerType) {
             fRectanizer = std::make_unique<RectanizerSkyline>(kWidth, kHeight);
+        } else {
+            SkASSERT(kMaxRects_RectanizerType == fRectanizerType);
+            fRectanizer = std::make_unique<RectanizerMaxRects>(kWidth, kHeight);
         }
     }
 
@@ -97,9 +108,11 @@ protected:
             } else if (kRandPow2_RectType == fRectType) {
                 size = SkISize::Make(GrNextPow2(rand.nextRangeU(1, kWidth / 2)),
                                      GrNextPow2(rand.nextRangeU(1, kHeight / 2)));
-            } else {
-                SkASSERT(kSmallPow2_RectType == fRectType);
+            } else if (kSmallPow2_RectType == fRectType) {
                 size = SkISize::Make(128, 128);
+            } else {
+                SkASSERT(kSmallRand_RectType == fRectType);
+                size = SkISize::Make(rand.nextRangeU(4, 64), rand.nextRangeU(4, 64));
             }
 
             if (!fRectanizer->addRect(size.fWidth, size.fHeight, &loc)) {
@@ -136,3 +149,15 @@ DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
                                      RectanizerBench::kRandPow2_RectType);)
 DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
                                      RectanizerBench::kSmallPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kPow2_RectanizerType,
+                                     RectanizerBench::kSmallRand_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
+                                     RectanizerBench::kSmallRand_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kRand_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kRandPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kSmallPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(RectanizerBench::kMaxRects_RectanizerType,
+                                     RectanizerBench::kSmallRand_RectType);)
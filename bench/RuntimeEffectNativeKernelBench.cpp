@@ -0,0 +1,87 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkShader.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/core/SkRuntimeEffectPriv.h"
+
+// Generated by skslc from resources/sksl/native_kernels/ into tests/sksl/native_kernels/.
+extern const SkRuntimeEffectPriv::NativeKernel gNativeKernel_Plasma;
+extern const SkRuntimeEffectPriv::NativeKernel gNativeKernel_Posterize;
+
+// Draws a runtime effect into the raster canvas, either through its ahead-of-time native kernel
+// or through the default raster path (with the kernel unregistered).
+class RuntimeEffectNativeKernelBench : public Benchmark {
+public:
+    RuntimeEffectNativeKernelBench(const char* name,
+                                   const SkRuntimeEffectPriv::NativeKernel& kernel,
+                                   bool native)
+            : fKernel(kernel), fNative(native) {
+        fName.printf("runtime_effect_native_kernel_%s_%s", name, native ? "native" : "default");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+
+    void onDelayedSetup() override {
+        SkString sksl(fKernel.fSkSL);
+        if (sk_sp<SkRuntimeEffect> effect = SkRuntimeEffect::MakeForShader(sksl).effect) {
+            SkRuntimeShaderBuilder builder(effect);
+            builder.uniform("time") = 0.75f;
+            builder.uniform("colorA") = SkV4{1, 0.5f, 0, 1};
+            builder.uniform("colorB") = SkV4{0, 0.25f, 1, 1};
+            fPaint.setShader(builder.makeShader());
+        } else {
+            effect = SkRuntimeEffect::MakeForColorFilter(sksl).effect;
+            SkASSERT(effect);
+            const SkPoint pts[] = {{0, 0}, {256, 256}};
+            const SkColor colors[] = {SK_ColorRED, SK_ColorTRANSPARENT, SK_ColorCYAN};
+            fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 3,
+                                                          SkTileMode::kClamp));
+            float levels = 4;
+            fPaint.setColorFilter(effect->makeColorFilter(SkData::MakeWithCopy(&levels,
+                                                                               sizeof(levels))));
+        }
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        if (fNative) {
+            SkRuntimeEffectPriv::RegisterNativeKernel(&fKernel);
+        }
+    }
+
+    void onPostDraw(SkCanvas*) override {
+        if (fNative) {
+            SkRuntimeEffectPriv::UnregisterNativeKernel(&fKernel);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            canvas->drawRect({0, 0, 256, 256}, fPaint);
+        }
+    }
+
+private:
+    const SkRuntimeEffectPriv::NativeKernel& fKernel;
+    bool fNative;
+    SkString fName;
+    SkPaint fPaint;
+};
+
+DEF_BENCH(return new RuntimeEffectNativeKernelBench("plasma", gNativeKernel_Plasma, false);)
+DEF_BENCH(return new RuntimeEffectNativeKernelBench("plasma", gNativeKernel_Plasma, true);)
+DEF_BENCH(return new RuntimeEffectNativeKernelBench("posterize", gNativeKernel_Posterize, false);)
+DEF_BENCH(return new RuntimeEffectNativeKernelBench("posterize", gNativeKernel_Posterize, true);)
@@ -5,24 +5,49 @@
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkString.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "tools/Resources.h"
 
 #include <cfloat>
+#include <memory>
 
 namespace {
 struct ShaperBench : public Benchmark {
-    ShaperBench(const char* r, const char* n) : fResource(r), fName(n) {}
+    ShaperBench(const char* r, const char* n, bool wordCache = false)
+        : fResource(r), fWordCache(wordCache) {
+        fName.printf("%s%s", n, wordCache ? "_word_cache" : "");
+    }
     std::unique_ptr<SkShaper> fShaper;
     sk_sp<SkData> fData;
     const char* fResource;
-    const char* fName;
-    const char* onGetName() override { return fName; }
+    SkString fName;
+    bool fWordCache;
+    const char* onGetName() override { return fName.c_str(); }
     bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
     void onDelayedSetup() override {
         fShaper = SkShaper::Make();
         fData = GetResourceAsData(fResource);
     }
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+    std::shared_ptr<SkShaper::HarfBuzzWordCache> fCache;
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        if (fWordCache) {
+            // Start from a cold cache of our own, so the hit rate covers all the loops and no
+            // other bench sees its words.
+            fCache = SkShaper::MakeHarfBuzzWordCache(4096);
+            fShaper = SkShaper::MakeShaperDrivenWrapper(nullptr, fCache);
+        }
+    }
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        if (fCache) {
+            auto stats = SkShaper::GetHarfBuzzWordCacheStats(*fCache);
+            size_t lookups = stats.fHits + stats.fMisses;
+            SkDEBUGCODE(SkDebugf("%s: %zu words cached, hit rate %1.2f%%\n", fName.c_str(),
+                                 stats.fCount, lookups ? stats.fHits * 100.0 / lookups : 0.0);)
+        }
+    }
+#endif
     void onDraw(int loops, SkCanvas*) override {
         if (!fData || !fShaper) { return; }
         SkFont font;
@@ -74,4 +99,13 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+#define SHAPER_WORD_CACHE_BENCH(X) \
+    DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_" #X, true);)
+SHAPER_WORD_CACHE_BENCH(cyrillic)
+SHAPER_WORD_CACHE_BENCH(english)
+SHAPER_WORD_CACHE_BENCH(greek)
+#undef SHAPER_WORD_CACHE_BENCH
+#endif
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
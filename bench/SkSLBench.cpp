@@ -8,16 +8,28 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/base/SkStringView.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRuntimeEffectPriv.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLModuleLoader.h"
 #include "src/sksl/SkSLParser.h"
+#include "src/sksl/SkSLUtil.h"
+#include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
+#include "src/sksl/codegen/SkSLRasterPipelineCodeGenerator.h"
 #include "src/sksl/codegen/SkSLVMCodeGenerator.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
 #include "src/sksl/ir/SkSLProgram.h"
+#include "tools/Resources.h"
 
 #include <regex>
+#include <vector>
 
 #include "src/sksl/generated/sksl_shared.minified.sksl"
 #include "src/sksl/generated/sksl_compute.minified.sksl"
@@ -51,6 +63,61 @@ protected:
 
 DEF_BENCH(return new SkSLCompilerStartupBench();)
 
+// Measures SkRuntimeEffect::MakeForShader with the effect cache cold (purged before every
+// creation) and warm (always hitting the cache).
+class RuntimeEffectCreationBench : public Benchmark {
+public:
+    RuntimeEffectCreationBench(bool warm) : fWarm(warm) {
+        fName.printf("sksl_runtime_effect_creation_%s", warm ? "warm" : "cold");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        // Prime the compiler's modules, so the cold bench only measures the effect itself.
+        SkRuntimeEffect::MakeForShader(SkString(kSrc));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (!fWarm) {
+                SkRuntimeEffectPriv::PurgeCache();
+            }
+            auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(kSrc));
+            SkASSERT(effect);
+        }
+    }
+
+private:
+    static constexpr char kSrc[] = R"(
+        uniform shader child;
+        uniform float4 gColor;
+        uniform float2x2 gMatrix;
+
+        half4 main(float2 p) {
+            float2 q = gMatrix * p;
+            half4 c = child.eval(q);
+            for (int i = 0; i < 4; i++) {
+                c.rgb = mix(c.rgb, half3(gColor.rgb), half(0.25 * float(i)));
+            }
+            return c * half(fract(q.x + q.y));
+        }
+    )";
+
+    SkString fName;
+    bool fWarm;
+};
+
+DEF_BENCH(return new RuntimeEffectCreationBench(/*warm=*/false);)
+DEF_BENCH(return new RuntimeEffectCreationBench(/*warm=*/true);)
+
 enum class Output {
     kNone,
     kGLSL,
@@ -630,3 +697,214 @@ DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
                                                    SkSL::ProgramKind::kGraphiteVertex,
                                                    SkSL::ProgramKind::kGraphiteFragment,
                                            });)
+
+// Measures the latency of the first runtime effect created in a process: the modules it needs are
+// unloaded (and the effect cache purged) before each run, so module loading is included. Compare
+// against sksl_runtime_effect_creation_cold to see how much of it SkGraphics::WarmUpSkSLModules
+// can move off the first compile.
+class SkSLFirstCompileBench : public Benchmark {
+public:
+    const char* onGetName() override {
+        return "sksl_first_runtime_effect_compile";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    int calculateLoops(int defaultLoops) const override {
+        return 1;
+    }
+
+    void onPreDraw(SkCanvas*) override {
+        SkSL::ModuleLoader::Get().unloadModules();
+        SkRuntimeEffectPriv::PurgeCache();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkASSERT(loops == 1);
+        auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(R"(
+            uniform shader child;
+            half4 main(float2 p) { return child.eval(p).bgra; }
+        )"));
+        SkASSERT(effect);
+    }
+};
+
+DEF_BENCH(return new SkSLFirstCompileBench();)
+
+// Compiles a runtime effect from resources/sksl/runtime for the SkSL Raster Pipeline backend, with
+// or without the Raster Pipeline optimizer (immediate-operand folding, copy forwarding, dead store
+// elimination and slot reuse). Returns null if the file is missing, or if the effect can't run on
+// the Raster Pipeline without more setup (children or a blender's destination color).
+static std::unique_ptr<SkSL::RP::Program> make_raster_pipeline_program(const char* path,
+                                                                      bool optimize,
+                                                                      int* uniformSlots) {
+    sk_sp<SkData> data = GetResourceAsData(path);
+    if (!data) {
+        return nullptr;
+    }
+    std::string src(static_cast<const char*>(data->data()), data->size());
+
+    SkSL::ProgramKind kind;
+    sk_sp<SkRuntimeEffect> effect;
+    if (skstd::ends_with(path, ".rtcf")) {
+        kind = SkSL::ProgramKind::kRuntimeColorFilter;
+        effect = SkRuntimeEffect::MakeForColorFilter(SkString(src)).effect;
+    } else if (skstd::ends_with(path, ".rts")) {
+        kind = SkSL::ProgramKind::kRuntimeShader;
+        effect = SkRuntimeEffect::MakeForShader(SkString(src)).effect;
+    } else {
+        return nullptr;
+    }
+    if (!effect || !effect->children().empty()) {
+        return nullptr;
+    }
+
+    SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Default());
+    SkSL::ProgramSettings settings;
+    // Only the Raster Pipeline optimizer is toggled, so both runs start from the same SkSL.
+    settings.fOptimizeRasterPipeline = optimize;
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(kind, src, settings);
+    if (!program) {
+        return nullptr;
+    }
+    const SkSL::FunctionDeclaration* main = program->getFunction("main");
+    *uniformSlots = effect->uniformSize() / sizeof(float);
+    return SkSL::MakeRasterPipelineProgram(*program, *main->definition());
+}
+
+// The programs from resources/sksl/runtime which run on the Raster Pipeline without children.
+#define SKSL_RP_PROGRAMS(M)                  \
+    M(ArrayIndexing, rts)                    \
+    M(Commutative, rts)                      \
+    M(ConversionConstructors, rts)           \
+    M(GlobalVariables, rts)                  \
+    M(HSLColorFilter, rtcf)                  \
+    M(LargeProgram_BlocklessLoops, rts)      \
+    M(LargeProgram_FlatLoop, rts)            \
+    M(LargeProgram_Functions, rts)           \
+    M(LargeProgram_NestedLoops, rts)         \
+    M(LargeProgram_SplitLoops, rts)          \
+    M(LoopFloat, rts)                        \
+    M(LoopInt, rts)                          \
+    M(RecursiveComparison_Arrays, rts)       \
+    M(RecursiveComparison_Structs, rts)      \
+    M(RecursiveComparison_Types, rts)        \
+    M(RecursiveComparison_Vectors, rts)      \
+    M(Switch, rts)                           \
+    M(SwitchWithFallthrough, rts)            \
+    M(SwitchWithLoops, rts)                  \
+    M(VectorIndexing, rts)
+
+// Runs a program from SKSL_RP_PROGRAMS through the SkSL Raster Pipeline backend, with and
+// without the Raster Pipeline optimizer, to measure the execution cost of the generated stages.
+class SkSLRasterPipelineBench : public Benchmark {
+public:
+    SkSLRasterPipelineBench(const char* name, const char* file, bool optimize)
+            : fName(SkStringPrintf("sksl_rp_%s%s", optimize ? "" : "unoptimized_", name))
+            , fFile(file)
+            , fOptimize(optimize) {}
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkString path = SkStringPrintf("sksl/runtime/%s", fFile);
+        int uniformSlots = 0;
+        fProgram = make_raster_pipeline_program(path.c_str(), fOptimize, &uniformSlots);
+        if (!fProgram) {
+            return;
+        }
+        // The test programs compare against uniform colors; any values will do for timing.
+        fUniforms.resize(uniformSlots, 1.0f);
+
+        fPipeline.append_constant_color(&fAlloc, SkColor4f{0.25f, 0.5f, 0.75f, 1.0f});
+        fProgram->appendStages(&fPipeline, &fAlloc, /*callbacks=*/nullptr, fUniforms);
+        fDstCtx = {fPixels, kWidth};
+        fPipeline.append(SkRasterPipelineOp::store_f32, &fDstCtx);
+        fRun = fPipeline.compile();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fRun) {
+            return;
+        }
+        for (int i = 0; i < loops; i++) {
+            fRun(0, 0, kWidth, kHeight);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 64;
+    static constexpr int kHeight = 16;
+
+    SkString fName;
+    const char* fFile;
+    bool fOptimize;
+    SkSTArenaAlloc<4096> fAlloc;
+    SkRasterPipeline fPipeline{&fAlloc};
+    std::unique_ptr<SkSL::RP::Program> fProgram;
+    std::vector<float> fUniforms;
+    SkRasterPipeline_MemoryCtx fDstCtx;
+    std::function<void(size_t, size_t, size_t, size_t)> fRun;
+    float fPixels[4 * kWidth * kHeight];
+};
+
+#define RASTER_PIPELINE_BENCH(name, ext)                                                   \
+DEF_BENCH(return new SkSLRasterPipelineBench(#name, #name "." #ext, /*optimize=*/false);)  \
+DEF_BENCH(return new SkSLRasterPipelineBench(#name, #name "." #ext, /*optimize=*/true);)
+
+SKSL_RP_PROGRAMS(RASTER_PIPELINE_BENCH)
+
+#undef RASTER_PIPELINE_BENCH
+
+// Counts the Raster Pipeline stages that a program appends.
+static int count_raster_pipeline_stages(const SkSL::RP::Program& program, int uniformSlots) {
+    SkSTArenaAlloc<4096> alloc;
+    SkRasterPipeline pipeline(&alloc);
+    std::vector<float> uniforms(uniformSlots);
+    program.appendStages(&pipeline, &alloc, /*callbacks=*/nullptr, uniforms);
+    return pipeline.getNumStages();
+}
+
+// These aren't timed either; they report how many stages each program from SKSL_RP_PROGRAMS
+// takes, before and after the Raster Pipeline optimizer.
+void RunSkSLRasterPipelineStageCounts(NanoJSONResultsWriter* log) {
+#define RASTER_PIPELINE_PROGRAM(name, ext) {#name, #name "." #ext},
+    static constexpr struct {
+        const char* fName;
+        const char* fFile;
+    } kPrograms[] = { SKSL_RP_PROGRAMS(RASTER_PIPELINE_PROGRAM) };
+#undef RASTER_PIPELINE_PROGRAM
+
+    for (const auto& [programName, file] : kPrograms) {
+        SkString path = SkStringPrintf("sksl/runtime/%s", file);
+        int uniformSlots = 0;
+        std::unique_ptr<SkSL::RP::Program> unoptimized =
+                make_raster_pipeline_program(path.c_str(), /*optimize=*/false, &uniformSlots);
+        std::unique_ptr<SkSL::RP::Program> optimized =
+                make_raster_pipeline_program(path.c_str(), /*optimize=*/true, &uniformSlots);
+        if (!unoptimized || !optimized) {
+            continue;
+        }
+        SkString name = SkStringPrintf("sksl_rp_stages_%s", programName);
+        int before = count_raster_pipeline_stages(*unoptimized, uniformSlots);
+        int after = count_raster_pipeline_stages(*optimized, uniformSlots);
+        SkDEBUGCODE(SkDebugf("%s: %d stages (%d unoptimized)\n", name.c_str(), after, before);)
+        log->beginObject(name.c_str());                   // test
+        log->beginObject("meta");                         //   config
+        log->appendS32("stages", after);                  //     sub_result
+        log->appendS32("stages_unoptimized", before);     //     sub_result
+        log->endObject();                                 //   config
+        log->endObject();                                 // test
+    }
+}
+
+#undef SKSL_RP_PROGRAMS
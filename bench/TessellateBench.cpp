@@ -184,6 +184,42 @@ DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_affine, make_cubic_path(18),
     benchmark_wangs_formula_cubic_log2(fMatrix, fPath);
 }
 
+// Evaluates the cubics four at a time, the way PatchWriter::writeCubicRun() does.
+static void benchmark_wangs_formula_cubic_log2_x4(const SkMatrix& matrix, const SkPath& path) {
+    int sum = 0;
+    wangs_formula::VectorXform xform(matrix);
+    // make_cubic_path() writes a single run of cubics, so cubic i starts at point 3i.
+    const SkPoint* pts = SkPathPriv::PointData(path);
+    int count = (path.countPoints() - 1) / 3;
+    for (; count >= 4; count -= 4, pts += 12) {
+        skvx::float4 x[4], y[4];
+        for (int i = 0; i < 4; ++i) {
+            x[i] = {pts[i].fX, pts[i + 3].fX, pts[i + 6].fX, pts[i + 9].fX};
+            y[i] = {pts[i].fY, pts[i + 3].fY, pts[i + 6].fY, pts[i + 9].fY};
+        }
+        skvx::float4 n4 = wangs_formula::cubic_p4(4, x, y, xform);
+        for (int i = 0; i < 4; ++i) {
+            sum += wangs_formula::nextlog16(n4[i]);
+        }
+    }
+    for (; count > 0; --count, pts += 3) {
+        sum += wangs_formula::cubic_log2(4, pts, xform);
+    }
+    // Don't let the compiler optimize away wangs_formula::cubic_p4.
+    if (sum <= 0) {
+        SK_ABORT("sum should be > 0.");
+    }
+}
+
+DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_x4, make_cubic_path(18), SkMatrix::I()) {
+    benchmark_wangs_formula_cubic_log2_x4(fMatrix, fPath);
+}
+
+DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_x4_affine, make_cubic_path(18),
+                    SkMatrix::MakeAll(.9f,0.9f,0,  1.1f,1.1f,0, 0,0,1)) {
+    benchmark_wangs_formula_cubic_log2_x4(fMatrix, fPath);
+}
+
 static void benchmark_wangs_formula_conic(const SkMatrix& matrix, const SkPath& path) {
     int sum = 0;
     wangs_formula::VectorXform xform(matrix);
@@ -6,11 +6,21 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
+#include "src/gpu/ganesh/geometry/GrAATriangulator.h"
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulationCache.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include "tools/gpu/MemoryCache.h"
+#include <memory>
 #include <vector>
 
 using namespace skia_private;
@@ -110,6 +120,133 @@ public:
 
 DEF_BENCH( return new PathToTrianglesBench(); );
 
+// Lays copies of the tiger paths out on a grid as one large path with many disjoint components,
+// and triangulates it serially or split up across a thread pool.
+class PathToTrianglesParallelBench : public TriangulatorBenchmark {
+public:
+    PathToTrianglesParallelBench(bool aa, int threads)
+            : TriangulatorBenchmark(SkStringPrintf("PathToTriangles%sParallel_%d",
+                                                   aa ? "AA" : "", threads).c_str())
+            , fAA(aa) {
+        if (threads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(threads);
+        }
+    }
+
+protected:
+    void onDelayedSetup() override {
+        TriangulatorBenchmark::onDelayedSetup();
+        SkRect cell = SkRect::MakeEmpty();
+        for (const SkPath& path : fPaths) {
+            cell.join(path.getBounds());
+        }
+        for (int i = 0; i < 64; ++i) {
+            const SkPath& path = fPaths[i % fPaths.size()];
+            fBigPath.addPath(path, (i % 8) * (cell.width() + 2), (i / 8) * (cell.height() + 2));
+        }
+    }
+
+    void doLoop() override {
+        if (fAA) {
+            GrAATriangulator::PathToAATrianglesParallel(fBigPath, kTigerTolerance,
+                                                        SkRect::MakeEmpty(), this,
+                                                        fExecutor.get());
+        } else {
+            bool isLinear;
+            GrTriangulator::PathToTrianglesParallel(fBigPath, kTigerTolerance,
+                                                    SkRect::MakeEmpty(), this, &isLinear,
+                                                    fExecutor.get());
+        }
+    }
+
+    bool fAA;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkPath fBigPath;
+};
+
+DEF_BENCH( return new PathToTrianglesParallelBench(false, 0); );
+DEF_BENCH( return new PathToTrianglesParallelBench(false, 2); );
+DEF_BENCH( return new PathToTrianglesParallelBench(false, 4); );
+DEF_BENCH( return new PathToTrianglesParallelBench(true, 0); );
+DEF_BENCH( return new PathToTrianglesParallelBench(true, 4); );
+
+// Loads the tiger triangulations from a warm persistent cache, as a restarted app would. Compare
+// with PathToTriangles.
+class PersistentCacheHitBench : public TriangulatorBenchmark {
+public:
+    PersistentCacheHitBench() : TriangulatorBenchmark("PersistentCacheHit") {}
+
+protected:
+    void onDelayedSetup() override {
+        TriangulatorBenchmark::onDelayedSetup();
+        for (const SkPath& path : fPaths) {
+            fKeys.push_back(GrTriangulationCache::MakeKey(path, kTigerTolerance,
+                                                          /*antialias=*/false,
+                                                          SkRect::MakeEmpty()));
+        }
+        this->doLoop();
+    }
+
+    void doLoop() override {
+        for (int i = 0; i < fPaths.size(); ++i) {
+            bool isLinear;
+            GrTriangulationCache::Triangulate(&fCache, *fKeys[i], fPaths[i], this, &isLinear,
+                    [&](GrEagerVertexAllocator* allocator, bool* linear) {
+                        return GrTriangulator::PathToTriangles(fPaths[i], kTigerTolerance,
+                                                               SkRect::MakeEmpty(), allocator,
+                                                               linear);
+                    });
+        }
+    }
+
+    sk_gpu_test::MemoryCache fCache;
+    SkTArray<sk_sp<SkData>> fKeys;
+};
+
+DEF_BENCH( return new PersistentCacheHitBench(); );
+
+// Draws the tiger paths non-AA through TriangulatingPathRenderer on a new mock context, as the
+// first frame after a launch or a context loss does. With 'persistent' the triangulations are
+// loaded from a warm persistent geometry cache rather than computed.
+class ColdStartBench : public TriangulatorBenchmark {
+public:
+    ColdStartBench(bool persistent)
+            : TriangulatorBenchmark(persistent ? "ColdStartPersistentCache" : "ColdStart")
+            , fPersistent(persistent) {}
+
+protected:
+    void onDelayedSetup() override {
+        TriangulatorBenchmark::onDelayedSetup();
+        if (fPersistent) {
+            this->doLoop();
+        }
+    }
+
+    void doLoop() override {
+        GrContextOptions options;
+        options.fGpuPathRenderers = GpuPathRenderers::kTriangulating;
+        options.fPersistentGeometryCache = fPersistent ? &fCache : nullptr;
+        sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr, options);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+                dContext.get(), skgpu::Budgeted::kNo, SkImageInfo::MakeN32Premul(1024, 1024));
+        if (!surface) {
+            return;
+        }
+        SkPaint paint;
+        paint.setAntiAlias(false);
+        for (const SkPath& path : fPaths) {
+            surface->getCanvas()->drawPath(path, paint);
+        }
+        dContext->flushAndSubmit();
+    }
+
+    bool fPersistent;
+    sk_gpu_test::MemoryCache fCache;
+};
+
+DEF_BENCH( return new ColdStartBench(false); );
+DEF_BENCH( return new ColdStartBench(true); );
+
 class TriangulateInnerFanBench : public TriangulatorBenchmark {
 public:
     TriangulateInnerFanBench() : TriangulatorBenchmark("TriangulateInnerFan") {}
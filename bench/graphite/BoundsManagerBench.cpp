@@ -175,7 +175,19 @@ DEF_BOUNDS_MANAGER_BENCH_SET(skgpu::graphite::GridBoundsManager::Make({1800, 180
 DEF_BOUNDS_MANAGER_BENCH_SET(skgpu::graphite::GridBoundsManager::Make({1800, 1800}, 512), "grid512")
 DEF_BOUNDS_MANAGER_BENCH_SET(std::make_unique<skgpu::graphite::HybridBoundsManager>(SkISize{1800, 1800}, 16, 64), "hybrid16x16n128")
 DEF_BOUNDS_MANAGER_BENCH_SET(std::make_unique<skgpu::graphite::HybridBoundsManager>(SkISize{1800, 1800}, 16, 128), "hybrid16x16n256")
+DEF_BOUNDS_MANAGER_BENCH_SET(skgpu::graphite::HierarchicalGridBoundsManager::Make({1800, 1800}, 16), "hiergrid16")
 // Uncomment and adjust device size to match reported bounds from --boundsManagerFile
 // DEF_BOUNDS_MANAGER_BENCH_SET(skgpu::graphite::GridBoundsManager::MakeRes({w, h}, 8), "gridRes8")
 
 #undef DEF_BOUNDS_MANAGER_BENCH_SET
+
+// Text-heavy frames can record far more draws than the brute force manager can keep up with, so
+// only the sub-linear managers are run at this size.
+#define DEF_LARGE_BOUNDS_MANAGER_BENCH(manager, name) \
+    DEF_BENCH( return new skgpu::graphite::RandomBoundsManagerBench(manager, name, 100000); )
+
+DEF_LARGE_BOUNDS_MANAGER_BENCH(skgpu::graphite::GridBoundsManager::Make({1800, 1800}, 128), "grid128")
+DEF_LARGE_BOUNDS_MANAGER_BENCH(std::make_unique<skgpu::graphite::HybridBoundsManager>(SkISize{1800, 1800}, 16, 128), "hybrid16x16n256")
+DEF_LARGE_BOUNDS_MANAGER_BENCH(skgpu::graphite::HierarchicalGridBoundsManager::Make({1800, 1800}, 16), "hiergrid16")
+
+#undef DEF_LARGE_BOUNDS_MANAGER_BENCH
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "bench/Benchmark.h"
+#include "src/base/SkRandom.h"
+#include "src/base/SkTSort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace skgpu::graphite {
+
+// Sorts keys laid out like DrawPass::SortKey: a 64-bit key holding the painter's order, stencil
+// index, render step and pipeline index, a 64-bit key of uniform and texture binding indices, and a
+// pointer back to the draw.
+class DrawPassSortBench : public Benchmark {
+public:
+    // Every 'drawsPerOrder' draws share a CompressedPaintersOrder, like runs of glyphs that do not
+    // overlap each other.
+    DrawPassSortBench(bool radix, int drawCount, int drawsPerOrder)
+            : fRadix(radix)
+            , fDrawCount(drawCount)
+            , fDrawsPerOrder(drawsPerOrder) {
+        fName.printf("DrawPassSort_%s_%d_%d", radix ? "radix" : "std", drawCount, drawsPerOrder);
+    }
+
+protected:
+    struct Key {
+        uint64_t fPipelineKey;
+        uint64_t fUniformKey;
+        const void* fDraw;
+
+        bool operator<(const Key& k) const {
+            return fPipelineKey < k.fPipelineKey ||
+                   (fPipelineKey == k.fPipelineKey && fUniformKey < k.fUniformKey);
+        }
+    };
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        fKeys.clear();
+        for (int i = 0; i < fDrawCount; ++i) {
+            uint64_t order = (i / fDrawsPerOrder + 1) & 0xFFFF;
+            // Depth-only draws and clips reuse an order lower than the latest one.
+            if (rand.nextULessThan(8) == 0) {
+                order = rand.nextRangeU(1, order);
+            }
+            uint64_t renderStep = rand.nextULessThan(2);
+            uint64_t pipeline = rand.nextULessThan(16);
+            uint64_t geometry = rand.nextULessThan(fDrawCount);
+            uint64_t shading = rand.nextULessThan(64);
+            uint64_t textures = rand.nextULessThan(8);
+            fKeys.push_back({order << 48 | renderStep << 30 | pipeline,
+                             geometry << 42 | shading << 21 | textures,
+                             nullptr});
+        }
+        fSorted.resize(fDrawCount);
+        fScratch.resize(fDrawCount);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            std::copy(fKeys.begin(), fKeys.end(), fSorted.begin());
+            if (fRadix) {
+                SkTRadixSort(fSorted.data(), fScratch.data(), fDrawCount,
+                             [](const Key& k) { return (uint32_t) (k.fPipelineKey >> 48); },
+                             [](const Key& a, const Key& b) { return a < b; });
+            } else {
+                std::sort(fSorted.begin(), fSorted.end());
+            }
+        }
+    }
+
+private:
+    bool fRadix;
+    int fDrawCount;
+    int fDrawsPerOrder;
+    SkString fName;
+
+    std::vector<Key> fKeys;
+    std::vector<Key> fSorted;
+    std::vector<Key> fScratch;
+};
+
+}  // namespace skgpu::graphite
+
+#define DEF_DRAW_PASS_SORT_BENCH(drawCount, drawsPerOrder) \
+    DEF_BENCH( return new skgpu::graphite::DrawPassSortBench(false, drawCount, drawsPerOrder); ) \
+    DEF_BENCH( return new skgpu::graphite::DrawPassSortBench(true, drawCount, drawsPerOrder); )
+
+DEF_DRAW_PASS_SORT_BENCH(100, 1)
+DEF_DRAW_PASS_SORT_BENCH(10000, 1)
+DEF_DRAW_PASS_SORT_BENCH(10000, 32)
+DEF_DRAW_PASS_SORT_BENCH(100000, 8)
+DEF_DRAW_PASS_SORT_BENCH(100000, 64)
+
+#undef DEF_DRAW_PASS_SORT_BENCH
@@ -1435,6 +1435,7 @@ int main(int argc, char** argv) {
     // loaded, so we won't be able to capture a delta for them.
     log.beginObject("results");
     RunSkSLModuleBenchmarks(&log);
+    RunSkSLRasterPipelineStageCounts(&log);
 
     int runs = 0;
     BenchmarkStream benchStream;
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "fuzz/Fuzz.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/pathops/SkPathOps.h"
+#include "src/pathops/SkPathOpsLinear.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+const uint8_t MAX_CONTOURS = 4;
+const uint8_t MAX_POINTS = 12;
+const uint8_t GRID = 16;
+
+// Polygons on a small integer grid, so that edges often cross, touch and overlap.
+static void fuzz_linear_path(Fuzz* fuzz, SkPath* path, std::vector<SkPoint>* edges) {
+    uint8_t contours;
+    fuzz->nextRange(&contours, 1, MAX_CONTOURS);
+    for (uint8_t c = 0; c < contours && !fuzz->exhausted(); ++c) {
+        uint8_t count;
+        fuzz->nextRange(&count, 2, MAX_POINTS);
+        SkPoint first = {0, 0}, last = {0, 0};
+        for (uint8_t i = 0; i < count; ++i) {
+            // nextRange() clamps, which would pile most points onto the far corner.
+            uint8_t x, y;
+            fuzz->next(&x, &y);
+            SkPoint pt = SkPoint::Make(x % (GRID + 1), y % (GRID + 1));
+            if (i == 0) {
+                path->moveTo(pt);
+                first = pt;
+            } else {
+                path->lineTo(pt);
+                edges->push_back(last);
+                edges->push_back(pt);
+            }
+            last = pt;
+        }
+        edges->push_back(last);
+        edges->push_back(first);
+        bool close;
+        fuzz->next(&close);
+        if (close) {
+            path->close();
+        }
+    }
+    SkPathFillType ft;
+    fuzz->nextRange(&ft, 0, (int)SkPathFillType::kInverseEvenOdd);
+    path->setFillType(ft);
+}
+
+// Returns true if pt is within 'tolerance' of one of the segments in 'edges'.
+static bool near_edge(SkPoint pt, const std::vector<SkPoint>& edges, SkScalar tolerance) {
+    for (size_t i = 0; i < edges.size(); i += 2) {
+        SkVector d = edges[i + 1] - edges[i];
+        SkScalar len = d.dot(d);
+        SkScalar t = len > 0 ? std::clamp((pt - edges[i]).dot(d) / len, 0.f, 1.f) : 0;
+        if (SkPoint::Distance(pt, edges[i] + d * t) <= tolerance) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The edges of a path made only of lines, as pairs of points.
+static std::vector<SkPoint> path_edges(const SkPath& path) {
+    std::vector<SkPoint> edges;
+    SkPath::Iter iter(path, /*forceClose=*/true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        if (verb == SkPath::kLine_Verb) {
+            edges.push_back(pts[0]);
+            edges.push_back(pts[1]);
+        }
+    }
+    return edges;
+}
+
+DEF_FUZZ(LinearPathop, fuzz) {
+    SkPath one, two;
+    std::vector<SkPoint> edges;
+    fuzz_linear_path(fuzz, &one, &edges);
+    bool simplify;
+    fuzz->next(&simplify);
+    if (!simplify) {
+        fuzz_linear_path(fuzz, &two, &edges);
+    }
+    SkPathOp op;
+    fuzz->nextRange(&op, 0, SkPathOp::kReverseDifference_SkPathOp);
+
+    SkPath result;
+    SkASSERT_RELEASE(simplify ? LinearSimplify(one, &result) : LinearOp(one, two, op, &result));
+
+    SkPath reference;
+    if (!(simplify ? Simplify(one, &reference) : Op(one, two, op, &reference))) {
+        return;
+    }
+
+    // The inputs are snapped to a grid 2^19 units across their combined bounds, and each output
+    // point is the center of a grid unit that the general result's boundary passes through.
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    int exponent;
+    std::frexp(std::max({bounds.width(), bounds.height(), 1.f}), &exponent);
+    const SkScalar tolerance = 2 * std::ldexp(1.0f, exponent - 19);
+    if (!result.isEmpty()) {
+        SkASSERT_RELEASE(reference.getBounds().makeOutset(tolerance, tolerance)
+                                 .contains(result.getBounds()));
+    }
+    std::vector<SkPoint> referenceEdges = path_edges(reference);
+    for (int i = 0; i < result.countPoints(); ++i) {
+        SkASSERT_RELEASE(near_edge(result.getPoint(i), referenceEdges, tolerance));
+    }
+
+    // Both results lie on the input edges (up to rounding), so away from those they must agree.
+    // Features thinner than a grid unit may disappear, so only the area is compared.
+    for (int y = -1; y <= 2 * GRID + 1; ++y) {
+        for (int x = -1; x <= 2 * GRID + 1; ++x) {
+            SkPoint pt = SkPoint::Make(x * 0.5f + 0.125f, y * 0.5f + 0.375f);
+            if (!near_edge(pt, edges, 1.f / 64)) {
+                SkASSERT_RELEASE(result.contains(pt.fX, pt.fY) ==
+                                 reference.contains(pt.fX, pt.fY));
+            }
+        }
+    }
+}
@@ -285,6 +285,7 @@ static std::map<std::string, std::string> cf_api_map = {
     {"api_ddl_threading", "DDLThreadingGL"},
     {"api_gradients", "Gradients"},
     {"api_image_filter", "ImageFilter"},
+    {"api_linear_pathop", "LinearPathop"},
     {"api_mock_gpu_canvas", "MockGPUCanvas"},
     {"api_null_canvas", "NullCanvas"},
     {"api_path_measure", "PathMeasure"},
@@ -95,9 +95,13 @@ for input in inputs:
         worklist.write(input + "\n")
         worklist.write(target + ".wgsl\n")
         worklist.write(settings + "\n\n")
+    elif lang == "--native":
+        worklist.write(input + "\n")
+        worklist.write(target + ".cpp\n")
+        worklist.write(settings + "\n\n")
     else:
         sys.exit("### Expected one of: --glsl --metal --hlsl --spirv --skrp " +
-                 "--skvm --stage --wgsl, got " + lang)
+                 "--skvm --stage --wgsl --native, got " + lang)
 
     # Compile items one at a time.
     if not batchCompile:
@@ -13,6 +13,7 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
 class SkImageGenerator;
 class SkOpenTypeSVGDecoder;
 class SkTraceMemoryDump;
@@ -66,6 +67,28 @@ public:
      */
     static int SetFontCacheCountLimit(int count);
 
+    /**
+     *  Set the executor used by the font cache to rasterize the missing glyph images of a run in
+     *  parallel, and return the previous one. The executor is not owned, and must stay alive
+     *  until it is replaced. The default, nullptr, rasterizes on the calling thread.
+     */
+    static SkExecutor* SetFontCacheRasterExecutor(SkExecutor* executor);
+
+    /**
+     *  Write the most recently used glyphs in the font cache (their metrics, images and paths) to
+     *  a file, up to about maxBytes, so that a later process can start with them by calling
+     *  LoadFontCacheFromFile(). Return false if the file could not be written.
+     */
+    static bool SaveFontCacheToFile(const char path[], size_t maxBytes);
+
+    /**
+     *  Pre-populate the font cache from a file written by SaveFontCacheToFile(). The file is memory
+     *  mapped while it is read. Glyphs for fonts which are no longer installed, or have changed,
+     *  are skipped. Return the number of cache entries loaded, or -1 if the file could not be
+     *  read or was written by a different version of Skia.
+     */
+    static int LoadFontCacheFromFile(const char path[]);
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
@@ -103,6 +126,26 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  These functions get/set the approximate memory limit for the cache of compiled runtime
+     *  effects (SkRuntimeEffect::MakeForShader and friends), which is keyed by the effect's source
+     *  and options. Setting the limit to zero disables the cache.
+     */
+    static size_t GetRuntimeEffectCacheByteLimit();
+    static size_t SetRuntimeEffectCacheByteLimit(size_t newLimit);
+
+    /**
+     *  Return the approximate memory used by the cache of compiled runtime effects.
+     */
+    static size_t GetRuntimeEffectCacheBytesUsed();
+
+    /**
+     *  Starts loading the built-in SkSL modules used by runtime effects and GPU shaders on the
+     *  given executor (or the default SkExecutor, if null). Calling this early during startup
+     *  moves module loading off the first SkRuntimeEffect or shader compile.
+     */
+    static void WarmUpSkSLModules(SkExecutor* executor);
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
@@ -100,8 +100,8 @@ struct SK_API GrContextOptions {
     /**
      * Executor to handle threaded work within Ganesh. If this is nullptr, then all work will be
      * done serially on the main thread. To have worker threads assist with various tasks, set this
-     * to a valid SkExecutor instance. Currently, used for software path rendering, but may be used
-     * for other tasks.
+     * to a valid SkExecutor instance. Currently, used for software path rendering and for
+     * triangulating the disjoint components of large paths, but may be used for other tasks.
      */
     SkExecutor* fExecutor = nullptr;
 
@@ -164,6 +164,13 @@ struct SK_API GrContextOptions {
      */
     Enable fAllowMultipleGlyphCacheTextures = Enable::kDefault;
 
+    /**
+     * If true, the glyph atlas places glyphs in each plot by tracking all of the plot's free
+     * rectangles, rather than with a skyline. This packs mixed glyph sizes more tightly, so plots
+     * are evicted and uploaded again less often, but placing each glyph is slower.
+     */
+    bool fUseMaxRectsGlyphAtlas = false;
+
     /**
      * Bugs on certain drivers cause stencil buffers to leak. This flag causes Skia to avoid
      * allocating stencil buffers and use alternate rasterization paths, avoiding the leak.
@@ -207,6 +214,13 @@ struct SK_API GrContextOptions {
      */
     PersistentCache* fPersistentCache = nullptr;
 
+    /**
+     * Cache in which to store triangulated path geometry between runs, so that static paths need
+     * not be triangulated again after a restart or a context loss. Recording contexts (DDLs) share
+     * it, so it must be thread safe if they are used.
+     */
+    PersistentCache* fPersistentGeometryCache = nullptr;
+
     /**
      * This affects the usage of the PersistentCache. We can cache SkSL, backend source (GLSL), or
      * backend binaries (GL program binaries). By default we cache binaries, but if the driver's
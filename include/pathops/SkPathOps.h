@@ -12,6 +12,7 @@
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 
+class SkExecutor;
 struct SkRect;
 
 
@@ -101,12 +102,26 @@ public:
       */
     bool resolve(SkPath* result);
 
+    /** Like resolve(), but does its work on an SkExecutor. The intersections between paths are
+        found concurrently, and when every operand is a union, the paths are combined
+        concurrently too: disjoint paths are simplified at once, and overlapping paths are
+        unioned pairwise in a balanced tree rather than one at a time. The result covers the same
+        area as resolve()'s, and is the same however the work is scheduled.
+
+        @param result The product of the operands.
+        @param executor Where to run the work. If null, the default SkExecutor is used.
+        @return True if the operation succeeded.
+      */
+    bool resolveParallel(SkPath* result, SkExecutor* executor = nullptr);
+
 private:
     SkTArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
 
     static bool FixWinding(SkPath* path);
     static void ReversePath(SkPath* path);
+    bool resolve(SkPath* result, SkExecutor* executor);
+    bool unionTree(SkPath* result, SkExecutor* executor);
     void reset();
 };
 
@@ -77,6 +77,12 @@ public:
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
 
+    // Experimental API that replaces the UTF-8 text range [from:to) with the given text.
+    // The inserted text takes the style of the text right before it.
+    // The next layout reshapes only the runs touched by the edit when it can
+    // (and falls back to shaping the entire text when it cannot).
+    virtual void updateText(size_t from, size_t to, const SkString& text) = 0;
+
     enum VisitorFlags {
         kWhiteSpace_VisitorFlag = 1 << 0,
     };
@@ -22,6 +22,7 @@
 #include "src/base/SkUTF.h"
 #include <math.h>
 #include <algorithm>
+#include <new>
 #include <utility>
 
 
@@ -83,6 +84,7 @@ ParagraphImpl::ParagraphImpl(const SkString& text,
         , fHasLineBreaks(false)
         , fHasWhitespacesInside(false)
         , fTrailingSpaces(0)
+        , fTextShapedByLastLayout(EMPTY_RANGE)
 {
     SkASSERT(fUnicode);
 }
@@ -118,6 +120,7 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
 
     // TODO: This rounding is done to match Flutter tests. Must be removed...
     auto floorWidth = SkScalarFloorToScalar(rawWidth);
+    fTextShapedByLastLayout = EMPTY_RANGE;
 
     if ((!SkScalarIsFinite(rawWidth) || fLongestLine <= floorWidth) &&
         fState >= kLineBroken &&
@@ -125,63 +128,78 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         // Most common case: one line of text (and one line is never justified, so no cluster shifts)
         // We cannot mark it as kLineBroken because the new width can be bigger than the old width
         fWidth = floorWidth;
-        fState = kShaped;
+        fState = kMetricsResolved;
     } else if (fState >= kLineBroken && fOldWidth != floorWidth) {
-        // We can use the results from SkShaper but have to do EVERYTHING ELSE again
-        fState = kShaped;
+        // We can use the results from SkShaper (and the resolved metrics that do not depend
+        // on the width) but have to break the text into lines again
+        fState = kMetricsResolved;
     } else {
         // Nothing changed case: we can reuse the data from the last layout
     }
 
     if (fState < kShaped) {
+        // The runs shaped before the text edits (if any) are only good for this layout
+        auto edit = fPendingEdit;
+        fPendingEdit.reset();
         // Check if we have the text in the cache and don't need to shape it again
         if (!fFontCollection->getParagraphCache()->findParagraph(this)) {
             if (fState < kIndexed) {
-                // This only happens once at the first layout; the text is immutable
-                // and there is no reason to repeat it
+                // This only happens at the first layout (or after the text was updated);
+                // the text is immutable otherwise and there is no reason to repeat it
                 if (this->computeCodeUnitProperties()) {
                     fState = kIndexed;
                 }
             }
-            this->fRuns.clear();
-            this->fClusters.clear();
-            this->fClustersIndexFromCodeUnit.clear();
-            this->fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
-            if (!this->shapeTextIntoEndlessLine()) {
-                this->resetContext();
-                // TODO: merge the two next calls - they always come together
-                this->resolveStrut();
-                this->computeEmptyMetrics();
-                this->fLines.clear();
-
-                // Set the important values that are not zero
-                fWidth = floorWidth;
-                fHeight = fEmptyMetrics.height();
-                if (fParagraphStyle.getStrutStyle().getStrutEnabled() &&
-                    fParagraphStyle.getStrutStyle().getForceStrutHeight()) {
-                    fHeight = fStrutMetrics.height();
-                }
-                fAlphabeticBaseline = fEmptyMetrics.alphabeticBaseline();
-                fIdeographicBaseline = fEmptyMetrics.ideographicBaseline();
-                fLongestLine = FLT_MIN - FLT_MAX;  // That is what flutter has
-                fMinIntrinsicWidth = 0;
-                fMaxIntrinsicWidth = 0;
-                this->fOldWidth = floorWidth;
-                this->fOldHeight = this->fHeight;
-
-                return;
-            } else {
-                // Add the paragraph to the cache
+            if (edit.has_value() && this->shapeEditedTextIntoEndlessLine(*edit)) {
+                // Only the runs touched by the edits were shaped again
                 fFontCollection->getParagraphCache()->updateParagraph(this);
+            } else {
+                fTextShapedByLastLayout = TextRange(0, fText.size());
+                this->fRuns.clear();
+                this->fClusters.clear();
+                this->fClustersIndexFromCodeUnit.clear();
+                this->fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
+                if (!this->shapeTextIntoEndlessLine()) {
+                    this->resetContext();
+                    // TODO: merge the two next calls - they always come together
+                    this->resolveStrut();
+                    this->computeEmptyMetrics();
+                    this->fLines.clear();
+
+                    // Set the important values that are not zero
+                    fWidth = floorWidth;
+                    fHeight = fEmptyMetrics.height();
+                    if (fParagraphStyle.getStrutStyle().getStrutEnabled() &&
+                        fParagraphStyle.getStrutStyle().getForceStrutHeight()) {
+                        fHeight = fStrutMetrics.height();
+                    }
+                    fAlphabeticBaseline = fEmptyMetrics.alphabeticBaseline();
+                    fIdeographicBaseline = fEmptyMetrics.ideographicBaseline();
+                    fLongestLine = FLT_MIN - FLT_MAX;  // That is what flutter has
+                    fMinIntrinsicWidth = 0;
+                    fMaxIntrinsicWidth = 0;
+                    this->fOldWidth = floorWidth;
+                    this->fOldHeight = this->fHeight;
+
+                    return;
+                } else {
+                    // Add the paragraph to the cache
+                    fFontCollection->getParagraphCache()->updateParagraph(this);
+                }
             }
         }
         fState = kShaped;
     }
 
     if (fState == kShaped) {
-        this->resetContext();
+        // TODO: merge the two next calls - they always come together
         this->resolveStrut();
         this->computeEmptyMetrics();
+        fState = kMetricsResolved;
+    }
+
+    if (fState == kMetricsResolved) {
+        this->resetContext();
         this->fLines.clear();
         this->breakShapedTextIntoLines(floorWidth);
         fState = kLineBroken;
@@ -531,6 +549,148 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
     return result;
 }
 
+bool ParagraphImpl::shapeEditedTextIntoEndlessLine(const TextEdit& edit) {
+
+    // We only handle the simplest (and the most common for text editing) case here:
+    // left-to-right text without placeholders and spacing, shaped into runs covering all the text.
+    // Everything else is shaped from scratch
+    if (fText.size() == 0 || fRuns.empty()) {
+        return false;
+    }
+    for (auto& placeholder : fPlaceholders) {
+        if (placeholder.fRange.width() > 0) {
+            return false;
+        }
+    }
+    for (auto& block : fTextStyles) {
+        if (!SkScalarNearlyZero(block.fStyle.getLetterSpacing()) ||
+            !SkScalarNearlyZero(block.fStyle.getWordSpacing())) {
+            return false;
+        }
+    }
+    for (auto& bidiRegion : fBidiRegions) {
+        if (bidiRegion.level % 2 != 0) {
+            return false;
+        }
+    }
+
+    // Find the runs touched by the edit (in the text we shaped them for);
+    // the runs next to the edit are shaped again, too, so we do not lose the shaping context
+    RunIndex firstRun = EMPTY_RUN;
+    RunIndex lastRun = EMPTY_RUN;
+    TextIndex runStart = 0;
+    for (RunIndex index = 0; index < SkToSizeT(fRuns.size()); ++index) {
+        auto& run = fRuns[index];
+        if (run.isPlaceholder() || !run.leftToRight() || run.fTextRange.start != runStart) {
+            return false;
+        }
+        runStart = run.fTextRange.end;
+        if (run.fTextRange.end >= edit.fEditStart && run.fTextRange.start <= edit.fEditOldEnd) {
+            if (firstRun == EMPTY_RUN) {
+                firstRun = index;
+            }
+            lastRun = index;
+        }
+    }
+    if (firstRun == EMPTY_RUN || runStart + edit.fEditNewEnd - edit.fEditOldEnd != fText.size()) {
+        return false;
+    }
+
+    // The text after the edit moves by textShift (which can wrap around as a negative value)
+    const size_t textShift = edit.fEditNewEnd - edit.fEditOldEnd;
+    const TextRange oldText(fRuns[firstRun].fTextRange.start, fRuns[lastRun].fTextRange.end);
+    const TextRange newText(oldText.start, oldText.end + textShift);
+
+    // Shape the new text as if it was a paragraph on its own
+    SkTArray<Block, true> blocks;
+    for (auto& block : fTextStyles) {
+        auto intersection = block.fRange * newText;
+        if (intersection.width() > 0) {
+            blocks.emplace_back(intersection.start - newText.start,
+                                intersection.end - newText.start,
+                                block.fStyle);
+        }
+    }
+    if (blocks.empty()) {
+        return false;
+    }
+    SkTArray<Placeholder, true> placeholders;
+    placeholders.emplace_back(newText.width(), newText.width(),
+                              PlaceholderStyle(), blocks.back().fStyle,
+                              BlockRange(0, blocks.size()), TextRange(0, newText.width()));
+    ParagraphImpl piece(SkString(fText.c_str() + newText.start, newText.width()),
+                        fParagraphStyle,
+                        std::move(blocks),
+                        std::move(placeholders),
+                        fFontCollection,
+                        fUnicode);
+    if (!piece.computeCodeUnitProperties()) {
+        return false;
+    }
+    OneLineShaper oneLineShaper(&piece);
+    if (!oneLineShaper.shape() || piece.fRuns.empty()) {
+        return false;
+    }
+    for (auto& run : piece.fRuns) {
+        if (!run.leftToRight()) {
+            return false;
+        }
+    }
+
+    // Replace the old runs with the new ones, moving all the runs after them
+    const SkScalar startX = fRuns[firstRun].fOffset.fX;
+    const SkScalar oldAdvance = fRuns[lastRun].fOffset.fX + fRuns[lastRun].fAdvance.fX - startX;
+    const SkScalar newAdvance = piece.fRuns.back().fOffset.fX + piece.fRuns.back().fAdvance.fX;
+    size_t unresolvedGlyphs = 0;
+    SkTArray<Run, false> runs;
+    runs.reserve_back(firstRun + piece.fRuns.size() + fRuns.size() - lastRun - 1);
+    for (RunIndex index = 0; index < SkToSizeT(fRuns.size()); ++index) {
+        auto& run = fRuns[index];
+        if (index < firstRun) {
+            runs.emplace_back(run);
+        } else if (index > lastRun) {
+            runs.emplace_back(run, this, runs.size(), textShift, newAdvance - oldAdvance);
+        } else {
+            // Unresolved glyphs end up as glyph 0
+            for (auto glyph : run.glyphs()) {
+                unresolvedGlyphs += glyph == 0 ? 1 : 0;
+            }
+            if (index == lastRun) {
+                for (auto& newRun : piece.fRuns) {
+                    runs.emplace_back(newRun, this, runs.size(), newText.start, startX);
+                }
+            }
+        }
+    }
+    fRuns = std::move(runs);
+    fUnresolvedGlyphs -= std::min(fUnresolvedGlyphs, unresolvedGlyphs);
+    fUnresolvedGlyphs += oneLineShaper.unresolvedGlyphs();
+
+    SkTArray<ResolvedFontDescriptor> fontSwitches;
+    for (auto& fontSwitch : fFontSwitches) {
+        if (fontSwitch.fTextStart < oldText.start) {
+            fontSwitches.emplace_back(fontSwitch);
+        }
+    }
+    for (auto& fontSwitch : piece.fFontSwitches) {
+        fontSwitches.emplace_back(fontSwitch.fTextStart + newText.start, fontSwitch.fFont);
+    }
+    for (auto& fontSwitch : fFontSwitches) {
+        if (fontSwitch.fTextStart >= oldText.end) {
+            fontSwitches.emplace_back(fontSwitch.fTextStart + textShift, fontSwitch.fFont);
+        }
+    }
+    fFontSwitches = std::move(fontSwitches);
+
+    this->fClusters.clear();
+    this->fClustersIndexFromCodeUnit.clear();
+    this->fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
+    this->applySpacingAndBuildClusterTable();
+
+    fTextShapedByLastLayout = newText;
+    return true;
+}
+
 void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
 
     if (!fHasLineBreaks &&
@@ -939,6 +1099,7 @@ void ParagraphImpl::setState(InternalState state) {
             [[fallthrough]];
 
         case kShaped:
+        case kMetricsResolved:
             fLines.clear();
             [[fallthrough]];
 
@@ -1032,6 +1193,73 @@ void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
   fState = std::min(fState, kIndexed);
   fOldWidth = 0;
   fOldHeight = 0;
+  fPendingEdit.reset();
+}
+
+void ParagraphImpl::updateText(size_t from, size_t to, const SkString& text) {
+    SkASSERT(from <= to && to <= fText.size());
+    for (auto& placeholder : fPlaceholders) {
+        if (placeholder.fRange.width() > 0 &&
+            from < placeholder.fRange.end && to > placeholder.fRange.start) {
+            SkDEBUGF("Cannot update the text of a placeholder\n");
+            return;
+        }
+    }
+
+    // The edited text goes to the style before it; the deleted text takes its styles with it
+    auto newIndex = [from, to, &text](TextIndex index) -> TextIndex {
+        if (index == 0 || index < from) {
+            return index;
+        } else if (index < to) {
+            return from + text.size();
+        }
+        return index - to + from + text.size();
+    };
+    for (auto& block : fTextStyles) {
+        block.fRange = TextRange(newIndex(block.fRange.start), newIndex(block.fRange.end));
+    }
+    for (auto& placeholder : fPlaceholders) {
+        placeholder.fRange = TextRange(newIndex(placeholder.fRange.start),
+                                       newIndex(placeholder.fRange.end));
+        placeholder.fTextBefore = TextRange(newIndex(placeholder.fTextBefore.start),
+                                            newIndex(placeholder.fTextBefore.end));
+    }
+
+    // Keep the runs we have so the next layout can reshape only the edited text
+    if (fPendingEdit.has_value()) {
+        auto& edit = *fPendingEdit;
+        edit.fEditOldEnd = to > edit.fEditNewEnd ? to - edit.fEditNewEnd + edit.fEditOldEnd
+                                                 : edit.fEditOldEnd;
+        edit.fEditNewEnd = std::max(newIndex(edit.fEditNewEnd), from + text.size());
+        edit.fEditStart = std::min(edit.fEditStart, from);
+    } else if (fState >= kShaped) {
+        fPendingEdit = TextEdit{from, to, from + text.size()};
+    } else {
+        fRuns.clear();
+    }
+
+    fText.remove(from, to - from);
+    fText.insert(from, text);
+
+    // All the text properties have to be calculated again
+    fState = kUnknown;
+    fLines.clear();
+    fPicture = nullptr;
+    fClusters.clear();
+    fClustersIndexFromCodeUnit.clear();
+    fCodeUnitProperties.clear();
+    fWords.clear();
+    fBidiRegions.clear();
+    fUTF8IndexForUTF16Index.clear();
+    fUTF16IndexForUTF8Index.clear();
+    // SkOnce can't be reset, so start over with a fresh one. Editing is not const, so no reader
+    // can be inside ensureUTF16Mapping() while this runs.
+    fillUTF16MappingOnce.~SkOnce();
+    new (&fillUTF16MappingOnce) SkOnce;
+    fHasLineBreaks = false;
+    fHasWhitespacesInside = false;
+    fOldWidth = 0;
+    fOldHeight = 0;
 }
 
 void ParagraphImpl::updateTextAlign(TextAlign textAlign) {
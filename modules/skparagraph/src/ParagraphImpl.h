@@ -29,6 +29,7 @@
 #include "src/core/SkTHash.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -73,6 +74,7 @@ enum InternalState {
   kUnknown = 0,
   kIndexed = 1,     // Text is indexed
   kShaped = 2,      // Text is shaped
+  kMetricsResolved = 3, // Strut and empty line metrics are resolved
   kLineBroken = 5,
   kFormatted = 6,
   kDrawn = 7
@@ -176,11 +178,15 @@ public:
     SkSpan<Block> blocks(BlockRange blockRange);
     Block& block(BlockIndex blockIndex);
     SkTArray<ResolvedFontDescriptor> resolvedFonts() const { return fFontSwitches; }
+    // The text shaped by the last layout: all of it, only the runs touched by the text edits,
+    // or nothing (EMPTY_RANGE) if the shaping results were reused
+    TextRange textShapedByLastLayout() const { return fTextShapedByLastLayout; }
 
     void markDirty() override {
         if (fState > kIndexed) {
             fState = kIndexed;
         }
+        fPendingEdit.reset();
     }
 
     int32_t unresolvedGlyphs() override;
@@ -203,6 +209,7 @@ public:
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
+    void updateText(size_t from, size_t to, const SkString& text) override;
 
     void visit(const Visitor&) override;
 
@@ -234,6 +241,15 @@ private:
 
     void computeEmptyMetrics();
 
+    // The text edits accumulated since the last shaping:
+    // the text [fEditStart:fEditOldEnd) of the shaped text became [fEditStart:fEditNewEnd)
+    struct TextEdit {
+        TextIndex fEditStart;
+        TextIndex fEditOldEnd;
+        TextIndex fEditNewEnd;
+    };
+    bool shapeEditedTextIntoEndlessLine(const TextEdit& edit);
+
     // Input
     SkTArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
     SkTArray<StyleBlock<SkScalar>> fWordSpaceStyles;
@@ -276,6 +292,8 @@ private:
     bool fHasLineBreaks;
     bool fHasWhitespacesInside;
     TextIndex fTrailingSpaces;
+    std::optional<TextEdit> fPendingEdit;
+    TextRange fTextShapedByLastLayout;
 };
 }  // namespace textlayout
 }  // namespace skia
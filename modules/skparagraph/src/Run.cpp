@@ -58,6 +58,39 @@ Run::Run(ParagraphImpl* owner,
     fPlaceholderIndex = std::numeric_limits<size_t>::max();
 }
 
+Run::Run(const Run& run, ParagraphImpl* owner, size_t index, size_t textShift, SkScalar offsetX)
+    : fOwner(owner)
+    , fTextRange(run.fTextRange.start + textShift, run.fTextRange.end + textShift)
+    , fClusterRange(EMPTY_CLUSTERS)
+    , fFont(run.fFont)
+    , fPlaceholderIndex(run.fPlaceholderIndex)
+    , fIndex(index)
+    , fAdvance(run.fAdvance)
+    , fOffset(SkVector::Make(run.fOffset.fX + offsetX, run.fOffset.fY))
+    , fClusterStart(run.fClusterStart + textShift)
+    , fUtf8Range(run.fUtf8Range)
+    , fGlyphData(std::make_shared<GlyphData>(*run.fGlyphData))
+    , fGlyphs(fGlyphData->glyphs)
+    , fPositions(fGlyphData->positions)
+    , fOffsets(fGlyphData->offsets)
+    , fClusterIndexes(fGlyphData->clusterIndexes)
+    , fFontMetrics(run.fFontMetrics)
+    , fHeightMultiplier(run.fHeightMultiplier)
+    , fUseHalfLeading(run.fUseHalfLeading)
+    , fBaselineShift(run.fBaselineShift)
+    , fCorrectAscent(run.fCorrectAscent)
+    , fCorrectDescent(run.fCorrectDescent)
+    , fCorrectLeading(run.fCorrectLeading)
+    , fEllipsis(run.fEllipsis)
+    , fBidiLevel(run.fBidiLevel)
+{
+    if (offsetX != 0) {
+        for (auto& position : fPositions) {
+            position.fX += offsetX;
+        }
+    }
+}
+
 void Run::calculateMetrics() {
     fCorrectAscent = fFontMetrics.fAscent - fFontMetrics.fLeading * 0.5;
     fCorrectDescent = fFontMetrics.fDescent + fFontMetrics.fLeading * 0.5;
@@ -63,6 +63,9 @@ public:
         size_t index,
         SkScalar shiftX);
     Run(const Run&) = default;
+    // Unlike the copy constructor, this one does not share the glyph data with the original run
+    // so the copy can be moved along the text and the endless line
+    Run(const Run& run, ParagraphImpl* owner, size_t index, size_t textShift, SkScalar offsetX);
     Run& operator=(const Run&) = delete;
     Run(Run&&) = default;
     Run& operator=(Run&&) = delete;
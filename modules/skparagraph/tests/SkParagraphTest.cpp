@@ -7251,6 +7251,70 @@ DEF_TEST(SkParagraph_lineMetricsAfterUpdate, reporter) {
     REPORTER_ASSERT(reporter, lm.size() == 2);
 }
 
+UNIX_ONLY_TEST(SkParagraph_UpdateText, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>(true);
+    if (!fontCollection->fontsFound()) return;
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+    ParagraphStyle paragraph_style;
+    paragraph_style.setTextStyle(text_style);
+
+    // The larger text in the middle is shaped into its own run
+    TextStyle large_style = text_style;
+    large_style.setFontSize(30);
+    auto build = [&](const char* head) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(head);
+        builder.pushStyle(large_style);
+        builder.addText(" jumps over");
+        builder.pop();
+        builder.addText(" the lazy dog");
+        return builder.Build();
+    };
+
+    auto paragraph = build("The quick brown fox");
+    auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+    paragraph->layout(200);
+    REPORTER_ASSERT(reporter, impl->textShapedByLastLayout() == TextRange(0, impl->text().size()));
+    paragraph->updateText(10, 15, SkString("red"));
+    paragraph->updateText(0, 0, SkString("Look: "));
+    paragraph->layout(200);
+    const char* expectedHead = "Look: The quick red fox";
+    auto expected = build(expectedHead);
+    expected->layout(200);
+
+    // Only the runs of the edited text were shaped again
+    auto shaped = impl->textShapedByLastLayout();
+    REPORTER_ASSERT(reporter, shaped.start == 0 && shaped.end >= strlen(expectedHead) &&
+                              shaped.end < impl->text().size(),
+                    "shaped [%zu:%zu) of %zu", shaped.start, shaped.end, impl->text().size());
+
+    auto expectedImpl = static_cast<ParagraphImpl*>(expected.get());
+    REPORTER_ASSERT(reporter, impl->text().size() == expectedImpl->text().size());
+    REPORTER_ASSERT(reporter, impl->lineNumber() == expectedImpl->lineNumber());
+    REPORTER_ASSERT(reporter, impl->clusters().size() == expectedImpl->clusters().size());
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(impl->getHeight(), expectedImpl->getHeight()));
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(impl->getMaxIntrinsicWidth(),
+                                                  expectedImpl->getMaxIntrinsicWidth(),
+                                                  EPSILON100));
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(impl->getLongestLine(),
+                                                  expectedImpl->getLongestLine(),
+                                                  EPSILON100));
+
+    // Changing the width only breaks the shaped text into lines again
+    paragraph->layout(100);
+    expected->layout(100);
+    REPORTER_ASSERT(reporter, impl->textShapedByLastLayout() == EMPTY_RANGE);
+    REPORTER_ASSERT(reporter, impl->state() == kFormatted);
+    REPORTER_ASSERT(reporter, impl->lineNumber() == expectedImpl->lineNumber());
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(impl->getHeight(), expectedImpl->getHeight()));
+}
+
 // Google logo is shown in one style (the first one)
 UNIX_ONLY_TEST(SkParagraph_MultiStyle_Logo, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>(true);
@@ -50,6 +50,27 @@ public:
     static std::unique_ptr<SkShaper> MakeShapeDontWrapOrReorder(std::unique_ptr<SkUnicode> unicode,
                                                                 sk_sp<SkFontMgr> = nullptr);
     static void PurgeHarfBuzzCache();
+
+    // Experimental: HarfBuzz shapers shape the runs that are safe to split at spaces
+    // (left-to-right Latin, Cyrillic, Greek or Common script text without local features)
+    // word by word and cache up to 'count' shaped words across all shapers that were not made
+    // with a cache of their own.
+    // The cache is off by default (count == 0).
+    struct WordCacheStats {
+        size_t fHits;
+        size_t fMisses;
+        size_t fCount;
+    };
+    static void SetHarfBuzzWordCacheLimit(int count);
+    static WordCacheStats GetHarfBuzzWordCacheStats();
+
+    // Experimental: a word cache of up to 'count' words that is used only by the shapers made
+    // with it, instead of the one shared by all shapers.
+    class HarfBuzzWordCache;
+    static std::shared_ptr<HarfBuzzWordCache> MakeHarfBuzzWordCache(int count);
+    static WordCacheStats GetHarfBuzzWordCacheStats(const HarfBuzzWordCache&);
+    static std::unique_ptr<SkShaper> MakeShaperDrivenWrapper(sk_sp<SkFontMgr>,
+                                                             std::shared_ptr<HarfBuzzWordCache>);
     #endif
     #ifdef SK_SHAPER_CORETEXT_AVAILABLE
     static std::unique_ptr<SkShaper> MakeCoreText();
@@ -20,6 +20,7 @@
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkBitmaskEnum.h"
+#include "include/private/SkChecksum.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTypeTraits.h"
 #include "include/private/base/SkMalloc.h"
@@ -664,13 +665,21 @@ struct ShapedRunGlyphIterator {
     size_t fGlyphIndex;
 };
 
+}  // namespace
+
+// The word cache of the shapers that are not made with their own.
+static SkShaper::HarfBuzzWordCache* global_word_cache();
+
+namespace {
+
 class ShaperHarfBuzz : public SkShaper {
 public:
     ShaperHarfBuzz(std::unique_ptr<SkUnicode>,
                    SkUnicodeBreak line,
                    SkUnicodeBreak grapheme,
                    HBBuffer,
-                   sk_sp<SkFontMgr>);
+                   sk_sp<SkFontMgr>,
+                   std::shared_ptr<HarfBuzzWordCache> = nullptr);
 
 protected:
     std::unique_ptr<SkUnicode> fUnicode;
@@ -689,6 +698,9 @@ private:
     const sk_sp<SkFontMgr> fFontMgr;
     HBBuffer               fBuffer;
     hb_language_t          fUndefinedLanguage;
+    // Keeps a word cache of this shaper's own alive; fWordCache points at it or the global one.
+    std::shared_ptr<HarfBuzzWordCache> fOwnWordCache;
+    HarfBuzzWordCache*     fWordCache;
 
     void shape(const char* utf8, size_t utf8Bytes,
                const SkFont&,
@@ -769,7 +781,9 @@ private:
               RunHandler*) const override;
 };
 
-static std::unique_ptr<SkShaper> MakeHarfBuzz(sk_sp<SkFontMgr> fontmgr, bool correct) {
+static std::unique_ptr<SkShaper> MakeHarfBuzz(
+        sk_sp<SkFontMgr> fontmgr, bool correct,
+        std::shared_ptr<SkShaper::HarfBuzzWordCache> wordCache = nullptr) {
     HBBuffer buffer(hb_buffer_create());
     if (!buffer) {
         SkDEBUGF("Could not create hb_buffer");
@@ -793,21 +807,26 @@ static std::unique_ptr<SkShaper> MakeHarfBuzz(sk_sp<SkFontMgr> fontmgr, bool cor
 
     if (correct) {
         return std::make_unique<ShaperDrivenWrapper>(std::move(unicode),
-            std::move(lineIter), std::move(graphIter), std::move(buffer), std::move(fontmgr));
+            std::move(lineIter), std::move(graphIter), std::move(buffer), std::move(fontmgr),
+            std::move(wordCache));
     } else {
         return std::make_unique<ShapeThenWrap>(std::move(unicode),
-            std::move(lineIter), std::move(graphIter), std::move(buffer), std::move(fontmgr));
+            std::move(lineIter), std::move(graphIter), std::move(buffer), std::move(fontmgr),
+            std::move(wordCache));
     }
 }
 
 ShaperHarfBuzz::ShaperHarfBuzz(std::unique_ptr<SkUnicode> unicode,
-    SkUnicodeBreak lineIter, SkUnicodeBreak graphIter, HBBuffer buffer, sk_sp<SkFontMgr> fontmgr)
+    SkUnicodeBreak lineIter, SkUnicodeBreak graphIter, HBBuffer buffer, sk_sp<SkFontMgr> fontmgr,
+    std::shared_ptr<HarfBuzzWordCache> wordCache)
     : fUnicode(std::move(unicode))
     , fLineBreakIterator(std::move(lineIter))
     , fGraphemeBreakIterator(std::move(graphIter))
     , fFontMgr(std::move(fontmgr))
     , fBuffer(std::move(buffer))
     , fUndefinedLanguage(hb_language_from_string("und", -1))
+    , fOwnWordCache(std::move(wordCache))
+    , fWordCache(fOwnWordCache ? fOwnWordCache.get() : global_word_cache())
 { }
 
 void ShaperHarfBuzz::shape(const char* utf8, size_t utf8Bytes,
@@ -1321,6 +1340,270 @@ static HBLockedFaceCache get_hbFace_cache() {
     return HBLockedFaceCache(gHBFaceCache, gHBFaceCacheMutex);
 }
 
+// Shaped words are reused across runs (and shapers) when the shaping cannot be affected by the
+// text around them. The glyph clusters are relative to the start of the word.
+struct HBWordKey {
+    SkString fWord;
+    SkTypefaceID fTypefaceID;
+    SkScalar fSize;
+    SkScalar fScaleX;
+    SkScalar fSkewX;
+    uint32_t fFontFlags;
+    hb_script_t fScript;
+    hb_direction_t fDirection;
+    hb_language_t fLanguage;
+    uint32_t fFeaturesHash;
+
+    bool operator==(const HBWordKey& that) const {
+        return fTypefaceID == that.fTypefaceID &&
+               fSize == that.fSize &&
+               fScaleX == that.fScaleX &&
+               fSkewX == that.fSkewX &&
+               fFontFlags == that.fFontFlags &&
+               fScript == that.fScript &&
+               fDirection == that.fDirection &&
+               fLanguage == that.fLanguage &&
+               fFeaturesHash == that.fFeaturesHash &&
+               fWord.equals(that.fWord);
+    }
+
+    struct Hash {
+        uint32_t operator()(const HBWordKey& key) const {
+            uint32_t hash = SkGoodHash()(key.fWord);
+            hash = SkChecksum::Mix(hash ^ key.fTypefaceID);
+            hash = SkChecksum::Mix(hash ^ SkFloat2Bits(key.fSize));
+            hash = SkChecksum::Mix(hash ^ SkFloat2Bits(key.fScaleX));
+            hash = SkChecksum::Mix(hash ^ SkFloat2Bits(key.fSkewX));
+            hash = SkChecksum::Mix(hash ^ key.fFontFlags);
+            hash = SkChecksum::Mix(hash ^ key.fScript ^ (key.fDirection << 24));
+            return SkChecksum::Mix(hash ^ key.fFeaturesHash);
+        }
+    };
+};
+
+struct HBWord {
+    std::unique_ptr<ShapedGlyph[]> fGlyphs;
+    size_t fNumGlyphs;
+};
+
+using HBWordLRUCache = SkLRUCache<HBWordKey, HBWord, HBWordKey::Hash>;
+
+}  // namespace
+
+// Shaped words, keyed by the font, script, direction, language and features they were shaped
+// with. Every HarfBuzz shaper uses the global cache, unless it was made with its own.
+class SkShaper::HarfBuzzWordCache {
+public:
+    explicit HarfBuzzWordCache(int count) { this->setLimit(count); }
+
+    bool enabled() const {
+        SkAutoMutexExclusive lock(fMutex);
+        return fCache != nullptr;
+    }
+    // Appends the glyphs of the cached word to 'glyphs' with 'append', and returns false if the
+    // word is not in the cache.
+    template <typename AppendFn>
+    bool find(const HBWordKey& key, AppendFn&& append) {
+        SkAutoMutexExclusive lock(fMutex);
+        HBWord* word = fCache ? fCache->find(key) : nullptr;
+        if (word) {
+            ++fHits;
+            append(*word);
+        } else {
+            ++fMisses;
+        }
+        return word != nullptr;
+    }
+    void insert(const HBWordKey& key, HBWord word) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fCache) {
+            fCache->insert(key, std::move(word));
+        }
+    }
+    void setLimit(int count) {
+        SkAutoMutexExclusive lock(fMutex);
+        fCache = count > 0 ? std::make_unique<HBWordLRUCache>(count) : nullptr;
+        fHits = 0;
+        fMisses = 0;
+    }
+    void reset() {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fCache) {
+            fCache->reset();
+        }
+    }
+    SkShaper::WordCacheStats stats() const {
+        SkAutoMutexExclusive lock(fMutex);
+        return {fHits, fMisses, fCache ? (size_t)fCache->count() : 0};
+    }
+
+private:
+    mutable SkMutex fMutex;
+    std::unique_ptr<HBWordLRUCache> fCache;
+    size_t fHits = 0;
+    size_t fMisses = 0;
+};
+
+static SkShaper::HarfBuzzWordCache* global_word_cache() {
+    static auto* gHBWordCache = new SkShaper::HarfBuzzWordCache(0);
+    return gHBWordCache;
+}
+
+namespace {
+
+// Only the scripts that cannot form ligatures or reorder glyphs across spaces are shaped word
+// by word; kerning with the spaces themselves is lost, which is what the callers opt in for.
+bool can_shape_by_words(hb_direction_t direction, hb_script_t script,
+                        SkSpan<const hb_feature_t> features) {
+    if (direction != HB_DIRECTION_LTR) {
+        return false;
+    }
+    if (script != HB_SCRIPT_LATIN && script != HB_SCRIPT_CYRILLIC &&
+        script != HB_SCRIPT_GREEK && script != HB_SCRIPT_COMMON) {
+        return false;
+    }
+    for (const auto& feature : features) {
+        if (feature.start != HB_FEATURE_GLOBAL_START || feature.end != HB_FEATURE_GLOBAL_END) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fills the glyphs from the shaped buffer and returns the advance of all of them.
+SkVector make_shaped_glyphs(hb_buffer_t* buffer, const SkFont& font, ShapedGlyph* glyphs) {
+    unsigned len = hb_buffer_get_length(buffer);
+    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
+    hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
+
+    // Undo skhb_position with (1.0/(1<<16)) and scale as needed.
+    AutoSTArray<32, SkGlyphID> glyphIDs(len);
+    for (unsigned i = 0; i < len; i++) {
+        glyphIDs[i] = info[i].codepoint;
+    }
+    AutoSTArray<32, SkRect> glyphBounds(len);
+    SkPaint p;
+    font.getBounds(glyphIDs.get(), len, glyphBounds.get(), &p);
+
+    double SkScalarFromHBPosX = +(1.52587890625e-5) * font.getScaleX();
+    double SkScalarFromHBPosY = -(1.52587890625e-5);  // HarfBuzz y-up, Skia y-down
+    SkVector runAdvance = { 0, 0 };
+    for (unsigned i = 0; i < len; i++) {
+        ShapedGlyph& glyph = glyphs[i];
+        glyph.fID = info[i].codepoint;
+        glyph.fCluster = info[i].cluster;
+        glyph.fOffset.fX = pos[i].x_offset * SkScalarFromHBPosX;
+        glyph.fOffset.fY = pos[i].y_offset * SkScalarFromHBPosY;
+        glyph.fAdvance.fX = pos[i].x_advance * SkScalarFromHBPosX;
+        glyph.fAdvance.fY = pos[i].y_advance * SkScalarFromHBPosY;
+
+        glyph.fHasVisual = !glyphBounds[i].isEmpty(); //!font->currentTypeface()->glyphBoundsAreZero(glyph.fID);
+#if SK_HB_VERSION_CHECK(1, 5, 0)
+        glyph.fUnsafeToBreak = info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK;
+#else
+        glyph.fUnsafeToBreak = false;
+#endif
+        glyph.fMustLineBreakBefore = false;
+
+        runAdvance += glyph.fAdvance;
+    }
+    return runAdvance;
+}
+
+// Shapes the run word by word (spaces are the break points), reusing the cached words.
+void shape_by_words(SkShaper::HarfBuzzWordCache* cache,
+                    hb_buffer_t* buffer, hb_font_t* hbFont,
+                    char const * const utf8,
+                    char const * const utf8Start,
+                    char const * const utf8End,
+                    hb_direction_t direction,
+                    hb_script_t script,
+                    hb_language_t language,
+                    SkSpan<const hb_feature_t> features,
+                    ShapedRun* run) {
+    uint32_t featuresHash = 0;
+    for (const auto& feature : features) {
+        featuresHash = SkChecksum::Mix(featuresHash ^ feature.tag) ^ feature.value;
+    }
+    const SkFont& font = run->fFont;
+    HBWordKey key = {
+        SkString(),
+        font.getTypeface()->uniqueID(),
+        font.getSize(),
+        font.getScaleX(),
+        font.getSkewX(),
+        (uint32_t)font.getEdging()                |
+        (uint32_t)font.getHinting()         << 2  |
+        (uint32_t)font.isSubpixel()         << 4  |
+        (uint32_t)font.isLinearMetrics()    << 5  |
+        (uint32_t)font.isEmbolden()         << 6  |
+        (uint32_t)font.isForceAutoHinting() << 7  |
+        (uint32_t)font.isEmbeddedBitmaps()  << 8  |
+        (uint32_t)font.isBaselineSnap()     << 9,
+        script,
+        direction,
+        language,
+        featuresHash,
+    };
+
+    SkSTArray<64, ShapedGlyph, true> glyphs;
+    SkVector runAdvance = { 0, 0 };
+    const char* wordStart = utf8Start;
+    while (wordStart < utf8End) {
+        // A word is either a sequence of spaces or a sequence of anything else
+        const bool isSpace = *wordStart == ' ';
+        const char* wordEnd = wordStart;
+        while (wordEnd < utf8End && (*wordEnd == ' ') == isSpace) {
+            ++wordEnd;
+        }
+        key.fWord.set(wordStart, wordEnd - wordStart);
+        const uint32_t wordCluster = wordStart - utf8;
+
+        auto appendWord = [&](const HBWord& word) {
+            for (size_t i = 0; i < word.fNumGlyphs; ++i) {
+                ShapedGlyph& glyph = glyphs.push_back(word.fGlyphs[i]);
+                glyph.fCluster += wordCluster;
+                runAdvance += glyph.fAdvance;
+            }
+        };
+
+        if (cache->find(key, appendWord)) {
+            wordStart = wordEnd;
+            continue;
+        }
+
+        hb_buffer_clear_contents(buffer);
+        hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
+        hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+        const char* utf8Current = wordStart;
+        while (utf8Current < wordEnd) {
+            unsigned int cluster = utf8Current - wordStart;
+            hb_codepoint_t u = utf8_next(&utf8Current, wordEnd);
+            hb_buffer_add(buffer, u, cluster);
+        }
+        hb_buffer_set_direction(buffer, direction);
+        hb_buffer_set_script(buffer, script);
+        hb_buffer_set_language(buffer, language);
+        hb_shape(hbFont, buffer, features.data(), features.size());
+
+        HBWord word;
+        word.fNumGlyphs = hb_buffer_get_length(buffer);
+        word.fGlyphs.reset(new ShapedGlyph[word.fNumGlyphs]);
+        make_shaped_glyphs(buffer, font, word.fGlyphs.get());
+        appendWord(word);
+        cache->insert(key, std::move(word));
+        wordStart = wordEnd;
+    }
+
+    if (glyphs.empty()) {
+        return;
+    }
+    run->fGlyphs.reset(new ShapedGlyph[glyphs.size()]);
+    memcpy(run->fGlyphs.get(), glyphs.data(), glyphs.size() * sizeof(ShapedGlyph));
+    run->fNumGlyphs = glyphs.size();
+    run->fAdvance = runAdvance;
+}
+
 ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   size_t const utf8Bytes,
                                   char const * const utf8Start,
@@ -1337,40 +1620,6 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
 
     hb_buffer_t* buffer = fBuffer.get();
     SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
-    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
-    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
-
-    // Documentation for HB_BUFFER_FLAG_BOT/EOT at 763e5466c0a03a7c27020e1e2598e488612529a7.
-    // Currently BOT forces a dotted circle when first codepoint is a mark; EOT has no effect.
-    // Avoid adding dotted circle, re-evaluate if BOT/EOT change. See https://skbug.com/9618.
-    // hb_buffer_set_flags(buffer, HB_BUFFER_FLAG_BOT | HB_BUFFER_FLAG_EOT);
-
-    // Add precontext.
-    hb_buffer_add_utf8(buffer, utf8, utf8Start - utf8, utf8Start - utf8, 0);
-
-    // Populate the hb_buffer directly with utf8 cluster indexes.
-    const char* utf8Current = utf8Start;
-    while (utf8Current < utf8End) {
-        unsigned int cluster = utf8Current - utf8;
-        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
-        hb_buffer_add(buffer, u, cluster);
-    }
-
-    // Add postcontext.
-    hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
-
-    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
-    hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
-    // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
-    // The user must provide a language, but may provide data hb_language_from_string cannot use.
-    // Use "und" for the undefined language in this case (RFC5646 4.1 5).
-    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
-    if (hbLanguage == HB_LANGUAGE_INVALID) {
-        hbLanguage = fUndefinedLanguage;
-    }
-    hb_buffer_set_language(buffer, hbLanguage);
-    hb_buffer_guess_segment_properties(buffer);
 
     // TODO: better cache HBFace (data) / hbfont (typeface)
     // An HBFace is expensive (it sanitizes the bits).
@@ -1410,6 +1659,49 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         }
     }
 
+    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
+    hb_script_t hbScript = hb_script_from_iso15924_tag((hb_tag_t)script.currentScript());
+    // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
+    // The user must provide a language, but may provide data hb_language_from_string cannot use.
+    // Use "und" for the undefined language in this case (RFC5646 4.1 5).
+    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
+    if (hbLanguage == HB_LANGUAGE_INVALID) {
+        hbLanguage = fUndefinedLanguage;
+    }
+
+    if (fWordCache->enabled() && can_shape_by_words(direction, hbScript, hbFeatures)) {
+        shape_by_words(fWordCache, buffer, hbFont.get(), utf8, utf8Start, utf8End,
+                       direction, hbScript, hbLanguage, hbFeatures, &run);
+        return run;
+    }
+
+    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
+    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+
+    // Documentation for HB_BUFFER_FLAG_BOT/EOT at 763e5466c0a03a7c27020e1e2598e488612529a7.
+    // Currently BOT forces a dotted circle when first codepoint is a mark; EOT has no effect.
+    // Avoid adding dotted circle, re-evaluate if BOT/EOT change. See https://skbug.com/9618.
+    // hb_buffer_set_flags(buffer, HB_BUFFER_FLAG_BOT | HB_BUFFER_FLAG_EOT);
+
+    // Add precontext.
+    hb_buffer_add_utf8(buffer, utf8, utf8Start - utf8, utf8Start - utf8, 0);
+
+    // Populate the hb_buffer directly with utf8 cluster indexes.
+    const char* utf8Current = utf8Start;
+    while (utf8Current < utf8End) {
+        unsigned int cluster = utf8Current - utf8;
+        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
+        hb_buffer_add(buffer, u, cluster);
+    }
+
+    // Add postcontext.
+    hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
+
+    hb_buffer_set_direction(buffer, direction);
+    hb_buffer_set_script(buffer, hbScript);
+    hb_buffer_set_language(buffer, hbLanguage);
+    hb_buffer_guess_segment_properties(buffer);
+
     hb_shape(hbFont.get(), buffer, hbFeatures.data(), hbFeatures.size());
     unsigned len = hb_buffer_get_length(buffer);
     if (len == 0) {
@@ -1421,45 +1713,11 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         // Note that the advances remain ltr.
         hb_buffer_reverse(buffer);
     }
-    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
-    hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
 
     run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
                     font.currentFont(), bidi.currentLevel(),
                     std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len);
-
-    // Undo skhb_position with (1.0/(1<<16)) and scale as needed.
-    AutoSTArray<32, SkGlyphID> glyphIDs(len);
-    for (unsigned i = 0; i < len; i++) {
-        glyphIDs[i] = info[i].codepoint;
-    }
-    AutoSTArray<32, SkRect> glyphBounds(len);
-    SkPaint p;
-    run.fFont.getBounds(glyphIDs.get(), len, glyphBounds.get(), &p);
-
-    double SkScalarFromHBPosX = +(1.52587890625e-5) * run.fFont.getScaleX();
-    double SkScalarFromHBPosY = -(1.52587890625e-5);  // HarfBuzz y-up, Skia y-down
-    SkVector runAdvance = { 0, 0 };
-    for (unsigned i = 0; i < len; i++) {
-        ShapedGlyph& glyph = run.fGlyphs[i];
-        glyph.fID = info[i].codepoint;
-        glyph.fCluster = info[i].cluster;
-        glyph.fOffset.fX = pos[i].x_offset * SkScalarFromHBPosX;
-        glyph.fOffset.fY = pos[i].y_offset * SkScalarFromHBPosY;
-        glyph.fAdvance.fX = pos[i].x_advance * SkScalarFromHBPosX;
-        glyph.fAdvance.fY = pos[i].y_advance * SkScalarFromHBPosY;
-
-        glyph.fHasVisual = !glyphBounds[i].isEmpty(); //!font->currentTypeface()->glyphBoundsAreZero(glyph.fID);
-#if SK_HB_VERSION_CHECK(1, 5, 0)
-        glyph.fUnsafeToBreak = info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK;
-#else
-        glyph.fUnsafeToBreak = false;
-#endif
-        glyph.fMustLineBreakBefore = false;
-
-        runAdvance += glyph.fAdvance;
-    }
-    run.fAdvance = runAdvance;
+    run.fAdvance = make_shaped_glyphs(buffer, run.fFont, run.fGlyphs.get());
 
     return run;
 }
@@ -1525,6 +1783,10 @@ std::unique_ptr<SkShaper::ScriptRunIterator> SkShaper::MakeSkUnicodeHbScriptRunI
 std::unique_ptr<SkShaper> SkShaper::MakeShaperDrivenWrapper(sk_sp<SkFontMgr> fontmgr) {
     return MakeHarfBuzz(std::move(fontmgr), true);
 }
+std::unique_ptr<SkShaper> SkShaper::MakeShaperDrivenWrapper(
+        sk_sp<SkFontMgr> fontmgr, std::shared_ptr<HarfBuzzWordCache> wordCache) {
+    return MakeHarfBuzz(std::move(fontmgr), true, std::move(wordCache));
+}
 std::unique_ptr<SkShaper> SkShaper::MakeShapeThenWrap(sk_sp<SkFontMgr> fontmgr) {
     return MakeHarfBuzz(std::move(fontmgr), false);
 }
@@ -1547,4 +1809,21 @@ std::unique_ptr<SkShaper> SkShaper::MakeShapeDontWrapOrReorder(std::unique_ptr<S
 void SkShaper::PurgeHarfBuzzCache() {
     HBLockedFaceCache cache = get_hbFace_cache();
     cache.reset();
+    global_word_cache()->reset();
+}
+
+void SkShaper::SetHarfBuzzWordCacheLimit(int count) {
+    global_word_cache()->setLimit(count);
+}
+
+SkShaper::WordCacheStats SkShaper::GetHarfBuzzWordCacheStats() {
+    return global_word_cache()->stats();
+}
+
+std::shared_ptr<SkShaper::HarfBuzzWordCache> SkShaper::MakeHarfBuzzWordCache(int count) {
+    return std::make_shared<HarfBuzzWordCache>(count);
+}
+
+SkShaper::WordCacheStats SkShaper::GetHarfBuzzWordCacheStats(const HarfBuzzWordCache& cache) {
+    return cache.stats();
 }
@@ -21,6 +21,7 @@
 #include <cinttypes>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace {
 struct RunHandler final : public SkShaper::RunHandler {
@@ -115,8 +116,8 @@ struct RunHandler final : public SkShaper::RunHandler {
     void commitLine() override { fCommitLine = true; }
 };
 
-void shaper_test(skiatest::Reporter* reporter, const char* name, SkData* data) {
-    auto shaper = SkShaper::Make();
+void shaper_test(skiatest::Reporter* reporter, const char* name, SkData* data,
+                 std::unique_ptr<SkShaper> shaper = SkShaper::Make()) {
     if (!shaper) {
         ERRORF(reporter, "Could not create shaper.");
         return;
@@ -142,14 +143,15 @@ void shaper_test(skiatest::Reporter* reporter, const char* name, SkData* data) {
                   fontIterator, bidiIterator, scriptIterator, languageIterator, kWidth, &rh);
 }
 
-void cluster_test(skiatest::Reporter* reporter, const char* resource) {
+void cluster_test(skiatest::Reporter* reporter, const char* resource,
+                  std::unique_ptr<SkShaper> shaper = SkShaper::Make()) {
     auto data = GetResourceAsData(resource);
     if (!data) {
         ERRORF(reporter, "Could not get resource %s.", resource);
         return;
     }
 
-    shaper_test(reporter, resource, data.get());
+    shaper_test(reporter, resource, data.get(), std::move(shaper));
 }
 
 }  // namespace
@@ -193,4 +195,80 @@ SHAPER_TEST(taitham)
 SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+DEF_TEST(Shaper_word_cache, r) {
+    // The other tests run concurrently, so use a cache of our own rather than the global one.
+    auto cache = SkShaper::MakeHarfBuzzWordCache(1024);
+    cluster_test(r, "text/english.txt", SkShaper::MakeShaperDrivenWrapper(nullptr, cache));
+    auto stats = SkShaper::GetHarfBuzzWordCacheStats(*cache);
+    REPORTER_ASSERT(r, stats.fCount > 0);
+    REPORTER_ASSERT(r, stats.fMisses > 0);
+
+    // The same words are found in the cache the second time
+    cluster_test(r, "text/english.txt", SkShaper::MakeShaperDrivenWrapper(nullptr, cache));
+    auto secondStats = SkShaper::GetHarfBuzzWordCacheStats(*cache);
+    REPORTER_ASSERT(r, secondStats.fHits > stats.fHits);
+    REPORTER_ASSERT(r, secondStats.fCount == stats.fCount);
+}
+
+namespace {
+// Records the glyphs, positions and advances of every run, to compare shapers' output.
+struct RecordingRunHandler final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+    std::vector<SkVector> fAdvances;
+    int fLines = 0;
+
+    void beginLine() override { ++fLines; }
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        size_t start = fGlyphs.size();
+        fGlyphs.resize(start + info.glyphCount);
+        fPositions.resize(start + info.glyphCount);
+        fClusters.resize(start + info.glyphCount);
+        return {fGlyphs.data() + start, fPositions.data() + start, nullptr,
+                fClusters.data() + start, {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo& info) override { fAdvances.push_back(info.fAdvance); }
+    void commitLine() override {}
+};
+
+RecordingRunHandler shape(SkShaper* shaper, SkData* data) {
+    RecordingRunHandler rh;
+    SkFont font(SkTypeface::MakeDefault());
+    shaper->shape((const char*)data->data(), data->size(), font, true, 400, &rh);
+    return rh;
+}
+}  // namespace
+
+// Words shaped once and found in the cache must give the same glyphs as shaping the whole run.
+DEF_TEST(Shaper_word_cache_output, r) {
+    for (const char* resource : {"text/english.txt", "text/cyrillic.txt", "text/greek.txt"}) {
+        auto data = GetResourceAsData(resource);
+        auto shaper = SkShaper::MakeShaperDrivenWrapper(nullptr);
+        auto cache = SkShaper::MakeHarfBuzzWordCache(1024);
+        auto cachingShaper = SkShaper::MakeShaperDrivenWrapper(nullptr, cache);
+        if (!data || !shaper || !cachingShaper) {
+            ERRORF(r, "Could not shape %s.", resource);
+            continue;
+        }
+
+        RecordingRunHandler expected = shape(shaper.get(), data.get());
+        // The first pass fills the cache; the second one is served from it.
+        for (int pass = 0; pass < 2; ++pass) {
+            RecordingRunHandler actual = shape(cachingShaper.get(), data.get());
+            REPORTER_ASSERT(r, actual.fLines == expected.fLines, "%s", resource);
+            REPORTER_ASSERT(r, actual.fGlyphs == expected.fGlyphs, "%s", resource);
+            REPORTER_ASSERT(r, actual.fPositions == expected.fPositions, "%s", resource);
+            REPORTER_ASSERT(r, actual.fClusters == expected.fClusters, "%s", resource);
+            REPORTER_ASSERT(r, actual.fAdvances == expected.fAdvances, "%s", resource);
+        }
+        REPORTER_ASSERT(r, SkShaper::GetHarfBuzzWordCacheStats(*cache).fHits > 0, "%s",
+                        resource);
+    }
+}
+#endif
+
 #endif  // defined(SKSHAPER_IMPLEMENTATION) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -777,6 +777,8 @@ BASE_SRCS_ALL = [
     "src/gpu/KeyBuilder.h",
     "src/gpu/MutableTextureStateRef.h",
     "src/gpu/Rectanizer.h",
+    "src/gpu/RectanizerMaxRects.cpp",
+    "src/gpu/RectanizerMaxRects.h",
     "src/gpu/RectanizerPow2.cpp",
     "src/gpu/RectanizerPow2.h",
     "src/gpu/RectanizerSkyline.cpp",
@@ -1086,6 +1088,8 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/geometry/GrShape.h",
     "src/gpu/ganesh/geometry/GrStyledShape.cpp",
     "src/gpu/ganesh/geometry/GrStyledShape.h",
+    "src/gpu/ganesh/geometry/GrTriangulationCache.cpp",
+    "src/gpu/ganesh/geometry/GrTriangulationCache.h",
     "src/gpu/ganesh/geometry/GrTriangulator.cpp",
     "src/gpu/ganesh/geometry/GrTriangulator.h",
     "src/gpu/ganesh/glsl/GrGLSLBlend.cpp",
@@ -1293,6 +1297,8 @@ BASE_SRCS_ALL = [
     "src/pathops/SkPathOpsDebug.h",
     "src/pathops/SkPathOpsLine.cpp",
     "src/pathops/SkPathOpsLine.h",
+    "src/pathops/SkPathOpsLinear.cpp",
+    "src/pathops/SkPathOpsLinear.h",
     "src/pathops/SkPathOpsOp.cpp",
     "src/pathops/SkPathOpsPoint.h",
     "src/pathops/SkPathOpsQuad.cpp",
@@ -1423,6 +1429,8 @@ BASE_SRCS_ALL = [
     "src/sksl/SkSLBuiltinTypes.h",
     "src/sksl/SkSLCompiler.cpp",
     "src/sksl/SkSLCompiler.h",
+    "src/sksl/SkSLCompilerPool.cpp",
+    "src/sksl/SkSLCompilerPool.h",
     "src/sksl/SkSLConstantFolder.cpp",
     "src/sksl/SkSLConstantFolder.h",
     "src/sksl/SkSLContext.cpp",
@@ -8,10 +8,15 @@
 #ifndef SkTSort_DEFINED
 #define SkTSort_DEFINED
 
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkMathPriv.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -211,4 +216,63 @@ template <typename T> void SkTQSort(T** begin, T** end) {
     SkTQSort(begin, end, [](const T* a, const T* b) { return *a < *b; });
 }
 
+/** Sorts the region from left to right using comparator lessThan, after first bucketing it by a
+ *  16-bit leading digit with a counting sort. This is a most significant digit radix sort that
+ *  stops after one digit and finishes each bucket with Introsort, so it is much faster than a
+ *  comparison sort alone when the digit splits the elements into many small buckets.
+ *
+ *  @param array the elements to sort; they are sorted in place
+ *  @param scratch storage for count elements
+ *  @param count the number of elements in array
+ *  @param digit a functor/lambda which returns an element's leading digit, in [0, 0xFFFF]. If
+ *         digit(a) < digit(b) then lessThan(a, b) must be true.
+ *  @param lessThan a functor/lambda which returns true if a comes before b.
+ */
+template <typename T, typename D, typename C>
+void SkTRadixSort(T array[], T scratch[], int count, const D& digit, const C& lessThan) {
+    static_assert(std::is_trivially_copyable<T>::value, "elements are copied as bytes");
+    if (count <= 1) {
+        return;
+    }
+    uint32_t minDigit = digit(array[0]);
+    uint32_t maxDigit = minDigit;
+    for (int i = 1; i < count; ++i) {
+        uint32_t d = digit(array[i]);
+        minDigit = std::min(minDigit, d);
+        maxDigit = std::max(maxDigit, d);
+    }
+    SkASSERT(maxDigit <= 0xFFFF);
+    int bucketCount = maxDigit - minDigit + 1;
+    if (bucketCount == 1 || bucketCount > 4 * count) {
+        // Counting would not split the elements up, or would cost more than it saves.
+        SkTQSort(array, array + count, lessThan);
+        return;
+    }
+
+    // After the scatter below, ends[b] is the index just past the last element in bucket b.
+    skia_private::AutoSTMalloc<256, int> ends(bucketCount);
+    memset(ends.get(), 0, bucketCount * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        ends[digit(array[i]) - minDigit]++;
+    }
+    int sum = 0;
+    for (int b = 0; b < bucketCount; ++b) {
+        int bucketSize = ends[b];
+        ends[b] = sum;
+        sum += bucketSize;
+    }
+    for (int i = 0; i < count; ++i) {
+        scratch[ends[digit(array[i]) - minDigit]++] = array[i];
+    }
+    memcpy(array, scratch, count * sizeof(T));
+
+    int start = 0;
+    for (int b = 0; b < bucketCount; ++b) {
+        if (ends[b] - start > 1) {
+            SkTQSort(array + start, array + ends[b], lessThan);
+        }
+        start = ends[b];
+    }
+}
+
 #endif
@@ -6,13 +6,19 @@
  */
 
 #include "include/private/SkColorData.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
-#include "src/base/SkAutoMalloc.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkPointPriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <utility>
 
 using namespace skia_private;
@@ -25,92 +31,56 @@ struct DFData {
     SkPoint fDistVector; // distance vector to nearest (so far) edge texel
 };
 
-enum NeighborFlags {
-    kLeft_NeighborFlag        = 0x01,
-    kRight_NeighborFlag       = 0x02,
-    kTopLeft_NeighborFlag     = 0x04,
-    kTop_NeighborFlag         = 0x08,
-    kTopRight_NeighborFlag    = 0x10,
-    kBottomLeft_NeighborFlag  = 0x20,
-    kBottom_NeighborFlag      = 0x40,
-    kBottomRight_NeighborFlag = 0x80,
-    kAll_NeighborFlags        = 0xff,
-
-    kNeighborFlagCount        = 8
-};
-
 // We treat an "edge" as a place where we cross from >=128 to <128, or vice versa, or
 // where we have two non-zero pixels that are <128.
-// 'neighborFlags' is used to limit the directions in which we test to avoid indexing
-// outside of the image
-static bool found_edge(const unsigned char* imagePtr, int width, int neighborFlags) {
-    // the order of these should match the neighbor flags above
-    const int kNum8ConnectedNeighbors = 8;
-    const int offsets[8] = {-1, 1, -width-1, -width, -width+1, width-1, width, width+1 };
-    SkASSERT(kNum8ConnectedNeighbors == kNeighborFlagCount);
-
-    // search for an edge
-    unsigned char currVal = *imagePtr;
-    unsigned char currCheck = (currVal >> 7);
-    for (int i = 0; i < kNum8ConnectedNeighbors; ++i) {
-        unsigned char neighborVal;
-        if ((1 << i) & neighborFlags) {
-            const unsigned char* checkPtr = imagePtr + offsets[i];
-            neighborVal = *checkPtr;
-        } else {
-            neighborVal = 0;
-        }
-        unsigned char neighborCheck = (neighborVal >> 7);
-        SkASSERT(currCheck == 0 || currCheck == 1);
-        SkASSERT(neighborCheck == 0 || neighborCheck == 1);
-        // if sharp transition
-        if (currCheck != neighborCheck ||
-            // or both <128 and >0
-            (!currCheck && !neighborCheck && currVal && neighborVal)) {
-            return true;
+// 'image' holds the glyph at the same position as in the data, with zeros around it, so every
+// texel can check all 8 of its neighbors. Its rows must have room for 15 more texels.
+static void find_edges(unsigned char* edges, const unsigned char* image, size_t imageRowBytes,
+                       int dataWidth, int dataHeight) {
+    using byte16 = skvx::byte16;
+    const ptrdiff_t rowBytes = imageRowBytes;
+    const ptrdiff_t offsets[8] = {-1, 1, -rowBytes-1, -rowBytes, -rowBytes+1,
+                                  rowBytes-1, rowBytes, rowBytes+1};
+    // the outermost texels are never edges
+    for (int j = 1; j < dataHeight-1; ++j) {
+        const unsigned char* imagePtr = image + j*rowBytes;
+        unsigned char* edgePtr = edges + j*dataWidth;
+        for (int i = 1; i < dataWidth-1; i += 16) {
+            byte16 curr = byte16::Load(imagePtr + i);
+            byte16 currHigh = curr >= 128;
+            byte16 currLow = ~currHigh & (curr != 0);
+            byte16 edge = 0;
+            for (ptrdiff_t offset : offsets) {
+                byte16 neighbor = byte16::Load(imagePtr + i + offset);
+                byte16 neighborHigh = neighbor >= 128;
+                byte16 neighborLow = ~neighborHigh & (neighbor != 0);
+                // if sharp transition, or both <128 and >0
+                edge |= (currHigh ^ neighborHigh) | (currLow & neighborLow);
+            }
+            // using 255 makes for convenient debug rendering
+            if (i + 16 <= dataWidth-1) {
+                edge.store(edgePtr + i);
+            } else {
+                unsigned char tail[16];
+                edge.store(tail);
+                memcpy(edgePtr + i, tail, dataWidth-1 - i);
+            }
         }
     }
-
-    return false;
 }
 
-static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned char* image,
-                            int dataWidth, int dataHeight,
-                            int imageWidth, int imageHeight,
-                            int pad) {
-    data += pad*dataWidth;
-    data += pad;
-    edges += (pad*dataWidth + pad);
-
-    for (int j = 0; j < imageHeight; ++j) {
-        for (int i = 0; i < imageWidth; ++i) {
-            if (255 == *image) {
+static void init_glyph_data(DFData* data, const unsigned char* image, size_t imageRowBytes,
+                            int dataWidth, int dataHeight) {
+    for (int j = 0; j < dataHeight; ++j) {
+        for (int i = 0; i < dataWidth; ++i) {
+            if (255 == image[i]) {
                 data->fAlpha = 1.0f;
             } else {
-                data->fAlpha = (*image)*0.00392156862f;  // 1/255
-            }
-            int checkMask = kAll_NeighborFlags;
-            if (i == 0) {
-                checkMask &= ~(kLeft_NeighborFlag|kTopLeft_NeighborFlag|kBottomLeft_NeighborFlag);
-            }
-            if (i == imageWidth-1) {
-                checkMask &= ~(kRight_NeighborFlag|kTopRight_NeighborFlag|kBottomRight_NeighborFlag);
-            }
-            if (j == 0) {
-                checkMask &= ~(kTopLeft_NeighborFlag|kTop_NeighborFlag|kTopRight_NeighborFlag);
-            }
-            if (j == imageHeight-1) {
-                checkMask &= ~(kBottomLeft_NeighborFlag|kBottom_NeighborFlag|kBottomRight_NeighborFlag);
-            }
-            if (found_edge(image, imageWidth, checkMask)) {
-                *edges = 255;  // using 255 makes for convenient debug rendering
+                data->fAlpha = image[i]*0.00392156862f;  // 1/255
             }
             ++data;
-            ++image;
-            ++edges;
         }
-        data += 2*pad;
-        edges += 2*pad;
+        image += imageRowBytes;
     }
 }
 
@@ -339,18 +309,19 @@ static unsigned char pack_distance_field_val(float dist) {
 
     // Scale into unsigned char range.
     // Round to place negative and positive values as equally as possible around 128
-    // (which represents zero).
-    return (unsigned char)SkScalarRoundToInt(dist / (2 * distanceMagnitude) * 256.0f);
+    // (which represents zero). The value is not negative, so truncation rounds it without the
+    // floor() call of SkScalarRoundToInt().
+    return (unsigned char)(dist / (2 * distanceMagnitude) * 256.0f + 0.5f);
 }
 #endif
 
-// assumes a padded 8-bit image and distance field
-// width and height are the original width and height of the image
+// Generates the distance field of a width x height 8-bit image. 'copyRow' is called with each row
+// y of the image, and a pointer to write its 8-bit values to.
+template <typename CopyRowProc>
 static bool generate_distance_field_from_image(unsigned char* distanceField,
-                                               const unsigned char* copyPtr,
-                                               int width, int height) {
+                                               int width, int height,
+                                               CopyRowProc&& copyRow) {
     SkASSERT(distanceField);
-    SkASSERT(copyPtr);
 
     // we expand our temp data by one more on each side to simplify
     // the scanning code -- will always be treated as infinitely far away
@@ -359,16 +330,25 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     // set params for distance field data
     int dataWidth = width + 2*pad;
     int dataHeight = height + 2*pad;
+    // the padded copy of the image leaves room for find_edges() to read 16 texels at a time
+    size_t imageRowBytes = SkAlignTo(dataWidth + 15, 16);
 
-    // create zeroed temp DFData+edge storage
-    UniqueVoidPtr storage(sk_calloc_throw(dataWidth*dataHeight*(sizeof(DFData) + 1)));
+    // create zeroed temp DFData+edge+image storage
+    size_t dataSize = dataWidth*dataHeight*(sizeof(DFData) + 1);
+    UniqueVoidPtr storage(sk_calloc_throw(dataSize + dataHeight*imageRowBytes));
     DFData*        dataPtr = (DFData*)storage.get();
     unsigned char* edgePtr = (unsigned char*)storage.get() + dataWidth*dataHeight*sizeof(DFData);
+    unsigned char* imagePtr = (unsigned char*)storage.get() + dataSize;
+
+    // we copy our source image into a padded copy to ensure we catch edge transitions
+    // around the outside
+    for (int j = 0; j < height; ++j) {
+        copyRow(j, imagePtr + (j + pad)*imageRowBytes + pad);
+    }
 
     // copy glyph into distance field storage
-    init_glyph_data(dataPtr, edgePtr, copyPtr,
-                    dataWidth, dataHeight,
-                    width+2, height+2, SK_DistanceFieldPad);
+    find_edges(edgePtr, imagePtr, imageRowBytes, dataWidth, dataHeight);
+    init_glyph_data(dataPtr, imagePtr, imageRowBytes, dataWidth, dataHeight);
 
     // create initial distance data, particularly at edges
     init_distances(dataPtr, edgePtr, dataWidth, dataHeight);
@@ -406,8 +386,8 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     }
 
     // backwards in y
-    currData = dataPtr+dataWidth*(dataHeight-2) - 1; // skip outer buffer
-    currEdge = edgePtr+dataWidth*(dataHeight-2) - 1;
+    currData = dataPtr+dataWidth*(dataHeight-2) + 1; // skip outer buffer
+    currEdge = edgePtr+dataWidth*(dataHeight-2) + 1;
     for (int j = 1; j < dataHeight-1; ++j) {
         // forwards in x
         for (int i = 1; i < dataWidth-1; ++i) {
@@ -477,25 +457,10 @@ bool SkGenerateDistanceFieldFromA8Image(unsigned char* distanceField,
     SkASSERT(distanceField);
     SkASSERT(image);
 
-    // create temp data
-    SkAutoSMalloc<1024> copyStorage((width+2)*(height+2)*sizeof(char));
-    unsigned char* copyPtr = (unsigned char*) copyStorage.get();
-
-    // we copy our source image into a padded copy to ensure we catch edge transitions
-    // around the outside
-    const unsigned char* currSrcScanLine = image;
-    sk_bzero(copyPtr, (width+2)*sizeof(char));
-    unsigned char* currDestPtr = copyPtr + width + 2;
-    for (int i = 0; i < height; ++i) {
-        *currDestPtr++ = 0;
-        memcpy(currDestPtr, currSrcScanLine, width);
-        currSrcScanLine += rowBytes;
-        currDestPtr += width;
-        *currDestPtr++ = 0;
-    }
-    sk_bzero(currDestPtr, (width+2)*sizeof(char));
-
-    return generate_distance_field_from_image(distanceField, copyPtr, width, height);
+    return generate_distance_field_from_image(distanceField, width, height,
+                                              [=](int y, unsigned char* dst) {
+        memcpy(dst, image + y*rowBytes, width);
+    });
 }
 
 // assumes a 16-bit lcd mask and 8-bit distance field
@@ -505,27 +470,15 @@ bool SkGenerateDistanceFieldFromLCD16Mask(unsigned char* distanceField,
     SkASSERT(distanceField);
     SkASSERT(image);
 
-    // create temp data
-    SkAutoSMalloc<1024> copyStorage((w+2)*(h+2)*sizeof(char));
-    unsigned char* copyPtr = (unsigned char*) copyStorage.get();
-
-    // we copy our source image into a padded copy to ensure we catch edge transitions
-    // around the outside
-    const uint16_t* start = reinterpret_cast<const uint16_t*>(image);
-    auto currSrcScanline = SkMask::AlphaIter<SkMask::kLCD16_Format>(start);
-    auto endSrcScanline = SkMask::AlphaIter<SkMask::kLCD16_Format>(start + w);
-    sk_bzero(copyPtr, (w+2)*sizeof(char));
-    unsigned char* currDestPtr = copyPtr + w + 2;
-    for (int i = 0; i < h; ++i, currSrcScanline >>= rowBytes, endSrcScanline >>= rowBytes) {
-        *currDestPtr++ = 0;
-        for (auto src = currSrcScanline; src < endSrcScanline; ++src) {
-            *currDestPtr++ = *src;
+    return generate_distance_field_from_image(distanceField, w, h,
+                                              [=](int y, unsigned char* dst) {
+        const uint16_t* start = reinterpret_cast<const uint16_t*>(image + y*rowBytes);
+        auto src = SkMask::AlphaIter<SkMask::kLCD16_Format>(start);
+        auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(start + w);
+        for (; src < end; ++src) {
+            *dst++ = *src;
         }
-        *currDestPtr++ = 0;
-    }
-    sk_bzero(currDestPtr, (w+2)*sizeof(char));
-
-    return generate_distance_field_from_image(distanceField, copyPtr, w, h);
+    });
 }
 
 // assumes a 1-bit image and 8-bit distance field
@@ -535,33 +488,76 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
     SkASSERT(distanceField);
     SkASSERT(image);
 
-    // create temp data
-    SkAutoSMalloc<1024> copyStorage((width+2)*(height+2)*sizeof(char));
-    unsigned char* copyPtr = (unsigned char*) copyStorage.get();
-
-    // we copy our source image into a padded copy to ensure we catch edge transitions
-    // around the outside
-    const unsigned char* currSrcScanLine = image;
-    sk_bzero(copyPtr, (width+2)*sizeof(char));
-    unsigned char* currDestPtr = copyPtr + width + 2;
-    for (int i = 0; i < height; ++i) {
-        *currDestPtr++ = 0;
-
+    return generate_distance_field_from_image(distanceField, width, height,
+                                              [=](int y, unsigned char* dst) {
         int rowWritesLeft = width;
-        const unsigned char *maskPtr = currSrcScanLine;
+        const unsigned char *maskPtr = image + y*rowBytes;
         while (rowWritesLeft > 0) {
             unsigned mask = *maskPtr++;
             for (int j = 7; j >= 0 && rowWritesLeft; --j, --rowWritesLeft) {
-                *currDestPtr++ = (mask & (1 << j)) ? 0xff : 0;
+                *dst++ = (mask & (1 << j)) ? 0xff : 0;
             }
         }
-        currSrcScanLine += rowBytes;
+    });
+}
+
+bool SkGenerateDistanceFieldFromMask(unsigned char* distanceField, const SkMask& mask) {
+    switch (mask.fFormat) {
+        case SkMask::kA8_Format:
+            return SkGenerateDistanceFieldFromA8Image(distanceField, mask.fImage,
+                                                      mask.fBounds.width(), mask.fBounds.height(),
+                                                      mask.fRowBytes);
+        case SkMask::kLCD16_Format:
+            return SkGenerateDistanceFieldFromLCD16Mask(distanceField, mask.fImage,
+                                                        mask.fBounds.width(),
+                                                        mask.fBounds.height(), mask.fRowBytes);
+        case SkMask::kBW_Format:
+            return SkGenerateDistanceFieldFromBWImage(distanceField, mask.fImage,
+                                                      mask.fBounds.width(), mask.fBounds.height(),
+                                                      mask.fRowBytes);
+        default:
+            return false;
+    }
+}
 
-        *currDestPtr++ = 0;
+bool SkGenerateDistanceFields(SkSpan<const SkDistanceFieldJob> jobs, SkExecutor* executor) {
+    // Even a small field takes several microseconds, so a few of them make a worthwhile task.
+    static constexpr size_t kMinJobsPerTask = 4;
+    static constexpr int kMaxTasks = 8;
+    const int taskCount = std::min(SkToInt(jobs.size() / kMinJobsPerTask), kMaxTasks);
+
+    // The time to generate a field grows with its area. Deal the masks out largest first, so the
+    // tasks get about the same amount of work.
+    AutoTArray<int> order(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.get(), order.get() + jobs.size(), [&jobs](int a, int b) {
+        return jobs[a].fMask.fBounds.width() * jobs[a].fMask.fBounds.height() >
+               jobs[b].fMask.fBounds.width() * jobs[b].fMask.fBounds.height();
+    });
+
+    std::atomic<bool> succeeded{true};
+    auto generate = [&](int task, int stride) {
+        for (size_t i = task; i < jobs.size(); i += stride) {
+            const SkDistanceFieldJob& job = jobs[order[i]];
+            if (!SkGenerateDistanceFieldFromMask(job.fDistanceField, job.fMask)) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+    if (executor == nullptr || taskCount < 2) {
+        generate(0, 1);
+        return succeeded.load();
     }
-    sk_bzero(currDestPtr, (width+2)*sizeof(char));
 
-    return generate_distance_field_from_image(distanceField, copyPtr, width, height);
+    SkTaskGroup group{*executor};
+    for (int task = 1; task < taskCount; ++task) {
+        group.add([&generate, task, taskCount] { generate(task, taskCount); });
+    }
+    generate(0, taskCount);
+    group.wait();
+    return succeeded.load();
 }
 
 #endif // !defined(SK_DISABLE_SDF_TEXT)
@@ -7,10 +7,14 @@
 #ifndef SkDistanceFieldGen_DEFINED
 #define SkDistanceFieldGen_DEFINED
 
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
+#include "src/core/SkMask.h"
 
 #include <cstddef>
 
+class SkExecutor;
+
 #if !defined(SK_DISABLE_SDF_TEXT)
 
 // the max magnitude for the distance field
@@ -68,6 +72,27 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
                                         const unsigned char* image,
                                         int w, int h, size_t rowBytes);
 
+/** Given a kA8, kLCD16 or kBW mask, generate the associated distance field. Returns false for
+ *  other formats.
+ *
+ *  @param distanceField     The distance field to be generated. Should already be allocated
+ *                           by the client with the padding above.
+ *  @param mask              The mask we're using to generate the distance field.
+ */
+bool SkGenerateDistanceFieldFromMask(unsigned char* distanceField, const SkMask& mask);
+
+/** A mask, and the distance field to generate from it with SkGenerateDistanceFields(). */
+struct SkDistanceFieldJob {
+    unsigned char* fDistanceField;  // allocated by the client with the padding above
+    SkMask         fMask;
+};
+
+/** Generate the distance fields of many masks, such as the glyphs of a new page of text. If
+ *  'executor' is not null, the fields are generated in parallel on it, and this returns once they
+ *  are all done. Returns false if any of the masks has an unsupported format.
+ */
+bool SkGenerateDistanceFields(SkSpan<const SkDistanceFieldJob> jobs, SkExecutor* executor);
+
 /** Given width and height of original image, return size (in bytes) of distance field
  *  @param w                 Width of the original image.
  *  @param h                 Height of the original image.
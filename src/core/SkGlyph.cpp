@@ -12,7 +12,9 @@
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/pathops/SkPathOpsCubic.h"
 #include "src/pathops/SkPathOpsPoint.h"
 #include "src/pathops/SkPathOpsQuad.h"
@@ -118,6 +120,63 @@ bool SkGlyph::setImage(SkArenaAlloc* alloc, const void* image) {
     return false;
 }
 
+void SkGlyph::flattenMetrics(SkWriteBuffer& buffer) const {
+    buffer.writeUInt(fID.value());
+    buffer.writeScalar(fAdvanceX);
+    buffer.writeScalar(fAdvanceY);
+    buffer.writeUInt(fWidth);
+    buffer.writeUInt(fHeight);
+    buffer.writeInt(fTop);
+    buffer.writeInt(fLeft);
+    buffer.writeUInt(fMaskFormat);
+    buffer.writeUInt(fScalerContextBits);
+}
+
+std::optional<SkGlyph> SkGlyph::MakeFromBuffer(SkReadBuffer& buffer) {
+    SkPackedGlyphID packedID{buffer.readUInt()};
+    SkGlyph glyph{packedID};
+    glyph.fAdvanceX = buffer.readScalar();
+    glyph.fAdvanceY = buffer.readScalar();
+    const uint32_t width = buffer.readUInt();
+    const uint32_t height = buffer.readUInt();
+    const int32_t top = buffer.readInt();
+    const int32_t left = buffer.readInt();
+    const uint32_t maskFormat = buffer.readUInt();
+    const uint32_t scalerContextBits = buffer.readUInt();
+    if (!buffer.validate(width <= std::numeric_limits<uint16_t>::max() &&
+                         height <= std::numeric_limits<uint16_t>::max() &&
+                         SkTFitsIn<int16_t>(top) &&
+                         SkTFitsIn<int16_t>(left) &&
+                         SkMask::IsValidFormat(maskFormat) &&
+                         scalerContextBits <= std::numeric_limits<uint16_t>::max())) {
+        return std::nullopt;
+    }
+    glyph.fWidth = SkTo<uint16_t>(width);
+    glyph.fHeight = SkTo<uint16_t>(height);
+    glyph.fTop = SkTo<int16_t>(top);
+    glyph.fLeft = SkTo<int16_t>(left);
+    glyph.fMaskFormat = static_cast<SkMask::Format>(maskFormat);
+    glyph.fScalerContextBits = SkTo<uint16_t>(scalerContextBits);
+    SkDEBUGCODE(glyph.fAdvancesBoundsFormatAndInitialPathDone = true;)
+    return glyph;
+}
+
+void SkGlyph::flattenImage(SkWriteBuffer& buffer) const {
+    SkASSERT(fImage != nullptr);
+    buffer.writePad32(fImage, this->imageSize());
+}
+
+size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc) {
+    const size_t size = this->imageSize();
+    const void* image = buffer.skip(SkAlign4(size));
+    if (image == nullptr || size == 0 || this->setImageHasBeenCalled()) {
+        return 0;
+    }
+    this->allocImage(alloc);
+    memcpy(fImage, image, size);
+    return size;
+}
+
 size_t SkGlyph::setMetricsAndImage(SkArenaAlloc* alloc, const SkGlyph& from) {
     // Since the code no longer tries to find replacement glyphs, the image should always be
     // nullptr.
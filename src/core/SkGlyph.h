@@ -28,10 +28,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <optional>
 
 class SkArenaAlloc;
 class SkGlyph;
+class SkReadBuffer;
 class SkScalerContext;
+class SkWriteBuffer;
 namespace sktext {
 class StrikeForGPU;
 }  // namespace sktext
@@ -422,6 +425,17 @@ public:
     bool setImage(SkArenaAlloc* alloc, SkScalerContext* scalerContext);
     bool setImage(SkArenaAlloc* alloc, const void* image);
 
+    // Flatten the metrics, including fScalerContextBits so a scaler context for the same strike
+    // can still generate the glyph's path or image later, and recreate the glyph from them.
+    void flattenMetrics(SkWriteBuffer&) const;
+    static std::optional<SkGlyph> MakeFromBuffer(SkReadBuffer&);
+
+    // Flatten the image, which must have been set, and read it back into this glyph using alloc.
+    // If the image of this glyph has already been set, then the image is skipped. Return the
+    // number of bytes allocated.
+    void flattenImage(SkWriteBuffer&) const;
+    size_t addImageFromBuffer(SkReadBuffer&, SkArenaAlloc*);
+
     // Merge the 'from' glyph into this glyph using alloc to allocate image data. Return the number
     // of bytes allocated. Copy the width, height, top, left, format, and image into this glyph
     // making a copy of the image using the alloc.
@@ -513,6 +527,7 @@ private:
     friend class SkScalerContext_DW;
     friend class SkScalerContext_GDI;
     friend class SkScalerContext_Mac;
+    friend class SkStrike;
     friend class SkStrikeClientImpl;
     friend class SkTestScalerContext;
     friend class SkTestSVGScalerContext;
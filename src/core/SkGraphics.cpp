@@ -8,6 +8,7 @@
 #include "include/core/SkGraphics.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkOpenTypeSVGDecoder.h"
 #include "include/core/SkPath.h"
@@ -24,12 +25,18 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTypefaceCache.h"
 
 #include <stdlib.h>
 
+#if defined(SK_ENABLE_SKSL)
+#include "include/private/SkSLProgramKind.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#endif
+
 void SkGraphics::Init() {
     // SkGraphics::Init() must be thread-safe and idempotent.
     SkCpu::CacheRuntimeFeatures();
@@ -47,6 +54,49 @@ void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
     SkImageFilter_Base::PurgeCache();
+#if defined(SK_ENABLE_SKSL)
+    SkRuntimeEffectPriv::PurgeCache();
+#endif
+}
+
+size_t SkGraphics::GetRuntimeEffectCacheByteLimit() {
+#if defined(SK_ENABLE_SKSL)
+    return SkRuntimeEffectPriv::GetCacheLimit();
+#else
+    return 0;
+#endif
+}
+
+size_t SkGraphics::SetRuntimeEffectCacheByteLimit(size_t newLimit) {
+#if defined(SK_ENABLE_SKSL)
+    return SkRuntimeEffectPriv::SetCacheLimit(newLimit);
+#else
+    return 0;
+#endif
+}
+
+size_t SkGraphics::GetRuntimeEffectCacheBytesUsed() {
+#if defined(SK_ENABLE_SKSL)
+    return SkRuntimeEffectPriv::GetCacheStats().fBytesUsed;
+#else
+    return 0;
+#endif
+}
+
+void SkGraphics::WarmUpSkSLModules(SkExecutor* executor) {
+#if defined(SK_ENABLE_SKSL)
+    static constexpr SkSL::ProgramKind kKinds[] = {
+        SkSL::ProgramKind::kRuntimeShader,
+        SkSL::ProgramKind::kPrivateRuntimeShader,
+        SkSL::ProgramKind::kFragment,
+        SkSL::ProgramKind::kVertex,
+#if defined(SK_GRAPHITE)
+        SkSL::ProgramKind::kGraphiteFragment,
+        SkSL::ProgramKind::kGraphiteVertex,
+#endif
+    };
+    SkSL::ModuleLoader::WarmUp(executor, kKinds);
+#endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -121,6 +171,24 @@ int SkGraphics::GetFontCacheCountUsed() {
     return SkStrikeCache::GlobalStrikeCache()->getCacheCountUsed();
 }
 
+SkExecutor* SkGraphics::SetFontCacheRasterExecutor(SkExecutor* executor) {
+    return SkStrikeCache::GlobalStrikeCache()->setRasterExecutor(executor);
+}
+
+bool SkGraphics::SaveFontCacheToFile(const char path[], size_t maxBytes) {
+    sk_sp<SkData> data = SkStrikeCache::GlobalStrikeCache()->serializeStrikes(maxBytes);
+    SkFILEWStream stream{path};
+    return stream.isValid() && stream.write(data->data(), data->size());
+}
+
+int SkGraphics::LoadFontCacheFromFile(const char path[]) {
+    sk_sp<SkData> data = SkData::MakeFromFileName(path);
+    if (data == nullptr) {
+        return -1;
+    }
+    return SkStrikeCache::GlobalStrikeCache()->prepopulate(data->data(), data->size());
+}
+
 void SkGraphics::PurgeFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgeAll();
     SkTypefaceCache::PurgeAll();
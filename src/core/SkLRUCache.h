@@ -84,6 +84,19 @@ public:
         return fMap.count();
     }
 
+    // Return the least recently used value, or nullptr if the cache is empty.
+    V* leastRecentlyUsed() {
+        Entry* entry = fLRU.tail();
+        return entry ? &entry->fValue : nullptr;
+    }
+
+    // Remove the least recently used entry, if there is one.
+    void removeLeastRecentlyUsed() {
+        if (Entry* entry = fLRU.tail()) {
+            this->remove(entry->fKey);
+        }
+    }
+
     template <typename Fn>  // f(K*, V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
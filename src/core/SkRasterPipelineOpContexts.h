@@ -153,6 +153,11 @@ struct SkRasterPipeline_BinaryOpCtx {
     const float *src;
 };
 
+struct SkRasterPipeline_ConstantCtx {
+    int32_t value;  // the immediate operand; reinterpreted as a float by float ops
+    float *dst;
+};
+
 struct SkRasterPipeline_TernaryOpCtx {
     float *dst;
     const float *src0;
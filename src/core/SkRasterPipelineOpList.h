@@ -139,6 +139,10 @@
     M(swizzle_copy_slot_masked)    M(swizzle_copy_2_slots_masked)                             \
     M(swizzle_copy_3_slots_masked) M(swizzle_copy_4_slots_masked)                             \
     M(swizzle_1) M(swizzle_2) M(swizzle_3) M(swizzle_4) M(shuffle)                            \
+    M(add_imm_float)   M(add_imm_int)   M(mul_imm_float)   M(mul_imm_int)                     \
+    M(min_imm_float)   M(max_imm_float)                                                       \
+    M(cmplt_imm_float) M(cmplt_imm_int) M(cmple_imm_float) M(cmple_imm_int)                   \
+    M(cmpeq_imm_float) M(cmpeq_imm_int) M(cmpne_imm_float) M(cmpne_imm_int)                   \
     M(add_n_floats)   M(add_float)   M(add_2_floats)   M(add_3_floats)   M(add_4_floats)      \
     M(add_n_ints)     M(add_int)     M(add_2_ints)     M(add_3_ints)     M(add_4_ints)        \
     M(sub_n_floats)   M(sub_float)   M(sub_2_floats)   M(sub_3_floats)   M(sub_4_floats)      \
@@ -24,6 +24,7 @@
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkVM.h"
@@ -42,6 +43,11 @@
 #include "src/sksl/ir/SkSLVarDeclarations.h"
 #include "src/sksl/tracing/SkVMDebugTrace.h"
 
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <vector>
+
 #if defined(SK_GANESH)
 #include "include/gpu/GrRecordingContext.h"
 #include "src/gpu/SkBackingFit.h"
@@ -424,6 +430,242 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
     return settings;
 }
 
+#ifndef SK_DEFAULT_RUNTIME_EFFECT_CACHE_LIMIT
+    #define SK_DEFAULT_RUNTIME_EFFECT_CACHE_LIMIT (2 * 1024 * 1024)
+#endif
+
+namespace {
+
+SK_BEGIN_REQUIRE_DENSE
+struct EffectCacheKey {
+    uint32_t skslHashA;
+    uint32_t skslHashB;
+    uint32_t kind;
+    uint32_t options;
+
+    bool operator==(const EffectCacheKey& that) const {
+        return this->skslHashA == that.skslHashA
+            && this->skslHashB == that.skslHashB
+            && this->kind      == that.kind
+            && this->options   == that.options;
+    }
+};
+SK_END_REQUIRE_DENSE
+
+class EffectCache {
+public:
+    static EffectCache& Get() {
+        static auto* cache = new EffectCache;
+        return *cache;
+    }
+
+    static EffectCacheKey MakeKey(const SkString& sksl,
+                                  const SkRuntimeEffect::Options& options,
+                                  SkSL::ProgramKind kind) {
+        return {SkOpts::hash(sksl.c_str(), sksl.size(), 0),
+                SkOpts::hash(sksl.c_str(), sksl.size(), 1),
+                static_cast<uint32_t>(kind),
+                SkRuntimeEffectPriv::OptionsKey(options)};
+    }
+
+    // The IR isn't measured directly, so charge each effect in proportion to its source, which
+    // the size of the IR roughly follows.
+    static size_t ApproximateBytes(const SkString& sksl) {
+        return sizeof(SkRuntimeEffect) + 16 * sksl.size();
+    }
+
+    sk_sp<SkRuntimeEffect> find(const EffectCacheKey& key) {
+        SkAutoMutexExclusive _(fMutex);
+        if (Entry* entry = fCache.find(key)) {
+            fHits++;
+            return entry->fEffect;
+        }
+        fMisses++;
+        return nullptr;
+    }
+
+    void add(const EffectCacheKey& key, sk_sp<SkRuntimeEffect> effect, size_t bytes) {
+        SkAutoMutexExclusive _(fMutex);
+        if (bytes > fLimit) {
+            return;
+        }
+        if (Entry* entry = fCache.find(key)) {
+            // Another thread compiled the same effect; keep the first one.
+            return;
+        }
+        fCache.insert(key, Entry{std::move(effect), bytes});
+        fBytesUsed += bytes;
+        this->purgeToLimit();
+    }
+
+    size_t limit() {
+        SkAutoMutexExclusive _(fMutex);
+        return fLimit;
+    }
+
+    size_t setLimit(size_t bytes) {
+        SkAutoMutexExclusive _(fMutex);
+        size_t prevLimit = fLimit;
+        fLimit = bytes;
+        this->purgeToLimit();
+        return prevLimit;
+    }
+
+    SkRuntimeEffectPriv::CacheStats stats() {
+        SkAutoMutexExclusive _(fMutex);
+        return {fHits, fMisses, fCache.count(), fBytesUsed};
+    }
+
+    void purge() {
+        SkAutoMutexExclusive _(fMutex);
+        fCache.reset();
+        fBytesUsed = 0;
+    }
+
+private:
+    struct Entry {
+        sk_sp<SkRuntimeEffect> fEffect;
+        size_t fBytes;
+    };
+
+    void purgeToLimit() SK_REQUIRES(fMutex) {
+        while (fBytesUsed > fLimit) {
+            Entry* entry = fCache.leastRecentlyUsed();
+            SkASSERT(entry);
+            fBytesUsed -= entry->fBytes;
+            fCache.removeLeastRecentlyUsed();
+        }
+    }
+
+    SkMutex fMutex;
+    // The cache is bounded by bytes rather than by count.
+    SkLRUCache<EffectCacheKey, Entry> fCache SK_GUARDED_BY(fMutex) {INT_MAX};
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+    size_t fLimit SK_GUARDED_BY(fMutex) = SK_DEFAULT_RUNTIME_EFFECT_CACHE_LIMIT;
+    int fHits SK_GUARDED_BY(fMutex) = 0;
+    int fMisses SK_GUARDED_BY(fMutex) = 0;
+};
+
+}  // namespace
+
+size_t SkRuntimeEffectPriv::GetCacheLimit() {
+    return EffectCache::Get().limit();
+}
+
+size_t SkRuntimeEffectPriv::SetCacheLimit(size_t bytes) {
+    return EffectCache::Get().setLimit(bytes);
+}
+
+SkRuntimeEffectPriv::CacheStats SkRuntimeEffectPriv::GetCacheStats() {
+    return EffectCache::Get().stats();
+}
+
+void SkRuntimeEffectPriv::PurgeCache() {
+    EffectCache::Get().purge();
+}
+
+namespace {
+
+class NativeKernelRegistry {
+public:
+    using NativeKernel = SkRuntimeEffectPriv::NativeKernel;
+
+    static NativeKernelRegistry& Get() {
+        static auto* registry = new NativeKernelRegistry;
+        return *registry;
+    }
+
+    void add(const NativeKernel* kernel) {
+        SkASSERT(kernel && kernel->fSkSL && kernel->fRun);
+        SkAutoMutexExclusive _(fMutex);
+        if (this->indexOf(kernel) < 0) {
+            fKernels.push_back({SkOpts::hash(kernel->fSkSL, strlen(kernel->fSkSL)), kernel});
+            fCount.store(fKernels.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void remove(const NativeKernel* kernel) {
+        SkAutoMutexExclusive _(fMutex);
+        if (int index = this->indexOf(kernel); index >= 0) {
+            fKernels.erase(fKernels.begin() + index);
+            fCount.store(fKernels.size(), std::memory_order_relaxed);
+        }
+    }
+
+    const NativeKernel* find(const std::string& sksl) {
+        // This is called for every raster draw of a runtime effect; skip hashing when there's
+        // nothing to find.
+        if (fCount.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        uint32_t hash = SkOpts::hash(sksl.data(), sksl.size());
+        SkAutoMutexExclusive _(fMutex);
+        for (const Entry& entry : fKernels) {
+            if (entry.fHash == hash && sksl == entry.fKernel->fSkSL) {
+                return entry.fKernel;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    struct Entry {
+        uint32_t fHash;
+        const NativeKernel* fKernel;
+    };
+
+    int indexOf(const NativeKernel* kernel) SK_REQUIRES(fMutex) {
+        for (size_t i = 0; i < fKernels.size(); ++i) {
+            if (fKernels[i].fKernel == kernel) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    SkMutex fMutex;
+    std::vector<Entry> fKernels SK_GUARDED_BY(fMutex);
+    std::atomic<size_t> fCount{0};
+};
+
+}  // namespace
+
+void SkRuntimeEffectPriv::RegisterNativeKernel(const NativeKernel* kernel) {
+    NativeKernelRegistry::Get().add(kernel);
+}
+
+void SkRuntimeEffectPriv::UnregisterNativeKernel(const NativeKernel* kernel) {
+    NativeKernelRegistry::Get().remove(kernel);
+}
+
+const SkRuntimeEffectPriv::NativeKernel* SkRuntimeEffectPriv::FindNativeKernel(
+        const SkRuntimeEffect& effect) {
+    if (!effect.children().empty()) {
+        return nullptr;
+    }
+    return NativeKernelRegistry::Get().find(effect.source());
+}
+
+// Appends a callback stage which runs `kernel` over the pipeline's src registers.
+static void append_native_kernel(const SkStageRec& rec,
+                                 const SkRuntimeEffectPriv::NativeKernel* kernel,
+                                 sk_sp<const SkData> uniforms) {
+    struct NativeKernelCtx : SkRasterPipeline_CallbackCtx {
+        const SkRuntimeEffectPriv::NativeKernel* kernel;
+        sk_sp<const SkData> uniforms;
+    };
+    auto ctx = rec.fAlloc->make<NativeKernelCtx>();
+    ctx->kernel = kernel;
+    ctx->uniforms = std::move(uniforms);
+    ctx->fn = [](SkRasterPipeline_CallbackCtx* self, int active_pixels) {
+        auto ctx = static_cast<NativeKernelCtx*>(self);
+        ctx->kernel->fRun(static_cast<const float*>(ctx->uniforms->data()),
+                          ctx->rgba,
+                          active_pixels);
+    };
+    rec.fPipeline->append(SkRasterPipelineOp::callback, ctx);
+}
+
 // TODO: Many errors aren't caught until we process the generated Program here. Catching those
 // in the IR generator would provide better errors messages (with locations).
 #define RETURN_FAILURE(...) return Result{nullptr, SkStringPrintf(__VA_ARGS__)}
@@ -431,6 +673,13 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
 SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
                                                         const Options& options,
                                                         SkSL::ProgramKind kind) {
+    EffectCache& cache = EffectCache::Get();
+    const EffectCacheKey key = EffectCache::MakeKey(sksl, options, kind);
+    if (sk_sp<SkRuntimeEffect> effect = cache.find(key)) {
+        return Result{std::move(effect), SkString()};
+    }
+    const size_t bytes = EffectCache::ApproximateBytes(sksl);
+
     SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
@@ -440,7 +689,11 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
         RETURN_FAILURE("%s", compiler.errorText().c_str());
     }
 
-    return MakeInternal(std::move(program), options, kind);
+    Result result = MakeInternal(std::move(program), options, kind);
+    if (result.effect) {
+        cache.add(key, result.effect, bytes);
+    }
+    return result;
 }
 
 SkRuntimeEffect::Result SkRuntimeEffect::MakeInternal(std::unique_ptr<SkSL::Program> program,
@@ -639,47 +892,16 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeForBlender(SkString sksl, const Opt
 sk_sp<SkRuntimeEffect> SkMakeCachedRuntimeEffect(
         SkRuntimeEffect::Result (*make)(SkString sksl, const SkRuntimeEffect::Options&),
         SkString sksl) {
-    SK_BEGIN_REQUIRE_DENSE
-    struct Key {
-        uint32_t skslHashA;
-        uint32_t skslHashB;
-
-        bool operator==(const Key& that) const {
-            return this->skslHashA == that.skslHashA
-                && this->skslHashB == that.skslHashB;
-        }
-
-        explicit Key(const SkString& sksl)
-            : skslHashA(SkOpts::hash(sksl.c_str(), sksl.size(), 0))
-            , skslHashB(SkOpts::hash(sksl.c_str(), sksl.size(), 1)) {}
-    };
-    SK_END_REQUIRE_DENSE
-
-    static auto* mutex = new SkMutex;
-    static auto* cache = new SkLRUCache<Key, sk_sp<SkRuntimeEffect>>(11/*totally arbitrary*/);
-
-    Key key(sksl);
-    {
-        SkAutoMutexExclusive _(*mutex);
-        if (sk_sp<SkRuntimeEffect>* found = cache->find(key)) {
-            return *found;
-        }
-    }
-
     SkRuntimeEffect::Options options;
     SkRuntimeEffectPriv::AllowPrivateAccess(&options);
 
+    // make() goes through SkRuntimeEffect::MakeFromSource, which looks in the effect cache.
     auto [effect, err] = make(std::move(sksl), options);
     if (!effect) {
         SkDEBUGFAILF("%s", err.c_str());
         return nullptr;
     }
     SkASSERT(err.isEmpty());
-
-    {
-        SkAutoMutexExclusive _(*mutex);
-        cache->insert_or_update(key, effect);
-    }
     return effect;
 }
 
@@ -1215,6 +1437,14 @@ public:
 #endif
 
     bool appendStages(const SkStageRec& rec, bool) const override {
+        if (const SkRuntimeEffectPriv::NativeKernel* kernel =
+                    SkRuntimeEffectPriv::FindNativeKernel(*fEffect)) {
+            append_native_kernel(rec, kernel,
+                                 SkRuntimeEffectPriv::TransformUniforms(fEffect->uniforms(),
+                                                                        fUniforms,
+                                                                        rec.fDstCS));
+            return true;
+        }
 #ifdef SK_ENABLE_SKSL_IN_RASTER_PIPELINE
         if (!SkRuntimeEffectPriv::CanDraw(SkCapabilities::RasterBackend().get(), fEffect.get())) {
             // SkRP has support for many parts of #version 300 already, but for now, we restrict its
@@ -1432,6 +1662,22 @@ public:
 #endif
 
     bool appendStages(const SkStageRec& rec, const MatrixRec& mRec) const override {
+        if (!fDebugTrace) {
+            if (const SkRuntimeEffectPriv::NativeKernel* kernel =
+                        SkRuntimeEffectPriv::FindNativeKernel(*fEffect)) {
+                // Like the Raster Pipeline program, the kernel reads local coordinates from r,g.
+                std::optional<MatrixRec> newMRec = mRec.apply(rec);
+                if (!newMRec.has_value()) {
+                    return false;
+                }
+                append_native_kernel(rec, kernel,
+                                     SkRuntimeEffectPriv::TransformUniforms(
+                                             fEffect->uniforms(),
+                                             this->uniformData(rec.fDstCS),
+                                             rec.fDstCS));
+                return true;
+            }
+        }
 #ifdef SK_ENABLE_SKSL_IN_RASTER_PIPELINE
         if (!SkRuntimeEffectPriv::CanDraw(SkCapabilities::RasterBackend().get(), fEffect.get())) {
             // SkRP has support for many parts of #version 300 already, but for now, we restrict its
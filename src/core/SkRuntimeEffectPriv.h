@@ -67,6 +67,13 @@ public:
         options->allowPrivateAccess = true;
     }
 
+    // Packs all the options that affect compilation, for keying the effect cache.
+    static uint32_t OptionsKey(const SkRuntimeEffect::Options& options) {
+        return (options.forceUnoptimized   ? 0b01 : 0) |
+               (options.allowPrivateAccess ? 0b10 : 0) |
+               (static_cast<uint32_t>(options.maxVersionAllowed) << 2);
+    }
+
     static SkRuntimeEffect::Uniform VarAsUniform(const SkSL::Variable&,
                                                  const SkSL::Context&,
                                                  size_t* offset);
@@ -82,15 +89,41 @@ public:
 
     static bool CanDraw(const SkCapabilities*, const SkSL::Program*);
     static bool CanDraw(const SkCapabilities*, const SkRuntimeEffect*);
+
+    // The process-wide cache of compiled effects, keyed by a hash of their source, program kind
+    // and options. It is used by the SkRuntimeEffect::Make*() functions and by
+    // SkMakeCachedRuntimeEffect(). Its byte limit is exposed through SkGraphics.
+    struct CacheStats {
+        int    fHits;
+        int    fMisses;
+        int    fCount;
+        size_t fBytesUsed;
+    };
+    static size_t GetCacheLimit();
+    static size_t SetCacheLimit(size_t bytes);
+    static CacheStats GetCacheStats();
+    static void PurgeCache();
+
+    // A runtime shader or color filter compiled ahead of time into native code by skslc (see
+    // tools/skslc/NativeKernelCodeGenerator.h). Once registered, the raster backend runs the kernel
+    // instead of the interpreted program for any effect created from identical SkSL. Kernels are
+    // not used for effects with children, or for shaders with a debug trace.
+    struct NativeKernel {
+        const char* fSkSL;
+        // Runs the effect on `count` interleaved RGBA pixels in place. Shaders read their local
+        // coordinates from the first two channels; color filters read the input color.
+        void (*fRun)(const float* uniforms, float* rgba, int count);
+    };
+    // The kernel must outlive its registration. Registering a kernel twice, or unregistering one
+    // that isn't registered, does nothing.
+    static void RegisterNativeKernel(const NativeKernel*);
+    static void UnregisterNativeKernel(const NativeKernel*);
+    static const NativeKernel* FindNativeKernel(const SkRuntimeEffect&);
 };
 
-// These internal APIs for creating runtime effects vary from the public API in two ways:
-//
-//     1) they're used in contexts where it's not useful to receive an error message;
-//     2) they're cached.
-//
-// Users of the public SkRuntimeEffect::Make*() can of course cache however they like themselves;
-// keeping these APIs private means users will not be forced into our cache or cache policy.
+// These internal APIs for creating runtime effects vary from the public API in that they're used in
+// contexts where it's not useful to receive an error message. Like the public SkRuntimeEffect::
+// Make*(), they're cached (see SkRuntimeEffectPriv::GetCacheStats).
 
 sk_sp<SkRuntimeEffect> SkMakeCachedRuntimeEffect(
         SkRuntimeEffect::Result (*make)(SkString sksl, const SkRuntimeEffect::Options&),
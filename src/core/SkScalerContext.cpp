@@ -18,6 +18,7 @@
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkFontPriv.h"
 #include "src/core/SkGlyph.h"
@@ -34,6 +35,7 @@
 #include "src/core/SkWriteBuffer.h"
 #include "src/utils/SkMatrix22.h"
 #include <new>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -556,6 +558,98 @@ void SkScalerContext::GenerateImageFromPath(
     }
 }
 
+// Copies the filtered 'srcMask' into the image of 'origGlyph', whose bounds may differ.
+static void copy_filtered_mask(SkMask srcMask, const SkGlyph& origGlyph) {
+    SkASSERT_RELEASE(srcMask.fFormat == origGlyph.maskFormat());
+    SkMask dstMask = origGlyph.mask();
+    SkIRect origBounds = dstMask.fBounds;
+
+    // Find the intersection of src and dst while updating the fImages.
+    if (srcMask.fBounds.fTop < dstMask.fBounds.fTop) {
+        int32_t topDiff = dstMask.fBounds.fTop - srcMask.fBounds.fTop;
+        srcMask.fImage += srcMask.fRowBytes * topDiff;
+        srcMask.fBounds.fTop = dstMask.fBounds.fTop;
+    }
+    if (dstMask.fBounds.fTop < srcMask.fBounds.fTop) {
+        int32_t topDiff = srcMask.fBounds.fTop - dstMask.fBounds.fTop;
+        dstMask.fImage += dstMask.fRowBytes * topDiff;
+        dstMask.fBounds.fTop = srcMask.fBounds.fTop;
+    }
+
+    if (srcMask.fBounds.fLeft < dstMask.fBounds.fLeft) {
+        int32_t leftDiff = dstMask.fBounds.fLeft - srcMask.fBounds.fLeft;
+        srcMask.fImage += leftDiff;
+        srcMask.fBounds.fLeft = dstMask.fBounds.fLeft;
+    }
+    if (dstMask.fBounds.fLeft < srcMask.fBounds.fLeft) {
+        int32_t leftDiff = srcMask.fBounds.fLeft - dstMask.fBounds.fLeft;
+        dstMask.fImage += leftDiff;
+        dstMask.fBounds.fLeft = srcMask.fBounds.fLeft;
+    }
+
+    if (srcMask.fBounds.fBottom < dstMask.fBounds.fBottom) {
+        dstMask.fBounds.fBottom = srcMask.fBounds.fBottom;
+    }
+    if (dstMask.fBounds.fBottom < srcMask.fBounds.fBottom) {
+        srcMask.fBounds.fBottom = dstMask.fBounds.fBottom;
+    }
+
+    if (srcMask.fBounds.fRight < dstMask.fBounds.fRight) {
+        dstMask.fBounds.fRight = srcMask.fBounds.fRight;
+    }
+    if (dstMask.fBounds.fRight < srcMask.fBounds.fRight) {
+        srcMask.fBounds.fRight = dstMask.fBounds.fRight;
+    }
+
+    SkASSERT(srcMask.fBounds == dstMask.fBounds);
+    int width = srcMask.fBounds.width();
+    int height = srcMask.fBounds.height();
+    int dstRB = dstMask.fRowBytes;
+    int srcRB = srcMask.fRowBytes;
+
+    const uint8_t* src = srcMask.fImage;
+    uint8_t* dst = dstMask.fImage;
+
+    if (SkMask::k3D_Format == srcMask.fFormat) {
+        // we have to copy 3 times as much
+        height *= 3;
+    }
+
+    // If not filling the full original glyph, clear it out first.
+    if (dstMask.fBounds != origBounds) {
+        sk_bzero(origGlyph.mask().fImage, origGlyph.imageSize());
+    }
+
+    while (--height >= 0) {
+        memcpy(dst, src, width);
+        src += srcRB;
+        dst += dstRB;
+    }
+}
+
+void SkScalerContext::generateUnfilteredImage(const SkGlyph& origGlyph,
+                                              const SkGlyph& unfilteredGlyph) {
+    if (!fGenerateImageFromPath) {
+        generateImage(unfilteredGlyph);
+    } else {
+        SkASSERT(origGlyph.setPathHasBeenCalled());
+        const SkPath* devPath = origGlyph.path();
+
+        if (!devPath) {
+            generateImage(unfilteredGlyph);
+        } else {
+            SkMask mask = unfilteredGlyph.mask();
+            SkASSERT(SkMask::kARGB32_Format != origGlyph.fMaskFormat);
+            SkASSERT(SkMask::kARGB32_Format != mask.fFormat);
+            const bool doBGR = SkToBool(fRec.fFlags & SkScalerContext::kLCD_BGROrder_Flag);
+            const bool doVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
+            const bool a8LCD = SkToBool(fRec.fFlags & SkScalerContext::kGenA8FromLCD_Flag);
+            const bool hairline = origGlyph.pathIsHairline();
+            GenerateImageFromPath(mask, *devPath, fPreBlend, doBGR, doVert, a8LCD, hairline);
+        }
+    }
+}
+
 void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     SkASSERT(origGlyph.fAdvancesBoundsFormatAndInitialPathDone);
 
@@ -583,25 +677,7 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
         unfilteredGlyph = &tmpGlyph;
     }
 
-    if (!fGenerateImageFromPath) {
-        generateImage(*unfilteredGlyph);
-    } else {
-        SkASSERT(origGlyph.setPathHasBeenCalled());
-        const SkPath* devPath = origGlyph.path();
-
-        if (!devPath) {
-            generateImage(*unfilteredGlyph);
-        } else {
-            SkMask mask = unfilteredGlyph->mask();
-            SkASSERT(SkMask::kARGB32_Format != origGlyph.fMaskFormat);
-            SkASSERT(SkMask::kARGB32_Format != mask.fFormat);
-            const bool doBGR = SkToBool(fRec.fFlags & SkScalerContext::kLCD_BGROrder_Flag);
-            const bool doVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
-            const bool a8LCD = SkToBool(fRec.fFlags & SkScalerContext::kGenA8FromLCD_Flag);
-            const bool hairline = origGlyph.pathIsHairline();
-            GenerateImageFromPath(mask, *devPath, fPreBlend, doBGR, doVert, a8LCD, hairline);
-        }
-    }
+    this->generateUnfilteredImage(origGlyph, *unfilteredGlyph);
 
     if (fMaskFilter) {
         // k3D_Format should not be mask filtered.
@@ -630,74 +706,61 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
             memcpy(srcMask.fImage, unfilteredGlyph->fImage, imageSize);
         }
 
-        SkASSERT_RELEASE(srcMask.fFormat == origGlyph.fMaskFormat);
-        SkMask dstMask = origGlyph.mask();
-        SkIRect origBounds = dstMask.fBounds;
-
-        // Find the intersection of src and dst while updating the fImages.
-        if (srcMask.fBounds.fTop < dstMask.fBounds.fTop) {
-            int32_t topDiff = dstMask.fBounds.fTop - srcMask.fBounds.fTop;
-            srcMask.fImage += srcMask.fRowBytes * topDiff;
-            srcMask.fBounds.fTop = dstMask.fBounds.fTop;
-        }
-        if (dstMask.fBounds.fTop < srcMask.fBounds.fTop) {
-            int32_t topDiff = srcMask.fBounds.fTop - dstMask.fBounds.fTop;
-            dstMask.fImage += dstMask.fRowBytes * topDiff;
-            dstMask.fBounds.fTop = srcMask.fBounds.fTop;
-        }
+        copy_filtered_mask(srcMask, origGlyph);
+        SkMask::FreeImage(filteredMask.fImage);
+    }
+}
 
-        if (srcMask.fBounds.fLeft < dstMask.fBounds.fLeft) {
-            int32_t leftDiff = dstMask.fBounds.fLeft - srcMask.fBounds.fLeft;
-            srcMask.fImage += leftDiff;
-            srcMask.fBounds.fLeft = dstMask.fBounds.fLeft;
-        }
-        if (dstMask.fBounds.fLeft < srcMask.fBounds.fLeft) {
-            int32_t leftDiff = srcMask.fBounds.fLeft - dstMask.fBounds.fLeft;
-            dstMask.fImage += leftDiff;
-            dstMask.fBounds.fLeft = srcMask.fBounds.fLeft;
+#if !defined(SK_DISABLE_SDF_TEXT)
+void SkScalerContext::getDistanceFieldImages(SkSpan<const SkGlyph> glyphs, SkExecutor* executor) {
+    SkASSERT(fMaskFilter);
+
+    SkArenaAlloc alloc{4096};
+    std::vector<const SkGlyph*> targets;
+    std::vector<SkMask> fields;
+    std::vector<SkDistanceFieldJob> jobs;
+    for (const SkGlyph& glyph : glyphs) {
+        SkASSERT(glyph.fAdvancesBoundsFormatAndInitialPathDone);
+        if (SkMask::kSDF_Format != glyph.fMaskFormat) {
+            // Empty glyphs keep the format they had before the mask filter.
+            this->getImage(glyph);
+            continue;
         }
 
-        if (srcMask.fBounds.fBottom < dstMask.fBounds.fBottom) {
-            dstMask.fBounds.fBottom = srcMask.fBounds.fBottom;
-        }
-        if (dstMask.fBounds.fBottom < srcMask.fBounds.fBottom) {
-            srcMask.fBounds.fBottom = dstMask.fBounds.fBottom;
-        }
+        // need the original bounds, sans our maskfilter
+        sk_sp<SkMaskFilter> mf = std::move(fMaskFilter);
+        SkGlyph unfiltered = this->makeGlyph(glyph.getPackedID(), &alloc);
+        fMaskFilter = std::move(mf);
 
-        if (srcMask.fBounds.fRight < dstMask.fBounds.fRight) {
-            dstMask.fBounds.fRight = srcMask.fBounds.fRight;
+        // This is the distance field mask filter's destination, less the image.
+        SkMask field = SkMask::PrepareDestination(SK_DistanceFieldPad, SK_DistanceFieldPad,
+                                                  unfiltered.mask());
+        SkMask::Format format = unfiltered.fMaskFormat;
+        if (unfiltered.isEmpty() || field.fBounds.isEmpty() ||
+            (format != SkMask::kA8_Format && format != SkMask::kBW_Format &&
+             format != SkMask::kLCD16_Format)) {
+            // Leave the odd glyph to the mask filter.
+            this->getImage(glyph);
+            continue;
         }
-        if (dstMask.fBounds.fRight < srcMask.fBounds.fRight) {
-            srcMask.fBounds.fRight = dstMask.fBounds.fRight;
-        }
-
-        SkASSERT(srcMask.fBounds == dstMask.fBounds);
-        int width = srcMask.fBounds.width();
-        int height = srcMask.fBounds.height();
-        int dstRB = dstMask.fRowBytes;
-        int srcRB = srcMask.fRowBytes;
+        field.fFormat = SkMask::kSDF_Format;
+        field.fImage = alloc.makeArrayDefault<uint8_t>(field.computeImageSize());
 
-        const uint8_t* src = srcMask.fImage;
-        uint8_t* dst = dstMask.fImage;
+        unfiltered.fImage = alloc.makeBytesAlignedTo(unfiltered.imageSize(),
+                                                     alignof(uint32_t));
+        this->generateUnfilteredImage(glyph, unfiltered);
 
-        if (SkMask::k3D_Format == filteredMask.fFormat) {
-            // we have to copy 3 times as much
-            height *= 3;
-        }
-
-        // If not filling the full original glyph, clear it out first.
-        if (dstMask.fBounds != origBounds) {
-            sk_bzero(origGlyph.fImage, origGlyph.fHeight * origGlyph.rowBytes());
-        }
+        targets.push_back(&glyph);
+        fields.push_back(field);
+        jobs.push_back({field.fImage, unfiltered.mask()});
+    }
 
-        while (--height >= 0) {
-            memcpy(dst, src, width);
-            src += srcRB;
-            dst += dstRB;
-        }
-        SkMask::FreeImage(filteredMask.fImage);
+    SkAssertResult(SkGenerateDistanceFields(jobs, executor));
+    for (size_t i = 0; i < targets.size(); ++i) {
+        copy_filtered_mask(fields[i], *targets[i]);
     }
 }
+#endif
 
 void SkScalerContext::getPath(SkGlyph& glyph, SkArenaAlloc* alloc) {
     this->internalGetPath(glyph, alloc);
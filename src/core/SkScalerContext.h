@@ -15,6 +15,7 @@
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkMacros.h"
 #include "src/core/SkGlyph.h"
@@ -25,6 +26,7 @@
 
 class SkAutoDescriptor;
 class SkDescriptor;
+class SkExecutor;
 class SkMaskFilter;
 class SkPathEffect;
 class SkScalerContext;
@@ -288,6 +290,11 @@ public:
 
     SkGlyph     makeGlyph(SkPackedGlyphID, SkArenaAlloc*);
     void        getImage(const SkGlyph&);
+#if !defined(SK_DISABLE_SDF_TEXT)
+    // Like getImage() for each of glyphs. The kSDF_Format glyphs are rasterized one at a time, then
+    // all of their distance fields are generated at once, in parallel on executor if it is not null.
+    void        getDistanceFieldImages(SkSpan<const SkGlyph> glyphs, SkExecutor* executor);
+#endif
     void        getPath(SkGlyph&, SkArenaAlloc*);
     sk_sp<SkDrawable> getDrawable(SkGlyph&);
     void        getFontMetrics(SkFontMetrics*);
@@ -433,6 +440,9 @@ private:
     // calling generateImage.
     bool fGenerateImageFromPath;
 
+    // Rasterizes origGlyph, ignoring the mask filter, into unfilteredGlyph's image.
+    void generateUnfilteredImage(const SkGlyph& origGlyph, const SkGlyph& unfilteredGlyph);
+
     void internalGetPath(SkGlyph&, SkArenaAlloc*);
     SkGlyph internalMakeGlyph(SkPackedGlyphID, SkMask::Format, SkArenaAlloc*);
 
@@ -8,6 +8,7 @@
 #include "src/core/SkStrike.h"
 
 #include "include/core/SkDrawable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkTraceMemoryDump.h"
@@ -16,10 +17,16 @@
 #include "src/core/SkEnumerate.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkGlyphBuffer.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
+#include <vector>
+
 #if defined(SK_GANESH)
     #include "src/text/gpu/StrikeCache.h"
 #endif
@@ -146,17 +153,83 @@ SkSpan<const SkGlyph*> SkStrike::preparePaths(
 
 SkSpan<const SkGlyph*> SkStrike::prepareImages(
         SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
+    SkExecutor* executor = fStrikeCache->getRasterExecutor();
     const SkGlyph** cursor = results;
-    Monitor m{this};
-    for (auto glyphID : glyphIDs) {
-        SkGlyph* glyph = this->glyph(glyphID);
-        this->prepareForImage(glyph);
-        *cursor++ = glyph;
+
+    // The glyphs whose images are missing, and copies of them to rasterize.
+    std::vector<SkGlyph*> targets;
+    std::vector<SkGlyph> missing;
+    {
+        Monitor m{this};
+        SkTHashSet<const SkGlyph*> seen;
+        for (auto glyphID : glyphIDs) {
+            SkGlyph* glyph = this->glyph(glyphID);
+            if (!glyph->setImageHasBeenCalled() && !seen.contains(glyph)) {
+                seen.add(glyph);
+                targets.push_back(glyph);
+            }
+            *cursor++ = glyph;
+        }
+
+        if (executor == nullptr || targets.size() < 2 * kMinGlyphsPerRasterTask) {
+            for (SkGlyph* glyph : targets) {
+                this->prepareForImage(glyph);
+            }
+            return {results, glyphIDs.size()};
+        }
+        for (SkGlyph* glyph : targets) {
+            missing.push_back(*glyph);
+        }
+    }
+
+    // Rasterize the copies without holding the strike lock. Waiting for the executor may run
+    // other work on this thread, and that work may need this strike.
+    SkArenaAlloc scratch{kMinAllocAmount};
+    for (SkGlyph& glyph : missing) {
+        glyph.allocImage(&scratch);
+    }
+#if !defined(SK_DISABLE_SDF_TEXT)
+    auto isSDF = [](const SkGlyph& glyph) { return SkMask::kSDF_Format == glyph.maskFormat(); };
+    if (std::any_of(missing.begin(), missing.end(), isSDF)) {
+        // Generating the distance fields takes much longer than rasterizing the glyphs, so
+        // rasterize them with one context and generate all of their fields on the executor.
+        fStrikeSpec.createScalerContext()->getDistanceFieldImages(missing, executor);
+    } else {
+        this->rasterizeImages(missing, executor);
     }
+#else
+    this->rasterizeImages(missing, executor);
+#endif
 
+    // Publish the images all at once. Another thread may have made some of them meanwhile.
+    Monitor m{this};
+    for (size_t i = 0; i < missing.size(); ++i) {
+        if (targets[i]->setImage(&fAlloc, missing[i].image())) {
+            fMemoryIncrease += targets[i]->imageSize();
+        }
+    }
     return {results, glyphIDs.size()};
 }
 
+void SkStrike::rasterizeImages(SkSpan<SkGlyph> glyphs, SkExecutor* executor) const {
+    // Scaler contexts are not thread safe (FreeType faces in particular), and the strike's own is
+    // guarded by the strike lock, so each task makes its own.
+    const int taskCount = std::min(SkToInt(glyphs.size() / kMinGlyphsPerRasterTask),
+                                   kMaxRasterTasks);
+    auto rasterize = [this, glyphs, taskCount](int task) {
+        std::unique_ptr<SkScalerContext> context = fStrikeSpec.createScalerContext();
+        for (size_t i = task; i < glyphs.size(); i += taskCount) {
+            context->getImage(glyphs[i]);
+        }
+    };
+    SkTaskGroup group{*executor};
+    for (int task = 1; task < taskCount; ++task) {
+        group.add([&rasterize, task] { rasterize(task); });
+    }
+    rasterize(0);
+    group.wait();
+}
+
 SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
     const SkGlyph** cursor = results;
@@ -191,6 +264,68 @@ void SkStrike::glyphIDsToDrawables(SkSpan<sktext::IDOrDrawable> idsOrDrawables)
     }
 }
 
+void SkStrike::flattenGlyphs(SkWriteBuffer& buffer) const {
+    SkAutoMutexExclusive lock{fStrikeLock};
+    SkSTArray<32, const SkGlyph*> glyphs;
+    for (const SkGlyph* glyph : fGlyphForIndex) {
+        if (glyph->isEmpty() || (glyph->setImageHasBeenCalled() && glyph->image() != nullptr)) {
+            glyphs.push_back(glyph);
+        }
+    }
+
+    buffer.writeUInt(glyphs.size());
+    for (const SkGlyph* glyph : glyphs) {
+        glyph->flattenMetrics(buffer);
+        const bool hasImage = !glyph->isEmpty();
+        buffer.writeBool(hasImage);
+        if (hasImage) {
+            glyph->flattenImage(buffer);
+        }
+        const bool hasPath = glyph->setPathHasBeenCalled() && glyph->path() != nullptr;
+        buffer.writeBool(hasPath);
+        if (hasPath) {
+            buffer.writePath(*glyph->path());
+            buffer.writeBool(glyph->pathIsHairline());
+        }
+    }
+}
+
+bool SkStrike::mergeGlyphsFromBuffer(SkReadBuffer& buffer) {
+    Monitor m{this};
+    const uint32_t glyphCount = buffer.readUInt();
+    for (uint32_t i = 0; i < glyphCount && buffer.isValid(); ++i) {
+        std::optional<SkGlyph> prototype = SkGlyph::MakeFromBuffer(buffer);
+        if (!prototype) {
+            return false;
+        }
+
+        SkGlyph* glyph = nullptr;
+        if (fDigestForPackedGlyphID.find(prototype->getPackedID()) == nullptr) {
+            glyph = fAlloc.make<SkGlyph>(*prototype);
+            fMemoryIncrease += sizeof(SkGlyph);
+            (void)this->addGlyphAndDigest(glyph);
+        }
+
+        if (buffer.readBool()) {
+            if (glyph != nullptr) {
+                fMemoryIncrease += glyph->addImageFromBuffer(buffer, &fAlloc);
+            } else {
+                buffer.skip(SkAlign4(prototype->imageSize()));
+            }
+        }
+
+        if (buffer.readBool()) {
+            SkPath path;
+            buffer.readPath(&path);
+            const bool hairline = buffer.readBool();
+            if (glyph != nullptr && buffer.isValid() && glyph->setPath(&fAlloc, &path, hairline)) {
+                fMemoryIncrease += glyph->path()->approximateBytesUsed();
+            }
+        }
+    }
+    return buffer.isValid();
+}
+
 void SkStrike::dump() const {
     SkAutoMutexExclusive lock{fStrikeLock};
     const SkTypeface* face = fScalerContext->getTypeface();
@@ -21,9 +21,12 @@
 
 #include <memory>
 
+class SkExecutor;
+class SkReadBuffer;
 class SkScalerContext;
 class SkStrikeCache;
 class SkTraceMemoryDump;
+class SkWriteBuffer;
 
 namespace sktext {
 union IDOrPath;
@@ -119,6 +122,14 @@ public:
         }
     }
 
+    // Write the glyphs that have an image (or are empty) along with their paths, for the
+    // persistent glyph cache. Glyphs that only have metrics are cheap to recreate, and are skipped.
+    void flattenGlyphs(SkWriteBuffer& buffer) const SK_EXCLUDES(fStrikeLock);
+
+    // Add the glyphs written by flattenGlyphs. Glyphs, images and paths that are already in the
+    // strike are kept. Return false if the buffer is malformed.
+    bool mergeGlyphsFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+
     void dump() const SK_EXCLUDES(fStrikeLock);
     void dumpMemoryStatistics(SkTraceMemoryDump* dump) const SK_EXCLUDES(fStrikeLock);
 
@@ -143,6 +154,11 @@ private:
         kMetricsAndPath
     };
 
+    // Rasterize the images of glyphs, which have already been allocated, spreading the work over
+    // several tasks on executor. The glyphs are copies, so this runs without the strike lock.
+    void rasterizeImages(SkSpan<SkGlyph> glyphs, SkExecutor* executor) const
+            SK_EXCLUDES(fStrikeLock);
+
     // internalPrepare will only be called with a mutex already held.
     SkSpan<const SkGlyph*> internalPrepare(
             SkSpan<const SkGlyphID> glyphIDs,
@@ -180,6 +196,10 @@ private:
     inline static constexpr size_t kMinGlyphImageSize = 16 /* height */ * 8 /* width */;
     inline static constexpr size_t kMinAllocAmount = kMinGlyphImageSize * kMinGlyphCount;
 
+    // Each raster task needs its own scaler context, so make sure it has enough work to pay for it.
+    inline static constexpr size_t kMinGlyphsPerRasterTask = 8;
+    inline static constexpr int kMaxRasterTasks = 8;
+
     SkArenaAlloc            fAlloc SK_GUARDED_BY(fStrikeLock) {kMinAllocAmount};
 
     // The following are protected by the SkStrikeCache's mutex.
@@ -9,14 +9,24 @@
 
 #include <cctype>
 
+#include "include/core/SkData.h"
+#include "include/core/SkFontMetrics.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/core/SkGlyphBuffer.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
 
 #if defined(SK_GANESH)
 #include "src/text/gpu/StrikeCache.h"
@@ -187,6 +197,138 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
     return prevCount;
 }
 
+// Bump the version whenever the layout of the serialized strikes, glyphs, descriptors or
+// SkScalerContextRec changes.
+static constexpr uint32_t kSerializedStrikesMagic = SkSetFourByteTag('s', 'k', 's', 'c');
+static constexpr uint32_t kSerializedStrikesVersion = 1;
+
+// A typeface found by family and style in a later process may still be a different font file.
+// The 'head' table holds the font revision and the checksum of the whole font, so use it along
+// with the glyph count to make sure the glyphs still apply.
+static sk_sp<SkData> typeface_fingerprint(const SkTypeface& typeface) {
+    static constexpr SkFontTableTag kHeadTag = SkSetFourByteTag('h', 'e', 'a', 'd');
+    const size_t headSize = typeface.getTableSize(kHeadTag);
+    sk_sp<SkData> fingerprint = SkData::MakeUninitialized(sizeof(int) + headSize);
+    auto data = static_cast<char*>(fingerprint->writable_data());
+    const int glyphCount = typeface.countGlyphs();
+    memcpy(data, &glyphCount, sizeof(int));
+    if (headSize != typeface.getTableData(kHeadTag, 0, headSize, data + sizeof(int))) {
+        return nullptr;
+    }
+    return fingerprint;
+}
+
+sk_sp<SkData> SkStrikeCache::serializeStrikes(size_t maxBytes) const {
+    SkBinaryWriteBuffer buffer;
+    buffer.writeUInt(kSerializedStrikesMagic);
+    buffer.writeUInt(kSerializedStrikesVersion);
+
+    this->forEachStrike([&](const SkStrike& strike) {
+        const SkDescriptor& descriptor = strike.getDescriptor();
+        const SkTypeface& typeface = strike.strikeSpec().typeface();
+        if (buffer.bytesWritten() >= maxBytes) {
+            return;
+        }
+        // The effects can not be recreated from the descriptor alone.
+        if (descriptor.findEntry(kEffects_SkDescriptorTag, nullptr) != nullptr) {
+            return;
+        }
+        sk_sp<SkData> fingerprint = typeface_fingerprint(typeface);
+        if (fingerprint == nullptr) {
+            return;
+        }
+
+        SkBinaryWriteBuffer glyphs;
+        strike.flattenGlyphs(glyphs);
+
+        buffer.writeBool(true);
+        buffer.writeDataAsByteArray(
+                typeface.serialize(SkTypeface::SerializeBehavior::kDontIncludeData).get());
+        buffer.writeDataAsByteArray(fingerprint.get());
+        descriptor.flatten(buffer);
+        buffer.writeByteArray(&strike.getFontMetrics(), sizeof(SkFontMetrics));
+        // Write the size of the glyphs first, so the reader can skip them without copying.
+        buffer.writeUInt(SkToU32(glyphs.bytesWritten()));
+        buffer.writePad32(glyphs.snapshotAsData()->data(), glyphs.bytesWritten());
+    });
+    buffer.writeBool(false);
+
+    return buffer.snapshotAsData();
+}
+
+int SkStrikeCache::prepopulate(const void* data, size_t size) {
+    SkReadBuffer buffer{data, size};
+    if (!buffer.validate(buffer.readUInt() == kSerializedStrikesMagic &&
+                         buffer.readUInt() == kSerializedStrikesVersion)) {
+        return -1;
+    }
+
+    // Several strikes usually share a typeface, so only look each of them up once.
+    std::vector<std::pair<sk_sp<SkData>, sk_sp<SkTypeface>>> typefaces;
+    auto findTypeface = [&](sk_sp<SkData> typefaceData, const SkData& fingerprint) {
+        for (const auto& [knownData, knownTypeface] : typefaces) {
+            if (knownData->equals(typefaceData.get())) {
+                return knownTypeface;
+            }
+        }
+        SkMemoryStream stream{typefaceData};
+        sk_sp<SkTypeface> typeface = SkTypeface::MakeDeserialize(&stream);
+        if (typeface != nullptr) {
+            sk_sp<SkData> localFingerprint = typeface_fingerprint(*typeface);
+            if (localFingerprint == nullptr || !localFingerprint->equals(&fingerprint)) {
+                typeface = nullptr;
+            }
+        }
+        typefaces.emplace_back(std::move(typefaceData), typeface);
+        return typeface;
+    };
+
+    int strikeCount = 0;
+    while (buffer.readBool()) {
+        sk_sp<SkData> typefaceData = buffer.readByteArrayAsData();
+        sk_sp<SkData> fingerprint = buffer.readByteArrayAsData();
+        std::optional<SkAutoDescriptor> descriptor = SkAutoDescriptor::MakeFromBuffer(buffer);
+        SkFontMetrics metrics;
+        buffer.readByteArray(&metrics, sizeof(SkFontMetrics));
+        const uint32_t glyphsSize = buffer.readUInt();
+        const void* glyphsData = buffer.skip(SkAlign4(glyphsSize));
+        if (!buffer.isValid() || !descriptor || typefaceData == nullptr || fingerprint == nullptr) {
+            return -1;
+        }
+
+        sk_sp<SkTypeface> typeface = findTypeface(std::move(typefaceData), *fingerprint);
+        if (typeface == nullptr) {
+            continue;
+        }
+
+        // Rewrite the typefaceID in the rec for this process.
+        SkDescriptor* desc = descriptor->getDesc();
+        uint32_t recSize;
+        void* recPtr = const_cast<void*>(desc->findEntry(kRec_SkDescriptorTag, &recSize));
+        if (recPtr == nullptr || recSize != sizeof(SkScalerContextRec)) {
+            return -1;
+        }
+        SkScalerContextRec rec;
+        memcpy((void*)&rec, recPtr, recSize);
+        rec.fTypefaceID = typeface->uniqueID();
+        memcpy(recPtr, &rec, recSize);
+        desc->computeChecksum();
+
+        sk_sp<SkStrike> strike = this->findStrike(*desc);
+        if (strike == nullptr) {
+            strike = this->createStrike(SkStrikeSpec{*desc, std::move(typeface)}, &metrics);
+        }
+
+        SkReadBuffer glyphs{glyphsData, glyphsSize};
+        if (!strike->mergeGlyphsFromBuffer(glyphs)) {
+            return -1;
+        }
+        strikeCount += 1;
+    }
+
+    return buffer.isValid() ? strikeCount : -1;
+}
+
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
     SkAutoMutexExclusive ac(fLock);
 
@@ -16,6 +16,10 @@
 #include "src/core/SkStrikeSpec.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <atomic>
+
+class SkData;
+class SkExecutor;
 class SkStrike;
 class SkStrikePinner;
 class SkTraceMemoryDump;
@@ -59,6 +63,16 @@ public:
 
     void purgeAll() SK_EXCLUDES(fLock); // does not change budget
 
+    // Write the most recently used strikes, with the metrics, images and paths of their glyphs,
+    // stopping once about maxBytes have been written. A later process can pre-populate its cache
+    // from the data with prepopulate().
+    sk_sp<SkData> serializeStrikes(size_t maxBytes) const SK_EXCLUDES(fLock);
+
+    // Add the strikes written by serializeStrikes(). Strikes whose typeface is not available, or
+    // no longer matches the one the data was written with, are skipped. Return the number of
+    // strikes added to, or -1 if the data is malformed or was written by a different version.
+    int prepopulate(const void* data, size_t size) SK_EXCLUDES(fLock);
+
     int getCacheCountLimit() const SK_EXCLUDES(fLock);
     int setCacheCountLimit(int limit) SK_EXCLUDES(fLock);
     int getCacheCountUsed() const SK_EXCLUDES(fLock);
@@ -67,6 +81,15 @@ public:
     size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
     size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
 
+    // When set, strikes rasterize the missing images of a batch of glyphs in parallel on this
+    // executor. It is not owned, and must outlive its use by the cache. nullptr (the default)
+    // rasterizes on the calling thread. Strikes do not hold their lock while waiting on the
+    // executor, so it may be shared with work that uses the same strikes.
+    SkExecutor* getRasterExecutor() const { return fRasterExecutor.load(); }
+    SkExecutor* setRasterExecutor(SkExecutor* executor) {
+        return fRasterExecutor.exchange(executor);
+    }
+
 private:
     friend class SkStrike;  // for SkStrike::updateDelta
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
@@ -103,6 +126,9 @@ private:
     size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
     int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
+
+    // Read by strikes while holding their own lock, so it does not use fLock.
+    std::atomic<SkExecutor*> fRasterExecutor{nullptr};
 };
 
 #endif  // SkStrikeCache_DEFINED
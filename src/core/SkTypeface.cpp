@@ -13,6 +13,7 @@
 #include "include/private/base/SkOnce.h"
 #include "include/utils/SkCustomTypeface.h"
 #include "src/base/SkUTF.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkEndian.h"
 #include "src/core/SkFontDescriptor.h"
@@ -405,7 +406,21 @@ public:
                 uni = fStorage.reset(byteLength);
                 const char* ptr = (const char*)text;
                 const char* end = ptr + byteLength;
-                for (int i = 0; ptr < end; ++i) {
+                int i = 0;
+                // Widen 16 bytes at a time while they are all ASCII, which is the common case.
+                while (end - ptr >= 16) {
+                    auto bytes = skvx::byte16::Load(ptr);
+                    if (!skvx::any(bytes >= 0x80)) {
+                        skvx::cast<SkUnichar>(bytes).store(&fStorage[i]);
+                        ptr += 16;
+                        i += 16;
+                    } else {
+                        for (const char* stop = ptr + 16; ptr < stop; ++i) {
+                            fStorage[i] = SkUTF::NextUTF8(&ptr, end);
+                        }
+                    }
+                }
+                for (; ptr < end; ++i) {
                     fStorage[i] = SkUTF::NextUTF8(&ptr, end);
                 }
             } break;
@@ -413,7 +428,21 @@ public:
                 uni = fStorage.reset(byteLength);
                 const uint16_t* ptr = (const uint16_t*)text;
                 const uint16_t* end = ptr + (byteLength >> 1);
-                for (int i = 0; ptr < end; ++i) {
+                int i = 0;
+                // Widen 8 units at a time while none of them is a surrogate.
+                while (end - ptr >= 8) {
+                    auto units = skvx::Vec<8, uint16_t>::Load(ptr);
+                    if (!skvx::any((units & 0xF800) == 0xD800)) {
+                        skvx::cast<SkUnichar>(units).store(&fStorage[i]);
+                        ptr += 8;
+                        i += 8;
+                    } else {
+                        for (const uint16_t* stop = ptr + 8; ptr < stop; ++i) {
+                            fStorage[i] = SkUTF::NextUTF16(&ptr, end);
+                        }
+                    }
+                }
+                for (; ptr < end; ++i) {
                     fStorage[i] = SkUTF::NextUTF16(&ptr, end);
                 }
             } break;
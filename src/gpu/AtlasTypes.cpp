@@ -13,7 +13,8 @@
 namespace skgpu {
 
 Plot::Plot(int pageIndex, int plotIndex, AtlasGenerationCounter* generationCounter,
-           int offX, int offY, int width, int height, SkColorType colorType, size_t bpp)
+           int offX, int offY, int width, int height, SkColorType colorType, size_t bpp,
+           PlotRectanizer rectanizer)
         : fLastUpload(AtlasToken::InvalidToken())
         , fLastUse(AtlasToken::InvalidToken())
         , fFlushesSinceLastUse(0)
@@ -27,7 +28,7 @@ Plot::Plot(int pageIndex, int plotIndex, AtlasGenerationCounter* generationCount
         , fHeight(height)
         , fX(offX)
         , fY(offY)
-        , fRectanizer(width, height)
+        , fRectanizer(std::in_place_type<RectanizerSkyline>, width, height)
         , fOffset(SkIPoint16::Make(fX * fWidth, fY * fHeight))
         , fColorType(colorType)
         , fBytesPerPixel(bpp)
@@ -39,6 +40,9 @@ Plot::Plot(int pageIndex, int plotIndex, AtlasGenerationCounter* generationCount
     SkASSERT(((width*fBytesPerPixel) & 0x3) == 0);
     // The padding for faster uploads only works for 1, 2 and 4 byte texels
     SkASSERT(fBytesPerPixel != 3 && fBytesPerPixel <= 4);
+    if (rectanizer == PlotRectanizer::kMaxRects) {
+        fRectanizer.emplace<RectanizerMaxRects>(width, height);
+    }
     fDirtyRect.setEmpty();
     fCachedRect.setEmpty();
 }
@@ -51,7 +55,8 @@ bool Plot::addSubImage(int width, int height, const void* image, AtlasLocator* a
     SkASSERT(width <= fWidth && height <= fHeight);
 
     SkIPoint16 loc;
-    if (!fRectanizer.addRect(width, height, &loc)) {
+    if (!std::visit([&](auto& rectanizer) { return rectanizer.addRect(width, height, &loc); },
+                    fRectanizer)) {
         return false;
     }
 
@@ -132,7 +137,7 @@ std::pair<const void*, SkIRect> Plot::prepareForUpload(bool useCachedUploads) {
 }
 
 void Plot::resetRects() {
-    fRectanizer.reset();
+    std::visit([](auto& rectanizer) { rectanizer.reset(); }, fRectanizer);
     fGenID = fGenerationCounter->next();
     fPlotLocator = PlotLocator(fPageIndex, fPlotIndex, fGenID);
     fLastUpload = AtlasToken::InvalidToken();
@@ -9,6 +9,7 @@
 #define skgpu_AtlasTypes_DEFINED
 
 #include <array>
+#include <variant>
 
 #include "include/core/SkColorType.h"
 #include "include/core/SkRect.h"
@@ -18,6 +19,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkTInternalLList.h"
 #include "src/core/SkIPoint16.h"
+#include "src/gpu/RectanizerMaxRects.h"
 #include "src/gpu/RectanizerSkyline.h"
 
 class GrOpFlushState;
@@ -423,6 +425,15 @@ private:
     uint32_t fPlotAlreadyUpdated[skgpu::PlotLocator::kMaxMultitexturePages];
 };
 
+/**
+ * How a Plot places its subimages. kMaxRects packs mixed sizes more tightly than kSkyline, so
+ * plots fill up and are evicted less often, but each insert is slower.
+ */
+enum class PlotRectanizer {
+    kSkyline,
+    kMaxRects,
+};
+
 /**
  * The backing texture for an atlas is broken into a spatial grid of Plots. The Plots
  * keep track of subimage placement via their Rectanizer. A Plot may be subclassed if
@@ -433,7 +444,8 @@ class Plot : public SkRefCnt {
 
 public:
     Plot(int pageIndex, int plotIndex, AtlasGenerationCounter* generationCounter,
-         int offX, int offY, int width, int height, SkColorType colorType, size_t bpp);
+         int offX, int offY, int width, int height, SkColorType colorType, size_t bpp,
+         PlotRectanizer rectanizer = PlotRectanizer::kSkyline);
 
     uint32_t pageIndex() const { return fPageIndex; }
 
@@ -452,6 +464,12 @@ public:
 
     bool addSubImage(int width, int height, const void* image, AtlasLocator* atlasLocator);
 
+    // The fraction of the plot's area that its subimages cover.
+    float percentFull() const {
+        return std::visit([](const auto& rectanizer) { return rectanizer.percentFull(); },
+                          fRectanizer);
+    }
+
     /**
      * To manage the lifetime of a plot, we use two tokens. We use the last upload token to
      * know when we can 'piggy back' uploads, i.e. if the last upload hasn't been flushed to
@@ -479,7 +497,9 @@ public:
     sk_sp<Plot> clone() const {
         return sk_sp<Plot>(new Plot(
             fPageIndex, fPlotIndex, fGenerationCounter, fX, fY, fWidth, fHeight, fColorType,
-            fBytesPerPixel));
+            fBytesPerPixel,
+            std::holds_alternative<RectanizerMaxRects>(fRectanizer) ? PlotRectanizer::kMaxRects
+                                                                    : PlotRectanizer::kSkyline));
     }
 
 #ifdef SK_DEBUG
@@ -508,7 +528,8 @@ private:
     const int fHeight;
     const int fX;
     const int fY;
-    skgpu::RectanizerSkyline fRectanizer;
+    // The concrete types are final, so calls through the variant aren't virtual.
+    std::variant<skgpu::RectanizerSkyline, skgpu::RectanizerMaxRects> fRectanizer;
     const SkIPoint16 fOffset;  // the offset of the plot in the backing texture
     const SkColorType fColorType;
     const size_t fBytesPerPixel;
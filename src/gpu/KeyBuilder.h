@@ -10,6 +10,7 @@
 
 #include "include/core/SkString.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
 
 namespace skgpu {
 
@@ -55,8 +56,50 @@ public:
         this->addBits(32, v, label);
     }
 
+    // Appends 'numBits' bits that another KeyBuilder packed into 'data', starting with the low bit
+    // of data[0]. The key is the same as if the calls that wrote them had been made here instead.
+    void addBitString(const uint32_t* data, uint32_t numBits, std::string_view label) {
+        for (; numBits >= 32; numBits -= 32) {
+            this->addBits(32, *data++, label);
+        }
+        if (numBits) {
+            this->addBits(numBits, *data, label);
+        }
+    }
+
     virtual void appendComment(const char* comment) {}
 
+    // The number of bits added so far.
+    uint32_t bitCount() const { return SkToU32(fData->size()) * 32 + fBitsUsed; }
+
+    // Copies the bits added since 'startBit' (an earlier bitCount()) into 'out', packed as
+    // addBitString() expects them. Returns the number of bits copied.
+    uint32_t copyBitsSince(uint32_t startBit, SkTArray<uint32_t, true>* out) const {
+        SkASSERT(startBit <= this->bitCount());
+        auto word = [this](uint32_t i) -> uint32_t {
+            uint32_t flushedWords = SkToU32(fData->size());
+            if (i < flushedWords) {
+                return (*fData)[i];
+            }
+            // The current word holds the bits that haven't been flushed yet.
+            return i == flushedWords ? fCurValue : 0;
+        };
+        uint32_t numBits = this->bitCount() - startBit;
+        uint32_t shift = startBit % 32;
+        out->clear();
+        for (uint32_t i = startBit / 32, copied = 0; copied < numBits; ++i, copied += 32) {
+            uint32_t bits = word(i) >> shift;
+            if (shift) {
+                bits |= word(i + 1) << (32 - shift);
+            }
+            if (numBits - copied < 32) {
+                bits &= (1u << (numBits - copied)) - 1;
+            }
+            out->push_back(bits);
+        }
+        return numBits;
+    }
+
     // Introduces a word-boundary in the key. Must be called before using the key with any cache,
     // but can also be called to create a break between generic data and backend-specific data.
     void flush() {
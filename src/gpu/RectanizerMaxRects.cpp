@@ -0,0 +1,102 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/RectanizerMaxRects.h"
+
+#include "src/core/SkIPoint16.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace skgpu {
+
+bool RectanizerMaxRects::addRect(int width, int height, SkIPoint16* loc) {
+    if ((unsigned)width > (unsigned)this->width() ||
+        (unsigned)height > (unsigned)this->height()) {
+        return false;
+    }
+
+    int bestShortSide = std::numeric_limits<int>::max();
+    int bestLongSide = std::numeric_limits<int>::max();
+    int bestIndex = -1;
+    for (int i = 0; i < fFreeRects.size(); ++i) {
+        const SkIRect& free = fFreeRects[i];
+        int leftoverX = free.width() - width;
+        int leftoverY = free.height() - height;
+        if (leftoverX < 0 || leftoverY < 0) {
+            continue;
+        }
+        int shortSide = std::min(leftoverX, leftoverY);
+        int longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            bestIndex = i;
+        }
+    }
+
+    if (-1 == bestIndex) {
+        loc->fX = 0;
+        loc->fY = 0;
+        return false;
+    }
+
+    SkIRect used = SkIRect::MakeXYWH(fFreeRects[bestIndex].fLeft, fFreeRects[bestIndex].fTop,
+                                     width, height);
+    this->splitFreeRects(used);
+    this->pruneFreeRects();
+
+    loc->fX = used.fLeft;
+    loc->fY = used.fTop;
+
+    fAreaSoFar += width*height;
+    return true;
+}
+
+void RectanizerMaxRects::splitFreeRects(const SkIRect& used) {
+    // Keep the free rects that miss 'used' at the front and append the pieces of the others.
+    int count = fFreeRects.size();
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        SkIRect free = fFreeRects[i];
+        if (!SkIRect::Intersects(free, used)) {
+            fFreeRects[kept++] = free;
+            continue;
+        }
+        if (used.fLeft > free.fLeft) {
+            fFreeRects.push_back({free.fLeft, free.fTop, used.fLeft, free.fBottom});
+        }
+        if (used.fRight < free.fRight) {
+            fFreeRects.push_back({used.fRight, free.fTop, free.fRight, free.fBottom});
+        }
+        if (used.fTop > free.fTop) {
+            fFreeRects.push_back({free.fLeft, free.fTop, free.fRight, used.fTop});
+        }
+        if (used.fBottom < free.fBottom) {
+            fFreeRects.push_back({free.fLeft, used.fBottom, free.fRight, free.fBottom});
+        }
+    }
+    fFreeRects.remove(kept, count - kept);
+}
+
+void RectanizerMaxRects::pruneFreeRects() {
+    for (int i = 0; i < fFreeRects.size(); ++i) {
+        for (int j = i + 1; j < fFreeRects.size(); ++j) {
+            if (fFreeRects[j].contains(fFreeRects[i])) {
+                fFreeRects.removeShuffle(i);
+                --i;
+                break;
+            }
+            if (fFreeRects[i].contains(fFreeRects[j])) {
+                fFreeRects.removeShuffle(j);
+                --j;
+            }
+        }
+    }
+}
+
+} // End of namespace skgpu
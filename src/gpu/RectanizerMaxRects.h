@@ -0,0 +1,58 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_RectanizerMaxRects_DEFINED
+#define skgpu_RectanizerMaxRects_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTDArray.h"
+#include "src/gpu/Rectanizer.h"
+
+namespace skgpu {
+
+// Tracks every maximal free rectangle and places each new rect in the free rectangle that leaves
+// the shortest leftover side ("best short side fit"). Based on Jukka Jylanki's "A Thousand Ways to
+// Pack the Bin".
+//
+// This packs mixed sizes more tightly than the skyline, which can't use the space under an
+// overhang, but each insert costs time quadratic in the number of free rectangles.
+//
+// Mark this class final in an effort to avoid the vtable when this subclass is used explicitly.
+class RectanizerMaxRects final : public Rectanizer {
+public:
+    RectanizerMaxRects(int w, int h) : Rectanizer(w, h) {
+        this->reset();
+    }
+
+    ~RectanizerMaxRects() final {}
+
+    void reset() final {
+        fAreaSoFar = 0;
+        fFreeRects.clear();
+        fFreeRects.push_back(SkIRect::MakeWH(this->width(), this->height()));
+    }
+
+    bool addRect(int w, int h, SkIPoint16* loc) final;
+
+    float percentFull() const final {
+        return fAreaSoFar / ((float)this->width() * this->height());
+    }
+
+private:
+    // Replaces each free rect that overlaps 'used' with the maximal free rects around it.
+    void splitFreeRects(const SkIRect& used);
+    // Removes free rects that are contained in another one.
+    void pruneFreeRects();
+
+    SkTDArray<SkIRect> fFreeRects;
+
+    int32_t fAreaSoFar;
+};
+
+} // End of namespace skgpu
+
+#endif
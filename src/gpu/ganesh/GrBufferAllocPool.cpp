@@ -70,6 +70,59 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 
 //////////////////////////////////////////////////////////////////////////////
 
+sk_sp<GrBufferAllocPool::GpuBufferCache> GrBufferAllocPool::GpuBufferCache::Make(
+        int maxBuffersPerType) {
+    return sk_sp<GpuBufferCache>(new GpuBufferCache(maxBuffersPerType));
+}
+
+GrBufferAllocPool::GpuBufferCache::GpuBufferCache(int maxBuffersPerType)
+        : fMaxBuffersPerType(maxBuffersPerType) {}
+
+sk_sp<GrGpuBuffer> GrBufferAllocPool::GpuBufferCache::makeBuffer(GrResourceProvider* provider,
+                                                                 GrGpuBufferType type) {
+    auto createBuffer = [&] {
+        return provider->createBuffer(kDefaultBufferSize,
+                                      type,
+                                      kDynamic_GrAccessPattern,
+                                      GrResourceProvider::ZeroInit::kNo);
+    };
+    Ring& ring = fRings[static_cast<int>(type)];
+    int count = ring.fBuffers.size();
+    for (int i = 0; i < count; ++i) {
+        int index = (ring.fNext + i) % count;
+        sk_sp<GrGpuBuffer>& buffer = ring.fBuffers[index];
+        if (buffer->wasDestroyed()) {
+            sk_sp<GrGpuBuffer> replacement = createBuffer();
+            if (!replacement) {
+                return nullptr;
+            }
+            buffer = std::move(replacement);
+        } else if (!buffer->unique()) {
+            // An earlier flush's ops or command buffers are still using it.
+            continue;
+        }
+        ring.fNext = (index + 1) % count;
+        return buffer;
+    }
+    if (count >= fMaxBuffersPerType) {
+        return nullptr;
+    }
+    sk_sp<GrGpuBuffer> buffer = createBuffer();
+    if (buffer) {
+        ring.fBuffers.push_back(buffer);
+    }
+    return buffer;
+}
+
+void GrBufferAllocPool::GpuBufferCache::releaseAll() {
+    for (Ring& ring : fRings) {
+        ring.fBuffers.clear();
+        ring.fNext = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 #ifdef SK_DEBUG
     #define VALIDATE validate
 #else
@@ -86,9 +139,11 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
     } while (false)
 
 GrBufferAllocPool::GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType,
-                                     sk_sp<CpuBufferCache> cpuBufferCache)
+                                     sk_sp<CpuBufferCache> cpuBufferCache,
+                                     sk_sp<GpuBufferCache> gpuBufferCache)
         : fBlocks(8)
         , fCpuBufferCache(std::move(cpuBufferCache))
+        , fGpuBufferCache(std::move(gpuBufferCache))
         , fGpu(gpu)
         , fBufferType(bufferType) {}
 
@@ -416,6 +471,12 @@ sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
         return fCpuBufferCache ? fCpuBufferCache->makeBuffer(size, mustInitialize)
                                : GrCpuBuffer::Make(size);
     }
+    if (fGpuBufferCache && size == kDefaultBufferSize) {
+        if (sk_sp<GrGpuBuffer> buffer = fGpuBufferCache->makeBuffer(resourceProvider,
+                                                                    fBufferType)) {
+            return buffer;
+        }
+    }
     return resourceProvider->createBuffer(size,
                                           fBufferType,
                                           kDynamic_GrAccessPattern,
@@ -424,8 +485,11 @@ sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache)) {}
+GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu,
+                                                 sk_sp<CpuBufferCache> cpuBufferCache,
+                                                 sk_sp<GpuBufferCache> gpuBufferCache)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache),
+                            std::move(gpuBufferCache)) {}
 
 void* GrVertexBufferAllocPool::makeSpace(size_t vertexSize,
                                          int vertexCount,
@@ -477,8 +541,11 @@ void* GrVertexBufferAllocPool::makeSpaceAtLeast(size_t vertexSize, int minVertex
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache)) {}
+GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu,
+                                               sk_sp<CpuBufferCache> cpuBufferCache,
+                                               sk_sp<GpuBufferCache> gpuBufferCache)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache),
+                            std::move(gpuBufferCache)) {}
 
 void* GrIndexBufferAllocPool::makeSpace(int indexCount, sk_sp<const GrBuffer>* buffer,
                                         int* startIndex) {
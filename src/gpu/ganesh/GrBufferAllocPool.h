@@ -16,9 +16,11 @@
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/gpu/ganesh/GrCpuBuffer.h"
 #include "src/gpu/ganesh/GrDrawIndirectCommand.h"
+#include "src/gpu/ganesh/GrGpuBuffer.h"
 #include "src/gpu/ganesh/GrNonAtomicRef.h"
 
 class GrGpu;
+class GrResourceProvider;
 
 /**
  * A pool of geometry buffers tied to a GrGpu.
@@ -58,6 +60,34 @@ public:
         int fMaxBuffersToCache = 0;
     };
 
+    /**
+     * A cache object that can be shared by multiple GrBufferAllocPool instances. It keeps a ring
+     * of kDefaultBufferSize GPU buffers for each buffer type, so that a flush can reuse the
+     * buffers of earlier flushes instead of going back to the resource cache for new ones.
+     *
+     * Ops and backend command buffers hold refs on the buffers they draw from until the GPU is
+     * done with them, so a buffer is free for reuse once the ring's ref is the only one left.
+     */
+    class GpuBufferCache : public GrNonAtomicRef<GpuBufferCache> {
+    public:
+        static sk_sp<GpuBufferCache> Make(int maxBuffersPerType);
+
+        // Returns null if every buffer in the ring is still in use and the ring is full.
+        sk_sp<GrGpuBuffer> makeBuffer(GrResourceProvider*, GrGpuBufferType);
+        void releaseAll();
+
+    private:
+        GpuBufferCache(int maxBuffersPerType);
+
+        struct Ring {
+            SkTArray<sk_sp<GrGpuBuffer>> fBuffers;
+            // The buffer to try first. It is the one that was handed out longest ago.
+            int fNext = 0;
+        };
+        Ring fRings[kGrGpuBufferTypeCount];
+        int fMaxBuffersPerType = 0;
+    };
+
     /**
      * Ensures all buffers are unmapped and have all data written to them.
      * Call before drawing using buffers from the pool.
@@ -83,8 +113,11 @@ protected:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param gpuBufferCache        If non-null a cache for GPU buffers of the default size
+     *                              that outlives the pool.
      */
-    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache,
+                      sk_sp<GpuBufferCache> gpuBufferCache = nullptr);
 
     virtual ~GrBufferAllocPool();
 
@@ -165,6 +198,7 @@ private:
 
     SkTArray<BufferBlock> fBlocks;
     sk_sp<CpuBufferCache> fCpuBufferCache;
+    sk_sp<GpuBufferCache> fGpuBufferCache;
     sk_sp<GrCpuBuffer> fCpuStagingBuffer;
     GrGpu* fGpu;
     GrGpuBufferType fBufferType;
@@ -183,8 +217,11 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param gpuBufferCache        If non-null a cache for GPU buffers of the default size
+     *                              that outlives the pool.
      */
-    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                            sk_sp<GpuBufferCache> gpuBufferCache = nullptr);
 
     /**
      * Returns a block of memory to hold vertices. A buffer designated to hold
@@ -262,8 +299,11 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param gpuBufferCache        If non-null a cache for GPU buffers of the default size
+     *                              that outlives the pool.
      */
-    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                           sk_sp<GpuBufferCache> gpuBufferCache = nullptr);
 
     /**
      * Returns a block of memory to hold indices. A buffer designated to hold
@@ -322,8 +362,10 @@ private:
 
 class GrDrawIndirectBufferAllocPool : private GrBufferAllocPool {
 public:
-    GrDrawIndirectBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-            : GrBufferAllocPool(gpu, GrGpuBufferType::kDrawIndirect, std::move(cpuBufferCache)) {}
+    GrDrawIndirectBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                  sk_sp<GpuBufferCache> gpuBufferCache = nullptr)
+            : GrBufferAllocPool(gpu, GrGpuBufferType::kDrawIndirect, std::move(cpuBufferCache),
+                                std::move(gpuBufferCache)) {}
 
     GrDrawIndirectWriter makeSpace(int drawCount, sk_sp<const GrBuffer>* buffer, size_t* offset) {
         return this->GrBufferAllocPool::makeSpace(drawCount * sizeof(GrDrawIndirectCommand), 4,
@@ -273,7 +273,10 @@ bool GrDirectContext::init() {
     fAtlasManager = std::make_unique<GrAtlasManager>(proxyProvider,
                                                      this->options().fGlyphCacheTextureMaximumBytes,
                                                      allowMultitexturing,
-                                                     this->options().fSupportBilerpFromGlyphAtlas);
+                                                     this->options().fSupportBilerpFromGlyphAtlas,
+                                                     this->options().fUseMaxRectsGlyphAtlas
+                                                             ? skgpu::PlotRectanizer::kMaxRects
+                                                             : skgpu::PlotRectanizer::kSkyline);
     this->priv().addOnFlushCallbackObject(fAtlasManager.get());
 
     return true;
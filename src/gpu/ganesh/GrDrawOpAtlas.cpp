@@ -73,7 +73,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
                                                    GenerationCounter* generationCounter,
                                                    AllowMultitexturing allowMultitexturing,
                                                    EvictionCallback* evictor,
-                                                   std::string_view label) {
+                                                   std::string_view label,
+                                                   skgpu::PlotRectanizer plotRectanizer) {
     if (!format.isValid()) {
         return nullptr;
     }
@@ -81,7 +82,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
     std::unique_ptr<GrDrawOpAtlas> atlas(new GrDrawOpAtlas(proxyProvider, format, colorType, bpp,
                                                            width, height, plotWidth, plotHeight,
                                                            generationCounter,
-                                                           allowMultitexturing, label));
+                                                           allowMultitexturing, label,
+                                                           plotRectanizer));
     if (!atlas->getViews()[0].proxy()) {
         return nullptr;
     }
@@ -97,7 +99,8 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
 GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendFormat& format,
                              SkColorType colorType, size_t bpp, int width, int height,
                              int plotWidth, int plotHeight, GenerationCounter* generationCounter,
-                             AllowMultitexturing allowMultitexturing, std::string_view label)
+                             AllowMultitexturing allowMultitexturing, std::string_view label,
+                             skgpu::PlotRectanizer plotRectanizer)
         : fFormat(format)
         , fColorType(colorType)
         , fBytesPerPixel(bpp)
@@ -106,6 +109,7 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendForm
         , fPlotWidth(plotWidth)
         , fPlotHeight(plotHeight)
         , fLabel(label)
+        , fPlotRectanizer(plotRectanizer)
         , fGenerationCounter(generationCounter)
         , fAtlasGeneration(fGenerationCounter->next())
         , fPrevFlushToken(AtlasToken::InvalidToken())
@@ -141,6 +145,7 @@ void GrDrawOpAtlas::uploadPlotToTexture(GrDeferredTextureUploadWritePixelsFn& wr
     const void* dataPtr;
     SkIRect rect;
     std::tie(dataPtr, rect) = plot->prepareForUpload(/*useCachedUploads=*/false);
+    fUploadedBytes += rect.width() * rect.height() * fBytesPerPixel;
 
     writePixels(proxy,
                 rect,
@@ -313,6 +318,19 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
     return ErrorCode::kSucceeded;
 }
 
+float GrDrawOpAtlas::occupancy() const {
+    if (!fNumActivePages) {
+        return 0;
+    }
+    float full = 0;
+    for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+        for (unsigned int plotIndex = 0; plotIndex < fNumPlots; ++plotIndex) {
+            full += fPages[pageIndex].fPlotArray[plotIndex]->percentFull();
+        }
+    }
+    return full / (fNumActivePages * fNumPlots);
+}
+
 void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
     if (fNumActivePages < 1) {
         fPrevFlushToken = startTokenForNextFlush;
@@ -498,7 +516,7 @@ bool GrDrawOpAtlas::createPages(
                 uint32_t plotIndex = r * numPlotsX + c;
                 currPlot->reset(new Plot(
                     i, plotIndex, generationCounter, x, y, fPlotWidth, fPlotHeight, fColorType,
-                    fBytesPerPixel));
+                    fBytesPerPixel, fPlotRectanizer));
 
                 // build LRU list
                 fPages[i].fPlotList.addToHead(currPlot->get());
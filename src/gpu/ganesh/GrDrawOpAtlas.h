@@ -71,6 +71,7 @@ public:
      *  @param allowMultitexturing Can the atlas use more than one texture.
      *  @param evictor             A pointer to an eviction callback class.
      *  @param label               A label for the atlas texture.
+     *  @param plotRectanizer      How each plot places its subimages.
      *
      *  @return                    An initialized DrawAtlas, or nullptr if creation fails.
      */
@@ -82,7 +83,9 @@ public:
                                                skgpu::AtlasGenerationCounter* generationCounter,
                                                AllowMultitexturing allowMultitexturing,
                                                skgpu::PlotEvictionCallback* evictor,
-                                               std::string_view label);
+                                               std::string_view label,
+                                               skgpu::PlotRectanizer plotRectanizer =
+                                                       skgpu::PlotRectanizer::kSkyline);
 
     /**
      * Adds a width x height subimage to the atlas. Upon success it returns 'kSucceeded' and returns
@@ -162,6 +165,12 @@ public:
         return fMaxPages;
     }
 
+    // The fraction of the active pages' area that their plots have filled.
+    float occupancy() const;
+
+    // The number of bytes uploaded to the atlas textures so far.
+    size_t uploadedBytes() const { return fUploadedBytes; }
+
     int numAllocated_TestingOnly() const;
     void setMaxPages_TestingOnly(uint32_t maxPages);
 
@@ -169,7 +178,8 @@ private:
     GrDrawOpAtlas(GrProxyProvider*, const GrBackendFormat& format, SkColorType, size_t bpp,
                   int width, int height, int plotWidth, int plotHeight,
                   skgpu::AtlasGenerationCounter* generationCounter,
-                  AllowMultitexturing allowMultitexturing, std::string_view label);
+                  AllowMultitexturing allowMultitexturing, std::string_view label,
+                  skgpu::PlotRectanizer plotRectanizer);
 
     inline bool updatePlot(GrDeferredUploadTarget*, skgpu::AtlasLocator*, skgpu::Plot*);
 
@@ -211,6 +221,8 @@ private:
     int                   fPlotHeight;
     unsigned int          fNumPlots;
     const std::string     fLabel;
+    const skgpu::PlotRectanizer fPlotRectanizer;
+    size_t                fUploadedBytes = 0;
 
     // A counter to track the atlas eviction state for Glyphs. Each Glyph has a PlotLocator
     // which contains its current generation. When the atlas evicts a plot, it increases
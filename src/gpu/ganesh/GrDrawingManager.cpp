@@ -81,6 +81,10 @@ void GrDrawingManager::freeGpuResources() {
     // a path renderer may be holding onto resources
     fPathRendererChain = nullptr;
     fSoftwarePathRenderer = nullptr;
+
+    if (fGpuBufferCache) {
+        fGpuBufferCache->releaseAll();
+    }
 }
 
 // MDB TODO: make use of the 'proxies' parameter.
@@ -149,8 +153,14 @@ bool GrDrawingManager::flush(
         int maxCachedBuffers = fContext->priv().caps()->preferClientSideDynamicBuffers() ? 2 : 6;
         fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(maxCachedBuffers);
     }
+    if (!fGpuBufferCache) {
+        // A flush usually fits in a buffer or two of each type. The extra ones cover the flushes
+        // the GPU is still working on.
+        fGpuBufferCache = GrBufferAllocPool::GpuBufferCache::Make(4);
+    }
 
-    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache);
+    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache,
+                              fGpuBufferCache);
 
     GrOnFlushResourceProvider onFlushProvider(this);
 
@@ -188,6 +198,7 @@ bool GrDrawingManager::flush(
                 }
                 resourceAllocator.planAssignment();
             }
+            gpu->stats()->recordFlushPeakBytes(resourceAllocator.peakBytes());
             resourceAllocator.assign();
         }
 
@@ -227,6 +227,8 @@ private:
     // This cache is used by both the vertex and index pools. It reuses memory across multiple
     // flushes.
     sk_sp<GrBufferAllocPool::CpuBufferCache> fCpuBufferCache;
+    // Likewise for the GPU buffers the pools write into.
+    sk_sp<GrBufferAllocPool::GpuBufferCache> fGpuBufferCache;
 
     SkTArray<sk_sp<GrRenderTask>>            fDAG;
     std::vector<int>                         fReorderBlockerTaskIndices;
@@ -12,11 +12,13 @@
 #include "include/private/SkSLSampleUsage.h"
 #include "include/private/SkSLString.h"
 #include "include/private/base/SkMacros.h"
+#include "include/private/base/SkTArray.h"
 #include "src/gpu/ganesh/GrProcessor.h"
 #include "src/gpu/ganesh/glsl/GrGLSLUniformHandler.h"
 
 #include <tuple>
 
+class GrCaps;
 class GrGLSLFPFragmentBuilder;
 class GrGLSLProgramDataManager;
 class GrPaint;
@@ -190,6 +192,20 @@ public:
         }
     }
 
+    /**
+     * The program key of this processor and its children, as GrProgramDesc writes it. Most trees
+     * are keyed once, so the bits are only saved when the processor is keyed as the root of a
+     * pipeline's FP tree for the second time. The tree can't change after that, so later keys of
+     * the same tree copy these bits instead of rebuilding them.
+     */
+    struct KeyCache {
+        const GrCaps* fCaps = nullptr;  // The caps of the last key, or null if never keyed
+        bool fFilled = false;           // Whether fNumBits and fData hold the key for fCaps
+        uint32_t fNumBits = 0;
+        SkTArray<uint32_t, true> fData;
+    };
+    KeyCache* keyCache() const { return &fKeyCache; }
+
     int numChildProcessors() const { return fChildProcessors.size(); }
     int numNonNullChildProcessors() const;
 
@@ -459,6 +475,7 @@ private:
     const GrFragmentProcessor* fParent = nullptr;
     uint32_t fFlags = 0;
     SkSL::SampleUsage fUsage;
+    mutable KeyCache fKeyCache;
 
     using INHERITED = GrProcessor;
 };
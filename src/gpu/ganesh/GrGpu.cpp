@@ -34,6 +34,8 @@
 #include "src/gpu/ganesh/GrTracing.h"
 #include "src/sksl/SkSLCompiler.h"
 
+#include <algorithm>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 GrGpu::GrGpu(GrDirectContext* direct) : fResetBits(kAll_GrBackendState), fContext(direct) {}
@@ -826,6 +828,11 @@ void GrGpu::Stats::dump(SkString* out) {
                  fNumScratchMSAAAttachmentsReused);
     out->appendf("Number of Render Passes: %d\n", fRenderPasses);
     out->appendf("Reordered DAGs Over Budget: %d\n", fNumReorderedDAGsOverBudget);
+    out->appendf("Peak Allocator Bytes Per Flush: last %zu, max %zu, mean %.0f (%d flushes)\n",
+                 fFlushPeakBytes.fLast, fFlushPeakBytes.fMax,
+                 fFlushPeakBytes.fFlushes ? (double)fFlushPeakBytes.fTotal / fFlushPeakBytes.fFlushes
+                                          : 0.0,
+                 fFlushPeakBytes.fFlushes);
 
     // enable this block to output CSV-style stats for program pre-compilation
 #if 0
@@ -848,6 +855,13 @@ void GrGpu::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>*
     values->push_back(fRenderPasses);
     keys->push_back(SkString("reordered_dags_over_budget"));
     values->push_back(fNumReorderedDAGsOverBudget);
+    if (fFlushPeakBytes.fFlushes) {
+        // Flushes differ, so report the typical and the worst one rather than only the worst.
+        keys->push_back(SkString("flush_peak_bytes_mean"));
+        values->push_back((double)fFlushPeakBytes.fTotal / fFlushPeakBytes.fFlushes);
+        keys->push_back(SkString("flush_peak_bytes_max"));
+        values->push_back(fFlushPeakBytes.fMax);
+    }
 }
 
 #endif // GR_GPU_STATS
@@ -24,6 +24,9 @@
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/GrXferProcessor.h"
 
+#include <algorithm>
+#include <cstdint>
+
 class GrAttachment;
 class GrBackendRenderTarget;
 class GrBackendSemaphore;
@@ -500,6 +503,21 @@ public:
         int numReorderedDAGsOverBudget() const { return fNumReorderedDAGsOverBudget; }
         void incNumReorderedDAGsOverBudget() { fNumReorderedDAGsOverBudget++; }
 
+        // A summary of GrResourceAllocator::peakBytes() over the flushes so far.
+        struct FlushPeakBytes {
+            int      fFlushes = 0;
+            size_t   fLast = 0;
+            size_t   fMax = 0;
+            uint64_t fTotal = 0;
+        };
+        const FlushPeakBytes& flushPeakBytes() const { return fFlushPeakBytes; }
+        void recordFlushPeakBytes(size_t bytes) {
+            fFlushPeakBytes.fFlushes++;
+            fFlushPeakBytes.fLast = bytes;
+            fFlushPeakBytes.fMax = std::max(fFlushPeakBytes.fMax, bytes);
+            fFlushPeakBytes.fTotal += bytes;
+        }
+
 #if GR_TEST_UTILS
         void dump(SkString*);
         void dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values);
@@ -519,6 +537,7 @@ public:
         int fNumScratchMSAAAttachmentsReused = 0;
         int fRenderPasses = 0;
         int fNumReorderedDAGsOverBudget = 0;
+        FlushPeakBytes fFlushPeakBytes;
 
 #else  // !GR_GPU_STATS
 
@@ -540,6 +559,7 @@ public:
         void incNumScratchMSAAAttachmentsReused() {}
         void incRenderPasses() {}
         void incNumReorderedDAGsOverBudget() {}
+        void recordFlushPeakBytes(size_t) {}
 #endif
     };
 
@@ -30,7 +30,8 @@ public:
     // GrBufferAllocPool::kDefaultBufferSize. If the latter, then CPU memory is only allocated for
     // vertices/indices when a buffer larger than kDefaultBufferSize is required.
     GrOpFlushState(GrGpu*, GrResourceProvider*, skgpu::TokenTracker*,
-                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr);
+                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr,
+                   sk_sp<GrBufferAllocPool::GpuBufferCache> = nullptr);
 
     ~GrOpFlushState() final { this->reset(); }
 
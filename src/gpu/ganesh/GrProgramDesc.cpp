@@ -148,16 +148,47 @@ static void gen_fp_key(const GrFragmentProcessor& fp,
     }
 }
 
+// Keys a pipeline's FP tree. Ops sometimes key the same program more than once (e.g. a DDL's
+// programs are keyed when precompiled and again when drawn), so the tree's bits are cached on its
+// root. The first key is written straight into 'b', as if there were no cache, so that trees that
+// are keyed only once pay nothing for it.
+static void gen_root_fp_key(const GrFragmentProcessor& fp,
+                            const GrCaps& caps,
+                            skgpu::KeyBuilder* b,
+                            bool useKeyCache) {
+    if (!useKeyCache) {
+        gen_fp_key(fp, caps, b);
+        return;
+    }
+    SkASSERT(!fp.parent());
+    GrFragmentProcessor::KeyCache* cache = fp.keyCache();
+    if (cache->fCaps == &caps && cache->fFilled) {
+        b->addBitString(cache->fData.data(), cache->fNumBits, "fpTree");
+        return;
+    }
+    uint32_t startBit = b->bitCount();
+    gen_fp_key(fp, caps, b);
+    if (cache->fCaps == &caps) {
+        // This tree is being keyed again, so save its bits for the keys after this one.
+        cache->fNumBits = b->copyBitsSince(startBit, &cache->fData);
+        cache->fFilled = true;
+    } else {
+        cache->fCaps = &caps;
+        cache->fFilled = false;
+    }
+}
+
 static void gen_key(skgpu::KeyBuilder* b,
                     const GrProgramInfo& programInfo,
-                    const GrCaps& caps) {
+                    const GrCaps& caps,
+                    bool useKeyCache) {
     gen_geomproc_key(programInfo.geomProc(), caps, b);
 
     const GrPipeline& pipeline = programInfo.pipeline();
     b->addBits(2, pipeline.numFragmentProcessors(),      "numFPs");
     b->addBits(1, pipeline.numColorFragmentProcessors(), "numColorFPs");
     for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
-        gen_fp_key(pipeline.getFragmentProcessor(i), caps, b);
+        gen_root_fp_key(pipeline.getFragmentProcessor(i), caps, b, useKeyCache);
     }
 
     gen_xp_key(pipeline.getXferProcessor(), caps, pipeline, b);
@@ -178,7 +209,7 @@ void GrProgramDesc::Build(GrProgramDesc* desc,
                           const GrCaps& caps) {
     desc->reset();
     skgpu::KeyBuilder b(desc->key());
-    gen_key(&b, programInfo, caps);
+    gen_key(&b, programInfo, caps, /*useKeyCache=*/true);
     desc->fInitialKeyLength = desc->keyLength();
 }
 
@@ -186,7 +217,8 @@ SkString GrProgramDesc::Describe(const GrProgramInfo& programInfo,
                                  const GrCaps& caps) {
     GrProgramDesc desc;
     skgpu::StringKeyBuilder b(desc.key());
-    gen_key(&b, programInfo, caps);
+    // The description labels each field, so it walks the processors every time.
+    gen_key(&b, programInfo, caps, /*useKeyCache=*/false);
     b.flush();
     return b.description();
 }
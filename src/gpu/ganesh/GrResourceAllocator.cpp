@@ -16,6 +16,8 @@
 #include "src/gpu/ganesh/GrSurfaceProxyPriv.h"
 #include "src/gpu/ganesh/GrTexture.h"
 
+#include <algorithm>
+
 #ifdef SK_DEBUG
 #include <atomic>
 
@@ -314,6 +316,9 @@ void GrResourceAllocator::expire(unsigned int curIndex) {
 #endif
             // TODO: fix this insertion so we get a more LRU-ish behavior
             fFreePool.insert(r->scratchKey(), r);
+            SkASSERT(fLiveBytes >= r->liveBytes());
+            fLiveBytes -= r->liveBytes();
+            r->setLiveBytes(0);
         }
         fFinishedIntvls.insertByIncreasingStart(intvl);
     }
@@ -359,6 +364,12 @@ bool GrResourceAllocator::planAssignment() {
 #endif
         SkASSERT(!cur->proxy()->peekSurface());
         cur->setRegister(r);
+        // Uniquely keyed registers can be handed out again while they are still live.
+        if (!r->liveBytes()) {
+            r->setLiveBytes(cur->proxy()->gpuMemorySize());
+            fLiveBytes += r->liveBytes();
+            fPeakBytes = std::max(fPeakBytes, fLiveBytes);
+        }
     }
 
     // expire all the remaining intervals to drain the active interval list
@@ -402,6 +413,8 @@ void GrResourceAllocator::reset() {
     fIntvlList = IntervalList();
     fIntvlHash.reset();
     fUniqueKeyRegisters.reset();
+    fLiveBytes = 0;
+    fPeakBytes = 0;
     fFreePool.reset();
     fInternalAllocator.reset();
 }
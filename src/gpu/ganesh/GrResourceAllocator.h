@@ -108,6 +108,17 @@ public:
     // be known accurately. Returns false if any lazy proxy failed to instantiate, true otherwise.
     bool planAssignment();
 
+    // The most bytes of register-backed surfaces that the plan keeps alive at any one op. A
+    // register is live from the start of its first interval until it goes back to the free pool.
+    // Already-instantiated and lazy proxies are not counted. Only valid after planAssignment.
+    //
+    // TODO: Registers are only reused between proxies with the same scratch key, so this can be
+    // well above the sum of the largest surfaces live at once. Packing differently sized
+    // intervals into shared allocations would need the ops to stop reading
+    // backingStoreDimensions() at record time (texture coordinate normalization and wrap modes
+    // are baked in then) and a backend API for placing surfaces in a shared heap.
+    size_t peakBytes() const { return fPeakBytes; }
+
     // Figure out how much VRAM headroom this plan requires. If there's enough purgeable resources,
     // purge them and return true. Otherwise return false.
     bool makeBudgetHeadroom();
@@ -167,6 +178,10 @@ private:
 
         GrSurface* existingSurface() const { return fExistingSurface.get(); }
 
+        // The size of the surface while the plan has this register out of the free pool, or zero.
+        size_t liveBytes() const { return fLiveBytes; }
+        void setLiveBytes(size_t bytes) { fLiveBytes = bytes; }
+
         // Can this register be used by other proxies after this one?
         bool isRecyclable(const GrCaps&, GrSurfaceProxy* proxy, int knownUseCount) const;
 
@@ -182,6 +197,7 @@ private:
         skgpu::ScratchKey fScratchKey; // free pool wants a reference to this.
         sk_sp<GrSurface>  fExistingSurface; // queried from resource cache. may be null.
         bool              fAccountedForInBudget = false;
+        size_t            fLiveBytes = 0;
 
 #ifdef SK_DEBUG
         uint32_t         fUniqueID;
@@ -282,6 +298,8 @@ private:
                                                      // (sorted by increasing start)
     UniqueKeyRegisterHash        fUniqueKeyRegisters;
     unsigned int                 fNumOps = 0;
+    size_t                       fLiveBytes = 0;     // Bytes held by live registers while planning
+    size_t                       fPeakBytes = 0;
 
     SkDEBUGCODE(bool             fPlanned = false;)
     SkDEBUGCODE(bool             fAssigned = false;)
@@ -20,101 +20,140 @@ GrThreadSafeCache::VertexData::~VertexData () {
     this->reset();
 }
 
-GrThreadSafeCache::GrThreadSafeCache()
-    : fFreeEntryList(nullptr) {
-}
+GrThreadSafeCache::GrThreadSafeCache() = default;
 
 GrThreadSafeCache::~GrThreadSafeCache() {
     this->dropAllRefs();
 }
 
+// These take and release the shards' locks on behalf of fAllShards, which the analysis can't see.
+void GrThreadSafeCache::lockAllShards() const SK_NO_THREAD_SAFETY_ANALYSIS {
+    // Always lock in the same order so two threads doing this can't deadlock.
+    for (const Shard& shard : fShards) {
+        shard.fSpinLock.acquire();
+    }
+}
+
+void GrThreadSafeCache::unlockAllShards() const SK_NO_THREAD_SAFETY_ANALYSIS {
+    for (const Shard& shard : fShards) {
+        shard.fSpinLock.release();
+    }
+}
+
 #if GR_TEST_UTILS
 int GrThreadSafeCache::numEntries() const {
-    SkAutoSpinlock lock{fSpinLock};
+    int count = 0;
+    for (const Shard& shard : fShards) {
+        SkAutoSpinlock lock{shard.fSpinLock};
 
-    return fUniquelyKeyedEntryMap.count();
+        count += shard.fUniquelyKeyedEntryMap.count();
+    }
+    return count;
 }
 
 size_t GrThreadSafeCache::approxBytesUsedForHash() const {
-    SkAutoSpinlock lock{fSpinLock};
+    size_t bytes = 0;
+    for (const Shard& shard : fShards) {
+        SkAutoSpinlock lock{shard.fSpinLock};
 
-    return fUniquelyKeyedEntryMap.approxBytesUsed();
+        bytes += shard.fUniquelyKeyedEntryMap.approxBytesUsed();
+    }
+    return bytes;
 }
 #endif
 
 void GrThreadSafeCache::dropAllRefs() {
-    SkAutoSpinlock lock{fSpinLock};
+    for (Shard& shard : fShards) {
+        SkAutoSpinlock lock{shard.fSpinLock};
 
-    fUniquelyKeyedEntryMap.reset();
-    while (auto tmp = fUniquelyKeyedEntryList.head()) {
-        fUniquelyKeyedEntryList.remove(tmp);
-        this->recycleEntry(tmp);
+        shard.fUniquelyKeyedEntryMap.reset();
+        while (auto tmp = shard.fUniquelyKeyedEntryList.head()) {
+            shard.fUniquelyKeyedEntryList.remove(tmp);
+            RecycleEntry(&shard, tmp);
+        }
+        // TODO: should we empty out the fFreeEntryList and reset fEntryAllocator?
     }
-    // TODO: should we empty out the fFreeEntryList and reset fEntryAllocator?
 }
 
 // TODO: If iterating becomes too expensive switch to using something like GrIORef for the
 // GrSurfaceProxy
 void GrThreadSafeCache::dropUniqueRefs(GrResourceCache* resourceCache) {
-    SkAutoSpinlock lock{fSpinLock};
-
-    // Iterate from LRU to MRU
-    Entry* cur = fUniquelyKeyedEntryList.tail();
-    Entry* prev = cur ? cur->fPrev : nullptr;
+    this->lockAllShards();
+
+    // Iterate from LRU to MRU, merging the shards' lists by last access.
+    Entry* cur[kNumShards];
+    for (int i = 0; i < kNumShards; ++i) {
+        Shard* shard = &fShards[i];
+        this->assertShardLocked(shard);
+        cur[i] = shard->fUniquelyKeyedEntryList.tail();
+    }
 
-    while (cur) {
+    while (true) {
         if (resourceCache && !resourceCache->overBudget()) {
-            return;
+            break;
         }
 
-        if (cur->uniquelyHeld()) {
-            fUniquelyKeyedEntryMap.remove(cur->key());
-            fUniquelyKeyedEntryList.remove(cur);
-            this->recycleEntry(cur);
+        int lru = -1;
+        for (int i = 0; i < kNumShards; ++i) {
+            if (cur[i] && (lru < 0 || cur[i]->fLastAccess < cur[lru]->fLastAccess)) {
+                lru = i;
+            }
+        }
+        if (lru < 0) {
+            break;
         }
 
-        cur = prev;
-        prev = cur ? cur->fPrev : nullptr;
+        Entry* entry = cur[lru];
+        cur[lru] = entry->fPrev;
+        if (entry->uniquelyHeld()) {
+            Shard* shard = &fShards[lru];
+            this->assertShardLocked(shard);
+            RemoveEntry(shard, entry);
+        }
     }
+
+    this->unlockAllShards();
 }
 
 void GrThreadSafeCache::dropUniqueRefsOlderThan(GrStdSteadyClock::time_point purgeTime) {
-    SkAutoSpinlock lock{fSpinLock};
-
-    // Iterate from LRU to MRU
-    Entry* cur = fUniquelyKeyedEntryList.tail();
-    Entry* prev = cur ? cur->fPrev : nullptr;
-
-    while (cur) {
-        if (cur->fLastAccess >= purgeTime) {
-            // This entry and all the remaining ones in the list will be newer than 'purgeTime'
-            return;
+    // The shards can be purged independently since this doesn't depend on the order across them.
+    for (Shard& shard : fShards) {
+        SkAutoSpinlock lock{shard.fSpinLock};
+
+        // Iterate from LRU to MRU
+        Entry* cur = shard.fUniquelyKeyedEntryList.tail();
+        Entry* prev = cur ? cur->fPrev : nullptr;
+
+        while (cur) {
+            if (cur->fLastAccess >= purgeTime) {
+                // This entry and all the remaining ones in the list will be newer than 'purgeTime'
+                break;
+            }
+
+            if (cur->uniquelyHeld()) {
+                RemoveEntry(&shard, cur);
+            }
+
+            cur = prev;
+            prev = cur ? cur->fPrev : nullptr;
         }
-
-        if (cur->uniquelyHeld()) {
-            fUniquelyKeyedEntryMap.remove(cur->key());
-            fUniquelyKeyedEntryList.remove(cur);
-            this->recycleEntry(cur);
-        }
-
-        cur = prev;
-        prev = cur ? cur->fPrev : nullptr;
     }
 }
 
-void GrThreadSafeCache::makeExistingEntryMRU(Entry* entry) {
-    SkASSERT(fUniquelyKeyedEntryList.isInList(entry));
+void GrThreadSafeCache::MakeExistingEntryMRU(Shard* shard, Entry* entry) {
+    SkASSERT(shard->fUniquelyKeyedEntryList.isInList(entry));
 
     entry->fLastAccess = GrStdSteadyClock::now();
-    fUniquelyKeyedEntryList.remove(entry);
-    fUniquelyKeyedEntryList.addToHead(entry);
+    shard->fUniquelyKeyedEntryList.remove(entry);
+    shard->fUniquelyKeyedEntryList.addToHead(entry);
 }
 
-std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalFind(
+std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::InternalFind(
+                                                       Shard* shard,
                                                        const skgpu::UniqueKey& key) {
-    Entry* tmp = fUniquelyKeyedEntryMap.find(key);
+    Entry* tmp = shard->fUniquelyKeyedEntryMap.find(key);
     if (tmp) {
-        this->makeExistingEntryMRU(tmp);
+        MakeExistingEntryMRU(shard, tmp);
         return { tmp->view(), tmp->refCustomData() };
     }
 
@@ -123,86 +162,98 @@ std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalFind(
 
 #ifdef SK_DEBUG
 bool GrThreadSafeCache::has(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    Entry* tmp = fUniquelyKeyedEntryMap.find(key);
+    Entry* tmp = shard->fUniquelyKeyedEntryMap.find(key);
     return SkToBool(tmp);
 }
 #endif
 
 GrSurfaceProxyView GrThreadSafeCache::find(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
     GrSurfaceProxyView view;
-    std::tie(view, std::ignore) = this->internalFind(key);
+    std::tie(view, std::ignore) = InternalFind(shard, key);
     return view;
 }
 
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::findWithData(
         const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    return this->internalFind(key);
+    return InternalFind(shard, key);
 }
 
-GrThreadSafeCache::Entry* GrThreadSafeCache::getEntry(const skgpu::UniqueKey& key,
+GrThreadSafeCache::Entry* GrThreadSafeCache::GetEntry(Shard* shard,
+                                                      const skgpu::UniqueKey& key,
                                                       const GrSurfaceProxyView& view) {
     Entry* entry;
 
-    if (fFreeEntryList) {
-        entry = fFreeEntryList;
-        fFreeEntryList = entry->fNext;
+    if (shard->fFreeEntryList) {
+        entry = shard->fFreeEntryList;
+        shard->fFreeEntryList = entry->fNext;
         entry->fNext = nullptr;
 
         entry->set(key, view);
     } else {
-        entry = fEntryAllocator.make<Entry>(key, view);
+        entry = shard->fEntryAllocator.make<Entry>(key, view);
     }
 
-    return this->makeNewEntryMRU(entry);
+    return MakeNewEntryMRU(shard, entry);
 }
 
-GrThreadSafeCache::Entry* GrThreadSafeCache::makeNewEntryMRU(Entry* entry) {
+GrThreadSafeCache::Entry* GrThreadSafeCache::MakeNewEntryMRU(Shard* shard, Entry* entry) {
     entry->fLastAccess = GrStdSteadyClock::now();
-    fUniquelyKeyedEntryList.addToHead(entry);
-    fUniquelyKeyedEntryMap.add(entry);
+    shard->fUniquelyKeyedEntryList.addToHead(entry);
+    shard->fUniquelyKeyedEntryMap.add(entry);
     return entry;
 }
 
-GrThreadSafeCache::Entry* GrThreadSafeCache::getEntry(const skgpu::UniqueKey& key,
+GrThreadSafeCache::Entry* GrThreadSafeCache::GetEntry(Shard* shard,
+                                                      const skgpu::UniqueKey& key,
                                                       sk_sp<VertexData> vertData) {
     Entry* entry;
 
-    if (fFreeEntryList) {
-        entry = fFreeEntryList;
-        fFreeEntryList = entry->fNext;
+    if (shard->fFreeEntryList) {
+        entry = shard->fFreeEntryList;
+        shard->fFreeEntryList = entry->fNext;
         entry->fNext = nullptr;
 
         entry->set(key, std::move(vertData));
     } else {
-        entry = fEntryAllocator.make<Entry>(key, std::move(vertData));
+        entry = shard->fEntryAllocator.make<Entry>(key, std::move(vertData));
     }
 
-    return this->makeNewEntryMRU(entry);
+    return MakeNewEntryMRU(shard, entry);
+}
+
+void GrThreadSafeCache::RemoveEntry(Shard* shard, Entry* entry) {
+    shard->fUniquelyKeyedEntryMap.remove(entry->key());
+    shard->fUniquelyKeyedEntryList.remove(entry);
+    RecycleEntry(shard, entry);
 }
 
-void GrThreadSafeCache::recycleEntry(Entry* dead) {
+void GrThreadSafeCache::RecycleEntry(Shard* shard, Entry* dead) {
     SkASSERT(!dead->fPrev && !dead->fNext && !dead->fList);
 
     dead->makeEmpty();
 
-    dead->fNext = fFreeEntryList;
-    fFreeEntryList = dead;
+    dead->fNext = shard->fFreeEntryList;
+    shard->fFreeEntryList = dead;
 }
 
-std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalAdd(
+std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::InternalAdd(
+                                                                Shard* shard,
                                                                 const skgpu::UniqueKey& key,
                                                                 const GrSurfaceProxyView& view) {
-    Entry* tmp = fUniquelyKeyedEntryMap.find(key);
+    Entry* tmp = shard->fUniquelyKeyedEntryMap.find(key);
     if (!tmp) {
-        tmp = this->getEntry(key, view);
+        tmp = GetEntry(shard, key, view);
 
-        SkASSERT(fUniquelyKeyedEntryMap.find(key));
+        SkASSERT(shard->fUniquelyKeyedEntryMap.find(key));
     }
 
     return { tmp->view(), tmp->refCustomData() };
@@ -210,46 +261,50 @@ std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalAdd(
 
 GrSurfaceProxyView GrThreadSafeCache::add(const skgpu::UniqueKey& key,
                                           const GrSurfaceProxyView& view) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
     GrSurfaceProxyView newView;
-    std::tie(newView, std::ignore) = this->internalAdd(key, view);
+    std::tie(newView, std::ignore) = InternalAdd(shard, key, view);
     return newView;
 }
 
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::addWithData(
                                                                 const skgpu::UniqueKey& key,
                                                                 const GrSurfaceProxyView& view) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    return this->internalAdd(key, view);
+    return InternalAdd(shard, key, view);
 }
 
 GrSurfaceProxyView GrThreadSafeCache::findOrAdd(const skgpu::UniqueKey& key,
                                                 const GrSurfaceProxyView& v) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
     GrSurfaceProxyView view;
-    std::tie(view, std::ignore) = this->internalFind(key);
+    std::tie(view, std::ignore) = InternalFind(shard, key);
     if (view) {
         return view;
     }
 
-    std::tie(view, std::ignore) = this->internalAdd(key, v);
+    std::tie(view, std::ignore) = InternalAdd(shard, key, v);
     return view;
 }
 
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::findOrAddWithData(
                                                                       const skgpu::UniqueKey& key,
                                                                       const GrSurfaceProxyView& v) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    auto [view, data] = this->internalFind(key);
+    auto [view, data] = InternalFind(shard, key);
     if (view) {
         return { std::move(view), std::move(data) };
     }
 
-    return this->internalAdd(key, v);
+    return InternalAdd(shard, key, v);
 }
 
 sk_sp<GrThreadSafeCache::VertexData> GrThreadSafeCache::MakeVertexData(const void* vertices,
@@ -265,10 +320,10 @@ sk_sp<GrThreadSafeCache::VertexData> GrThreadSafeCache::MakeVertexData(sk_sp<GrG
 }
 
 std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>>
-        GrThreadSafeCache::internalFindVerts(const skgpu::UniqueKey& key) {
-    Entry* tmp = fUniquelyKeyedEntryMap.find(key);
+        GrThreadSafeCache::InternalFindVerts(Shard* shard, const skgpu::UniqueKey& key) {
+    Entry* tmp = shard->fUniquelyKeyedEntryMap.find(key);
     if (tmp) {
-        this->makeExistingEntryMRU(tmp);
+        MakeExistingEntryMRU(shard, tmp);
         return { tmp->vertexData(), tmp->refCustomData() };
     }
 
@@ -277,20 +332,22 @@ std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>>
 
 std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>>
         GrThreadSafeCache::findVertsWithData(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    return this->internalFindVerts(key);
+    return InternalFindVerts(shard, key);
 }
 
-std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>> GrThreadSafeCache::internalAddVerts(
+std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>> GrThreadSafeCache::InternalAddVerts(
+                                                                    Shard* shard,
                                                                     const skgpu::UniqueKey& key,
                                                                     sk_sp<VertexData> vertData,
                                                                     IsNewerBetter isNewerBetter) {
-    Entry* tmp = fUniquelyKeyedEntryMap.find(key);
+    Entry* tmp = shard->fUniquelyKeyedEntryMap.find(key);
     if (!tmp) {
-        tmp = this->getEntry(key, std::move(vertData));
+        tmp = GetEntry(shard, key, std::move(vertData));
 
-        SkASSERT(fUniquelyKeyedEntryMap.find(key));
+        SkASSERT(shard->fUniquelyKeyedEntryMap.find(key));
     } else if (isNewerBetter(tmp->getCustomData(), key.getCustomData())) {
         // This orphans any existing uses of the prior vertex data but ensures the best
         // version is in the cache.
@@ -304,19 +361,19 @@ std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>> GrThreadSafeCach
                                                                     const skgpu::UniqueKey& key,
                                                                     sk_sp<VertexData> vertData,
                                                                     IsNewerBetter isNewerBetter) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    return this->internalAddVerts(key, std::move(vertData), isNewerBetter);
+    return InternalAddVerts(shard, key, std::move(vertData), isNewerBetter);
 }
 
 void GrThreadSafeCache::remove(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    Shard* shard = this->shardFor(key);
+    SkAutoSpinlock lock{shard->fSpinLock};
 
-    Entry* tmp = fUniquelyKeyedEntryMap.find(key);
+    Entry* tmp = shard->fUniquelyKeyedEntryMap.find(key);
     if (tmp) {
-        fUniquelyKeyedEntryMap.remove(key);
-        fUniquelyKeyedEntryList.remove(tmp);
-        this->recycleEntry(tmp);
+        RemoveEntry(shard, tmp);
     }
 }
 
@@ -69,35 +69,38 @@ public:
     ~GrThreadSafeCache();
 
 #if GR_TEST_UTILS
-    int numEntries() const  SK_EXCLUDES(fSpinLock);
+    int numEntries() const  SK_EXCLUDES(fAllShards);
 
-    size_t approxBytesUsedForHash() const  SK_EXCLUDES(fSpinLock);
+    size_t approxBytesUsedForHash() const  SK_EXCLUDES(fAllShards);
 #endif
 
-    void dropAllRefs()  SK_EXCLUDES(fSpinLock);
+    void dropAllRefs()  SK_EXCLUDES(fAllShards);
 
     // Drop uniquely held refs until under the resource cache's budget.
     // A null parameter means drop all uniquely held refs.
-    void dropUniqueRefs(GrResourceCache* resourceCache)  SK_EXCLUDES(fSpinLock);
+    void dropUniqueRefs(GrResourceCache* resourceCache)  SK_EXCLUDES(fAllShards);
 
     // Drop uniquely held refs that were last accessed before 'purgeTime'
-    void dropUniqueRefsOlderThan(GrStdSteadyClock::time_point purgeTime)  SK_EXCLUDES(fSpinLock);
+    void dropUniqueRefsOlderThan(GrStdSteadyClock::time_point purgeTime)  SK_EXCLUDES(fAllShards);
 
-    SkDEBUGCODE(bool has(const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);)
+    SkDEBUGCODE(bool has(const skgpu::UniqueKey& key)  SK_EXCLUDES(fAllShards, shardLock(key));)
 
-    GrSurfaceProxyView find(const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+    GrSurfaceProxyView find(const skgpu::UniqueKey& key)  SK_EXCLUDES(fAllShards, shardLock(key));
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> findWithData(
-            const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey& key)  SK_EXCLUDES(fAllShards, shardLock(key));
 
-    GrSurfaceProxyView add(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+    GrSurfaceProxyView add(const skgpu::UniqueKey& key,
+                           const GrSurfaceProxyView&)  SK_EXCLUDES(fAllShards, shardLock(key));
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> addWithData(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey& key,
+            const GrSurfaceProxyView&)  SK_EXCLUDES(fAllShards, shardLock(key));
 
-    GrSurfaceProxyView findOrAdd(const skgpu::UniqueKey&,
-                                 const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+    GrSurfaceProxyView findOrAdd(const skgpu::UniqueKey& key,
+                                 const GrSurfaceProxyView&)
+            SK_EXCLUDES(fAllShards, shardLock(key));
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> findOrAddWithData(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey& key,
+            const GrSurfaceProxyView&)  SK_EXCLUDES(fAllShards, shardLock(key));
 
     // To hold vertex data in the cache and have it transparently transition from cpu-side to
     // gpu-side while being shared between all the threads we need a ref counted object that
@@ -164,16 +167,17 @@ public:
                                             size_t vertexSize);
 
     std::tuple<sk_sp<VertexData>, sk_sp<SkData>> findVertsWithData(
-            const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey& key)  SK_EXCLUDES(fAllShards, shardLock(key));
 
     typedef bool (*IsNewerBetter)(SkData* incumbent, SkData* challenger);
 
     std::tuple<sk_sp<VertexData>, sk_sp<SkData>> addVertsWithData(
-                                                        const skgpu::UniqueKey&,
+                                                        const skgpu::UniqueKey& key,
                                                         sk_sp<VertexData>,
-                                                        IsNewerBetter)  SK_EXCLUDES(fSpinLock);
+                                                        IsNewerBetter)
+            SK_EXCLUDES(fAllShards, shardLock(key));
 
-    void remove(const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+    void remove(const skgpu::UniqueKey& key)  SK_EXCLUDES(fAllShards, shardLock(key));
 
     // To allow gpu-created resources to have priority, we pre-emptively place a lazy proxy
     // in the thread-safe cache (with findOrAdd). The Trampoline object allows that lazy proxy to
@@ -293,36 +297,74 @@ private:
         } fTag { kEmpty };
     };
 
-    void makeExistingEntryMRU(Entry*)  SK_REQUIRES(fSpinLock);
-    Entry* makeNewEntryMRU(Entry*)  SK_REQUIRES(fSpinLock);
+    // Entries are spread over independently locked shards by key hash, so that recording threads
+    // looking up different keys rarely contend. Each shard keeps its own LRU list. Purging in
+    // LRU order across the whole cache locks every shard and merges their lists by last access.
+    static constexpr int kNumShards = 16;
 
-    Entry* getEntry(const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_REQUIRES(fSpinLock);
-    Entry* getEntry(const skgpu::UniqueKey&, sk_sp<VertexData>)  SK_REQUIRES(fSpinLock);
+    struct Shard {
+        mutable SkSpinlock fSpinLock;
 
-    void recycleEntry(Entry*)  SK_REQUIRES(fSpinLock);
+        SkTDynamicHash<Entry, skgpu::UniqueKey> fUniquelyKeyedEntryMap  SK_GUARDED_BY(fSpinLock);
+        // The head of this list is the MRU
+        SkTInternalLList<Entry>            fUniquelyKeyedEntryList  SK_GUARDED_BY(fSpinLock);
 
-    std::tuple<GrSurfaceProxyView, sk_sp<SkData>> internalFind(
-            const skgpu::UniqueKey&)  SK_REQUIRES(fSpinLock);
-    std::tuple<GrSurfaceProxyView, sk_sp<SkData>> internalAdd(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_REQUIRES(fSpinLock);
+        // TODO: empirically determine this from the skps
+        static const int kInitialArenaSize = 4 * sizeof(Entry);
 
-    std::tuple<sk_sp<VertexData>, sk_sp<SkData>> internalFindVerts(
-            const skgpu::UniqueKey&)  SK_REQUIRES(fSpinLock);
-    std::tuple<sk_sp<VertexData>, sk_sp<SkData>> internalAddVerts(
-            const skgpu::UniqueKey&, sk_sp<VertexData>, IsNewerBetter)  SK_REQUIRES(fSpinLock);
-
-    mutable SkSpinlock fSpinLock;
-
-    SkTDynamicHash<Entry, skgpu::UniqueKey> fUniquelyKeyedEntryMap  SK_GUARDED_BY(fSpinLock);
-    // The head of this list is the MRU
-    SkTInternalLList<Entry>            fUniquelyKeyedEntryList  SK_GUARDED_BY(fSpinLock);
-
-    // TODO: empirically determine this from the skps
-    static const int kInitialArenaSize = 64 * sizeof(Entry);
+        char                         fStorage[kInitialArenaSize];
+        SkArenaAlloc                 fEntryAllocator{fStorage, kInitialArenaSize,
+                                                     kInitialArenaSize};
+        Entry*                       fFreeEntryList  SK_GUARDED_BY(fSpinLock) = nullptr;
+    };
 
-    char                         fStorage[kInitialArenaSize];
-    SkArenaAlloc                 fEntryAllocator{fStorage, kInitialArenaSize, kInitialArenaSize};
-    Entry*                       fFreeEntryList  SK_GUARDED_BY(fSpinLock);
+    Shard* shardFor(const skgpu::UniqueKey& key) {
+        // SkTDynamicHash indexes with the low bits of the hash, so pick the shard with the high.
+        return &fShards[key.hash() >> 28];
+    }
+    static_assert(kNumShards == 1 << (32 - 28));
+
+    // The lock of the shard that holds 'key', which the per-key calls take.
+    SkSpinlock& shardLock(const skgpu::UniqueKey& key)
+            SK_RETURN_CAPABILITY(this->shardFor(key)->fSpinLock) {
+        return this->shardFor(key)->fSpinLock;
+    }
+
+    // Holding every shard's lock at once, as purging in global LRU order does. The analysis can't
+    // follow a loop over the shards, so this stands in for all of their locks, and
+    // assertShardLocked() hands out each shard's lock while it is held.
+    class SK_CAPABILITY("mutex") AllShards {};
+    mutable AllShards fAllShards;
+
+    void lockAllShards() const  SK_ACQUIRE(fAllShards);
+    void unlockAllShards() const  SK_RELEASE_CAPABILITY(fAllShards);
+    void assertShardLocked(const Shard* shard) const
+            SK_REQUIRES(fAllShards) SK_ASSERT_CAPABILITY(shard->fSpinLock) {}
+
+    static void MakeExistingEntryMRU(Shard* shard, Entry*)  SK_REQUIRES(shard->fSpinLock);
+    static Entry* MakeNewEntryMRU(Shard* shard, Entry*)  SK_REQUIRES(shard->fSpinLock);
+
+    static Entry* GetEntry(Shard* shard, const skgpu::UniqueKey&,
+                           const GrSurfaceProxyView&)  SK_REQUIRES(shard->fSpinLock);
+    static Entry* GetEntry(Shard* shard, const skgpu::UniqueKey&,
+                           sk_sp<VertexData>)  SK_REQUIRES(shard->fSpinLock);
+
+    static void RemoveEntry(Shard* shard, Entry*)  SK_REQUIRES(shard->fSpinLock);
+    static void RecycleEntry(Shard* shard, Entry*)  SK_REQUIRES(shard->fSpinLock);
+
+    static std::tuple<GrSurfaceProxyView, sk_sp<SkData>> InternalFind(
+            Shard* shard, const skgpu::UniqueKey&)  SK_REQUIRES(shard->fSpinLock);
+    static std::tuple<GrSurfaceProxyView, sk_sp<SkData>> InternalAdd(
+            Shard* shard, const skgpu::UniqueKey&,
+            const GrSurfaceProxyView&)  SK_REQUIRES(shard->fSpinLock);
+
+    static std::tuple<sk_sp<VertexData>, sk_sp<SkData>> InternalFindVerts(
+            Shard* shard, const skgpu::UniqueKey&)  SK_REQUIRES(shard->fSpinLock);
+    static std::tuple<sk_sp<VertexData>, sk_sp<SkData>> InternalAddVerts(
+            Shard* shard, const skgpu::UniqueKey&, sk_sp<VertexData>,
+            IsNewerBetter)  SK_REQUIRES(shard->fSpinLock);
+
+    Shard fShards[kNumShards];
 };
 
 #endif // GrThreadSafeCache_DEFINED
@@ -713,4 +713,28 @@ int GrAATriangulator::polysToAATriangles(Poly* polys,
     return actualCount;
 }
 
+int GrAATriangulator::PathToAATrianglesParallel(const SkPath& path, SkScalar tolerance,
+                                                const SkRect& clipBounds,
+                                                GrEagerVertexAllocator* vertexAllocator,
+                                                SkExecutor* executor) {
+    // The alpha ramps reach half a pixel past the path, so keep components a pixel apart.
+    SkTArray<SkPath> components;
+    if (!executor || !SplitIntoComponents(path, 1, &components)) {
+        return PathToAATriangles(path, tolerance, clipBounds, vertexAllocator);
+    }
+    // SkPath computes its bounds lazily, so read them here rather than on the workers.
+    const SkRect sweepBounds = path.getBounds();
+    bool isLinear;
+    return TriangulateComponents(components, executor, vertexAllocator, &isLinear,
+            [&, sweepBounds](const SkPath& component, GrEagerVertexAllocator* allocator, bool* linear) {
+                SkArenaAlloc alloc(kArenaDefaultChunkSize);
+                GrAATriangulator aaTriangulator(component, &alloc);
+                aaTriangulator.fRoundVerticesToQuarterPixel = true;
+                aaTriangulator.fEmitCoverage = true;
+                aaTriangulator.fSweepBounds = sweepBounds;
+                auto [polys, success] = aaTriangulator.pathToPolys(tolerance, clipBounds, linear);
+                return success ? aaTriangulator.polysToAATriangles(polys, allocator) : 0;
+            });
+}
+
 #endif // SK_ENABLE_OPTIMIZE_SIZE
@@ -29,6 +29,13 @@ public:
         return aaTriangulator.polysToAATriangles(polys, vertexAllocator);
     }
 
+    // Like PathToAATriangles(), but the disjoint components of large paths are triangulated
+    // concurrently on 'executor' (see GrTriangulator::PathToTrianglesParallel).
+    static int PathToAATrianglesParallel(const SkPath& path, SkScalar tolerance,
+                                         const SkRect& clipBounds,
+                                         GrEagerVertexAllocator* vertexAllocator,
+                                         SkExecutor* executor);
+
     // Structs used by GrAATriangulator internals.
     struct SSEdge;
     struct EventList;
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/geometry/GrTriangulationCache.h"
+
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkPathPriv.h"
+#include "src/gpu/ganesh/GrEagerVertexAllocator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace GrTriangulationCache {
+
+static constexpr SkFourByteTag kTag = SkSetFourByteTag('T', 'R', 'I', 'S');
+// Bump this whenever the triangulators' output, or the layout of the data, changes.
+static constexpr uint32_t kVersion = 2;
+
+struct Header {
+    SkFourByteTag fTag;
+    uint32_t fVersion;
+    uint32_t fVertexStride;
+    int32_t fVertexCount;
+    uint32_t fIsLinear;
+    // Size of the key, points, weights and verbs that precede the vertices.
+    uint32_t fPathBytes;
+};
+
+// The key and path are stored as the key, then the points, conic weights and verbs, padded so the
+// vertices that follow stay aligned.
+static size_t path_bytes(const SkData& key, const SkPath& path) {
+    return SkAlign4(key.size() + path.countPoints() * sizeof(SkPoint) +
+                    SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar) + path.countVerbs());
+}
+
+// Calls 'fn' with each (pointer, size) part of the stored key and path, in order.
+template <typename Fn>
+static void for_each_path_part(const SkData& key, const SkPath& path, Fn&& fn) {
+    fn(key.data(), key.size());
+    fn(SkPathPriv::PointData(path), path.countPoints() * sizeof(SkPoint));
+    fn(SkPathPriv::ConicWeightData(path), SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar));
+    fn(SkPathPriv::VerbData(path), (size_t)path.countVerbs());
+}
+
+SkScalar BucketTolerance(SkScalar tolerance) {
+    if (!(tolerance > 0) || !SkScalarIsFinite(tolerance)) {
+        return tolerance;
+    }
+    // Use exact constants for the fractional steps, so the buckets are the same everywhere.
+    static constexpr float kQuarterSteps[4] = {1, 1.18920712f, 1.41421356f, 1.68179283f};
+    int quarters = (int)std::floor(4 * std::log2(tolerance));
+    SkScalar bucket = std::ldexp(kQuarterSteps[quarters & 3], quarters >> 2);
+    // log2() may round up across a step boundary.
+    return bucket > tolerance ? std::ldexp(kQuarterSteps[(quarters - 1) & 3], (quarters - 1) >> 2)
+                              : bucket;
+}
+
+sk_sp<SkData> MakeKey(const SkPath& path, SkScalar tolerance, bool antialias,
+                      const SkRect& clipBounds) {
+    struct Key {
+        SkFourByteTag fTag;
+        uint32_t fVersion;
+        uint32_t fFlags;
+        SkScalar fTolerance;
+        int32_t fVerbCount;
+        int32_t fPointCount;
+        uint32_t fHash[3];
+        SkRect fBounds;
+        SkRect fClipBounds;
+    } key;
+    memset(&key, 0, sizeof(key));
+    key.fTag = kTag;
+    key.fVersion = kVersion;
+    key.fFlags = (uint32_t)path.getFillType() | (antialias ? 1 << 2 : 0);
+    key.fTolerance = tolerance;
+    key.fVerbCount = path.countVerbs();
+    key.fPointCount = path.countPoints();
+    // Two seeds over the points give a 64-bit hash of the bulk of the data.
+    const SkPoint* points = SkPathPriv::PointData(path);
+    size_t pointBytes = key.fPointCount * sizeof(SkPoint);
+    key.fHash[0] = SkOpts::hash_fn(points, pointBytes, 0);
+    key.fHash[1] = SkOpts::hash_fn(points, pointBytes, 0x9e3779b9);
+    uint32_t verbHash = SkOpts::hash_fn(SkPathPriv::VerbData(path), key.fVerbCount, 0);
+    key.fHash[2] = SkOpts::hash_fn(SkPathPriv::ConicWeightData(path),
+                                   SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar),
+                                   verbHash);
+    key.fBounds = path.getBounds();
+    if (path.isInverseFillType()) {
+        // Only inverse fills depend on the clip.
+        key.fClipBounds = clipBounds;
+    }
+    return SkData::MakeWithCopy(&key, sizeof(key));
+}
+
+sk_sp<SkData> PackVertices(const SkData& key, const SkPath& path, const void* vertices,
+                           int vertexCount, size_t vertexStride, bool isLinear) {
+    size_t pathBytes = path_bytes(key, path);
+    size_t vertexBytes = vertexCount * vertexStride;
+    sk_sp<SkData> data = SkData::MakeZeroInitialized(sizeof(Header) + pathBytes + vertexBytes);
+    Header header = {kTag, kVersion, (uint32_t)vertexStride, vertexCount, isLinear,
+                     (uint32_t)pathBytes};
+    char* ptr = static_cast<char*>(data->writable_data());
+    memcpy(ptr, &header, sizeof(Header));
+    char* dst = ptr + sizeof(Header);
+    for_each_path_part(key, path, [&](const void* part, size_t size) {
+        if (size) {
+            memcpy(dst, part, size);
+            dst += size;
+        }
+    });
+    if (vertexBytes) {
+        memcpy(ptr + sizeof(Header) + pathBytes, vertices, vertexBytes);
+    }
+    return data;
+}
+
+bool UnpackVertices(const SkData& data, const SkData& key, const SkPath& path,
+                    const void** vertices, int* vertexCount, size_t* vertexStride, bool* isLinear) {
+    Header header;
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(Header));
+    size_t pathBytes = path_bytes(key, path);
+    // The triangulators write a position, plus a coverage when antialiasing.
+    if (header.fTag != kTag || header.fVersion != kVersion ||
+        (header.fVertexStride != sizeof(SkPoint) &&
+         header.fVertexStride != sizeof(SkPoint) + sizeof(float)) ||
+        header.fVertexCount < 0 || header.fVertexCount % 3 != 0 ||
+        header.fPathBytes != pathBytes) {
+        return false;
+    }
+    // The data comes from the client's cache, so it may be truncated or corrupt. Check the sizes
+    // without wrapping, even where size_t is 32 bits.
+    if (data.size() - sizeof(Header) < pathBytes) {
+        return false;
+    }
+    // A non-negative int32 count times a stride of at most 12 can't overflow 64 bits.
+    uint64_t vertexBytes = (uint64_t)header.fVertexCount * header.fVertexStride;
+    if (vertexBytes != (uint64_t)(data.size() - sizeof(Header) - pathBytes)) {
+        return false;
+    }
+    // The key is only a hash of the path, so check that this is the same one.
+    const uint8_t* src = data.bytes() + sizeof(Header);
+    bool matches = true;
+    for_each_path_part(key, path, [&](const void* part, size_t size) {
+        if (matches && size) {
+            matches = !memcmp(src, part, size);
+            src += size;
+        }
+    });
+    if (!matches) {
+        return false;
+    }
+    *vertices = data.bytes() + sizeof(Header) + pathBytes;
+    *vertexCount = header.fVertexCount;
+    *vertexStride = header.fVertexStride;
+    *isLinear = header.fIsLinear != 0;
+    return true;
+}
+
+static int copy_vertices(const void* vertices, int vertexCount, size_t vertexStride,
+                         GrEagerVertexAllocator* vertexAllocator) {
+    if (vertexCount == 0) {
+        return 0;
+    }
+    void* dst = vertexAllocator->lock(vertexStride, vertexCount);
+    if (!dst) {
+        return 0;
+    }
+    memcpy(dst, vertices, vertexCount * vertexStride);
+    vertexAllocator->unlock(vertexCount);
+    return vertexCount;
+}
+
+int Triangulate(GrContextOptions::PersistentCache* cache,
+                const SkData& key,
+                const SkPath& path,
+                GrEagerVertexAllocator* vertexAllocator,
+                bool* isLinear,
+                const TriangulateProc& triangulate) {
+    if (sk_sp<SkData> data = cache->load(key)) {
+        const void* vertices;
+        int vertexCount;
+        size_t vertexStride;
+        if (UnpackVertices(*data, key, path, &vertices, &vertexCount, &vertexStride, isLinear)) {
+            return copy_vertices(vertices, vertexCount, vertexStride, vertexAllocator);
+        }
+    }
+
+    *isLinear = false;
+    GrCpuVertexAllocator cpuAllocator;
+    int vertexCount = triangulate(&cpuAllocator, isLinear);
+    if (vertexCount == 0) {
+        // A failed triangulation also produces no vertices, so don't remember it.
+        return 0;
+    }
+    sk_sp<GrThreadSafeCache::VertexData> vertexData = cpuAllocator.detachVertexData();
+    sk_sp<SkData> data = PackVertices(key, path, vertexData->vertices(),
+                                      vertexData->numVertices(), vertexData->vertexSize(),
+                                      *isLinear);
+    cache->store(key, *data, SkStringPrintf("Triangulated path: %d verts", vertexCount));
+    return copy_vertices(vertexData->vertices(), vertexData->numVertices(),
+                         vertexData->vertexSize(), vertexAllocator);
+}
+
+}  // namespace GrTriangulationCache
+
+#endif // SK_ENABLE_OPTIMIZE_SIZE
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrTriangulationCache_DEFINED
+#define GrTriangulationCache_DEFINED
+
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/gpu/GrContextOptions.h"
+
+#include <cstddef>
+#include <functional>
+
+class GrEagerVertexAllocator;
+class SkPath;
+struct SkRect;
+
+// Stores path triangulations in a GrContextOptions::PersistentCache, so static paths need not be
+// triangulated again after a restart or a context loss.
+//
+// The key is a hash of the path's verbs, points and conic weights, plus its bounds, fill type,
+// AA mode, tolerance bucket and (for inverse fills) clip bounds. Since hashes can collide, the data
+// also holds the key and the path's verbs, points and weights, which must match on load. They are
+// followed by the vertices exactly as the triangulator wrote them.
+namespace GrTriangulationCache {
+
+// Rounds a tolerance down to a quarter power of two. Triangulating at the rounded tolerance gives
+// a result that is fine enough for every tolerance in the bucket, so they can share an entry.
+SkScalar BucketTolerance(SkScalar tolerance);
+
+sk_sp<SkData> MakeKey(const SkPath& path, SkScalar tolerance, bool antialias,
+                      const SkRect& clipBounds);
+
+// 'key' and 'path' must be the ones the key was made from.
+sk_sp<SkData> PackVertices(const SkData& key, const SkPath& path, const void* vertices,
+                           int vertexCount, size_t vertexStride, bool isLinear);
+
+// Returns false if 'data' is not a valid triangulation written by this version of Skia, or if it
+// was written for a different key or path.
+bool UnpackVertices(const SkData& data, const SkData& key, const SkPath& path,
+                    const void** vertices, int* vertexCount, size_t* vertexStride, bool* isLinear);
+
+// Writes the triangulation of 'path' stored under 'key' into 'vertexAllocator'. If there is none,
+// this runs 'triangulate' instead and stores its result. Returns the vertex count.
+using TriangulateProc = std::function<int(GrEagerVertexAllocator*, bool* isLinear)>;
+int Triangulate(GrContextOptions::PersistentCache* cache,
+                const SkData& key,
+                const SkPath& path,
+                GrEagerVertexAllocator* vertexAllocator,
+                bool* isLinear,
+                const TriangulateProc& triangulate);
+
+}  // namespace GrTriangulationCache
+
+#endif // SK_ENABLE_OPTIMIZE_SIZE
+
+#endif
@@ -11,10 +11,14 @@
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/geometry/GrPathUtils.h"
 
+#include "include/core/SkExecutor.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPointPriv.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
 
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
@@ -1541,7 +1545,7 @@ void GrTriangulator::SortMesh(VertexList* vertices, const Comparator& c) {
 }
 
 std::tuple<Poly*, bool> GrTriangulator::contoursToPolys(VertexList* contours, int contourCnt) {
-    const SkRect& pathBounds = fPath.getBounds();
+    const SkRect& pathBounds = fSweepBounds.isEmpty() ? fPath.getBounds() : fSweepBounds;
     Comparator c(pathBounds.width() > pathBounds.height() ? Comparator::Direction::kHorizontal
                                                           : Comparator::Direction::kVertical);
     VertexList mesh;
@@ -1665,4 +1669,164 @@ int GrTriangulator::polysToTriangles(Poly* polys, GrEagerVertexAllocator* vertex
     return actualCount;
 }
 
+// Below this many points a path is triangulated serially; the split and the copy would cost more
+// than the concurrency saves. Components are also batched up to at least this size.
+static constexpr int kMinParallelPoints = 1024;
+
+bool GrTriangulator::SplitIntoComponents(const SkPath& path, SkScalar outset,
+                                         SkTArray<SkPath>* components) {
+    if (path.isInverseFillType() || path.countPoints() < 2 * kMinParallelPoints) {
+        return false;
+    }
+    // Each contour's fill lies within the hull of its points, so within its (control) bounds.
+    SkTArray<SkPath> contours;
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb: contours.push_back().moveTo(pts[0]); break;
+            case SkPath::kLine_Verb: contours.back().lineTo(pts[1]); break;
+            case SkPath::kQuad_Verb: contours.back().quadTo(pts[1], pts[2]); break;
+            case SkPath::kConic_Verb:
+                contours.back().conicTo(pts[1], pts[2], iter.conicWeight());
+                break;
+            case SkPath::kCubic_Verb: contours.back().cubicTo(pts[1], pts[2], pts[3]); break;
+            case SkPath::kClose_Verb: contours.back().close(); break;
+            case SkPath::kDone_Verb: break;
+        }
+    }
+    int n = contours.size();
+    if (n < 2) {
+        return false;
+    }
+
+    // Union the contours whose outset bounds overlap, sweeping them in order of their left edge.
+    std::unique_ptr<SkRect[]> bounds(new SkRect[n]);
+    std::unique_ptr<int[]> order(new int[n]);
+    std::unique_ptr<int[]> parent(new int[n]);
+    for (int i = 0; i < n; ++i) {
+        bounds[i] = contours[i].getBounds().makeOutset(outset, outset);
+        order[i] = i;
+        parent[i] = i;
+    }
+    auto find = [&](int i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    std::sort(order.get(), order.get() + n, [&](int a, int b) {
+        return bounds[a].fLeft < bounds[b].fLeft || (bounds[a].fLeft == bounds[b].fLeft && a < b);
+    });
+    for (int i = 0; i < n; ++i) {
+        const SkRect& a = bounds[order[i]];
+        for (int j = i + 1; j < n && bounds[order[j]].fLeft <= a.fRight; ++j) {
+            const SkRect& b = bounds[order[j]];
+            if (b.fTop <= a.fBottom && a.fTop <= b.fBottom) {
+                int rootA = find(order[i]), rootB = find(order[j]);
+                // Keep the lowest contour index as the root, so the component order is stable.
+                parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+            }
+        }
+    }
+
+    // Gather the components in order of their first contour, batching small ones together.
+    std::unique_ptr<int[]> componentOf(new int[n]);
+    SkTArray<SkPath> groups;
+    int groupPoints = 0;
+    for (int i = 0; i < n; ++i) {
+        int root = find(i);
+        if (root == i) {
+            if (groups.empty() || groupPoints >= kMinParallelPoints) {
+                groups.push_back().setFillType(path.getFillType());
+                groupPoints = 0;
+            }
+            componentOf[i] = groups.size() - 1;
+        } else {
+            componentOf[i] = componentOf[root];
+        }
+        groups[componentOf[i]].addPath(contours[i]);
+        groupPoints += contours[i].countPoints();
+    }
+    if (groups.size() < 2) {
+        return false;
+    }
+    *components = std::move(groups);
+    return true;
+}
+
+int GrTriangulator::TriangulateComponents(const SkTArray<SkPath>& components,
+                                          SkExecutor* executor,
+                                          GrEagerVertexAllocator* vertexAllocator,
+                                          bool* isLinear,
+                                          const TriangulateProc& triangulate) {
+    struct Result {
+        GrCpuVertexAllocator fAllocator;
+        sk_sp<GrThreadSafeCache::VertexData> fVertexData;
+        bool fIsLinear = true;
+    };
+    int n = components.size();
+    std::unique_ptr<Result[]> results(new Result[n]);
+    SkTaskGroup taskGroup(*executor);
+    for (int i = 0; i < n; ++i) {
+        taskGroup.add([&, i] {
+            Result& result = results[i];
+            if (triangulate(components[i], &result.fAllocator, &result.fIsLinear) > 0) {
+                result.fVertexData = result.fAllocator.detachVertexData();
+            }
+        });
+    }
+    taskGroup.wait();
+
+    *isLinear = true;
+    int64_t count64 = 0;
+    size_t vertexStride = 0;
+    for (int i = 0; i < n; ++i) {
+        *isLinear = *isLinear && results[i].fIsLinear;
+        if (results[i].fVertexData) {
+            count64 += results[i].fVertexData->numVertices();
+            vertexStride = results[i].fVertexData->vertexSize();
+        }
+    }
+    if (0 == count64 || count64 > SK_MaxS32) {
+        return 0;
+    }
+    int count = count64;
+    char* verts = static_cast<char*>(vertexAllocator->lock(vertexStride, count));
+    if (!verts) {
+        SkDebugf("Could not allocate vertices\n");
+        return 0;
+    }
+    for (int i = 0; i < n; ++i) {
+        if (const GrThreadSafeCache::VertexData* data = results[i].fVertexData.get()) {
+            SkASSERT(data->vertexSize() == vertexStride);
+            memcpy(verts, data->vertices(), data->size());
+            verts += data->size();
+        }
+    }
+    vertexAllocator->unlock(count);
+    return count;
+}
+
+int GrTriangulator::PathToTrianglesParallel(const SkPath& path, SkScalar tolerance,
+                                            const SkRect& clipBounds,
+                                            GrEagerVertexAllocator* vertexAllocator,
+                                            bool* isLinear, SkExecutor* executor) {
+    SkTArray<SkPath> components;
+    if (!executor || !path.isFinite() || !SplitIntoComponents(path, 0, &components)) {
+        return PathToTriangles(path, tolerance, clipBounds, vertexAllocator, isLinear);
+    }
+    // SkPath computes its bounds lazily, so read them here rather than on the workers.
+    const SkRect sweepBounds = path.getBounds();
+    return TriangulateComponents(components, executor, vertexAllocator, isLinear,
+            [&, sweepBounds](const SkPath& component, GrEagerVertexAllocator* allocator, bool* linear) {
+                SkArenaAlloc alloc(kArenaDefaultChunkSize);
+                GrTriangulator triangulator(component, &alloc);
+                triangulator.fSweepBounds = sweepBounds;
+                auto [polys, success] = triangulator.pathToPolys(tolerance, clipBounds, linear);
+                return success ? triangulator.polysToTriangles(polys, allocator) : 0;
+            });
+}
+
 #endif // SK_ENABLE_OPTIMIZE_SIZE
@@ -13,10 +13,14 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPoint.h"
 #include "include/private/SkColorData.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/gpu/ganesh/GrColor.h"
 
+#include <functional>
+
 class GrEagerVertexAllocator;
+class SkExecutor;
 struct SkRect;
 
 #define TRIANGULATOR_LOGGING 0
@@ -44,6 +48,14 @@ public:
         return count;
     }
 
+    // Like PathToTriangles(), but large paths made of several disjoint components are split up and
+    // the components are triangulated concurrently on 'executor'. The vertices are emitted in the
+    // order of each component's first contour, so the output does not depend on scheduling.
+    static int PathToTrianglesParallel(const SkPath& path, SkScalar tolerance,
+                                       const SkRect& clipBounds,
+                                       GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                                       SkExecutor* executor);
+
     // Enums used by GrTriangulator internals.
     typedef enum { kLeft_Side, kRight_Side } Side;
     enum class EdgeType { kInner, kOuter, kConnector };
@@ -186,6 +198,21 @@ protected:
     static int64_t CountPoints(Poly* polys, SkPathFillType overrideFillType);
     int polysToTriangles(Poly*, GrEagerVertexAllocator*) const;
 
+    // Splits a non-inverse path into groups of contours whose bounds, outset by 'outset', don't
+    // touch. Such groups fill independently of each other, so they can be triangulated separately.
+    // Small components are batched together. Returns false if there would be only one group.
+    static bool SplitIntoComponents(const SkPath&, SkScalar outset,
+                                    SkTArray<SkPath>* components);
+
+    // Runs 'triangulate' on each of 'components' concurrently, then concatenates the vertices into
+    // 'vertexAllocator' in component order.
+    using TriangulateProc = std::function<int(const SkPath&, GrEagerVertexAllocator*, bool*)>;
+    static int TriangulateComponents(const SkTArray<SkPath>& components,
+                                     SkExecutor* executor,
+                                     GrEagerVertexAllocator* vertexAllocator,
+                                     bool* isLinear,
+                                     const TriangulateProc& triangulate);
+
     // FIXME: fPath should be plumbed through function parameters instead.
     const SkPath fPath;
     SkArenaAlloc* const fAlloc;
@@ -198,6 +225,11 @@ protected:
     bool fPreserveCollinearVertices = false;
     bool fCollectBreadcrumbTriangles = false;
 
+    // If not empty, these bounds choose the sweep direction instead of the path's own. The
+    // components of a split path use the whole path's bounds, so they triangulate exactly as they
+    // would have as part of the whole.
+    SkRect fSweepBounds = SkRect::MakeEmpty();
+
     // The breadcrumb triangles serve as a glue that erases T-junctions between a path's outer
     // curves and its inner polygon triangulation. Drawing a path's outer curves, breadcrumb
     // triangles, and inner polygon triangulation all together into the stencil buffer has the same
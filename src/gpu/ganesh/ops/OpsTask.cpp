@@ -33,11 +33,18 @@ namespace {
 // Experimentally we have found that most combining occurs within the first 10 comparisons.
 static const int kMaxOpMergeDistance = 10;
 static const int kMaxOpChainDistance = 10;
+// The number of chains per op class that ops can combine with beyond those distances.
+static const int kMaxMergeCandidatesPerClass = 4;
 
 ////////////////////////////////////////////////////////////////////////////////
 
 inline bool can_reorder(const SkRect& a, const SkRect& b) { return !GrRectsOverlap(a, b); }
 
+// A merge candidate's later bounds stay inverted until something is recorded after its chain.
+inline bool can_reorder_after(const SkRect& laterBounds, const SkRect& bounds) {
+    return laterBounds.fLeft > laterBounds.fRight || can_reorder(laterBounds, bounds);
+}
+
 GrOpsRenderPass* create_render_pass(GrGpu* gpu,
                                     GrRenderTarget* rt,
                                     bool useMSAASurface,
@@ -406,6 +413,7 @@ void OpsTask::deleteOps() {
         chain.deleteOps();
     }
     fOpChains.clear();
+    fMergeCandidates.clear();
 }
 
 OpsTask::~OpsTask() {
@@ -980,7 +988,10 @@ void OpsTask::recordOp(
                op->bounds().fRight, op->bounds().fBottom);
     GrOP_INFO(SkTabString(op->dumpInfo(), 1).c_str());
     GrOP_INFO("\tOutcome:\n");
+    const uint32_t classID = op->classID();
+    const SkRect opBounds = op->bounds();
     int maxCandidates = std::min(kMaxOpChainDistance, fOpChains.size());
+    bool reachedMaxLookback = false;
     if (maxCandidates) {
         int i = 0;
         while (true) {
@@ -988,6 +999,8 @@ void OpsTask::recordOp(
             op = candidate.appendOp(std::move(op), processorAnalysis, dstProxyView, clip, caps,
                                     fArenas->arenaAlloc(), fAuditTrail);
             if (!op) {
+                UpdateMergeCandidates(&fMergeCandidates, classID, fOpChains.size() - 1 - i,
+                                      opBounds);
                 return;
             }
             // Stop going backwards if we would cause a painter's order violation.
@@ -998,17 +1011,83 @@ void OpsTask::recordOp(
             }
             if (++i == maxCandidates) {
                 GrOP_INFO("\t\tBackward: Reached max lookback or beginning of op array %d\n", i);
+                reachedMaxLookback = true;
                 break;
             }
         }
     } else {
         GrOP_INFO("\t\tBackward: FirstOp\n");
     }
+    // Past the lookback, try the recent chains of the same class, if nothing recorded after them
+    // overlaps the op.
+    if (reachedMaxLookback) {
+        for (int c = fMergeCandidates.size() - 1; c >= 0; --c) {
+            const MergeCandidate& candidate = fMergeCandidates[c];
+            if (candidate.fClassID != classID ||
+                candidate.fChainIndex >= fOpChains.size() - kMaxOpChainDistance ||
+                !can_reorder_after(candidate.fLaterBounds, opBounds)) {
+                continue;
+            }
+            int chainIndex = candidate.fChainIndex;
+            op = fOpChains[chainIndex].appendOp(std::move(op), processorAnalysis, dstProxyView,
+                                                clip, caps, fArenas->arenaAlloc(), fAuditTrail);
+            if (!op) {
+                GrOP_INFO("\t\tBackward: Combined with chain %d\n", chainIndex);
+                UpdateMergeCandidates(&fMergeCandidates, classID, chainIndex, opBounds);
+                return;
+            }
+        }
+    }
     if (clip) {
         clip = fArenas->arenaAlloc()->make<GrAppliedClip>(std::move(*clip));
         SkDEBUGCODE(fNumClips++;)
     }
     fOpChains.emplace_back(std::move(op), processorAnalysis, clip, dstProxyView);
+    UpdateMergeCandidates(&fMergeCandidates, classID, fOpChains.size() - 1, opBounds);
+}
+
+void OpsTask::UpdateMergeCandidates(MergeCandidates* candidates, uint32_t classID,
+                                    int chainIndex, const SkRect& bounds) {
+    int found = -1;
+    int classCount = 0;
+    bool isNewest = true;
+    for (int c = 0; c < candidates->size(); ++c) {
+        MergeCandidate& candidate = (*candidates)[c];
+        if (candidate.fChainIndex < chainIndex) {
+            // Ops can have empty bounds and still overlap, so join those too.
+            candidate.fLaterBounds.joinPossiblyEmptyRect(bounds);
+        } else if (candidate.fChainIndex == chainIndex) {
+            found = c;
+        } else {
+            isNewest = false;
+        }
+        classCount += candidate.fClassID == classID;
+    }
+    if (found < 0 && !isNewest) {
+        // We no longer know the bounds of everything after this chain, so it can't come back.
+        return;
+    }
+    // The chain becomes its class's most recently used candidate.
+    MergeCandidate candidate = {classID, chainIndex, SkRectPriv::MakeLargestInverted()};
+    if (found >= 0) {
+        candidate = (*candidates)[found];
+        RemoveMergeCandidate(candidates, found);
+    } else if (classCount == kMaxMergeCandidatesPerClass) {
+        for (int c = 0; c < candidates->size(); ++c) {
+            if ((*candidates)[c].fClassID == classID) {
+                RemoveMergeCandidate(candidates, c);
+                break;
+            }
+        }
+    }
+    candidates->push_back(candidate);
+}
+
+void OpsTask::RemoveMergeCandidate(MergeCandidates* candidates, int index) {
+    for (int c = index + 1; c < candidates->size(); ++c) {
+        (*candidates)[c - 1] = (*candidates)[c];
+    }
+    candidates->pop_back();
 }
 
 void OpsTask::forwardCombine(const GrCaps& caps) {
@@ -1040,6 +1119,34 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
             }
         }
     }
+
+    // Now move chains forward onto a later chain of their class that is beyond the lookahead, when
+    // they don't overlap anything in between. Sweeping forward, each chain is a candidate for the
+    // recent earlier chains of its class.
+    MergeCandidates candidates;
+    for (int j = 0; j < fOpChains.size(); ++j) {
+        OpChain& chain = fOpChains[j];
+        if (!chain.head()) {
+            // This chain was moved forward. Its ops are accounted for where they ended up.
+            continue;
+        }
+        uint32_t classID = chain.head()->classID();
+        for (int c = candidates.size() - 1; c >= 0; --c) {
+            const MergeCandidate& candidate = candidates[c];
+            if (candidate.fClassID != classID ||
+                j - candidate.fChainIndex <= kMaxOpChainDistance) {
+                continue;
+            }
+            OpChain& earlier = fOpChains[candidate.fChainIndex];
+            if (can_reorder_after(candidate.fLaterBounds, earlier.bounds()) &&
+                chain.prependChain(&earlier, caps, fArenas->arenaAlloc(), fAuditTrail)) {
+                GrOP_INFO("\t\t%d: chain -> Combined with chain %d\n", candidate.fChainIndex, j);
+                RemoveMergeCandidate(&candidates, c);
+                break;
+            }
+        }
+        UpdateMergeCandidates(&candidates, classID, j, chain.bounds());
+    }
 }
 
 GrRenderTask::ExpectedOutcome OpsTask::onMakeClosed(GrRecordingContext* rContext,
@@ -258,6 +258,24 @@ private:
 
     void forwardCombine(const GrCaps&);
 
+    // A recent chain of an op class, and the bounds of everything recorded after it. An op of that
+    // class can combine with the chain from any distance, as long as it doesn't overlap those
+    // bounds. This lets us batch interleaved content (e.g. text between rects) that is too far
+    // apart for the fixed lookback. We keep the few chains of each class that most recently took
+    // ops, so ops of one class that can't combine with each other don't push out the others.
+    struct MergeCandidate {
+        uint32_t fClassID;
+        int fChainIndex;
+        SkRect fLaterBounds;
+    };
+    // Least recently used first.
+    using MergeCandidates = SkSTArray<16, MergeCandidate, true>;
+
+    // Call after ops of 'classID' with 'bounds' have been added to the chain at 'chainIndex'.
+    static void UpdateMergeCandidates(MergeCandidates*, uint32_t classID, int chainIndex,
+                                      const SkRect& bounds);
+    static void RemoveMergeCandidate(MergeCandidates*, int index);
+
     // Remove all ops, proxies, etc. Used in the merging algorithm when tasks can be skipped.
     void reset();
 
@@ -289,6 +307,7 @@ private:
 
     // For ops/opsTask we have mean: 5 stdDev: 28
     SkSTArray<25, OpChain> fOpChains;
+    MergeCandidates fMergeCandidates;
 
     sk_sp<GrArenas> fArenas;
     SkDEBUGCODE(int fNumClips;)
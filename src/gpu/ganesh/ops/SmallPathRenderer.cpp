@@ -16,11 +16,14 @@
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkPointPriv.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/BufferWriter.h"
 #include "src/gpu/ganesh/GrBuffer.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDistanceFieldGenFromVector.h"
 #include "src/gpu/ganesh/GrDrawOpTest.h"
+#include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/effects/GrBitmapTextGeoProc.h"
@@ -66,15 +69,19 @@ public:
                             const SkMatrix& viewMatrix,
                             bool gammaCorrect,
                             const GrUserStencilSettings* stencilSettings) {
+        // The distance fields of new shapes are generated on the context's executor, if it has
+        // one.
+        SkExecutor* executor = context->priv().options().fExecutor;
         return Helper::FactoryHelper<SmallPathOp>(context, std::move(paint), shape, viewMatrix,
-                                                  gammaCorrect, stencilSettings);
+                                                  gammaCorrect, stencilSettings, executor);
     }
 
     SmallPathOp(GrProcessorSet* processorSet, const SkPMColor4f& color, const GrStyledShape& shape,
                 const SkMatrix& viewMatrix, bool gammaCorrect,
-                const GrUserStencilSettings* stencilSettings)
+                const GrUserStencilSettings* stencilSettings, SkExecutor* executor)
             : INHERITED(ClassID())
-            , fHelper(processorSet, GrAAType::kCoverage, stencilSettings) {
+            , fHelper(processorSet, GrAAType::kCoverage, stencilSettings)
+            , fExecutor(executor) {
         SkASSERT(shape.hasUnstyledKey());
         // Compute bounds
         this->setTransformedBounds(shape.bounds(), viewMatrix, HasAABloat::kYes, IsHairline::kNo);
@@ -215,72 +222,37 @@ private:
             return;
         }
 
+        // Generate the distance fields of all the new shapes up front, so they can be generated in
+        // parallel.
+        std::unique_ptr<DFPathImage[]> dfImages;
+        if (fUsesDistanceField && fExecutor) {
+            dfImages = this->generateDFPaths(atlasMgr);
+        }
+
         flushInfo.fInstancesToFlush = 0;
         for (int i = 0; i < instanceCount; i++) {
             const Entry& args = fShapes[i];
 
             skgpu::v1::SmallPathShapeData* shapeData;
             if (fUsesDistanceField) {
-                // get mip level
-                SkScalar maxScale;
-                const SkRect& bounds = args.fShape.bounds();
-                if (args.fViewMatrix.hasPerspective()) {
-                    // approximate the scale since we can't get it from the matrix
-                    SkRect xformedBounds;
-                    args.fViewMatrix.mapRect(&xformedBounds, bounds);
-                    maxScale = SkScalarAbs(std::max(xformedBounds.width() / bounds.width(),
-                                                  xformedBounds.height() / bounds.height()));
-                } else {
-                    maxScale = SkScalarAbs(args.fViewMatrix.getMaxScale());
-                }
-                SkScalar maxDim = std::max(bounds.width(), bounds.height());
-                // We try to create the DF at a 2^n scaled path resolution (1/2, 1, 2, 4, etc.)
-                // In the majority of cases this will yield a crisper rendering.
-                SkScalar mipScale = 1.0f;
-                // Our mipscale is the maxScale clamped to the next highest power of 2
-                if (maxScale <= SK_ScalarHalf) {
-                    SkScalar log = SkScalarFloorToScalar(SkScalarLog2(SkScalarInvert(maxScale)));
-                    mipScale = SkScalarPow(2, -log);
-                } else if (maxScale > SK_Scalar1) {
-                    SkScalar log = SkScalarCeilToScalar(SkScalarLog2(maxScale));
-                    mipScale = SkScalarPow(2, log);
-                }
-                // Log2 isn't very precise at values close to a power of 2,
-                // so add a little tolerance here. A little bit of scaling up is fine.
-                SkASSERT(maxScale <= mipScale + SK_ScalarNearlyZero);
-
-                SkScalar mipSize = mipScale*SkScalarAbs(maxDim);
-                // For sizes less than kIdealMinMIP we want to use as large a distance field as we can
-                // so we can preserve as much detail as possible. However, we can't scale down more
-                // than a 1/4 of the size without artifacts. So the idea is that we pick the mipsize
-                // just bigger than the ideal, and then scale down until we are no more than 4x the
-                // original mipsize.
-                if (mipSize < kIdealMinMIP) {
-                    SkScalar newMipSize = mipSize;
-                    do {
-                        newMipSize *= 2;
-                    } while (newMipSize < kIdealMinMIP);
-                    while (newMipSize > 4 * mipSize) {
-                        newMipSize *= 0.25f;
-                    }
-                    mipSize = newMipSize;
-                }
-
-                SkScalar desiredDimension = std::min(mipSize, kMaxMIP);
+                SkScalar scale;
+                SkScalar desiredDimension = DFDimension(args.fShape, args.fViewMatrix, &scale);
                 int ceilDesiredDimension = SkScalarCeilToInt(desiredDimension);
 
                 // check to see if df path is cached
                 shapeData = atlasMgr->findOrCreate(args.fShape, ceilDesiredDimension);
                 if (!shapeData->fAtlasLocator.plotLocator().isValid()) {
-                    SkScalar scale = desiredDimension / maxDim;
-
+                    DFPathImage localImage;
+                    DFPathImage* image = dfImages ? &dfImages[i] : nullptr;
+                    if (!image || !image->fGenerated) {
+                        GenerateDFPath(args.fShape, scale, &localImage);
+                        image = &localImage;
+                    }
                     if (!this->addDFPathToAtlas(target,
                                                 &flushInfo,
                                                 atlasMgr,
                                                 shapeData,
-                                                args.fShape,
-                                                ceilDesiredDimension,
-                                                scale)) {
+                                                *image)) {
                         atlasMgr->deleteCacheEntry(shapeData);
                         continue;
                     }
@@ -340,13 +312,107 @@ private:
         return GrDrawOpAtlas::ErrorCode::kSucceeded == code;
     }
 
-    bool addDFPathToAtlas(GrMeshDrawTarget* target,
-                          FlushInfo* flushInfo,
-                          skgpu::v1::SmallPathAtlasMgr* atlasMgr,
-                          skgpu::v1::SmallPathShapeData* shapeData,
-                          const GrStyledShape& shape,
-                          uint32_t dimension,
-                          SkScalar scale) const {
+    // Returns the mip dimension at which to generate the distance field of 'shape', and the scale
+    // from the shape to it.
+    static SkScalar DFDimension(const GrStyledShape& shape, const SkMatrix& viewMatrix,
+                                SkScalar* scale) {
+        // get mip level
+        SkScalar maxScale;
+        const SkRect& bounds = shape.bounds();
+        if (viewMatrix.hasPerspective()) {
+            // approximate the scale since we can't get it from the matrix
+            SkRect xformedBounds;
+            viewMatrix.mapRect(&xformedBounds, bounds);
+            maxScale = SkScalarAbs(std::max(xformedBounds.width() / bounds.width(),
+                                          xformedBounds.height() / bounds.height()));
+        } else {
+            maxScale = SkScalarAbs(viewMatrix.getMaxScale());
+        }
+        SkScalar maxDim = std::max(bounds.width(), bounds.height());
+        // We try to create the DF at a 2^n scaled path resolution (1/2, 1, 2, 4, etc.)
+        // In the majority of cases this will yield a crisper rendering.
+        SkScalar mipScale = 1.0f;
+        // Our mipscale is the maxScale clamped to the next highest power of 2
+        if (maxScale <= SK_ScalarHalf) {
+            SkScalar log = SkScalarFloorToScalar(SkScalarLog2(SkScalarInvert(maxScale)));
+            mipScale = SkScalarPow(2, -log);
+        } else if (maxScale > SK_Scalar1) {
+            SkScalar log = SkScalarCeilToScalar(SkScalarLog2(maxScale));
+            mipScale = SkScalarPow(2, log);
+        }
+        // Log2 isn't very precise at values close to a power of 2,
+        // so add a little tolerance here. A little bit of scaling up is fine.
+        SkASSERT(maxScale <= mipScale + SK_ScalarNearlyZero);
+
+        SkScalar mipSize = mipScale*SkScalarAbs(maxDim);
+        // For sizes less than kIdealMinMIP we want to use as large a distance field as we can
+        // so we can preserve as much detail as possible. However, we can't scale down more
+        // than a 1/4 of the size without artifacts. So the idea is that we pick the mipsize
+        // just bigger than the ideal, and then scale down until we are no more than 4x the
+        // original mipsize.
+        if (mipSize < kIdealMinMIP) {
+            SkScalar newMipSize = mipSize;
+            do {
+                newMipSize *= 2;
+            } while (newMipSize < kIdealMinMIP);
+            while (newMipSize > 4 * mipSize) {
+                newMipSize *= 0.25f;
+            }
+            mipSize = newMipSize;
+        }
+
+        SkScalar desiredDimension = std::min(mipSize, kMaxMIP);
+        *scale = desiredDimension / maxDim;
+        return desiredDimension;
+    }
+
+    // A distance field generated for a shape, waiting to be added to the atlas.
+    struct DFPathImage {
+        SkAutoMalloc fStorage;
+        int fWidth = 0;
+        int fHeight = 0;
+        SkRect fDrawBounds;
+        bool fGenerated = false;
+        bool fSucceeded = false;
+    };
+
+    // Generates the distance fields of the shapes that are missing from the atlas on fExecutor.
+    // Each new shape is generated once, at the index of its first entry. Returns null when there
+    // are too few new shapes to be worth it; they are then generated inline as they are drawn.
+    std::unique_ptr<DFPathImage[]> generateDFPaths(SmallPathAtlasMgr* atlasMgr) const {
+        SkSTArray<8, int> indices;
+        SkSTArray<8, SkScalar> scales;
+        SkTHashSet<const SmallPathShapeData*> pending;
+        for (int i = 0; i < fShapes.size(); ++i) {
+            SkScalar scale;
+            const Entry& entry = fShapes[i];
+            int dimension = SkScalarCeilToInt(DFDimension(entry.fShape, entry.fViewMatrix, &scale));
+            const SmallPathShapeData* shapeData = atlasMgr->findOrCreate(entry.fShape,
+                                                                         dimension);
+            if (!shapeData->fAtlasLocator.plotLocator().isValid() && !pending.contains(shapeData)) {
+                pending.add(shapeData);
+                indices.push_back(i);
+                scales.push_back(scale);
+            }
+        }
+        if (indices.size() < 2) {
+            return nullptr;
+        }
+
+        std::unique_ptr<DFPathImage[]> images(new DFPathImage[fShapes.size()]);
+        SkTaskGroup taskGroup(*fExecutor);
+        taskGroup.batch(indices.size(), [&](int j) {
+            int i = indices[j];
+            GenerateDFPath(fShapes[i].fShape, scales[j], &images[i]);
+        });
+        taskGroup.wait();
+        return images;
+    }
+
+    // Generates the distance field of 'shape' at 'scale'. This only reads the shape, so it may run
+    // on any thread.
+    static void GenerateDFPath(const GrStyledShape& shape, SkScalar scale, DFPathImage* image) {
+        image->fGenerated = true;
 
         const SkRect& bounds = shape.bounds();
 
@@ -387,7 +453,8 @@ private:
         width = dfBounds.width();
         height = dfBounds.height();
         // TODO We should really generate this directly into the plot somehow
-        SkAutoSMalloc<1024> dfStorage(width * height * sizeof(unsigned char));
+        SkAutoMalloc& dfStorage = image->fStorage;
+        dfStorage.reset(width * height * sizeof(unsigned char));
 
         SkPath path;
         shape.asPath(&path);
@@ -399,7 +466,7 @@ private:
             // setup bitmap backing
             SkAutoPixmapStorage dst;
             if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(), devPathBounds.height()))) {
-                return false;
+                return;
             }
             sk_bzero(dst.writable_addr(), dst.computeByteSize());
 
@@ -431,9 +498,23 @@ private:
         drawBounds.fRight /= scale;
         drawBounds.fBottom /= scale;
 
+        image->fWidth = width;
+        image->fHeight = height;
+        image->fDrawBounds = drawBounds;
+        image->fSucceeded = true;
+    }
+
+    bool addDFPathToAtlas(GrMeshDrawTarget* target,
+                          FlushInfo* flushInfo,
+                          skgpu::v1::SmallPathAtlasMgr* atlasMgr,
+                          skgpu::v1::SmallPathShapeData* shapeData,
+                          const DFPathImage& image) const {
+        if (!image.fSucceeded) {
+            return false;
+        }
         return this->addToAtlasWithRetry(target, flushInfo, atlasMgr,
-                                         width, height, dfStorage.get(),
-                                         drawBounds, SK_DistanceFieldPad, shapeData);
+                                         image.fWidth, image.fHeight, image.fStorage.get(),
+                                         image.fDrawBounds, SK_DistanceFieldPad, shapeData);
     }
 
     bool addBMPathToAtlas(GrMeshDrawTarget* target,
@@ -656,6 +737,7 @@ private:
     Helper fHelper;
     bool fGammaCorrect;
     bool fWideColor;
+    SkExecutor* fExecutor;
 
     using INHERITED = GrMeshDrawOp;
 };
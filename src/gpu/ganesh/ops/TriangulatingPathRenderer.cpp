@@ -27,6 +27,7 @@
 #include "src/gpu/ganesh/geometry/GrAATriangulator.h"
 #include "src/gpu/ganesh/geometry/GrPathUtils.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
+#include "src/gpu/ganesh/geometry/GrTriangulationCache.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
 #include "src/gpu/ganesh/ops/GrMeshDrawOp.h"
 #include "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h"
@@ -182,9 +183,15 @@ public:
                             SkIRect devClipBounds,
                             GrAAType aaType,
                             const GrUserStencilSettings* stencilSettings) {
+        // Large paths are split into their disjoint components and triangulated on the
+        // context's executor, if it has one.
+        SkExecutor* executor = context->priv().options().fExecutor;
+        GrContextOptions::PersistentCache* persistentCache =
+                context->priv().options().fPersistentGeometryCache;
         return Helper::FactoryHelper<TriangulatingPathOp>(context, std::move(paint), shape,
                                                           viewMatrix, devClipBounds, aaType,
-                                                          stencilSettings);
+                                                          stencilSettings, executor,
+                                                          persistentCache);
     }
 
     const char* name() const override { return "TriangulatingPathOp"; }
@@ -203,14 +210,18 @@ public:
                         const SkMatrix& viewMatrix,
                         const SkIRect& devClipBounds,
                         GrAAType aaType,
-                        const GrUserStencilSettings* stencilSettings)
+                        const GrUserStencilSettings* stencilSettings,
+                        SkExecutor* executor,
+                        GrContextOptions::PersistentCache* persistentCache)
             : INHERITED(ClassID())
             , fHelper(processorSet, aaType, stencilSettings)
             , fColor(color)
             , fShape(shape)
             , fViewMatrix(viewMatrix)
             , fDevClipBounds(devClipBounds)
-            , fAntiAlias(GrAAType::kCoverage == aaType) {
+            , fAntiAlias(GrAAType::kCoverage == aaType)
+            , fExecutor(executor)
+            , fPersistentCache(persistentCache) {
         SkRect devBounds;
         viewMatrix.mapRect(&devBounds, shape.bounds());
         if (shape.inverseFilled()) {
@@ -269,7 +280,9 @@ private:
                            const GrStyledShape& shape,
                            const SkIRect& devClipBounds,
                            SkScalar tol,
-                           bool* isLinear) {
+                           bool* isLinear,
+                           SkExecutor* executor,
+                           GrContextOptions::PersistentCache* persistentCache) {
         SkRect clipBounds = SkRect::Make(devClipBounds);
 
         SkMatrix vmi;
@@ -282,7 +295,20 @@ private:
         SkPath path;
         shape.asPath(&path);
 
-        return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear);
+        if (!persistentCache) {
+            return GrTriangulator::PathToTrianglesParallel(path, tol, clipBounds, allocator,
+                                                           isLinear, executor);
+        }
+        // Triangulate at the bottom of the tolerance's bucket, so the stored triangulation is
+        // fine enough for every tolerance that shares its key.
+        tol = GrTriangulationCache::BucketTolerance(tol);
+        sk_sp<SkData> key = GrTriangulationCache::MakeKey(path, tol, /*antialias=*/false,
+                                                          clipBounds);
+        return GrTriangulationCache::Triangulate(persistentCache, *key, path, allocator, isLinear,
+                [&](GrEagerVertexAllocator* cpuAllocator, bool* linear) {
+                    return GrTriangulator::PathToTrianglesParallel(path, tol, clipBounds,
+                                                                   cpuAllocator, linear, executor);
+                });
     }
 
     void createNonAAMesh(GrMeshDrawTarget* target) {
@@ -327,7 +353,7 @@ private:
 
         bool isLinear;
         int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
-                                      &isLinear);
+                                      &isLinear, fExecutor, fPersistentCache);
         if (vertexCount == 0) {
             return;
         }
@@ -365,7 +391,23 @@ private:
         sk_sp<const GrBuffer> vertexBuffer;
         int firstVertex;
         GrEagerDynamicVertexAllocator allocator(target, &vertexBuffer, &firstVertex);
-        int vertexCount = GrAATriangulator::PathToAATriangles(path, tol, clipBounds, &allocator);
+        int vertexCount;
+        if (fPersistentCache) {
+            sk_sp<SkData> key = GrTriangulationCache::MakeKey(path, tol, /*antialias=*/true,
+                                                              clipBounds);
+            bool isLinear = false;
+            vertexCount = GrTriangulationCache::Triangulate(fPersistentCache, *key, path,
+                                                            &allocator, &isLinear,
+                    [&](GrEagerVertexAllocator* cpuAllocator, bool* linear) {
+                        // The AA triangulator doesn't report linearity.
+                        *linear = false;
+                        return GrAATriangulator::PathToAATrianglesParallel(
+                                path, tol, clipBounds, cpuAllocator, fExecutor);
+                    });
+        } else {
+            vertexCount = GrAATriangulator::PathToAATrianglesParallel(path, tol, clipBounds,
+                                                                      &allocator, fExecutor);
+        }
         if (vertexCount == 0) {
             return;
         }
@@ -465,7 +507,7 @@ private:
 
         bool isLinear;
         int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
-                                      &isLinear);
+                                      &isLinear, fExecutor, fPersistentCache);
         if (vertexCount == 0) {
             return;
         }
@@ -538,6 +580,8 @@ private:
     SkMatrix       fViewMatrix;
     SkIRect        fDevClipBounds;
     bool           fAntiAlias;
+    SkExecutor*    fExecutor;
+    GrContextOptions::PersistentCache* fPersistentCache;
 
     GrSimpleMesh*  fMesh = nullptr;
     GrProgramInfo* fProgramInfo = nullptr;
@@ -41,7 +41,26 @@ void write_curve_patches(CurveWriter&& patchWriter,
         if (patchWriter.attribs() & PatchAttribs::kColor) {
             patchWriter.updateColorAttrib(color);
         }
+        // Consecutive cubics share end points in the path's point array, so they are written as
+        // runs, which lets the PatchWriter process them four at a time.
+        const SkPoint* cubicRun = nullptr;
+        int cubicRunCount = 0;
+        auto flushCubicRun = [&]() {
+            if (cubicRunCount) {
+                patchWriter.writeCubicRun(cubicRun, cubicRunCount, m);
+                cubicRunCount = 0;
+            }
+        };
         for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+            if (verb == SkPathVerb::kCubic) {
+                if (pts != cubicRun + 3 * cubicRunCount) {
+                    flushCubicRun();
+                    cubicRun = pts;
+                }
+                ++cubicRunCount;
+                continue;
+            }
+            flushCubicRun();
             switch (verb) {
                 case SkPathVerb::kQuad: {
                     auto [p0, p1] = m.map2Points(pts);
@@ -59,17 +78,10 @@ void write_curve_patches(CurveWriter&& patchWriter,
                     break;
                 }
 
-                case SkPathVerb::kCubic: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto [p2, p3] = m.map2Points(pts+2);
-
-                    patchWriter.writeCubic(p0, p1, p2, p3);
-                    break;
-                }
-
                 default: break;
             }
         }
+        flushCubicRun();
     }
 }
 
@@ -29,9 +29,9 @@ public:
             : fWorstCaseTolerances(worstCaseTolerances)
             , fBuilder(target, chunks, stride, minVerticesPerChunk) {}
 
-    VertexWriter append(const tess::LinearTolerances& tolerances) {
+    VertexWriter append(const tess::LinearTolerances& tolerances, int count = 1) {
         fWorstCaseTolerances->accumulate(tolerances);
-        return fBuilder.appendVertices(1);
+        return fBuilder.appendVertices(count);
     }
 
 private:
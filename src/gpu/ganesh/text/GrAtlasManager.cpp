@@ -24,9 +24,11 @@ using MaskFormat = skgpu::MaskFormat;
 GrAtlasManager::GrAtlasManager(GrProxyProvider* proxyProvider,
                                size_t maxTextureBytes,
                                GrDrawOpAtlas::AllowMultitexturing allowMultitexturing,
-                               bool supportBilerpAtlas)
+                               bool supportBilerpAtlas,
+                               skgpu::PlotRectanizer plotRectanizer)
             : fAllowMultitexturing{allowMultitexturing}
             , fSupportBilerpAtlas{supportBilerpAtlas}
+            , fPlotRectanizer{plotRectanizer}
             , fProxyProvider{proxyProvider}
             , fCaps{fProxyProvider->refCaps()}
             , fAtlasConfig{fCaps->maxTextureSize(), maxTextureBytes} { }
@@ -353,7 +355,8 @@ bool GrAtlasManager::initAtlas(MaskFormat format) {
                                               this,
                                               fAllowMultitexturing,
                                               nullptr,
-                                              /*label=*/"TextAtlas");
+                                              /*label=*/"TextAtlas",
+                                              fPlotRectanizer);
         if (!fAtlases[index]) {
             return false;
         }
@@ -383,6 +386,18 @@ std::tuple<bool, int> GlyphVector::regenerateAtlas(int begin, int end,
 
         SkBulkGlyphMetricsAndImages metricsAndImages{fTextStrike->strikeSpec()};
 
+        // Prepare the images of all the glyphs missing from the atlas in one batch, so that the
+        // strike can rasterize them together.
+        SkSTArray<32, SkPackedGlyphID> missingIDs;
+        for (const Variant& variant : fGlyphs.subspan(begin, end - begin)) {
+            if (!atlasManager->hasGlyph(maskFormat, variant.glyph)) {
+                missingIDs.push_back(variant.glyph->fPackedID);
+            }
+        }
+        if (!missingIDs.empty()) {
+            metricsAndImages.glyphs(missingIDs);
+        }
+
         // Update the atlas information in the GrStrike.
         auto tokenTracker = uploadTarget->tokenTracker();
         auto glyphs = fGlyphs.subspan(begin, end - begin);
@@ -32,7 +32,8 @@ public:
     GrAtlasManager(GrProxyProvider*,
                    size_t maxTextureBytes,
                    GrDrawOpAtlas::AllowMultitexturing,
-                   bool supportBilerpAtlas);
+                   bool supportBilerpAtlas,
+                   skgpu::PlotRectanizer plotRectanizer = skgpu::PlotRectanizer::kSkyline);
     ~GrAtlasManager() override;
 
     // if getViews returns nullptr, the client must not try to use other functions on the
@@ -85,6 +86,11 @@ public:
         return this->getAtlas(format)->atlasGeneration();
     }
 
+    // The atlas for 'format', or nullptr if it hasn't been created yet. For stats and testing.
+    const GrDrawOpAtlas* peekAtlas(skgpu::MaskFormat format) const {
+        return fAtlases[MaskFormatToAtlasIndex(this->resolveMaskFormat(format))].get();
+    }
+
     // GrOnFlushCallbackObject overrides
 
     bool preFlush(GrOnFlushResourceProvider* onFlushRP) override {
@@ -156,6 +162,7 @@ private:
     std::unique_ptr<GrDrawOpAtlas> fAtlases[skgpu::kMaskFormatCount];
     static_assert(skgpu::kMaskFormatCount == 3);
     bool fSupportBilerpAtlas;
+    skgpu::PlotRectanizer fPlotRectanizer;
     GrProxyProvider* fProxyProvider;
     sk_sp<const GrCaps> fCaps;
     GrDrawOpAtlasConfig fAtlasConfig;
@@ -35,6 +35,7 @@
 
 #include "src/base/SkMathPriv.h"
 #include "src/base/SkTBlockList.h"
+#include "src/base/SkTSort.h"
 
 #include <algorithm>
 #include <unordered_map>
@@ -317,6 +318,8 @@ private:
  */
 class DrawPass::SortKey {
 public:
+    // Leaves the key uninitialized, so that sort scratch space can be allocated without setup.
+    SortKey() = default;
     SortKey(const DrawList::Draw* draw,
             int renderStep,
             GraphicsPipelineCache::Index pipelineIndex,
@@ -340,6 +343,9 @@ public:
                (fPipelineKey == k.fPipelineKey && fUniformKey < k.fUniformKey);
     }
 
+    // The most significant 16 bits of the key, used to bucket keys before comparing them.
+    uint32_t paintersOrderBits() const { return ColorDepthOrderField::get(fPipelineKey); }
+
     const RenderStep& renderStep() const {
         return fDraw->fRenderer->step(RenderStepField::get(fPipelineKey));
     }
@@ -512,14 +518,17 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     geometrySsboTracker.writeUniforms(bufferMgr);
     shadingSsboTracker.writeUniforms(bufferMgr);
 
-    // TODO: Explore sorting algorithms; in all likelihood this will be mostly sorted already, so
-    // algorithms that approach O(n) in that condition may be favorable. Alternatively, could
-    // explore radix sort that is always O(n). Brief testing suggested std::sort was faster than
-    // std::stable_sort and SkTQSort on my [ml]'s Windows desktop. Also worth considering in-place
-    // vs. algorithms that require an extra O(n) storage.
+    // Keys are bucketed by their CompressedPaintersOrder, which is usually spread across many
+    // values, and each bucket is then comparison sorted. This is several times faster than sorting
+    // all the keys with std::sort once there are thousands of them.
     // TODO: It's not strictly necessary, but would a stable sort be useful or just end up hiding
     // bugs in the DrawOrder determination code?
-    std::sort(keys.begin(), keys.end());
+    {
+        skia_private::AutoTMalloc<SortKey> scratch(keys.size());
+        SkTRadixSort(keys.data(), scratch.get(), SkToInt(keys.size()),
+                     [](const SortKey& k) { return k.paintersOrderBits(); },
+                     [](const SortKey& a, const SortKey& b) { return a < b; });
+    }
 
     // Used to record vertex/instance data, buffer binds, and draw calls
     DrawWriter drawWriter(&drawPass->fCommandList, bufferMgr);
@@ -14,9 +14,14 @@
 
 namespace skgpu::graphite {
 
+// Caps the shared copies of paint uniform blocks. While it is used up, new uniform blocks are
+// simply kept by each Recorder.
+static constexpr size_t kMaxSharedUniformBytes = 1 << 20;
+
 GlobalCache::GlobalCache()
         : fGraphicsPipelineCache(256) // TODO: find a good value for these limits
-        , fComputePipelineCache(16) {}
+        , fComputePipelineCache(16)
+        , fUniformDataCache(kMaxSharedUniformBytes) {}
 
 GlobalCache::~GlobalCache() = default;
 
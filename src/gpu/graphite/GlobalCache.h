@@ -12,6 +12,7 @@
 #include "include/private/SkSpinlock.h"
 #include "src/core/SkLRUCache.h"
 #include "src/gpu/ResourceKey.h"
+#include "src/gpu/graphite/PipelineDataCache.h"
 
 
 namespace skgpu::graphite {
@@ -61,6 +62,11 @@ public:
     // or reference tracking.
     void addStaticResource(sk_sp<Resource>) SK_EXCLUDES(fSpinLock);
 
+    // Backs every Recorder's UniformDataCache, so paint uniforms that are identical across
+    // Recorders share one copy. It has its own lock, so it does not contend with pipeline lookups.
+    SharedUniformDataCache* uniformDataCache() { return &fUniformDataCache; }
+    const SharedUniformDataCache* uniformDataCache() const { return &fUniformDataCache; }
+
 private:
     struct KeyHash {
         uint32_t operator()(const UniqueKey& key) const { return key.hash(); }
@@ -79,6 +85,8 @@ private:
     ComputePipelineCache  fComputePipelineCache  SK_GUARDED_BY(fSpinLock);
 
     SkTArray<sk_sp<Resource>> fStaticResource SK_GUARDED_BY(fSpinLock);
+
+    SharedUniformDataCache fUniformDataCache;
 };
 
 } // namespace skgpu::graphite
@@ -8,10 +8,16 @@
 #ifndef skgpu_graphite_PipelineDataCache_DEFINED
 #define skgpu_graphite_PipelineDataCache_DEFINED
 
+#include "include/private/SkSpinlock.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkTHash.h"
 #include "src/gpu/graphite/PipelineData.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 
 namespace skgpu::graphite {
 
@@ -23,10 +29,26 @@ namespace skgpu::graphite {
 //
 // T must define a hash() function, an operator==, and a static Make(const T&, SkArenaAlloc*)
 // factory that's used to copy the data into an arena allocation owned by the PipelineDataCache.
+//
+// A PipelineDataCache can be backed by a SharedPipelineDataCache. Blocks that miss in this cache
+// are then looked up (or added) there, so that identical blocks from every cache backed by it
+// share one copy, and pointer comparison also holds across those caches. The cache holds a
+// reference on each shared block it uses and releases them when it is destroyed.
+template<typename T>
+class SharedPipelineDataCache;
+
 template<typename T>
 class PipelineDataCache {
 public:
     PipelineDataCache() = default;
+    // 'shared' must outlive this cache.
+    explicit PipelineDataCache(SharedPipelineDataCache<T>* shared) : fShared(shared) {}
+
+    ~PipelineDataCache() {
+        if (fShared) {
+            fShared->release(fSharedBlocks);
+        }
+    }
 
     const T* insert(const T& dataBlock) {
         DataRef data{&dataBlock}; // will not be persisted, since pointer isn't from the arena.
@@ -34,8 +56,13 @@ public:
         if (existing) {
             return existing->fPointer;
         } else {
-            // Need to make a copy of dataBlock into the arena
-            T* copy = T::Make(dataBlock, &fArena);
+            const T* copy = fShared ? fShared->insert(dataBlock) : nullptr;
+            if (copy) {
+                fSharedBlocks.push_back(copy);
+            } else {
+                // Need to make a copy of dataBlock into the arena
+                copy = T::Make(dataBlock, &fArena);
+            }
             fDataPointers.add(DataRef{copy});
             return copy;
         }
@@ -55,6 +82,8 @@ public:
     }
 
 private:
+    friend class SharedPipelineDataCache<T>;
+
     struct DataRef {
         const T* fPointer;
 
@@ -74,13 +103,124 @@ private:
     };
 
     SkTHashSet<DataRef, Hash> fDataPointers;
-    // Holds the data that is pointed to by fDataPointers
+    // Holds the data that is pointed to by fDataPointers, unless it came from fShared
     SkArenaAlloc fArena{0};
+    SharedPipelineDataCache<T>* fShared = nullptr;
+    // The blocks in fDataPointers that this cache holds a reference on in fShared
+    std::vector<const T*> fSharedBlocks;
+};
+
+// A thread-safe, reference counted store of blocks shared by the PipelineDataCaches backed by it.
+// Each block is freed once every cache that uses it has released it. T must also define size(),
+// the number of bytes of data the block holds.
+//
+// The blocks are capped at 'maxBytes' in total. While the cache is at that budget it is marked
+// saturated, and insert() returns null without taking the lock, so the calling caches keep their
+// own copies. Releasing blocks below the budget clears the mark.
+template<typename T>
+class SharedPipelineDataCache {
+public:
+    explicit SharedPipelineDataCache(size_t maxBytes) : fMaxBytes(maxBytes) {}
+
+    // Returns the shared copy of 'dataBlock', adding one if it fits in the budget, and takes a
+    // reference on it that the caller must release(). Returns null if the cache is saturated or
+    // there is no copy and it does not fit.
+    const T* insert(const T& dataBlock) SK_EXCLUDES(fSpinLock) {
+        if (fSaturated.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        SkAutoSpinlock lock{fSpinLock};
+
+        DataRef data{&dataBlock};
+        if (std::unique_ptr<Entry>* existing = fEntries.find(data)) {
+            fStats.fHits++;
+            (*existing)->fRefs++;
+            return (*existing)->fBlock;
+        }
+        fStats.fMisses++;
+        size_t bytes = sizeof(T) + dataBlock.size();
+        if (fBytes + bytes > fMaxBytes) {
+            fSaturated.store(true, std::memory_order_relaxed);
+            return nullptr;
+        }
+        auto entry = std::make_unique<Entry>(bytes);
+        entry->fBlock = T::Make(dataBlock, &entry->fArena);
+        fBytes += bytes;
+        const T* copy = entry->fBlock;
+        fEntries.set(DataRef{copy}, std::move(entry));
+        return copy;
+    }
+
+    // Drops one reference on each of 'blocks', which must have come from insert(), freeing the
+    // blocks that are no longer used.
+    void release(const std::vector<const T*>& blocks) SK_EXCLUDES(fSpinLock) {
+        if (blocks.empty()) {
+            return;
+        }
+        SkAutoSpinlock lock{fSpinLock};
+
+        for (const T* block : blocks) {
+            DataRef data{block};
+            std::unique_ptr<Entry>* entry = fEntries.find(data);
+            SkASSERT(entry && (*entry)->fBlock == block);
+            if (--(*entry)->fRefs == 0) {
+                fBytes -= (*entry)->fBytes;
+                fEntries.remove(data);
+            }
+        }
+        if (fBytes < fMaxBytes) {
+            fSaturated.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    struct Stats {
+        int fHits = 0;    // lookups that found an existing block
+        int fMisses = 0;  // lookups that did not, whether or not the block was then added
+    };
+    Stats stats() const SK_EXCLUDES(fSpinLock) {
+        SkAutoSpinlock lock{fSpinLock};
+        return fStats;
+    }
+
+    int count() const SK_EXCLUDES(fSpinLock) {
+        SkAutoSpinlock lock{fSpinLock};
+        return fEntries.count();
+    }
+
+    size_t bytes() const SK_EXCLUDES(fSpinLock) {
+        SkAutoSpinlock lock{fSpinLock};
+        return fBytes;
+    }
+
+    bool isSaturated() const { return fSaturated.load(std::memory_order_relaxed); }
+
+private:
+    using DataRef = typename PipelineDataCache<T>::DataRef;
+    using Hash = typename PipelineDataCache<T>::Hash;
+
+    struct Entry {
+        explicit Entry(size_t bytes) : fArena(bytes), fBytes(bytes) {}
+
+        SkArenaAlloc fArena;  // holds just fBlock and its data
+        const T* fBlock = nullptr;
+        const size_t fBytes;
+        int fRefs = 1;
+    };
+
+    mutable SkSpinlock fSpinLock;
+    SkTHashMap<DataRef, std::unique_ptr<Entry>, Hash> fEntries SK_GUARDED_BY(fSpinLock);
+    size_t fBytes SK_GUARDED_BY(fSpinLock) = 0;
+    Stats fStats SK_GUARDED_BY(fSpinLock);
+    const size_t fMaxBytes;
+    std::atomic<bool> fSaturated{false};
 };
 
 // A UniformDataCache lives for the entire duration of a Recorder.
 using UniformDataCache = PipelineDataCache<UniformDataBlock>;
 
+// The GlobalCache holds a SharedUniformDataCache that backs every Recorder's UniformDataCache.
+using SharedUniformDataCache = SharedPipelineDataCache<UniformDataBlock>;
+
 // A TextureDataCache only lives for a single Recording. When a Recording is snapped it is pulled
 // off of the Recorder and goes with the Recording as a record of the required Textures and
 // Samplers.
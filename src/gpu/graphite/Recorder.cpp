@@ -86,7 +86,8 @@ Recorder::Recorder(sk_sp<SharedContext> sharedContext,
         : fSharedContext(std::move(sharedContext))
         , fRuntimeEffectDict(std::make_unique<RuntimeEffectDictionary>())
         , fGraph(new TaskGraph)
-        , fUniformDataCache(new UniformDataCache)
+        , fUniformDataCache(
+                new UniformDataCache(fSharedContext->globalCache()->uniformDataCache()))
         , fTextureDataCache(new TextureDataCache)
         , fRecorderID(next_id())
         , fAtlasManager(std::make_unique<AtlasManager>(this))
@@ -216,8 +216,10 @@ const ShaderCodeDictionary::Entry* ShaderCodeDictionary::findOrCreate(
     Entry** existingEntry = fHash.find(PaintParamsKeyPtr{&key});
     if (existingEntry) {
         SkASSERT(fEntryVector[(*existingEntry)->uniqueID().asUInt()] == *existingEntry);
+        fStats.fHits++;
         return *existingEntry;
     }
+    fStats.fMisses++;
 
     Entry* newEntry = this->makeEntry(key, builder->blendInfo());
     newEntry->setUniqueID(fEntryVector.size());
@@ -227,6 +229,12 @@ const ShaderCodeDictionary::Entry* ShaderCodeDictionary::findOrCreate(
     return newEntry;
 }
 
+ShaderCodeDictionary::Stats ShaderCodeDictionary::stats() const {
+    SkAutoSpinlock lock{fSpinLock};
+
+    return fStats;
+}
+
 const ShaderCodeDictionary::Entry* ShaderCodeDictionary::lookup(
         UniquePaintParamsID codeID) const {
 
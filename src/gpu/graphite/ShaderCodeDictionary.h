@@ -213,6 +213,14 @@ public:
 
     const Entry* findOrCreate(PaintParamsKeyBuilder*) SK_EXCLUDES(fSpinLock);
 
+    // How often findOrCreate() found an existing entry, across every Recorder using this
+    // dictionary.
+    struct Stats {
+        int fHits = 0;
+        int fMisses = 0;
+    };
+    Stats stats() const SK_EXCLUDES(fSpinLock);
+
     const Entry* lookup(UniquePaintParamsID) const SK_EXCLUDES(fSpinLock);
 
     SkSpan<const Uniform> getUniforms(BuiltInCodeSnippetID) const;
@@ -282,6 +290,7 @@ private:
 
     PaintHashMap fHash SK_GUARDED_BY(fSpinLock);
     std::vector<Entry*> fEntryVector SK_GUARDED_BY(fSpinLock);
+    Stats fStats SK_GUARDED_BY(fSpinLock);
 
     SK_BEGIN_REQUIRE_DENSE
     struct RuntimeEffectKey {
@@ -10,13 +10,17 @@
 
 #include "include/core/SkSize.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 
 #include "src/base/SkTBlockList.h"
 #include "src/base/SkVx.h"
 #include "src/gpu/graphite/DrawOrder.h"
 #include "src/gpu/graphite/geom/Rect.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 
 namespace skgpu::graphite {
 
@@ -225,6 +229,199 @@ private:
     skia_private::AutoTMalloc<CompressedPaintersOrder> fNodes;
 };
 
+// A BoundsManager that stores every draw in a loose quadtree, laid out as a stack of uniform grids
+// whose cells halve in size at each level. A draw is stored once, in the cell containing its center
+// on the finest level whose cells are at least as large as the draw, so it never extends more than
+// half a cell past that cell. Draws that are too large for any level below the root, or have NaN
+// bounds, are stored in the root.
+//
+// Each cell keeps its draws sorted by decreasing order, and tracks the highest order stored in it
+// or below it, which lets queries skip subtrees that cannot raise the result. Like
+// BruteForceBoundsManager, the results are exact, but a query only visits the few cells near its
+// bounds, so it keeps up with DrawLists of hundreds of thousands of draws.
+class HierarchicalGridBoundsManager final : public BoundsManager {
+public:
+    // The finest level has cells 'minCellSize' pixels wide; the root cell covers 'deviceSize'.
+    static std::unique_ptr<HierarchicalGridBoundsManager> Make(const SkISize& deviceSize,
+                                                               int minCellSize) {
+        SkASSERT(deviceSize.width() > 0 && deviceSize.height() > 0);
+        SkASSERT(minCellSize >= 1);
+
+        int maxLevel = 0;
+        int rootSize = minCellSize;
+        while (rootSize < std::max(deviceSize.width(), deviceSize.height()) &&
+               maxLevel < kMaxLevel) {
+            rootSize *= 2;
+            ++maxLevel;
+        }
+        return std::unique_ptr<HierarchicalGridBoundsManager>(
+                new HierarchicalGridBoundsManager(rootSize, maxLevel));
+    }
+
+    ~HierarchicalGridBoundsManager() override {}
+
+    CompressedPaintersOrder getMostRecentDraw(const Rect& bounds) const override {
+        CompressedPaintersOrder max = CompressedPaintersOrder::First();
+        this->findMostRecentDraw(bounds, Rect::ComplementRect(bounds), 0, 0, 0, 0, &max);
+        return max;
+    }
+
+    void recordDraw(const Rect& bounds, CompressedPaintersOrder order) override {
+        skvx::float2 size = bounds.size();
+        skvx::float2 center = bounds.center();
+
+        int level = fMaxLevel;
+        float cellSize = this->cellSize(level);
+        while (level > 0 && !(std::max(size.x(), size.y()) <= cellSize)) {
+            --level;
+            cellSize *= 2.f;
+        }
+        int x = 0, y = 0;
+        if (level > 0) {
+            // Draws centered off the device go in the nearest edge cell, whose loose bounds extend
+            // out to infinity.
+            float maxCoord = (float) ((1 << level) - 1);
+            x = (int) std::min(std::max(center.x() / cellSize, 0.f), maxCoord);
+            y = (int) std::min(std::max(center.y() / cellSize, 0.f), maxCoord);
+        }
+        int index = ZOrder(x, y);
+
+        // New draws usually have the highest order so far, so they are usually inserted first.
+        int cell = CellIndex(level, index);
+        Entry** link = &fHeads[cell];
+        while (*link && order < (*link)->fOrder) {
+            link = &(*link)->fNext;
+        }
+        Entry& entry = fEntries.push_back({bounds, *link, order, SkToU16(level),
+                                           SkToU16(index)});
+        *link = &entry;
+        fCellMaxOrders[cell] = fHeads[cell]->fOrder;
+
+        // Raise the subtree maximum of the cell and its ancestors.
+        while (fSubtreeMaxOrders[cell] < order) {
+            fSubtreeMaxOrders[cell] = order;
+            if (level == 0) {
+                break;
+            }
+            cell = CellIndex(--level, index >>= 2);
+        }
+    }
+
+    void reset() override {
+        // Clearing only the cells that hold draws, and their ancestors, is much cheaper than
+        // clearing every cell when there are few draws.
+        for (const Entry& entry : fEntries.items()) {
+            int level = entry.fLevel;
+            int index = entry.fIndex;
+            int cell = CellIndex(level, index);
+            fHeads[cell] = nullptr;
+            fCellMaxOrders[cell] = CompressedPaintersOrder::First();
+            while (fSubtreeMaxOrders[cell] != CompressedPaintersOrder::First()) {
+                fSubtreeMaxOrders[cell] = CompressedPaintersOrder::First();
+                if (level == 0) {
+                    break;
+                }
+                cell = CellIndex(--level, index >>= 2);
+            }
+        }
+        fEntries.reset();
+    }
+
+private:
+    // Level 7 has 128x128 cells, and all levels together take about 260KB.
+    static constexpr int kMaxLevel = 7;
+
+    struct Entry {
+        Rect                    fBounds;
+        Entry*                  fNext;
+        CompressedPaintersOrder fOrder;
+        uint16_t                fLevel;
+        uint16_t                fIndex;  // ZOrder() of the cell within its level
+    };
+
+    HierarchicalGridBoundsManager(int rootSize, int maxLevel)
+            : fRootSize(rootSize)
+            , fMaxLevel(maxLevel)
+            , fHeads(CellIndex(maxLevel + 1, 0))
+            , fCellMaxOrders(CellIndex(maxLevel + 1, 0))
+            , fSubtreeMaxOrders(CellIndex(maxLevel + 1, 0)) {
+        int cellCount = CellIndex(maxLevel + 1, 0);
+        memset(fHeads.data(), 0, sizeof(Entry*) * cellCount);
+        memset(fCellMaxOrders.data(), 0, sizeof(CompressedPaintersOrder) * cellCount);
+        memset(fSubtreeMaxOrders.data(), 0, sizeof(CompressedPaintersOrder) * cellCount);
+    }
+
+    // Cells are stored level by level, each level in Z-order so the four children of a cell are
+    // adjacent in memory.
+    static int CellIndex(int level, int index) { return ((1 << (2 * level)) - 1) / 3 + index; }
+
+    static int ZOrder(int x, int y) {
+        int index = 0;
+        for (int bit = 0; bit < kMaxLevel; ++bit) {
+            index |= ((x >> bit) & 1) << (2 * bit);
+            index |= ((y >> bit) & 1) << (2 * bit + 1);
+        }
+        return index;
+    }
+
+    float cellSize(int level) const { return (float) (fRootSize >> level); }
+
+    void findMostRecentDraw(const Rect& bounds, const Rect::ComplementRect& complement,
+                            int level, int x, int y, int index,
+                            CompressedPaintersOrder* max) const {
+        SkASSERT(index == ZOrder(x, y));
+        int cell = CellIndex(level, index);
+        if (*max < fCellMaxOrders[cell]) {
+            // The first draw in the cell that intersects 'bounds' is the most recent one.
+            for (const Entry* entry = fHeads[cell]; entry && *max < entry->fOrder;
+                 entry = entry->fNext) {
+                if (entry->fBounds.intersects(complement)) {
+                    *max = entry->fOrder;
+                    break;
+                }
+            }
+        }
+        if (level == fMaxLevel) {
+            return;
+        }
+        // Every draw in a child's subtree lies within the child outset by half its size, or past
+        // the edge of the device for children along it. Find which of the two columns and rows of
+        // children 'bounds' can reach.
+        float childSize = this->cellSize(level + 1);
+        int maxChild = (2 << level) - 1;
+        bool columns[2], rows[2];
+        for (int i = 0; i < 2; ++i) {
+            int childX = 2 * x + i;
+            int childY = 2 * y + i;
+            columns[i] = (childX == 0        || bounds.right() > (childX - 0.5f) * childSize) &&
+                         (childX == maxChild || bounds.left()  < (childX + 1.5f) * childSize);
+            rows[i]    = (childY == 0        || bounds.bot()   > (childY - 0.5f) * childSize) &&
+                         (childY == maxChild || bounds.top()   < (childY + 1.5f) * childSize);
+        }
+        const CompressedPaintersOrder* children = &fSubtreeMaxOrders[CellIndex(level + 1,
+                                                                               4 * index)];
+        for (int i = 0; i < 4; ++i) {
+            int childX = 2 * x + (i & 1);
+            int childY = 2 * y + (i >> 1);
+            if (columns[i & 1] && rows[i >> 1] && *max < children[i]) {
+                this->findMostRecentDraw(bounds, complement, level + 1, childX, childY,
+                                         4 * index + i, max);
+            }
+        }
+    }
+
+    const int fRootSize;
+    const int fMaxLevel;
+
+    // The draws and their highest order are kept apart from the subtree maximums, since queries
+    // mostly just read the latter.
+    skia_private::AutoTMalloc<Entry*>                  fHeads;
+    skia_private::AutoTMalloc<CompressedPaintersOrder> fCellMaxOrders;
+    skia_private::AutoTMalloc<CompressedPaintersOrder> fSubtreeMaxOrders;
+
+    SkTBlockList<Entry> fEntries{16, SkBlockAllocator::GrowthPolicy::kFibonacci};
+};
+
 // A BoundsManager that first relies on BruteForceBoundsManager for N draw calls, and then switches
 // to the GridBoundsManager if it exceeds its limit. For low N, the brute force approach is
 // surprisingly efficient, has the highest accuracy, and very low memory overhead. Once the draw
@@ -38,8 +38,8 @@ public:
         fInstances.reserve(reserveCount);
     }
 
-    VertexWriter append(const tess::LinearTolerances& tolerances) {
-        return fInstances.append(tolerances, 1);
+    VertexWriter append(const tess::LinearTolerances& tolerances, int count = 1) {
+        return fInstances.append(tolerances, count);
     }
 
 private:
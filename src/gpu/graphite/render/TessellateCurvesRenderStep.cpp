@@ -135,14 +135,34 @@ void TessellateCurvesRenderStep::writeVertices(DrawWriter* dw,
     // provide a templated WritePatches function, the iterator could also be a template arg in
     // addition to PatchWriter's traits. Whatever pattern we choose will be based more on what's
     // best for the wedge and stroke case, which have more complex loops.
+    //
+    // Consecutive cubics share end points in the path's point array, so they are written as runs,
+    // which lets the PatchWriter process them four at a time.
+    const SkPoint* cubicRun = nullptr;
+    int cubicRunCount = 0;
+    auto flushCubicRun = [&]() {
+        if (cubicRunCount) {
+            writer.writeCubicRun(cubicRun, cubicRunCount);
+            cubicRunCount = 0;
+        }
+    };
     for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+        if (verb == SkPathVerb::kCubic) {
+            if (pts != cubicRun + 3 * cubicRunCount) {
+                flushCubicRun();
+                cubicRun = pts;
+            }
+            ++cubicRunCount;
+            continue;
+        }
+        flushCubicRun();
         switch (verb) {
             case SkPathVerb::kQuad:  writer.writeQuadratic(pts); break;
             case SkPathVerb::kConic: writer.writeConic(pts, *w); break;
-            case SkPathVerb::kCubic: writer.writeCubic(pts);     break;
             default:                                             break;
         }
     }
+    flushCubicRun();
 }
 
 void TessellateCurvesRenderStep::writeUniformsAndTextures(const DrawParams& params,
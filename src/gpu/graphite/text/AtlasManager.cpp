@@ -326,6 +326,18 @@ std::tuple<bool, int> GlyphVector::regenerateAtlas(int begin, int end,
 
         SkBulkGlyphMetricsAndImages metricsAndImages{fTextStrike->strikeSpec()};
 
+        // Prepare the images of all the glyphs missing from the atlas in one batch, so that the
+        // strike can rasterize them together.
+        SkSTArray<32, SkPackedGlyphID> missingIDs;
+        for (const Variant& variant : fGlyphs.subspan(begin, end - begin)) {
+            if (!atlasManager->hasGlyph(maskFormat, variant.glyph)) {
+                missingIDs.push_back(variant.glyph->fPackedID);
+            }
+        }
+        if (!missingIDs.empty()) {
+            metricsAndImages.glyphs(missingIDs);
+        }
+
         // Update the atlas information in the GrStrike.
         auto glyphs = fGlyphs.subspan(begin, end - begin);
         int glyphsPlacedInAtlas = 0;
@@ -10,6 +10,7 @@
 
 #include "include/private/SkColorData.h"
 #include "src/gpu/BufferWriter.h"
+#include "src/gpu/tessellate/AffineMatrix.h"
 #include "src/gpu/tessellate/LinearTolerances.h"
 #include "src/gpu/tessellate/MiddleOutPolygonTriangulator.h"
 #include "src/gpu/tessellate/Tessellation.h"
@@ -60,6 +61,8 @@ namespace skgpu::tess {
  *    // LinearTolerances value represents the tolerances for the curve that will be written to the
  *    // returned vertex space.
  *    skgpu::VertexWriter append(const LinearTolerances&);
+ *    // The same, but for 'count' instances written back to back. The tolerances cover them all.
+ *    skgpu::VertexWriter append(const LinearTolerances&, int count);
  *
  * Additionally, it must have a constructor that takes the stride as its first argument.
  * PatchWriter forwards any additional constructor args from its ctor to the allocator after
@@ -247,6 +250,7 @@ class PatchWriter {
 
     using float2 = skvx::float2;
     using float4 = skvx::float4;
+    using int4 = skvx::int4;
 
     static_assert(!kTrackJoinControlPoints || req_attrib<PatchAttribs::kJoinControlPoint>::value,
                   "Deferred patches and auto-updating joins requires kJoinControlPoint attrib");
@@ -386,11 +390,7 @@ public:
                 return;
             }
         }
-        if (int numPatches = this->accountForCurve(n4)) {
-            this->chopAndWriteCubics(p0, p1, p2, p3, numPatches);
-        } else {
-            this->writeCubicPatch(p0, p1, p2, p3);
-        }
+        this->writeCubicWithN4(p0, p1, p2, p3, n4);
     }
     AI void writeCubic(const SkPoint pts[4]) {
         float4 p0p1 = float4::Load(pts);
@@ -398,6 +398,19 @@ public:
         this->writeCubic(p0p1.lo, p0p1.hi, p2p3.lo, p2p3.hi);
     }
 
+    // Writes 'count' cubics that share end points, the way a run of cubic verbs is stored in an
+    // SkPath: cubic i has the control points pts[3i..3i+3]. This writes the same patches, in the
+    // same order, as calling writeCubic() on each cubic (after mapping by 'm'). But it evaluates
+    // Wang's formula and discards flat curves four at a time, and when none of the four need to be
+    // chopped, it appends their patches to the instance buffer all at once.
+    ENABLE_IF(!kTrackJoinControlPoints) writeCubicRun(const SkPoint pts[], int count) {
+        this->writeCubicRun</*kMapPoints=*/false>(pts, count, nullptr);
+    }
+    ENABLE_IF(!kTrackJoinControlPoints) writeCubicRun(const SkPoint pts[], int count,
+                                                      const AffineMatrix& m) {
+        this->writeCubicRun</*kMapPoints=*/true>(pts, count, &m);
+    }
+
     // Write a conic curve with three control points and 'w', with the last coord of the last
     // control point signaling a conic by being set to infinity.
     AI void writeConic(float2 p0, float2 p1, float2 p2, float w) {
@@ -490,12 +503,12 @@ public:
         fTolerances.setParametricSegments(0.f);
         if (VertexWriter vw = fPatchAllocator.append(fTolerances)) {
             vw << VertexWriter::Repeat<4>(p); // p0,p1,p2,p3 = p -> 4 copies
-            this->emitPatchAttribs(std::move(vw), {fAttribs, p}, kCubicCurveType);
+            this->emitPatchAttribs(vw, {fAttribs, p}, kCubicCurveType);
         }
     }
 
 private:
-    AI void emitPatchAttribs(VertexWriter vertexWriter,
+    AI void emitPatchAttribs(VertexWriter& vertexWriter,
                              const JoinAttrib& join,
                              float explicitCurveType) {
         // NOTE: operator<< overrides automatically handle optional and disabled attribs.
@@ -523,7 +536,7 @@ private:
             // case, correct data will overwrite it when the contour is closed (this is fine since a
             // deferred patch writes to CPU memory instead of directly to the GPU buffer).
             vw << p0 << p1 << p2 << p3;
-            this->emitPatchAttribs(std::move(vw), fJoin, explicitCurveType);
+            this->emitPatchAttribs(vw, fJoin, explicitCurveType);
 
             // Automatically update join control point for next patch.
             if constexpr (kTrackJoinControlPoints) {
@@ -556,6 +569,74 @@ private:
         this->writePatch(p0, p1, p2, {w, SK_FloatInfinity}, kConicCurveType);
     }
 
+    template <bool kMapPoints>
+    void writeCubicRun(const SkPoint pts[], int count, const AffineMatrix* m) {
+        SkASSERT(count >= 0);
+        SkASSERT(kMapPoints == SkToBool(m));
+        for (; count >= 4; count -= 4, pts += 12) {
+            // The 13 control points of the next four cubics.
+            float2 p[13];
+            for (int i = 0; i < 12; i += 2) {
+                float4 pair = kMapPoints ? m->map2Points(pts + i) : float4::Load(pts + i);
+                std::tie(p[i], p[i + 1]) = {pair.lo, pair.hi};
+            }
+            p[12] = kMapPoints ? m->map1Point(pts + 12) : float2::Load(pts + 12);
+            // The second differences of each cubic, {p0 - 2p1 + p2, p1 - 2p2 + p3}, transposed so
+            // that each lane holds one cubic.
+            float4 v[4];
+            for (int i = 0; i < 4; ++i) {
+                const float2* c = p + 3*i;
+                v[i] = -2*float4(c[1], c[2]) + float4(c[0], c[1]) + float4(c[2], c[3]);
+            }
+            float4 x0 = {v[0][0], v[1][0], v[2][0], v[3][0]};
+            float4 y0 = {v[0][1], v[1][1], v[2][1], v[3][1]};
+            float4 x1 = {v[0][2], v[1][2], v[2][2], v[3][2]};
+            float4 y1 = {v[0][3], v[1][3], v[2][3], v[3][3]};
+            fApproxTransform(&x0, &y0);
+            fApproxTransform(&x1, &y1);
+            float4 n4 = max(x0*x0 + y0*y0, x1*x1 + y1*y1) *
+                        wangs_formula::length_term_p2<3>(kPrecision);
+            int4 keep = kDiscardFlatCurves ? int4(n4 > 1.f) : int4(-1);
+            if (!any(keep)) {
+                continue;
+            }
+            if (all(keep & (n4 <= kMaxParametricSegments_p4))) {
+                // The allocators only track the largest tolerance, so record all four at once.
+                fTolerances.setParametricSegments(max(n4));
+                if (VertexWriter vw = fPatchAllocator.append(fTolerances, 4)) {
+                    for (int i = 0; i < 4; ++i) {
+                        vw << p[3*i] << p[3*i + 1] << p[3*i + 2] << p[3*i + 3];
+                        this->emitPatchAttribs(vw, fJoin, kCubicCurveType);
+                    }
+                }
+                continue;
+            }
+            for (int i = 0; i < 4; ++i) {
+                if (keep[i]) {
+                    const float2* c = p + 3*i;
+                    this->writeCubicWithN4(c[0], c[1], c[2], c[3], n4[i]);
+                }
+            }
+        }
+        for (; count > 0; --count, pts += 3) {
+            if constexpr (kMapPoints) {
+                auto [p0, p1] = m->map2Points(pts);
+                auto [p2, p3] = m->map2Points(pts + 2);
+                this->writeCubic(p0, p1, p2, p3);
+            } else {
+                this->writeCubic(pts);
+            }
+        }
+    }
+
+    AI void writeCubicWithN4(float2 p0, float2 p1, float2 p2, float2 p3, float n4) {
+        if (int numPatches = this->accountForCurve(n4)) {
+            this->chopAndWriteCubics(p0, p1, p2, p3, numPatches);
+        } else {
+            this->writeCubicPatch(p0, p1, p2, p3);
+        }
+    }
+
     int accountForCurve(float n4) {
         if (n4 <= kMaxParametricSegments_p4) {
             // Record n^4 and return 0 to signal no chopping
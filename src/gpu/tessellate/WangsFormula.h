@@ -87,6 +87,12 @@ public:
         return join(fC0 * vectors.x() + fC1 * vectors.y(),
                     fC0 * vectors.z() + fC1 * vectors.w());
     }
+    // Transforms four vectors at once, given as their x and y components.
+    AI void operator()(skvx::float4* x, skvx::float4* y) const {
+        skvx::float4 vx = *x, vy = *y;
+        *x = fC0.x() * vx + fC1.x() * vy;
+        *y = fC0.y() * vx + fC1.y() * vy;
+    }
 private:
     // First and second columns of 2x2 matrix
     skvx::float2 fC0;
@@ -112,6 +118,17 @@ AI float quadratic_p4(float precision,
                         vectorXform);
 }
 
+// Returns Wang's formula, raised to the 4th power, for four quadratic curves at once. x[i] and y[i]
+// hold the coordinates of control point i, with one curve in each lane.
+AI skvx::float4 quadratic_p4(float precision,
+                             const skvx::float4 x[3], const skvx::float4 y[3],
+                             const VectorXform& vectorXform = VectorXform()) {
+    skvx::float4 vx = -2*x[1] + x[0] + x[2];
+    skvx::float4 vy = -2*y[1] + y[0] + y[2];
+    vectorXform(&vx, &vy);
+    return (vx*vx + vy*vy) * length_term_p2<2>(precision);
+}
+
 // Returns Wang's formula specialized for a quadratic curve.
 AI float quadratic(float precision,
                    const SkPoint pts[],
@@ -151,6 +168,20 @@ AI float cubic_p4(float precision,
                     vectorXform);
 }
 
+// Returns Wang's formula, raised to the 4th power, for four cubic curves at once. x[i] and y[i] hold
+// the coordinates of control point i, with one curve in each lane.
+AI skvx::float4 cubic_p4(float precision,
+                         const skvx::float4 x[4], const skvx::float4 y[4],
+                         const VectorXform& vectorXform = VectorXform()) {
+    skvx::float4 vx0 = -2*x[1] + x[0] + x[2];
+    skvx::float4 vy0 = -2*y[1] + y[0] + y[2];
+    skvx::float4 vx1 = -2*x[2] + x[1] + x[3];
+    skvx::float4 vy1 = -2*y[2] + y[1] + y[3];
+    vectorXform(&vx0, &vy0);
+    vectorXform(&vx1, &vy1);
+    return max(vx0*vx0 + vy0*vy0, vx1*vx1 + vy1*vy1) * length_term_p2<3>(precision);
+}
+
 // Returns Wang's formula specialized for a cubic curve.
 AI float cubic(float precision,
                const SkPoint pts[],
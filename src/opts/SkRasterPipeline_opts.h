@@ -3756,6 +3756,36 @@ DECLARE_N_WAY_BINARY_FLOAT(pow)
 #undef DECLARE_N_WAY_BINARY_INT
 #undef DECLARE_N_WAY_BINARY_UINT
 
+// Immediate ops apply a constant operand, stored in the context, to a single slot. The SkSL
+// optimizer folds `push literal; op` sequences into these.
+template <typename T, typename V, void (*ApplyFn)(T*, T*)>
+SI void apply_binary_immediate(SkRasterPipeline_ConstantCtx* ctx) {
+    T* dst = (T*)ctx->dst;
+    T src = sk_bit_cast<V>(ctx->value);
+    ApplyFn(dst, &src);
+}
+
+#define DECLARE_IMM_BINARY_FLOAT(name)                                   \
+    STAGE_TAIL(name##_imm_float, SkRasterPipeline_ConstantCtx* ctx) {    \
+        apply_binary_immediate<F, float, &name##_fn>(ctx);               \
+    }
+#define DECLARE_IMM_BINARY_INT(name)                                     \
+    STAGE_TAIL(name##_imm_int, SkRasterPipeline_ConstantCtx* ctx) {      \
+        apply_binary_immediate<I32, int32_t, &name##_fn>(ctx);           \
+    }
+
+DECLARE_IMM_BINARY_FLOAT(add)    DECLARE_IMM_BINARY_INT(add)
+DECLARE_IMM_BINARY_FLOAT(mul)    DECLARE_IMM_BINARY_INT(mul)
+DECLARE_IMM_BINARY_FLOAT(min)
+DECLARE_IMM_BINARY_FLOAT(max)
+DECLARE_IMM_BINARY_FLOAT(cmplt)  DECLARE_IMM_BINARY_INT(cmplt)
+DECLARE_IMM_BINARY_FLOAT(cmple)  DECLARE_IMM_BINARY_INT(cmple)
+DECLARE_IMM_BINARY_FLOAT(cmpeq)  DECLARE_IMM_BINARY_INT(cmpeq)
+DECLARE_IMM_BINARY_FLOAT(cmpne)  DECLARE_IMM_BINARY_INT(cmpne)
+
+#undef DECLARE_IMM_BINARY_FLOAT
+#undef DECLARE_IMM_BINARY_INT
+
 // Dots can be represented with multiply and add ops, but they are so foundational that it's worth
 // having dedicated ops.
 STAGE_TAIL(dot_2_floats, F* dst) {
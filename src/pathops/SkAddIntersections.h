@@ -7,9 +7,17 @@
 #ifndef SkAddIntersections_DEFINED
 #define SkAddIntersections_DEFINED
 
+class SkExecutor;
 class SkOpCoincidence;
 class SkOpContour;
+class SkOpContourHead;
 
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence);
 
+// Adds the intersections between all of the segments in the sorted contour list. If `executor` is
+// not null, the intersections of each pair of overlapping contours are found on it, then added in
+// the same order as the serial loop, so the result is the same either way.
+void AddAllIntersectTs(SkOpContourHead* contourList, SkOpCoincidence* coincidence,
+                       SkExecutor* executor);
+
 #endif
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkPoint.h"
@@ -17,6 +18,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkOpContour.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
 #include "src/pathops/SkOpSegment.h"
@@ -26,6 +28,9 @@
 #include "src/pathops/SkPathWriter.h"
 
 #include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
@@ -140,7 +145,54 @@ void SkOpBuilder::reset() {
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
+static bool all_unions(const SkTDArray<SkPathOp>& ops) {
+    for (SkPathOp op : ops) {
+        if (op != kUnion_SkPathOp) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Union is associative, so instead of adding the paths to the result one at a time (which
+   intersects the growing result with every path), combine them in a balanced tree. Each level
+   unions disjoint pairs concurrently, and the shape of the tree depends only on the number of
+   paths, so the result doesn't depend on how the work is scheduled. */
+bool SkOpBuilder::unionTree(SkPath* result, SkExecutor* executor) {
+    std::vector<SkPath> level(fPathRefs.begin(), fPathRefs.end());
+    while (level.size() > 1) {
+        int pairs = SkToInt(level.size() / 2);
+        std::vector<SkPath> next(level.size() - pairs);
+        std::unique_ptr<bool[]> failed(new bool[pairs]());
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(pairs, [&](int index) {
+            failed[index] = !OpParallel(level[2 * index], level[2 * index + 1], kUnion_SkPathOp,
+                                        &next[index], executor);
+        });
+        taskGroup.wait();
+        for (int index = 0; index < pairs; ++index) {
+            if (failed[index]) {
+                return false;
+            }
+        }
+        if (level.size() & 1) {
+            next.back() = std::move(level.back());
+        }
+        level = std::move(next);
+    }
+    *result = std::move(level.front());
+    return true;
+}
+
 bool SkOpBuilder::resolve(SkPath* result) {
+    return this->resolve(result, /*executor=*/nullptr);
+}
+
+bool SkOpBuilder::resolveParallel(SkPath* result, SkExecutor* executor) {
+    return this->resolve(result, executor ? executor : &SkExecutor::GetDefault());
+}
+
+bool SkOpBuilder::resolve(SkPath* result, SkExecutor* executor) {
     SkPath original = *result;
     int count = fOps.size();
     bool allUnion = true;
@@ -175,10 +227,18 @@ bool SkOpBuilder::resolve(SkPath* result) {
             }
         }
     }
+    if (!allUnion && executor && all_unions(fOps)) {
+        bool success = this->unionTree(result, executor);
+        reset();
+        if (!success) {
+            *result = original;
+        }
+        return success;
+    }
     if (!allUnion) {
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
-            if (!Op(*result, fPathRefs[index], fOps[index], result)) {
+            if (!OpParallel(*result, fPathRefs[index], fOps[index], result, executor)) {
                 reset();
                 *result = original;
                 return false;
@@ -187,24 +247,46 @@ bool SkOpBuilder::resolve(SkPath* result) {
         reset();
         return true;
     }
+    enum class Simplified { kOK, kSimplifyFailed, kFixWindingFailed };
+    auto simplify = [this](int index) {
+        SkPath* path = &fPathRefs[index];
+        if (!Simplify(*path, path)) {
+            return Simplified::kSimplifyFailed;
+        }
+        // convert the even odd result back to winding form before accumulating it
+        if (!path->isEmpty() && !FixWinding(path)) {
+            return Simplified::kFixWindingFailed;
+        }
+        return Simplified::kOK;
+    };
+    // Each path is simplified independently, so they can all be simplified at once. They are
+    // still accumulated in order.
+    std::vector<Simplified> simplified;
+    if (executor) {
+        simplified.resize(count);
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(count, [&](int index) { simplified[index] = simplify(index); });
+        taskGroup.wait();
+    }
     SkPath sum;
     for (int index = 0; index < count; ++index) {
-        if (!Simplify(fPathRefs[index], &fPathRefs[index])) {
-            reset();
-            *result = original;
-            return false;
-        }
-        if (!fPathRefs[index].isEmpty()) {
-            // convert the even odd result back to winding form before accumulating it
-            if (!FixWinding(&fPathRefs[index])) {
+        switch (executor ? simplified[index] : simplify(index)) {
+            case Simplified::kSimplifyFailed:
+                reset();
                 *result = original;
                 return false;
-            }
+            case Simplified::kFixWindingFailed:
+                *result = original;
+                return false;
+            case Simplified::kOK:
+                break;
+        }
+        if (!fPathRefs[index].isEmpty()) {
             sum.addPath(fPathRefs[index]);
         }
     }
     reset();
-    bool success = Simplify(sum, result);
+    bool success = SimplifyParallel(sum, result, executor);
     if (!success) {
         *result = original;
     }
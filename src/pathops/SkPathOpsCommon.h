@@ -10,6 +10,7 @@
 #include "include/pathops/SkPathOps.h"
 #include "src/pathops/SkPathOpsTypes.h"
 
+class SkExecutor;
 class SkOpAngle;
 class SkOpCoincidence;
 class SkOpContourHead;
@@ -32,5 +33,13 @@ bool HandleCoincidence(SkOpContourHead* , SkOpCoincidence* );
 bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
              SkDEBUGPARAMS(bool skipAssert)
              SkDEBUGPARAMS(const char* testName));
+bool SimplifyDebug(const SkPath& one, SkPath* result
+                   SkDEBUGPARAMS(bool skipAssert)
+                   SkDEBUGPARAMS(const char* testName));
+
+// Like Op() and Simplify(), but the intersections are found on `executor`, if it isn't null.
+bool OpParallel(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+                SkExecutor* executor);
+bool SimplifyParallel(const SkPath& path, SkPath* result, SkExecutor* executor);
 
 #endif
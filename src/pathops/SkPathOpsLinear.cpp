@@ -0,0 +1,622 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "src/pathops/SkPathOpsLinear.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTPin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Grid coordinates are in [0, 2^kGridBits]. With 19 bits, the largest product formed below (a
+// coordinate times the cross product of two edge vectors) stays under 2^60.
+static constexpr int kGridBits = 19;
+
+namespace {
+
+// Points sort top to bottom, then left to right.
+struct IPoint {
+    int64_t fX;
+    int64_t fY;
+
+    bool operator==(const IPoint& p) const { return fX == p.fX && fY == p.fY; }
+    bool operator!=(const IPoint& p) const { return !(*this == p); }
+    bool operator<(const IPoint& p) const { return fY < p.fY || (fY == p.fY && fX < p.fX); }
+};
+
+// Maps the combined bounds of the inputs onto the grid, preserving the aspect ratio.
+class Grid {
+public:
+    explicit Grid(const SkRect& bounds) : fBounds(bounds) {
+        double extent = std::max((double) bounds.fRight - bounds.fLeft,
+                                 (double) bounds.fBottom - bounds.fTop);
+        int exponent = 0;
+        if (extent > 0) {
+            std::frexp(extent, &exponent);  // extent < 2^exponent
+        }
+        fScale = std::ldexp(1.0, kGridBits - exponent);
+        fInvScale = std::ldexp(1.0, exponent - kGridBits);
+    }
+
+    IPoint snap(SkPoint pt) const {
+        return {(int64_t) std::floor((pt.fX - (double) fBounds.fLeft) * fScale + 0.5),
+                (int64_t) std::floor((pt.fY - (double) fBounds.fTop) * fScale + 0.5)};
+    }
+
+    SkPoint unsnap(IPoint pt) const {
+        // Rounding can put a point up to half a grid unit outside of the bounds.
+        float x = (float) (fBounds.fLeft + pt.fX * fInvScale);
+        float y = (float) (fBounds.fTop + pt.fY * fInvScale);
+        return {SkTPin(x, fBounds.fLeft, fBounds.fRight), SkTPin(y, fBounds.fTop, fBounds.fBottom)};
+    }
+
+private:
+    SkRect fBounds;
+    double fScale;
+    double fInvScale;
+};
+
+struct Segment {
+    IPoint fStart;
+    IPoint fEnd;
+    int fOperand;
+
+    int64_t left() const { return std::min(fStart.fX, fEnd.fX); }
+    int64_t right() const { return std::max(fStart.fX, fEnd.fX); }
+    int64_t top() const { return std::min(fStart.fY, fEnd.fY); }
+    int64_t bottom() const { return std::max(fStart.fY, fEnd.fY); }
+};
+
+// Divides the grid into square cells about the size of a typical segment, so that each segment
+// is only compared with the segments and hot pixels near it.
+class Cells {
+public:
+    explicit Cells(const std::vector<Segment>& segments) {
+        int64_t total = 0;
+        for (const Segment& s : segments) {
+            total += std::max(s.right() - s.left(), s.bottom() - s.top());
+        }
+        int64_t typical = total / std::max<int64_t>(segments.size(), 1) + 1;
+        int64_t maxCount = 4 * (int64_t) segments.size() + 16;
+        fShift = 0;
+        while ((int64_t{1} << fShift) < typical || this->columns() * this->columns() > maxCount) {
+            ++fShift;
+        }
+    }
+
+    int count() const { return (int) (this->columns() * this->columns()); }
+
+    int cellOf(const IPoint& pt) const {
+        return (int) ((pt.fY >> fShift) * this->columns() + (pt.fX >> fShift));
+    }
+
+    // Calls fn for every cell overlapping the segment's bounds.
+    template <typename Fn> void forEachCell(const Segment& s, Fn&& fn) const {
+        for (int64_t row = s.top() >> fShift; row <= s.bottom() >> fShift; ++row) {
+            for (int64_t column = s.left() >> fShift; column <= s.right() >> fShift; ++column) {
+                fn((int) (row * this->columns() + column));
+            }
+        }
+    }
+
+private:
+    int64_t columns() const { return ((int64_t{1} << kGridBits) >> fShift) + 1; }
+
+    int fShift;
+};
+
+// The items in each cell, stored contiguously. `forEach` is called twice with a function taking
+// an item and one of its cells.
+class CellLists {
+public:
+    template <typename ForEach> CellLists(int cellCount, ForEach&& forEach)
+            : fStarts(cellCount + 1, 0) {
+        forEach([&](int, int cell) { ++fStarts[cell + 1]; });
+        for (int cell = 0; cell < cellCount; ++cell) {
+            fStarts[cell + 1] += fStarts[cell];
+        }
+        fItems.resize(fStarts.back());
+        std::vector<int> next(fStarts.begin(), fStarts.end() - 1);
+        forEach([&](int item, int cell) { fItems[next[cell]++] = item; });
+    }
+
+    SkSpan<const int> list(int cell) const {
+        return {fItems.data() + fStarts[cell], (size_t) (fStarts[cell + 1] - fStarts[cell])};
+    }
+
+private:
+    std::vector<int> fStarts;
+    std::vector<int> fItems;
+};
+
+// An edge of the snap-rounded arrangement, directed from its top (or, if it is horizontal, its
+// left) end. fWind counts how many times each operand runs from fA to fB, less the times it runs
+// back. fPositive and fNegative are each operand's winding number on either side: the positive
+// side is the one to the left of a downward edge, or below a rightward edge.
+struct Piece {
+    IPoint fA;
+    IPoint fB;
+    int fWind[2];
+    int fPositive[2];
+    int fNegative[2];
+
+    bool isHorizontal() const { return fA.fY == fB.fY; }
+    int64_t dx() const { return fB.fX - fA.fX; }
+    int64_t dy() const { return fB.fY - fA.fY; }
+
+    // x * dy() at a y within the piece's vertical extent.
+    int64_t scaledXAt(int64_t y) const { return fA.fX * this->dy() + (y - fA.fY) * this->dx(); }
+};
+
+// A non-horizontal piece crossing the sweep line, with the parts of it the sweep reads most.
+struct ActiveEdge {
+    int64_t fBottom;
+    int fIndex;
+    int fWind[2];
+};
+
+struct DirectedEdge {
+    IPoint fFrom;
+    IPoint fTo;
+
+    bool operator<(const DirectedEdge& e) const {
+        return fFrom < e.fFrom || (fFrom == e.fFrom && fTo < e.fTo);
+    }
+};
+
+// Decides which side of a piece is inside of the result, from the winding numbers of each operand.
+class Classifier {
+public:
+    Classifier(SkPathOp op, SkPathFillType one, SkPathFillType two) : fOp(op) {
+        fEvenOdd[0] = SkPathFillType_IsEvenOdd(one);
+        fEvenOdd[1] = SkPathFillType_IsEvenOdd(two);
+        fInverse[0] = SkPathFillType_IsInverse(one);
+        fInverse[1] = SkPathFillType_IsInverse(two);
+    }
+
+    bool inside(const int wind[2]) const {
+        bool one = fInverse[0] != (fEvenOdd[0] ? (wind[0] & 1) != 0 : wind[0] != 0);
+        bool two = fInverse[1] != (fEvenOdd[1] ? (wind[1] & 1) != 0 : wind[1] != 0);
+        switch (fOp) {
+            case kDifference_SkPathOp:
+                return one && !two;
+            case kIntersect_SkPathOp:
+                return one && two;
+            case kUnion_SkPathOp:
+                return one || two;
+            case kXOR_SkPathOp:
+                return one != two;
+            case kReverseDifference_SkPathOp:
+                return two && !one;
+        }
+        SkUNREACHABLE;
+    }
+
+private:
+    SkPathOp fOp;
+    bool fEvenOdd[2];
+    bool fInverse[2];
+};
+
+}  // namespace
+
+static int64_t cross(int64_t ax, int64_t ay, int64_t bx, int64_t by) {
+    return ax * by - ay * bx;
+}
+
+static int orientation(const IPoint& a, const IPoint& b, const IPoint& c) {
+    int64_t turn = cross(b.fX - a.fX, b.fY - a.fY, c.fX - a.fX, c.fY - a.fY);
+    return (turn > 0) - (turn < 0);
+}
+
+static bool can_snap(const SkPath& path) {
+    return !(path.getSegmentMasks() & ~SkPath::kLine_SegmentMask) && path.isFinite();
+}
+
+static void add_segments(const SkPath& path, const Grid& grid, int operand,
+                         std::vector<Segment>* segments) {
+    SkPath::Iter iter(path, /*forceClose=*/true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        if (verb == SkPath::kLine_Verb) {
+            IPoint start = grid.snap(pts[0]);
+            IPoint end = grid.snap(pts[1]);
+            if (start != end) {
+                segments->push_back({start, end, operand});
+            }
+        }
+    }
+}
+
+// If the segments cross at a point inside of both, returns that point rounded to the grid.
+static bool crossing(const Segment& s, const Segment& t, IPoint* pt) {
+    if (orientation(s.fStart, s.fEnd, t.fStart) * orientation(s.fStart, s.fEnd, t.fEnd) >= 0 ||
+        orientation(t.fStart, t.fEnd, s.fStart) * orientation(t.fStart, t.fEnd, s.fEnd) >= 0) {
+        return false;
+    }
+    int64_t dx = s.fEnd.fX - s.fStart.fX;
+    int64_t dy = s.fEnd.fY - s.fStart.fY;
+    int64_t ex = t.fEnd.fX - t.fStart.fX;
+    int64_t ey = t.fEnd.fY - t.fStart.fY;
+    int64_t den = cross(dx, dy, ex, ey);
+    int64_t num = cross(t.fStart.fX - s.fStart.fX, t.fStart.fY - s.fStart.fY, ex, ey);
+    if (den < 0) {
+        den = -den;
+        num = -num;
+    }
+    // The crossing is at s.fStart + (dx, dy) * num / den; both of its coordinates are positive.
+    SkASSERT(0 < num && num < den);
+    pt->fX = (2 * (s.fStart.fX * den + dx * num) + den) / (2 * den);
+    pt->fY = (2 * (s.fStart.fY * den + dy * num) + den) / (2 * den);
+    return true;
+}
+
+// Returns the hot pixels: the grid points of every segment end and every crossing, sorted.
+static std::vector<IPoint> find_hot_pixels(const std::vector<Segment>& segments,
+                                           const Cells& cells) {
+    // The contours are closed, so every segment ends where another starts.
+    std::vector<IPoint> hot;
+    hot.reserve(segments.size() * 2);
+    for (const Segment& s : segments) {
+        hot.push_back(s.fStart);
+    }
+    CellLists segmentsByCell(cells.count(), [&](auto&& add) {
+        for (size_t i = 0; i < segments.size(); ++i) {
+            cells.forEachCell(segments[i], [&](int cell) { add((int) i, cell); });
+        }
+    });
+    for (int cell = 0; cell < cells.count(); ++cell) {
+        SkSpan<const int> list = segmentsByCell.list(cell);
+        for (size_t i = 0; i < list.size(); ++i) {
+            const Segment& s = segments[list[i]];
+            for (size_t j = i + 1; j < list.size(); ++j) {
+                const Segment& t = segments[list[j]];
+                // Test each pair once, in the cell holding the corner of their common bounds.
+                int64_t left = std::max(s.left(), t.left());
+                int64_t top = std::max(s.top(), t.top());
+                if (left > std::min(s.right(), t.right()) ||
+                    top > std::min(s.bottom(), t.bottom()) ||
+                    cells.cellOf({left, top}) != cell) {
+                    continue;
+                }
+                IPoint pt;
+                if (crossing(s, t, &pt)) {
+                    hot.push_back(pt);
+                }
+            }
+        }
+    }
+    std::sort(hot.begin(), hot.end());
+    hot.erase(std::unique(hot.begin(), hot.end()), hot.end());
+    return hot;
+}
+
+// Returns true if the segment touches the closed square of side 1 centered on the hot pixel.
+static bool touches(const Segment& s, const IPoint& pixel) {
+    // The caller has checked that the bounds overlap, so the segment misses the square only if
+    // all four corners are strictly on one side of it. The corners are computed at twice scale.
+    int64_t dx = s.fEnd.fX - s.fStart.fX;
+    int64_t dy = s.fEnd.fY - s.fStart.fY;
+    int64_t cx = 2 * (pixel.fX - s.fStart.fX);
+    int64_t cy = 2 * (pixel.fY - s.fStart.fY);
+    int positive = 0;
+    int negative = 0;
+    for (int corner = 0; corner < 4; ++corner) {
+        int64_t turn = cross(dx, dy, cx + (corner & 1 ? 1 : -1), cy + (corner & 2 ? 1 : -1));
+        positive += turn > 0;
+        negative += turn < 0;
+    }
+    return positive < 4 && negative < 4;
+}
+
+// Replaces each segment with the path through the hot pixels it touches, and accumulates the
+// resulting pieces. Segments that run along one another share their pieces.
+static std::vector<Piece> snap_round(const std::vector<Segment>& segments,
+                                     const std::vector<IPoint>& hot,
+                                     const Cells& cells) {
+    CellLists hotByCell(cells.count(), [&](auto&& add) {
+        for (size_t i = 0; i < hot.size(); ++i) {
+            add((int) i, cells.cellOf(hot[i]));
+        }
+    });
+    std::vector<Piece> pieces;
+    pieces.reserve(segments.size());
+    std::vector<IPoint> route;
+    for (const Segment& s : segments) {
+        // Only the hot pixels within the segment's bounds can touch it.
+        route.clear();
+        cells.forEachCell(s, [&](int cell) {
+            for (int index : hotByCell.list(cell)) {
+                const IPoint& pixel = hot[index];
+                if (s.left() <= pixel.fX && pixel.fX <= s.right() &&
+                    s.top() <= pixel.fY && pixel.fY <= s.bottom() && touches(s, pixel)) {
+                    route.push_back(pixel);
+                }
+            }
+        });
+        // Order the route by distance along the segment; the ends sort first and last.
+        int64_t dx = s.fEnd.fX - s.fStart.fX;
+        int64_t dy = s.fEnd.fY - s.fStart.fY;
+        std::sort(route.begin(), route.end(), [&](const IPoint& a, const IPoint& b) {
+            int64_t distA = (a.fX - s.fStart.fX) * dx + (a.fY - s.fStart.fY) * dy;
+            int64_t distB = (b.fX - s.fStart.fX) * dx + (b.fY - s.fStart.fY) * dy;
+            return distA < distB || (distA == distB && a < b);
+        });
+        SkASSERT(route.size() >= 2 && route.front() == s.fStart && route.back() == s.fEnd);
+        for (size_t i = 1; i < route.size(); ++i) {
+            Piece piece = {route[i - 1], route[i], {0, 0}, {0, 0}, {0, 0}};
+            piece.fWind[s.fOperand] = 1;
+            if (piece.fB < piece.fA) {
+                std::swap(piece.fA, piece.fB);
+                piece.fWind[s.fOperand] = -1;
+            }
+            pieces.push_back(piece);
+        }
+    }
+    std::sort(pieces.begin(), pieces.end(), [](const Piece& a, const Piece& b) {
+        return a.fA < b.fA || (a.fA == b.fA && a.fB < b.fB);
+    });
+    // Merge duplicates, and drop the pieces that the operands traverse equally in both directions.
+    size_t count = 0;
+    for (size_t i = 0; i < pieces.size();) {
+        Piece merged = pieces[i];
+        for (++i; i < pieces.size() && pieces[i].fA == merged.fA && pieces[i].fB == merged.fB;
+                ++i) {
+            merged.fWind[0] += pieces[i].fWind[0];
+            merged.fWind[1] += pieces[i].fWind[1];
+        }
+        if (merged.fWind[0] || merged.fWind[1]) {
+            pieces[count++] = merged;
+        }
+    }
+    pieces.resize(count);
+    return pieces;
+}
+
+// Returns true if `e` is left of `f` just below y. Both must span y.
+static bool left_of(const Piece& e, const Piece& f, int64_t y) {
+    int64_t ex = e.scaledXAt(y) * f.dy();
+    int64_t fx = f.scaledXAt(y) * e.dy();
+    if (ex != fx) {
+        return ex < fx;
+    }
+    return e.dx() * f.dy() < f.dx() * e.dy();
+}
+
+// Sets the winding on one side of each horizontal piece at y, from the non-horizontal pieces
+// that cross y to its left.
+static void wind_horizontals(std::vector<Piece>& pieces, const std::vector<ActiveEdge>& active,
+                             const std::vector<int>& horizontals, int64_t y, bool below) {
+    int wind[2] = {0, 0};
+    size_t next = 0;
+    for (int h : horizontals) {
+        Piece& horizontal = pieces[h];
+        int64_t twiceMidX = horizontal.fA.fX + horizontal.fB.fX;
+        for (; next < active.size(); ++next) {
+            const Piece& edge = pieces[active[next].fIndex];
+            if (2 * edge.scaledXAt(y) >= twiceMidX * edge.dy()) {
+                break;
+            }
+            wind[0] += edge.fWind[0];
+            wind[1] += edge.fWind[1];
+        }
+        int* side = below ? horizontal.fPositive : horizontal.fNegative;
+        side[0] = wind[0];
+        side[1] = wind[1];
+    }
+}
+
+// Computes the winding numbers on both sides of every piece with a sweep from top to bottom.
+static void wind_pieces(std::vector<Piece>& pieces) {
+    std::vector<ActiveEdge> active;  // the non-horizontal pieces crossing the sweep, left to right
+    std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t>> bottoms;
+    std::vector<int> horizontals;
+    size_t next = 0;
+    while (next < pieces.size() || !bottoms.empty()) {
+        int64_t y = next < pieces.size() ? pieces[next].fA.fY : bottoms.top();
+        if (!bottoms.empty()) {
+            y = std::min(y, bottoms.top());
+        }
+        while (!bottoms.empty() && bottoms.top() == y) {
+            bottoms.pop();
+        }
+        // Pieces are sorted by their top end, and horizontal ones at the same y by their left end.
+        size_t end = next;
+        horizontals.clear();
+        for (; end < pieces.size() && pieces[end].fA.fY == y; ++end) {
+            if (pieces[end].isHorizontal()) {
+                horizontals.push_back((int) end);
+            }
+        }
+        if (!horizontals.empty()) {
+            wind_horizontals(pieces, active, horizontals, y, /*below=*/false);
+        }
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [y](const ActiveEdge& e) { return e.fBottom == y; }),
+                     active.end());
+        bool inserted = false;
+        for (size_t i = next; i < end; ++i) {
+            const Piece& piece = pieces[i];
+            if (!piece.isHorizontal()) {
+                auto where = std::upper_bound(active.begin(), active.end(), piece,
+                        [&](const Piece& p, const ActiveEdge& e) {
+                            return left_of(p, pieces[e.fIndex], y);
+                        });
+                active.insert(where, {piece.fB.fY, (int) i, {piece.fWind[0], piece.fWind[1]}});
+                bottoms.push(piece.fB.fY);
+                inserted = true;
+            }
+        }
+        if (inserted) {
+            int wind[2] = {0, 0};
+            for (const ActiveEdge& e : active) {
+                if ((size_t) e.fIndex >= next) {
+                    Piece& piece = pieces[e.fIndex];
+                    piece.fPositive[0] = wind[0];
+                    piece.fPositive[1] = wind[1];
+                    piece.fNegative[0] = wind[0] + e.fWind[0];
+                    piece.fNegative[1] = wind[1] + e.fWind[1];
+                }
+                wind[0] += e.fWind[0];
+                wind[1] += e.fWind[1];
+            }
+        }
+        if (!horizontals.empty()) {
+            wind_horizontals(pieces, active, horizontals, y, /*below=*/true);
+        }
+        next = end;
+    }
+}
+
+// Returns the edges separating the inside of the result from the outside, directed so that the
+// inside of the bounded region is on their positive side.
+static std::vector<DirectedEdge> find_boundary(const std::vector<Piece>& pieces,
+                                               const Classifier& classifier, bool outInverse) {
+    std::vector<DirectedEdge> boundary;
+    for (const Piece& piece : pieces) {
+        bool positive = classifier.inside(piece.fPositive) != outInverse;
+        bool negative = classifier.inside(piece.fNegative) != outInverse;
+        if (positive != negative) {
+            boundary.push_back(positive ? DirectedEdge{piece.fA, piece.fB}
+                                        : DirectedEdge{piece.fB, piece.fA});
+        }
+    }
+    std::sort(boundary.begin(), boundary.end());
+    return boundary;
+}
+
+// Returns true if, turning from `back` toward the negative side, `a` comes before `b`.
+static bool turns_before(const IPoint& back, const IPoint& a, const IPoint& b) {
+    bool aSecondHalf = cross(back.fX, back.fY, a.fX, a.fY) >= 0;
+    bool bSecondHalf = cross(back.fX, back.fY, b.fX, b.fY) >= 0;
+    if (aSecondHalf != bSecondHalf) {
+        return bSecondHalf;
+    }
+    return cross(a.fX, a.fY, b.fX, b.fY) < 0;
+}
+
+// Links the boundary edges into closed contours. At a vertex shared by several contours, the
+// turn that keeps the bounded region on the same side is taken, so the contours never cross.
+static bool trace_boundary(const std::vector<DirectedEdge>& boundary, const Grid& grid,
+                           SkPath* path) {
+    std::vector<bool> used(boundary.size(), false);
+    std::vector<IPoint> contour;
+    for (size_t start = 0; start < boundary.size(); ++start) {
+        if (used[start]) {
+            continue;
+        }
+        contour.clear();
+        size_t edge = start;
+        do {
+            used[edge] = true;
+            const IPoint& from = boundary[edge].fFrom;
+            const IPoint& to = boundary[edge].fTo;
+            contour.push_back(from);
+            auto first = std::lower_bound(boundary.begin(), boundary.end(),
+                                          DirectedEdge{to, {INT64_MIN, INT64_MIN}});
+            if (first == boundary.end() || first->fFrom != to) {
+                return false;
+            }
+            IPoint back = {from.fX - to.fX, from.fY - to.fY};
+            auto best = first;
+            for (auto next = first + 1; next != boundary.end() && next->fFrom == to; ++next) {
+                IPoint out = {next->fTo.fX - to.fX, next->fTo.fY - to.fY};
+                IPoint bestOut = {best->fTo.fX - to.fX, best->fTo.fY - to.fY};
+                if (turns_before(back, out, bestOut)) {
+                    best = next;
+                }
+            }
+            edge = best - boundary.begin();
+            if (used[edge] && edge != start) {
+                return false;
+            }
+        } while (edge != start);
+
+        // Drop the vertices that fall in the middle of a straight run.
+        size_t count = contour.size();
+        bool moved = false;
+        for (size_t i = 0; i < count; ++i) {
+            const IPoint& prev = contour[(i + count - 1) % count];
+            const IPoint& pt = contour[i];
+            const IPoint& next = contour[(i + 1) % count];
+            int64_t inX = pt.fX - prev.fX;
+            int64_t inY = pt.fY - prev.fY;
+            int64_t outX = next.fX - pt.fX;
+            int64_t outY = next.fY - pt.fY;
+            if (cross(inX, inY, outX, outY) == 0 && inX * outX + inY * outY > 0) {
+                continue;
+            }
+            SkPoint point = grid.unsnap(pt);
+            if (moved) {
+                path->lineTo(point);
+            } else {
+                path->moveTo(point);
+                moved = true;
+            }
+        }
+        if (moved) {
+            path->close();
+        }
+    }
+    return true;
+}
+
+static bool linear_op(const SkPath& one, const SkPath* two, SkPathOp op, SkPath* result) {
+    SkRect bounds = one.getBounds();
+    if (two) {
+        bounds.joinPossiblyEmptyRect(two->getBounds());
+    }
+    Grid grid(bounds);
+    std::vector<Segment> segments;
+    segments.reserve(one.countPoints() + (two ? two->countPoints() : 0));
+    add_segments(one, grid, 0, &segments);
+    if (two) {
+        add_segments(*two, grid, 1, &segments);
+    }
+    Cells cells(segments);
+    std::vector<Piece> pieces = snap_round(segments, find_hot_pixels(segments, cells), cells);
+    wind_pieces(pieces);
+
+    // Simplify is the union of the path with nothing.
+    Classifier classifier(op, one.getFillType(),
+                          two ? two->getFillType() : SkPathFillType::kWinding);
+    const int outside[2] = {0, 0};
+    bool outInverse = classifier.inside(outside);
+    SkPath path;
+    path.setFillType(outInverse ? SkPathFillType::kInverseEvenOdd : SkPathFillType::kEvenOdd);
+    if (!trace_boundary(find_boundary(pieces, classifier, outInverse), grid, &path)) {
+        return false;
+    }
+    result->swap(path);
+    return true;
+}
+
+bool LinearOp(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    if (!can_snap(one) || !can_snap(two)) {
+        return false;
+    }
+    return linear_op(one, &two, op, result);
+}
+
+bool LinearSimplify(const SkPath& path, SkPath* result) {
+    if (!can_snap(path)) {
+        return false;
+    }
+    return linear_op(path, nullptr, kUnion_SkPathOp, result);
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkPathOpsLinear_DEFINED
+#define SkPathOpsLinear_DEFINED
+
+#include "include/pathops/SkPathOps.h"
+
+class SkPath;
+
+/**
+ *  Boolean operations for paths made only of lines.
+ *
+ *  The inputs are snapped to an integer grid spanning 2^19 units across their combined bounds,
+ *  and the edges are snap rounded (every edge is routed through the grid points of the
+ *  intersections and vertices it passes near), so all of the arithmetic that follows is exact.
+ *  The result is a function of the input points alone; it does not depend on the platform, the
+ *  order of the contours, or the thread.
+ *
+ *  These return false, leaving result untouched, if a path contains curves or non-finite points.
+ */
+bool LinearOp(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result);
+bool LinearSimplify(const SkPath& path, SkPath* result);
+
+/**
+ *  Like Op() and Simplify(), but paths made only of lines go through LinearOp() and
+ *  LinearSimplify(). The result can differ from Op()'s and Simplify()'s: output points may move
+ *  by up to half a grid unit, and features thinner than a grid unit may disappear. Paths with
+ *  curves or non-finite points are handled exactly as Op() and Simplify() do.
+ */
+bool SnapRoundedOp(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result);
+bool SnapRoundedSimplify(const SkPath& path, SkPath* result);
+
+#endif
@@ -20,6 +20,7 @@
 #include "src/pathops/SkOpSegment.h"
 #include "src/pathops/SkOpSpan.h"
 #include "src/pathops/SkPathOpsCommon.h"
+#include "src/pathops/SkPathOpsLinear.h"
 #include "src/pathops/SkPathOpsTypes.h"
 #include "src/pathops/SkPathWriter.h"
 
@@ -249,8 +250,9 @@ extern void (*gVerboseFinalize)();
 
 #endif
 
-bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
-        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+static bool op_internal(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+                        SkExecutor* executor, bool allowLinear
+                        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
 #if DEBUG_DUMP_VERIFY
 #ifndef SK_DEBUG
     const char* testName = "release";
@@ -259,6 +261,7 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         DumpOp(one, two, op, testName);
     }
 #endif
+    const SkPathOp originalOp = op;
     op = gOpInverse[op][one.isInverseFillType()][two.isInverseFillType()];
     bool inverseFill = gOutInverse[op][one.isInverseFillType()][two.isInverseFillType()];
     SkPathFillType fillType = inverseFill ? SkPathFillType::kInverseEvenOdd :
@@ -299,6 +302,9 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         }
         return Simplify(work, result);
     }
+    if (allowLinear && LinearOp(one, two, originalOp, result)) {
+        return true;
+    }
     SkSTArenaAlloc<4096> allocator;  // FIXME: add a constant expression here, tune
     SkOpContour contour;
     SkOpContourHead* contourList = static_cast<SkOpContourHead*>(&contour);
@@ -337,13 +343,7 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         return true;
     }
     // find all intersections between segments
-    SkOpContour* current = contourList;
-    do {
-        SkOpContour* next = current;
-        while (AddIntersectTs(current, next, &coincidence)
-                && (next = next->next()))
-            ;
-    } while ((current = current->next()));
+    AddAllIntersectTs(contourList, &coincidence, executor);
 #if DEBUG_VALIDATE
     globalState.setPhase(SkOpPhase::kWalking);
 #endif
@@ -380,6 +380,18 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
     return true;
 }
 
+bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
+        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+    return op_internal(one, two, op, result, /*executor=*/nullptr, /*allowLinear=*/false
+                       SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
+}
+
+bool OpParallel(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+                SkExecutor* executor) {
+    return op_internal(one, two, op, result, executor, /*allowLinear=*/false
+                       SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+}
+
 bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
@@ -393,3 +405,8 @@ bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
 #endif
     return OpDebug(one, two, op, result  SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
 }
+
+bool SnapRoundedOp(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    return op_internal(one, two, op, result, /*executor=*/nullptr, /*allowLinear=*/true
+                       SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+}
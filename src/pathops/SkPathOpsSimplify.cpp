@@ -17,6 +17,7 @@
 #include "src/pathops/SkOpSegment.h"
 #include "src/pathops/SkOpSpan.h"
 #include "src/pathops/SkPathOpsCommon.h"
+#include "src/pathops/SkPathOpsLinear.h"
 #include "src/pathops/SkPathOpsTypes.h"
 #include "src/pathops/SkPathWriter.h"
 
@@ -147,8 +148,8 @@ static bool bridgeXor(SkOpContourHead* contourList, SkPathWriter* writer) {
 }
 
 // FIXME : add this as a member of SkPath
-bool SimplifyDebug(const SkPath& path, SkPath* result
-        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+static bool simplify_internal(const SkPath& path, SkPath* result, SkExecutor* executor,
+        bool allowLinear SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
     // returns 1 for evenodd, -1 for winding, regardless of inverse-ness
     SkPathFillType fillType = path.isInverseFillType() ? SkPathFillType::kInverseEvenOdd
             : SkPathFillType::kEvenOdd;
@@ -159,6 +160,9 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
         result->setFillType(fillType);
         return true;
     }
+    if (allowLinear && LinearSimplify(path, result)) {
+        return true;
+    }
     // turn path into list of segments
     SkSTArenaAlloc<4096> allocator;  // FIXME: constant-ize, tune
     SkOpContour contour;
@@ -190,12 +194,7 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
         return true;
     }
     // find all intersections between segments
-    SkOpContour* current = contourList;
-    do {
-        SkOpContour* next = current;
-        while (AddIntersectTs(current, next, &coincidence)
-                && (next = next->next()));
-    } while ((current = current->next()));
+    AddAllIntersectTs(contourList, &coincidence, executor);
 #if DEBUG_VALIDATE
     globalState.setPhase(SkOpPhase::kWalking);
 #endif
@@ -221,6 +220,17 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
     return true;
 }
 
+bool SimplifyDebug(const SkPath& path, SkPath* result
+        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+    return simplify_internal(path, result, /*executor=*/nullptr, /*allowLinear=*/false
+                             SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
+}
+
+bool SimplifyParallel(const SkPath& path, SkPath* result, SkExecutor* executor) {
+    return simplify_internal(path, result, executor, /*allowLinear=*/false
+                             SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+}
+
 bool Simplify(const SkPath& path, SkPath* result) {
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
@@ -234,3 +244,8 @@ bool Simplify(const SkPath& path, SkPath* result) {
 #endif
     return SimplifyDebug(path, result  SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
 }
+
+bool SnapRoundedSimplify(const SkPath& path, SkPath* result) {
+    return simplify_internal(path, result, /*executor=*/nullptr, /*allowLinear=*/true
+                             SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+}
@@ -1744,7 +1744,8 @@ SkTypeface_FreeType::~SkTypeface_FreeType() {
     }
 }
 
-// Just made up, so we don't end up storing 1000s of entries
+// Just made up, so we don't end up storing 1000s of entries in the sorted array. The BMP is cached
+// in direct-mapped pages, which don't count toward this.
 constexpr int kMaxC2GCacheCount = 512;
 
 void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
@@ -1757,13 +1758,7 @@ void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
     {
         // Optimistically use a shared lock.
         SkAutoSharedMutexShared ama(fC2GCacheMutex);
-        for (i = 0; i < count; ++i) {
-            int index = fC2GCache.findGlyphIndex(uni[i]);
-            if (index < 0) {
-                break;
-            }
-            glyphs[i] = SkToU16(index);
-        }
+        i = fC2GCache.findGlyphs(uni, count, glyphs);
         if (i == count) {
             // we're done, no need to access the freetype objects
             return;
@@ -1790,7 +1785,7 @@ void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
         }
     }
 
-    if (fC2GCache.count() > kMaxC2GCacheCount) {
+    if (fC2GCache.otherCount() > kMaxC2GCacheCount) {
         fC2GCache.reset();
     }
 }
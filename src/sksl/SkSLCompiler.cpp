@@ -144,15 +144,16 @@ Compiler::Compiler(const ShaderCaps* caps) : fErrorReporter(this), fCaps(caps) {
 
 Compiler::~Compiler() {}
 
-const Module* Compiler::moduleForProgramKind(ProgramKind kind) {
-    auto m = ModuleLoader::Get();
+static const Module* load_module_for_program_kind(ModuleLoader& m,
+                                                  Compiler* compiler,
+                                                  ProgramKind kind) {
     switch (kind) {
-        case ProgramKind::kVertex:                return m.loadVertexModule(this);
-        case ProgramKind::kFragment:              return m.loadFragmentModule(this);
-        case ProgramKind::kCompute:               return m.loadComputeModule(this);
-        case ProgramKind::kGraphiteVertex:        return m.loadGraphiteVertexModule(this);
-        case ProgramKind::kGraphiteFragment:      return m.loadGraphiteFragmentModule(this);
-        case ProgramKind::kPrivateRuntimeShader:  return m.loadPrivateRTShaderModule(this);
+        case ProgramKind::kVertex:                return m.loadVertexModule(compiler);
+        case ProgramKind::kFragment:              return m.loadFragmentModule(compiler);
+        case ProgramKind::kCompute:               return m.loadComputeModule(compiler);
+        case ProgramKind::kGraphiteVertex:        return m.loadGraphiteVertexModule(compiler);
+        case ProgramKind::kGraphiteFragment:      return m.loadGraphiteFragmentModule(compiler);
+        case ProgramKind::kPrivateRuntimeShader:  return m.loadPrivateRTShaderModule(compiler);
         case ProgramKind::kRuntimeColorFilter:
         case ProgramKind::kRuntimeShader:
         case ProgramKind::kRuntimeBlender:
@@ -160,11 +161,22 @@ const Module* Compiler::moduleForProgramKind(ProgramKind kind) {
         case ProgramKind::kPrivateRuntimeBlender:
         case ProgramKind::kMeshVertex:
         case ProgramKind::kMeshFragment:
-        case ProgramKind::kGeneric:               return m.loadPublicModule(this);
+        case ProgramKind::kGeneric:               return m.loadPublicModule(compiler);
     }
     SkUNREACHABLE;
 }
 
+const Module* Compiler::moduleForProgramKind(ProgramKind kind) {
+    auto m = ModuleLoader::Get();
+    const Module* module = load_module_for_program_kind(m, this, kind);
+    // Programs resolve most of their identifiers through the symbols of the module they inherit
+    // from. Flatten them, so that each lookup probes one table instead of one per module. This is
+    // only done for modules that programs use directly (modules which are only parents of other
+    // modules don't need it), and it happens while we hold the ModuleLoader lock.
+    module->fSymbols->flatten();
+    return module;
+}
+
 void Compiler::FinalizeSettings(ProgramSettings* settings, ProgramKind kind) {
     // Honor our optimization-override flags.
     switch (sOptimizer) {
@@ -195,6 +207,7 @@ void Compiler::FinalizeSettings(ProgramSettings* settings, ProgramKind kind) {
     settings->fInlineThreshold *= (int)settings->fOptimize;
     settings->fRemoveDeadFunctions &= settings->fOptimize;
     settings->fRemoveDeadVariables &= settings->fOptimize;
+    settings->fOptimizeRasterPipeline &= settings->fOptimize;
 
     if (kind == ProgramKind::kGeneric) {
         // For "generic" interpreter programs, leave all functions intact. (The SkVM API supports
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/sksl/SkSLCompilerPool.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLStringStream.h"
+#include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
+#include "src/sksl/codegen/SkSLRasterPipelineCodeGenerator.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLProgram.h"
+
+#include <utility>
+
+namespace SkSL {
+
+struct CompilerPool::State {
+    State(const ShaderCaps* caps) : fCaps(caps) {}
+
+    struct IdleCompiler {
+        const ShaderCaps* fCaps;
+        std::unique_ptr<Compiler> fCompiler;
+    };
+
+    // Returns an idle Compiler built for `caps`, or a new one if there are none.
+    std::unique_ptr<Compiler> borrow(const ShaderCaps* caps) {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            for (auto iter = fIdle.rbegin(); iter != fIdle.rend(); ++iter) {
+                if (iter->fCaps == caps) {
+                    std::unique_ptr<Compiler> compiler = std::move(iter->fCompiler);
+                    fIdle.erase(std::next(iter).base());
+                    return compiler;
+                }
+            }
+        }
+        // Constructing a Compiler takes the ModuleLoader mutex; don't hold ours while we do it.
+        return std::make_unique<Compiler>(caps);
+    }
+
+    void giveBack(const ShaderCaps* caps, std::unique_ptr<Compiler> compiler) {
+        SkAutoMutexExclusive lock(fMutex);
+        fIdle.push_back({caps, std::move(compiler)});
+    }
+
+    CompileResult compile(const CompileRequest& request);
+
+    const ShaderCaps* const fCaps;
+    SkMutex fMutex;
+    std::vector<IdleCompiler> fIdle SK_GUARDED_BY(fMutex);
+};
+
+static bool generate_code(Compiler& compiler,
+                          Program& program,
+                          CompileTarget target,
+                          std::string* out) {
+    switch (target) {
+#if defined(SKSL_STANDALONE) || defined(SK_GANESH) || defined(SK_GRAPHITE)
+        case CompileTarget::kGLSL:
+            return compiler.toGLSL(program, out);
+
+        case CompileTarget::kSPIRV:
+            return compiler.toSPIRV(program, out);
+
+        case CompileTarget::kMetal:
+            return compiler.toMetal(program, out);
+
+        case CompileTarget::kHLSL:
+            return compiler.toHLSL(program, out);
+
+        case CompileTarget::kWGSL: {
+            StringStream buffer;
+            if (!compiler.toWGSL(program, buffer)) {
+                return false;
+            }
+            *out = buffer.str();
+            return true;
+        }
+#else
+        case CompileTarget::kGLSL:
+        case CompileTarget::kSPIRV:
+        case CompileTarget::kMetal:
+        case CompileTarget::kHLSL:
+        case CompileTarget::kWGSL:
+            compiler.errorReporter().error({}, "GPU code generation is not enabled");
+            return false;
+#endif
+        case CompileTarget::kRasterPipeline: {
+            const FunctionDeclaration* main = program.getFunction("main");
+            if (!main) {
+                compiler.errorReporter().error({}, "code has no entrypoint");
+                return false;
+            }
+            std::unique_ptr<RP::Program> rasterProg =
+                    MakeRasterPipelineProgram(program, *main->definition());
+            if (!rasterProg) {
+                compiler.errorReporter().error({}, "code is not supported");
+                return false;
+            }
+            SkDynamicMemoryWStream stream;
+            rasterProg->dump(&stream);
+            sk_sp<SkData> dump = stream.detachAsData();
+            out->assign(static_cast<const char*>(dump->data()), dump->size());
+            return true;
+        }
+    }
+    SkUNREACHABLE;
+}
+
+CompileResult CompilerPool::State::compile(const CompileRequest& request) {
+    const ShaderCaps* caps = request.fCaps ? request.fCaps : fCaps;
+    std::unique_ptr<Compiler> compiler = this->borrow(caps);
+
+    CompileResult result;
+    {
+        std::unique_ptr<Program> program =
+                compiler->convertProgram(request.fKind, request.fSource, request.fSettings);
+        result.fSuccess = program && generate_code(*compiler, *program, request.fTarget,
+                                                   &result.fOutput);
+    }
+    if (result.fSuccess) {
+        compiler->resetErrors();
+    } else {
+        result.fOutput.clear();
+        result.fErrors = compiler->errorText();
+    }
+
+    this->giveBack(caps, std::move(compiler));
+    return result;
+}
+
+CompilerPool::CompilerPool(const ShaderCaps* caps, SkExecutor* executor)
+        : fState(std::make_shared<State>(caps))
+        , fExecutor(executor ? executor : &SkExecutor::GetDefault()) {
+    SkASSERT(caps);
+}
+
+CompilerPool::~CompilerPool() = default;
+
+std::future<CompileResult> CompilerPool::compile(CompileRequest request) {
+    // SkExecutor takes a std::function, which must be copyable, so the promise is shared.
+    auto promise = std::make_shared<std::promise<CompileResult>>();
+    std::future<CompileResult> future = promise->get_future();
+    fExecutor->add([state = fState, promise, request = std::move(request)] {
+        promise->set_value(state->compile(request));
+    });
+    return future;
+}
+
+std::vector<std::future<CompileResult>> CompilerPool::compile(
+        SkSpan<const CompileRequest> requests) {
+    std::vector<std::future<CompileResult>> futures;
+    futures.reserve(requests.size());
+    for (const CompileRequest& request : requests) {
+        futures.push_back(this->compile(request));
+    }
+    return futures;
+}
+
+CompileResult CompilerPool::compileNow(const CompileRequest& request) {
+    return fState->compile(request);
+}
+
+}  // namespace SkSL
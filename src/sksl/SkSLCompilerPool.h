@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_COMPILERPOOL
+#define SKSL_COMPILERPOOL
+
+#include "include/core/SkSpan.h"
+#include "include/private/SkSLProgramKind.h"
+#include "src/sksl/SkSLProgramSettings.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+class SkExecutor;
+
+namespace SkSL {
+
+struct ShaderCaps;
+
+enum class CompileTarget {
+    kGLSL,
+    kSPIRV,
+    kMetal,
+    kHLSL,
+    kWGSL,
+    kRasterPipeline,  // Produces a text dump of the Raster Pipeline stages
+};
+
+struct CompileRequest {
+    ProgramKind fKind;
+    std::string fSource;
+    CompileTarget fTarget;
+    ProgramSettings fSettings;
+    // If null, the pool's default caps are used.
+    const ShaderCaps* fCaps = nullptr;
+};
+
+struct CompileResult {
+    bool fSuccess = false;
+    std::string fOutput;
+    std::string fErrors;
+};
+
+/**
+ * Compiles batches of SkSL programs concurrently on an SkExecutor. Each task borrows an idle
+ * Compiler from the pool (or creates one), so the number of Compilers grows to the number of
+ * threads the executor actually uses. Every Compiler shares the built-in modules owned by the
+ * ModuleLoader; they are loaded once, by whichever task needs them first.
+ *
+ * Tasks keep the pool's state alive, so the pool may be destroyed while compiles are pending.
+ */
+class CompilerPool {
+public:
+    // If `executor` is null, the default SkExecutor is used.
+    CompilerPool(const ShaderCaps* caps, SkExecutor* executor = nullptr);
+    ~CompilerPool();
+
+    CompilerPool(const CompilerPool&) = delete;
+    CompilerPool& operator=(const CompilerPool&) = delete;
+
+    std::future<CompileResult> compile(CompileRequest request);
+
+    // Returns one future per request, in the same order.
+    std::vector<std::future<CompileResult>> compile(SkSpan<const CompileRequest> requests);
+
+    // Compiles a single request on the calling thread, using a Compiler from the pool.
+    CompileResult compileNow(const CompileRequest& request);
+
+private:
+    struct State;
+
+    std::shared_ptr<State> fState;
+    SkExecutor* fExecutor;
+};
+
+}  // namespace SkSL
+
+#endif
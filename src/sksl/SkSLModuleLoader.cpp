@@ -6,6 +6,7 @@
  */
 #include "src/sksl/SkSLModuleLoader.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkSLIRNode.h"
 #include "include/private/SkSLModifiers.h"
@@ -16,6 +17,7 @@
 #include "src/sksl/SkSLBuiltinTypes.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLModifiersPool.h"
+#include "src/sksl/SkSLUtil.h"
 #include "src/sksl/ir/SkSLSymbolTable.h"
 #include "src/sksl/ir/SkSLType.h"
 #include "src/sksl/ir/SkSLVariable.h"
@@ -168,11 +170,31 @@ struct ModuleLoader::Impl {
     std::unique_ptr<const Module> fRuntimeShaderModule;     // [Public] + Runtime shader decls
 };
 
+static thread_local int sModulesCompiledOnThisThread = 0;
+
 ModuleLoader ModuleLoader::Get() {
     static ModuleLoader::Impl* sModuleLoaderImpl = new ModuleLoader::Impl;
     return ModuleLoader(*sModuleLoaderImpl);
 }
 
+void ModuleLoader::WarmUp(SkExecutor* executor, SkSpan<const ProgramKind> kinds) {
+    if (!executor) {
+        executor = &SkExecutor::GetDefault();
+    }
+    // Modules are loaded one at a time behind the ModuleLoader mutex, so a single task is enough.
+    // The Compiler is created inside the task; its constructor also takes the mutex.
+    executor->add([kinds = std::vector<ProgramKind>(kinds.begin(), kinds.end())] {
+        SkSL::Compiler compiler(ShaderCapsFactory::Standalone());
+        for (ProgramKind kind : kinds) {
+            compiler.moduleForProgramKind(kind);
+        }
+    });
+}
+
+int ModuleLoader::ModulesCompiledOnThisThread() {
+    return sModulesCompiledOnThisThread;
+}
+
 ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {
     fModuleLoader.fMutex.acquire();
 }
@@ -209,6 +231,7 @@ static std::unique_ptr<Module> compile_and_shrink(SkSL::Compiler* compiler,
                                                   std::string moduleSource,
                                                   const Module* parent,
                                                   ModifiersPool& modifiersPool) {
+    ++sModulesCompiledOnThisThread;
     std::unique_ptr<Module> m = compiler->compileModule(kind,
                                                         moduleName,
                                                         std::move(moduleSource),
@@ -8,9 +8,13 @@
 #ifndef SKSL_MODULELOADER
 #define SKSL_MODULELOADER
 
+#include "include/core/SkSpan.h"
+#include "include/private/SkSLProgramKind.h"
 #include "src/sksl/SkSLBuiltinTypes.h"
 #include <memory>
 
+class SkExecutor;
+
 namespace SkSL {
 
 class Compiler;
@@ -33,6 +37,16 @@ public:
     // allowed to fall out of scope, the mutex will be released.
     static ModuleLoader Get();
 
+    // Loads the modules needed to compile each of the given program kinds on `executor`, so that
+    // the first compile of those kinds doesn't pay for module loading. A compile which needs a
+    // module that is still being loaded will wait for it. If `executor` is null, the default
+    // SkExecutor is used.
+    static void WarmUp(SkExecutor* executor, SkSpan<const ProgramKind> kinds);
+
+    // The number of built-in modules which the calling thread has compiled. Tests use this to
+    // check that a compile found every module it needed already loaded.
+    static int ModulesCompiledOnThisThread();
+
     // The built-in types and root module are universal, immutable, and shared by every Compiler.
     // They are created when the ModuleLoader is instantiated and never change.
     const BuiltinTypes& builtinTypes();
@@ -1636,9 +1636,9 @@ DSLExpression Parser::assignmentExpression() {
     }
 }
 
-/* logicalOrExpression ('?' expression ':' assignmentExpression)? */
+/* binaryExpression ('?' expression ':' assignmentExpression)? */
 DSLExpression Parser::ternaryExpression() {
-    DSLExpression base = this->logicalOrExpression();
+    DSLExpression base = this->binaryExpression(OperatorPrecedence::kLogicalOr);
     if (!base.hasValue()) {
         return {};
     }
@@ -1664,251 +1664,67 @@ DSLExpression Parser::ternaryExpression() {
     return Select(std::move(base), std::move(trueExpr), std::move(falseExpr), pos);
 }
 
-/* logicalXorExpression (LOGICALOR logicalXorExpression)* */
-DSLExpression Parser::logicalOrExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->logicalXorExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    while (this->peek().fKind == Token::Kind::TK_LOGICALOR) {
-        if (!operatorRight(depth, Operator::Kind::LOGICALOR, &Parser::logicalXorExpression,
-                result)) {
-            return {};
-        }
-    }
-    return result;
-}
-
-/* logicalAndExpression (LOGICALXOR logicalAndExpression)* */
-DSLExpression Parser::logicalXorExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->logicalAndExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    while (this->peek().fKind == Token::Kind::TK_LOGICALXOR) {
-        if (!operatorRight(depth, Operator::Kind::LOGICALXOR, &Parser::logicalAndExpression,
-                result)) {
-            return {};
-        }
-    }
-    return result;
-}
-
-/* bitwiseOrExpression (LOGICALAND bitwiseOrExpression)* */
-DSLExpression Parser::logicalAndExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->bitwiseOrExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    while (this->peek().fKind == Token::Kind::TK_LOGICALAND) {
-        if (!operatorRight(depth, Operator::Kind::LOGICALAND, &Parser::bitwiseOrExpression,
-                result)) {
-            return {};
-        }
-    }
-    return result;
-}
-
-/* bitwiseXorExpression (BITWISEOR bitwiseXorExpression)* */
-DSLExpression Parser::bitwiseOrExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->bitwiseXorExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    while (this->peek().fKind == Token::Kind::TK_BITWISEOR) {
-        if (!operatorRight(depth, Operator::Kind::BITWISEOR, &Parser::bitwiseXorExpression,
-                result)) {
-            return {};
-        }
-    }
-    return result;
-}
-
-/* bitwiseAndExpression (BITWISEXOR bitwiseAndExpression)* */
-DSLExpression Parser::bitwiseXorExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->bitwiseAndExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    while (this->peek().fKind == Token::Kind::TK_BITWISEXOR) {
-        if (!operatorRight(depth, Operator::Kind::BITWISEXOR, &Parser::bitwiseAndExpression,
-                result)) {
-            return {};
-        }
-    }
-    return result;
-}
-
-/* equalityExpression (BITWISEAND equalityExpression)* */
-DSLExpression Parser::bitwiseAndExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->equalityExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    while (this->peek().fKind == Token::Kind::TK_BITWISEAND) {
-        if (!operatorRight(depth, Operator::Kind::BITWISEAND, &Parser::equalityExpression,
-                result)) {
-            return {};
-        }
-    }
-    return result;
-}
-
-/* relationalExpression ((EQEQ | NEQ) relationalExpression)* */
-DSLExpression Parser::equalityExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->relationalExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    for (;;) {
-        switch (this->peek().fKind) {
-            case Token::Kind::TK_EQEQ:
-                if (!operatorRight(depth, Operator::Kind::EQEQ, &Parser::relationalExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_NEQ:
-                if (!operatorRight(depth, Operator::Kind::NEQ, &Parser::relationalExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            default: return result;
-        }
-    }
-}
-
-/* shiftExpression ((LT | GT | LTEQ | GTEQ) shiftExpression)* */
-DSLExpression Parser::relationalExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->shiftExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    for (;;) {
-        switch (this->peek().fKind) {
-            case Token::Kind::TK_LT:
-                if (!operatorRight(depth, Operator::Kind::LT, &Parser::shiftExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_GT:
-                if (!operatorRight(depth, Operator::Kind::GT, &Parser::shiftExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_LTEQ:
-                if (!operatorRight(depth, Operator::Kind::LTEQ, &Parser::shiftExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_GTEQ:
-                if (!operatorRight(depth, Operator::Kind::GTEQ, &Parser::shiftExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            default:
-                return result;
-        }
-    }
-}
-
-/* additiveExpression ((SHL | SHR) additiveExpression)* */
-DSLExpression Parser::shiftExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->additiveExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    for (;;) {
-        switch (this->peek().fKind) {
-            case Token::Kind::TK_SHL:
-                if (!operatorRight(depth, Operator::Kind::SHL, &Parser::additiveExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_SHR:
-                if (!operatorRight(depth, Operator::Kind::SHR, &Parser::additiveExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            default:
-                return result;
-        }
-    }
-}
-
-/* multiplicativeExpression ((PLUS | MINUS) multiplicativeExpression)* */
-DSLExpression Parser::additiveExpression() {
-    AutoDepth depth(this);
-    DSLExpression result = this->multiplicativeExpression();
-    if (!result.hasValue()) {
-        return {};
-    }
-    for (;;) {
-        switch (this->peek().fKind) {
-            case Token::Kind::TK_PLUS:
-                if (!operatorRight(depth, Operator::Kind::PLUS,
-                        &Parser::multiplicativeExpression, result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_MINUS:
-                if (!operatorRight(depth, Operator::Kind::MINUS,
-                        &Parser::multiplicativeExpression, result)) {
-                    return {};
-                }
-                break;
-            default:
-                return result;
-        }
-    }
-}
-
-/* unaryExpression ((STAR | SLASH | PERCENT) unaryExpression)* */
-DSLExpression Parser::multiplicativeExpression() {
-    AutoDepth depth(this);
+static bool binary_operator(Token::Kind kind, Operator::Kind* op) {
+    switch (kind) {
+        case Token::Kind::TK_LOGICALOR:  *op = Operator::Kind::LOGICALOR;  return true;
+        case Token::Kind::TK_LOGICALXOR: *op = Operator::Kind::LOGICALXOR; return true;
+        case Token::Kind::TK_LOGICALAND: *op = Operator::Kind::LOGICALAND; return true;
+        case Token::Kind::TK_BITWISEOR:  *op = Operator::Kind::BITWISEOR;  return true;
+        case Token::Kind::TK_BITWISEXOR: *op = Operator::Kind::BITWISEXOR; return true;
+        case Token::Kind::TK_BITWISEAND: *op = Operator::Kind::BITWISEAND; return true;
+        case Token::Kind::TK_EQEQ:       *op = Operator::Kind::EQEQ;       return true;
+        case Token::Kind::TK_NEQ:        *op = Operator::Kind::NEQ;        return true;
+        case Token::Kind::TK_LT:         *op = Operator::Kind::LT;         return true;
+        case Token::Kind::TK_GT:         *op = Operator::Kind::GT;         return true;
+        case Token::Kind::TK_LTEQ:       *op = Operator::Kind::LTEQ;       return true;
+        case Token::Kind::TK_GTEQ:       *op = Operator::Kind::GTEQ;       return true;
+        case Token::Kind::TK_SHL:        *op = Operator::Kind::SHL;        return true;
+        case Token::Kind::TK_SHR:        *op = Operator::Kind::SHR;        return true;
+        case Token::Kind::TK_PLUS:       *op = Operator::Kind::PLUS;       return true;
+        case Token::Kind::TK_MINUS:      *op = Operator::Kind::MINUS;      return true;
+        case Token::Kind::TK_STAR:       *op = Operator::Kind::STAR;       return true;
+        case Token::Kind::TK_SLASH:      *op = Operator::Kind::SLASH;      return true;
+        case Token::Kind::TK_PERCENT:    *op = Operator::Kind::PERCENT;    return true;
+        default:                                                           return false;
+    }
+}
+
+/* unaryExpression (binaryOperator unaryExpression)*, for binary operators from multiplicative
+   through logical-or precedence */
+DSLExpression Parser::binaryExpression(OperatorPrecedence loosest) {
     DSLExpression result = this->unaryExpression();
     if (!result.hasValue()) {
         return {};
     }
-    for (;;) {
-        switch (this->peek().fKind) {
-            case Token::Kind::TK_STAR:
-                if (!operatorRight(depth, Operator::Kind::STAR, &Parser::unaryExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_SLASH:
-                if (!operatorRight(depth, Operator::Kind::SLASH, &Parser::unaryExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            case Token::Kind::TK_PERCENT:
-                if (!operatorRight(depth, Operator::Kind::PERCENT, &Parser::unaryExpression,
-                        result)) {
-                    return {};
-                }
-                break;
-            default: return result;
+    // This is precedence climbing: rather than descending through one function per precedence
+    // level for every operand, we jump straight to the level of the next operator. The right side
+    // of an operator only consumes operators which bind more tightly, so once a level is done,
+    // the next operator (if any) is always looser. Each level gets its own depth counter, exactly
+    // as it would in a recursive-descent parser.
+    Operator::Kind op;
+    while (binary_operator(this->peek().fKind, &op)) {
+        OperatorPrecedence precedence = Operator(op).getBinaryPrecedence();
+        if (precedence > loosest) {
+            break;
         }
+        AutoDepth depth(this);
+        do {
+            this->nextToken();
+            if (!depth.increase()) {
+                return {};
+            }
+            DSLExpression right = this->binaryExpression(
+                    static_cast<OperatorPrecedence>((int)precedence - 1));
+            if (!right.hasValue()) {
+                return {};
+            }
+            Position pos = result.position().rangeThrough(right.position());
+            DSLExpression next = result.binary(op, std::move(right), pos);
+            result.swap(next);
+        } while (binary_operator(this->peek().fKind, &op) &&
+                 Operator(op).getBinaryPrecedence() == precedence);
     }
+    return result;
 }
 
 /* postfixExpression | (PLUS | MINUS | NOT | PLUSPLUS | MINUSMINUS) unaryExpression */
@@ -237,27 +237,7 @@ private:
 
     dsl::DSLExpression ternaryExpression();
 
-    dsl::DSLExpression logicalOrExpression();
-
-    dsl::DSLExpression logicalXorExpression();
-
-    dsl::DSLExpression logicalAndExpression();
-
-    dsl::DSLExpression bitwiseOrExpression();
-
-    dsl::DSLExpression bitwiseXorExpression();
-
-    dsl::DSLExpression bitwiseAndExpression();
-
-    dsl::DSLExpression equalityExpression();
-
-    dsl::DSLExpression relationalExpression();
-
-    dsl::DSLExpression shiftExpression();
-
-    dsl::DSLExpression additiveExpression();
-
-    dsl::DSLExpression multiplicativeExpression();
+    dsl::DSLExpression binaryExpression(OperatorPrecedence loosest);
 
     dsl::DSLExpression unaryExpression();
 
@@ -49,6 +49,9 @@ struct ProgramSettings {
     bool fRemoveDeadFunctions = true;
     // (Requires fOptimize = true) Removes variables which are never used.
     bool fRemoveDeadVariables = true;
+    // (Requires fOptimize = true) Runs the Raster Pipeline builder's optimizer, which removes dead
+    // stores and reuses value slots, over the instructions generated for the program.
+    bool fOptimizeRasterPipeline = true;
     // (Requires fOptimize = true) When greater than zero, enables the inliner. The threshold value
     // sets an upper limit on the acceptable amount of code growth from inlining.
     int fInlineThreshold = SkSL::kDefaultInlineThreshold;
@@ -24,6 +24,7 @@
 #endif
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstring>
 #include <iterator>
@@ -89,6 +90,22 @@ namespace RP {
     case BuilderOp::cmpne_n_floats:     \
     case BuilderOp::cmpne_n_ints
 
+#define ALL_IMMEDIATE_BINARY_OP_CASES  \
+         BuilderOp::add_imm_float:     \
+    case BuilderOp::add_imm_int:       \
+    case BuilderOp::mul_imm_float:     \
+    case BuilderOp::mul_imm_int:       \
+    case BuilderOp::min_imm_float:     \
+    case BuilderOp::max_imm_float:     \
+    case BuilderOp::cmplt_imm_float:   \
+    case BuilderOp::cmplt_imm_int:     \
+    case BuilderOp::cmple_imm_float:   \
+    case BuilderOp::cmple_imm_int:     \
+    case BuilderOp::cmpeq_imm_float:   \
+    case BuilderOp::cmpeq_imm_int:     \
+    case BuilderOp::cmpne_imm_float:   \
+    case BuilderOp::cmpne_imm_int
+
 #define ALL_MULTI_SLOT_TERNARY_OP_CASES \
          BuilderOp::mix_n_floats:       \
     case BuilderOp::mix_n_ints
@@ -741,20 +758,6 @@ void Builder::matrix_resize(int origColumns, int origRows, int newColumns, int n
     this->swizzle(consumedSlots, SkSpan(elements, index));
 }
 
-std::unique_ptr<Program> Builder::finish(int numValueSlots,
-                                         int numUniformSlots,
-                                         SkRPDebugTrace* debugTrace) {
-    // Verify that calls to enableExecutionMaskWrites and disableExecutionMaskWrites are balanced.
-    SkASSERT(fExecutionMaskWritesEnabled == 0);
-
-    return std::make_unique<Program>(std::move(fInstructions), numValueSlots, numUniformSlots,
-                                     fNumLabels, debugTrace);
-}
-
-void Program::optimize() {
-    // TODO(johnstiles): perform any last-minute cleanup of the instruction stream here
-}
-
 static int stack_usage(const Instruction& inst) {
     switch (inst.fOp) {
         case BuilderOp::push_literal:
@@ -846,17 +849,812 @@ Program::StackDepthMap Program::tempStackMaxDepths() const {
     return largest;
 }
 
+std::unique_ptr<Program> Builder::finish(int numValueSlots,
+                                         int numUniformSlots,
+                                         SkRPDebugTrace* debugTrace,
+                                         bool optimize) {
+    // Verify that calls to enableExecutionMaskWrites and disableExecutionMaskWrites are balanced.
+    SkASSERT(fExecutionMaskWritesEnabled == 0);
+
+    return std::make_unique<Program>(std::move(fInstructions), numValueSlots, numUniformSlots,
+                                     fNumLabels, debugTrace, optimize);
+}
+
+// The value slots read and written by a single instruction. A complete write replaces every lane
+// of `write`; a partial (masked) write leaves inactive lanes alone, so its range is also reported
+// as a read.
+struct SlotUsage {
+    SlotRange reads[2];
+    int numReads = 0;
+    SlotRange write;
+    bool completeWrite = false;
+
+    void read(Slot index, int count) {
+        SkASSERT(numReads < (int)std::size(reads));
+        reads[numReads++] = {index, count};
+    }
+};
+
+// Fills in `usage` for the given instruction. Returns false if the instruction refers to value
+// slots in a way that the optimizer doesn't understand.
+static bool get_slot_usage(const Instruction& inst, SlotUsage* usage) {
+    *usage = {};
+    switch (inst.fOp) {
+        case BuilderOp::store_src_rg:
+            usage->write = {inst.fSlotA, 2};
+            usage->completeWrite = true;
+            return true;
+
+        case BuilderOp::store_src:
+        case BuilderOp::store_dst:
+        case BuilderOp::store_device_xy01:
+            usage->write = {inst.fSlotA, 4};
+            usage->completeWrite = true;
+            return true;
+
+        case BuilderOp::load_src:
+        case BuilderOp::load_dst:
+            usage->read(inst.fSlotA, 4);
+            return true;
+
+        case BuilderOp::reenable_loop_mask:
+            usage->read(inst.fSlotA, 1);
+            return true;
+
+        case BuilderOp::push_slots:
+            usage->read(inst.fSlotA, inst.fImmA);
+            return true;
+
+        case BuilderOp::copy_slot_unmasked:
+            usage->read(inst.fSlotB, inst.fImmA);
+            usage->write = {inst.fSlotA, inst.fImmA};
+            usage->completeWrite = true;
+            return true;
+
+        case BuilderOp::copy_slot_masked:
+            usage->read(inst.fSlotB, inst.fImmA);
+            usage->read(inst.fSlotA, inst.fImmA);
+            usage->write = {inst.fSlotA, inst.fImmA};
+            return true;
+
+        case BuilderOp::zero_slot_unmasked:
+        case BuilderOp::copy_stack_to_slots_unmasked:
+            usage->write = {inst.fSlotA, inst.fImmA};
+            usage->completeWrite = true;
+            return true;
+
+        case BuilderOp::copy_constant:
+            usage->write = {inst.fSlotA, 1};
+            usage->completeWrite = true;
+            return true;
+
+        case BuilderOp::copy_stack_to_slots:
+            usage->read(inst.fSlotA, inst.fImmA);
+            usage->write = {inst.fSlotA, inst.fImmA};
+            return true;
+
+        case BuilderOp::swizzle_copy_stack_to_slots: {
+            // The swizzle components are packed into immC, one nybble per component.
+            int highestComponent = 0;
+            for (int index = 0; index < inst.fImmA; ++index) {
+                highestComponent = std::max(highestComponent, (inst.fImmC >> (4 * index)) & 0xF);
+            }
+            usage->read(inst.fSlotA, highestComponent + 1);
+            usage->write = {inst.fSlotA, highestComponent + 1};
+            return true;
+        }
+        default:
+            // Any other op which refers to a value slot is unexpected.
+            return inst.fSlotA == NA && inst.fSlotB == NA && inst.fSlotC == NA;
+
+        case BuilderOp::push_uniform:
+            // The slot here is a uniform index, not a value slot.
+            return true;
+    }
+}
+
+// Returns true if the instruction's only side effect is writing its value slots.
+static bool is_removable_store(BuilderOp op) {
+    switch (op) {
+        case BuilderOp::store_src_rg:
+        case BuilderOp::store_src:
+        case BuilderOp::store_dst:
+        case BuilderOp::store_device_xy01:
+        case BuilderOp::copy_slot_unmasked:
+        case BuilderOp::copy_slot_masked:
+        case BuilderOp::zero_slot_unmasked:
+        case BuilderOp::copy_constant:
+        case BuilderOp::copy_stack_to_slots:
+        case BuilderOp::copy_stack_to_slots_unmasked:
+        case BuilderOp::swizzle_copy_stack_to_slots:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool is_branch(BuilderOp op) {
+    switch (op) {
+        case BuilderOp::jump:
+        case BuilderOp::branch_if_any_active_lanes:
+        case BuilderOp::branch_if_no_active_lanes:
+        case BuilderOp::branch_if_no_active_lanes_on_stack_top_equal:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+using SlotSet = std::vector<bool>;
+
+// Given the value slots which are live after `inst`, updates `live` to hold the slots which are
+// live before it. `labelLive` holds the slots which are live at each label.
+static void transfer_liveness(const Instruction& inst,
+                              const SlotUsage& usage,
+                              const std::vector<SlotSet>& labelLive,
+                              SlotSet* live) {
+    if (inst.fOp == BuilderOp::jump) {
+        *live = labelLive[inst.fImmA];
+        return;
+    }
+    if (is_branch(inst.fOp)) {
+        const SlotSet& target = labelLive[inst.fImmA];
+        for (size_t index = 0; index < live->size(); ++index) {
+            if (target[index]) {
+                (*live)[index] = true;
+            }
+        }
+        return;
+    }
+    if (usage.completeWrite) {
+        for (int index = 0; index < usage.write.count; ++index) {
+            (*live)[usage.write.index + index] = false;
+        }
+    }
+    for (int r = 0; r < usage.numReads; ++r) {
+        for (int index = 0; index < usage.reads[r].count; ++index) {
+            (*live)[usage.reads[r].index + index] = true;
+        }
+    }
+}
+
+// Computes the value slots which are live at each label. The program is walked backwards until
+// the label sets stop changing; every branch target is reached this way, including loops.
+static std::vector<SlotSet> compute_label_liveness(SkSpan<const Instruction> instructions,
+                                                   SkSpan<const SlotUsage> usages,
+                                                   int numValueSlots,
+                                                   int numLabels) {
+    std::vector<SlotSet> labelLive(numLabels, SlotSet(numValueSlots, false));
+    bool changed;
+    do {
+        changed = false;
+        SlotSet live(numValueSlots, false);
+        for (int index = SkToInt(instructions.size()) - 1; index >= 0; --index) {
+            const Instruction& inst = instructions[index];
+            if (inst.fOp == BuilderOp::label) {
+                if (labelLive[inst.fImmA] != live) {
+                    labelLive[inst.fImmA] = live;
+                    changed = true;
+                }
+                continue;
+            }
+            transfer_liveness(inst, usages[index], labelLive, &live);
+        }
+    } while (changed);
+
+    return labelLive;
+}
+
+// Returns true if the instruction only consumes and produces values on the current stack, without
+// any other side effect. The number of stack slots consumed and produced are returned.
+static bool is_pure_stack_op(const Instruction& inst, int* consumed, int* produced) {
+    switch (inst.fOp) {
+        case BuilderOp::push_literal:
+        case BuilderOp::push_condition_mask:
+        case BuilderOp::push_loop_mask:
+        case BuilderOp::push_return_mask:
+            *consumed = 0;
+            *produced = 1;
+            return true;
+
+        case BuilderOp::push_src_rgba:
+        case BuilderOp::push_dst_rgba:
+            *consumed = 0;
+            *produced = 4;
+            return true;
+
+        case BuilderOp::push_slots:
+        case BuilderOp::push_uniform:
+        case BuilderOp::push_zeros:
+        case BuilderOp::push_clone:
+        case BuilderOp::push_clone_from_stack:
+            *consumed = 0;
+            *produced = inst.fImmA;
+            return true;
+
+        case ALL_SINGLE_SLOT_UNARY_OP_CASES:
+        case ALL_MULTI_SLOT_UNARY_OP_CASES:
+            *consumed = *produced = inst.fImmA;
+            return true;
+
+        case ALL_N_WAY_BINARY_OP_CASES:
+        case ALL_MULTI_SLOT_BINARY_OP_CASES:
+        case BuilderOp::select:
+            *consumed = 2 * inst.fImmA;
+            *produced = inst.fImmA;
+            return true;
+
+        case ALL_MULTI_SLOT_TERNARY_OP_CASES:
+            *consumed = 3 * inst.fImmA;
+            *produced = inst.fImmA;
+            return true;
+
+        case ALL_IMMEDIATE_BINARY_OP_CASES:
+            *consumed = *produced = 1;
+            return true;
+
+        case BuilderOp::swizzle_1:
+        case BuilderOp::swizzle_2:
+        case BuilderOp::swizzle_3:
+        case BuilderOp::swizzle_4:
+            *consumed = inst.fImmA;
+            *produced = (int)inst.fOp - (int)BuilderOp::swizzle_1 + 1;
+            return true;
+
+        case BuilderOp::shuffle:
+            *consumed = inst.fImmA >> 16;
+            *produced = inst.fImmA & 0xFFFF;
+            return true;
+
+        case BuilderOp::dot_2_floats:
+        case BuilderOp::dot_3_floats:
+        case BuilderOp::dot_4_floats:
+            *consumed = 2 * ((int)inst.fOp - (int)BuilderOp::dot_2_floats + 2);
+            *produced = 1;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static void remove_instructions(SkTArray<Instruction>* instructions, const SlotSet& removed) {
+    int dst = 0;
+    for (int src = 0; src < instructions->size(); ++src) {
+        if (!removed[src]) {
+            (*instructions)[dst++] = (*instructions)[src];
+        }
+    }
+    instructions->pop_back_n(instructions->size() - dst);
+}
+
+static bool slot_usage_is_known(SkSpan<const Instruction> instructions) {
+    SlotUsage usage;
+    return std::all_of(instructions.begin(), instructions.end(), [&](const Instruction& inst) {
+        return get_slot_usage(inst, &usage);
+    });
+}
+
+void Program::optimize() {
+    // Immediates are folded first; the remaining passes can't create new opportunities for them.
+    this->foldImmediates();
+
+    if (!slot_usage_is_known(fInstructions)) {
+        // We can't reason about the program's slots, so only the stack can be cleaned up.
+        this->simplifyStackOps();
+        return;
+    }
+
+    // Forwarding copies can leave stores dead, and removing dead stores can leave pushes unused,
+    // so these passes run until the program stops changing.
+    for (;;) {
+        bool changed = this->propagateCopies();
+        changed |= this->eliminateDeadStores();
+        changed |= this->simplifyStackOps();
+        if (!changed) {
+            break;
+        }
+    }
+
+    // Renumbering slots would invalidate the debug trace's slot info.
+    if (!fDebugTrace) {
+        this->reuseSlots();
+    }
+}
+
+void Program::foldImmediates() {
+    // Returns the immediate op equivalent to `op`, or `unsupported` if there isn't one. For ops
+    // without an immediate form, `value` is adjusted to match (`x - c` becomes `x + -c`).
+    auto ImmediateOp = [](BuilderOp op, int32_t* value) -> BuilderOp {
+        switch (op) {
+            case BuilderOp::add_n_floats:   return BuilderOp::add_imm_float;
+            case BuilderOp::add_n_ints:     return BuilderOp::add_imm_int;
+            case BuilderOp::mul_n_floats:   return BuilderOp::mul_imm_float;
+            case BuilderOp::mul_n_ints:     return BuilderOp::mul_imm_int;
+            case BuilderOp::min_n_floats:   return BuilderOp::min_imm_float;
+            case BuilderOp::max_n_floats:   return BuilderOp::max_imm_float;
+            case BuilderOp::cmplt_n_floats: return BuilderOp::cmplt_imm_float;
+            case BuilderOp::cmplt_n_ints:   return BuilderOp::cmplt_imm_int;
+            case BuilderOp::cmple_n_floats: return BuilderOp::cmple_imm_float;
+            case BuilderOp::cmple_n_ints:   return BuilderOp::cmple_imm_int;
+            case BuilderOp::cmpeq_n_floats: return BuilderOp::cmpeq_imm_float;
+            case BuilderOp::cmpeq_n_ints:   return BuilderOp::cmpeq_imm_int;
+            case BuilderOp::cmpne_n_floats: return BuilderOp::cmpne_imm_float;
+            case BuilderOp::cmpne_n_ints:   return BuilderOp::cmpne_imm_int;
+
+            case BuilderOp::sub_n_floats:
+                *value = sk_bit_cast<int32_t>(-sk_bit_cast<float>(*value));
+                return BuilderOp::add_imm_float;
+
+            case BuilderOp::sub_n_ints:
+                *value = (int32_t)(0u - (uint32_t)*value);
+                return BuilderOp::add_imm_int;
+
+            default:
+                return BuilderOp::unsupported;
+        }
+    };
+
+    // These ops give the same result with their operands exchanged, so `c op x` can be folded too.
+    auto IsCommutative = [](BuilderOp op) {
+        switch (op) {
+            case BuilderOp::add_n_floats:   case BuilderOp::add_n_ints:
+            case BuilderOp::mul_n_floats:   case BuilderOp::mul_n_ints:
+            case BuilderOp::cmpeq_n_floats: case BuilderOp::cmpeq_n_ints:
+            case BuilderOp::cmpne_n_floats: case BuilderOp::cmpne_n_ints:
+                return true;
+
+            default:
+                return false;
+        }
+    };
+
+    auto GetLiteral = [](const Instruction& inst, int32_t* value) {
+        if (inst.fOp == BuilderOp::push_literal) {
+            *value = inst.fImmA;
+            return true;
+        }
+        if (inst.fOp == BuilderOp::push_zeros && inst.fImmA == 1) {
+            *value = 0;
+            return true;
+        }
+        return false;
+    };
+
+    SkTArray<Instruction> folded;
+    folded.reserve_back(fInstructions.size());
+    for (const Instruction& inst : fInstructions) {
+        folded.push_back(inst);
+        if (inst.fImmA != 1 || folded.size() < 2) {
+            continue;
+        }
+        // Look for `push_literal c; op(1)`, which becomes `op_imm c`...
+        int32_t value;
+        if (GetLiteral(folded.fromBack(1), &value)) {
+            BuilderOp immOp = ImmediateOp(inst.fOp, &value);
+            if (immOp != BuilderOp::unsupported) {
+                folded.pop_back();
+                folded.back() = {immOp, {}, value};
+            }
+            continue;
+        }
+        // ... and for `push_literal c; push_slots x(1); op(1)`, which becomes
+        // `push_slots x; op_imm c` when the op is commutative.
+        if (folded.size() >= 3 && IsCommutative(inst.fOp) &&
+            GetLiteral(folded.fromBack(2), &value)) {
+            const Instruction& push = folded.fromBack(1);
+            if ((push.fOp == BuilderOp::push_slots || push.fOp == BuilderOp::push_uniform) &&
+                push.fImmA == 1) {
+                BuilderOp immOp = ImmediateOp(inst.fOp, &value);
+                folded.fromBack(2) = push;
+                folded.fromBack(1) = {immOp, {}, value};
+                folded.pop_back();
+            }
+        }
+    }
+    fInstructions = std::move(folded);
+}
+
+bool Program::propagateCopies() {
+    if (fNumValueSlots == 0) {
+        return false;
+    }
+
+    // copyOf[s] names a slot which is known to hold the same value as slot `s` in every lane, or
+    // NA. The mapped slots are also kept in a list, so they can be found quickly.
+    std::vector<Slot> copyOf(fNumValueSlots, NA);
+    std::vector<Slot> mapped;
+
+    auto Forget = [&](SlotRange range) {
+        auto overlaps = [&](Slot slot) {
+            return slot >= range.index && slot < range.index + range.count;
+        };
+        mapped.erase(std::remove_if(mapped.begin(), mapped.end(), [&](Slot slot) {
+            if (overlaps(slot) || overlaps(copyOf[slot])) {
+                copyOf[slot] = NA;
+                return true;
+            }
+            return false;
+        }), mapped.end());
+    };
+    auto ForgetAll = [&] {
+        for (Slot slot : mapped) {
+            copyOf[slot] = NA;
+        }
+        mapped.clear();
+    };
+    // Redirects a read of `count` slots to the original copy, if every slot in the range maps to
+    // a matching contiguous range.
+    auto Forward = [&](Slot* index, int count) {
+        Slot first = copyOf[*index];
+        if (first == NA) {
+            return false;
+        }
+        for (int offset = 1; offset < count; ++offset) {
+            if (copyOf[*index + offset] != first + offset) {
+                return false;
+            }
+        }
+        *index = first;
+        return true;
+    };
+
+    bool changed = false;
+    SlotSet removed(fInstructions.size(), false);
+    for (int index = 0; index < fInstructions.size(); ++index) {
+        Instruction& inst = fInstructions[index];
+        if (inst.fOp == BuilderOp::label) {
+            // Values can arrive here from any branch; we don't track what they hold.
+            ForgetAll();
+            continue;
+        }
+
+        switch (inst.fOp) {
+            case BuilderOp::push_slots:
+                changed |= Forward(&inst.fSlotA, inst.fImmA);
+                break;
+
+            case BuilderOp::load_src:
+            case BuilderOp::load_dst:
+                changed |= Forward(&inst.fSlotA, 4);
+                break;
+
+            case BuilderOp::reenable_loop_mask:
+                changed |= Forward(&inst.fSlotA, 1);
+                break;
+
+            case BuilderOp::copy_slot_unmasked:
+            case BuilderOp::copy_slot_masked: {
+                Slot original = inst.fSlotB;
+                if (Forward(&inst.fSlotB, inst.fImmA)) {
+                    if (inst.fSlotA == inst.fSlotB) {
+                        // The destination already holds this value.
+                        removed[index] = true;
+                        changed = true;
+                        continue;
+                    }
+                    if (slot_ranges_overlap({inst.fSlotA, inst.fImmA},
+                                            {inst.fSlotB, inst.fImmA})) {
+                        inst.fSlotB = original;
+                    } else {
+                        changed = true;
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        SlotUsage usage;
+        SkAssertResult(get_slot_usage(inst, &usage));
+        if (usage.write.count > 0) {
+            Forget(usage.write);
+        }
+        if (inst.fOp == BuilderOp::copy_slot_unmasked &&
+            !slot_ranges_overlap({inst.fSlotA, inst.fImmA}, {inst.fSlotB, inst.fImmA})) {
+            for (int offset = 0; offset < inst.fImmA; ++offset) {
+                copyOf[inst.fSlotA + offset] = inst.fSlotB + offset;
+                mapped.push_back(inst.fSlotA + offset);
+            }
+        }
+    }
+
+    remove_instructions(&fInstructions, removed);
+    return changed;
+}
+
+bool Program::eliminateDeadStores() {
+    if (fNumValueSlots == 0) {
+        return false;
+    }
+
+    std::vector<SlotUsage> usages(fInstructions.size());
+    for (int index = 0; index < fInstructions.size(); ++index) {
+        SkAssertResult(get_slot_usage(fInstructions[index], &usages[index]));
+    }
+    std::vector<SlotSet> labelLive = compute_label_liveness(fInstructions, usages,
+                                                            fNumValueSlots, fNumLabels);
+
+    // Walk the program backwards once more, removing stores which nothing reads. No value slot is
+    // live once the program ends.
+    bool changed = false;
+    SlotSet removed(fInstructions.size(), false);
+    SlotSet live(fNumValueSlots, false);
+    for (int index = fInstructions.size() - 1; index >= 0; --index) {
+        Instruction& inst = fInstructions[index];
+        SlotUsage& usage = usages[index];
+        if (usage.write.count > 0 && is_removable_store(inst.fOp)) {
+            int first = usage.write.index;
+            int last = first + usage.write.count - 1;
+            int deadBefore = 0, deadAfter = 0;
+            while (first + deadBefore <= last && !live[first + deadBefore]) {
+                ++deadBefore;
+            }
+            if (deadBefore == usage.write.count) {
+                removed[index] = true;
+                changed = true;
+                continue;
+            }
+            while (!live[last - deadAfter]) {
+                ++deadAfter;
+            }
+            // Multi-slot copies can be trimmed down to the live part of their range.
+            if (deadBefore || deadAfter) {
+                switch (inst.fOp) {
+                    case BuilderOp::copy_slot_unmasked:
+                    case BuilderOp::copy_slot_masked:
+                        inst.fSlotB += deadBefore;
+                        [[fallthrough]];
+
+                    case BuilderOp::zero_slot_unmasked:
+                        inst.fSlotA += deadBefore;
+                        inst.fImmA -= deadBefore + deadAfter;
+                        changed = true;
+                        SkAssertResult(get_slot_usage(inst, &usage));
+                        break;
+
+                    case BuilderOp::copy_stack_to_slots:
+                    case BuilderOp::copy_stack_to_slots_unmasked:
+                        inst.fSlotA += deadBefore;
+                        inst.fImmA -= deadBefore + deadAfter;
+                        inst.fImmB -= deadBefore;
+                        changed = true;
+                        SkAssertResult(get_slot_usage(inst, &usage));
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+        if (inst.fOp == BuilderOp::label) {
+            continue;
+        }
+        transfer_liveness(inst, usage, labelLive, &live);
+    }
+
+    remove_instructions(&fInstructions, removed);
+    return changed;
+}
+
+bool Program::simplifyStackOps() {
+    bool changed = false;
+    SkTArray<Instruction> simplified;
+    simplified.reserve_back(fInstructions.size());
+    for (const Instruction& inst : fInstructions) {
+        if (!simplified.empty()) {
+            Instruction& lastInstruction = simplified.back();
+
+            // Combine pushes of adjacent slot ranges into a single push.
+            if (inst.fOp == BuilderOp::push_slots &&
+                lastInstruction.fOp == BuilderOp::push_slots &&
+                lastInstruction.fSlotA + lastInstruction.fImmA == inst.fSlotA) {
+                lastInstruction.fImmA += inst.fImmA;
+                changed = true;
+                continue;
+            }
+        }
+
+        if (inst.fOp != BuilderOp::discard_stack) {
+            simplified.push_back(inst);
+            continue;
+        }
+
+        // A value which is computed and then discarded without being used doesn't need to be
+        // computed at all. Discard the op's inputs instead of its results.
+        int count = inst.fImmA;
+        while (count > 0 && !simplified.empty()) {
+            Instruction& lastInstruction = simplified.back();
+            if (lastInstruction.fOp == BuilderOp::discard_stack) {
+                count += lastInstruction.fImmA;
+                simplified.pop_back();
+                changed = true;
+                continue;
+            }
+            int consumed, produced;
+            if (!is_pure_stack_op(lastInstruction, &consumed, &produced) || produced > count) {
+                break;
+            }
+            count += consumed - produced;
+            simplified.pop_back();
+            changed = true;
+        }
+        if (count > 0) {
+            simplified.push_back({BuilderOp::discard_stack, {}, count});
+        }
+    }
+
+    fInstructions = std::move(simplified);
+    return changed;
+}
+
+void Program::reuseSlots() {
+    if (fNumValueSlots == 0) {
+        return;
+    }
+
+    std::vector<SlotUsage> usages(fInstructions.size());
+    for (int index = 0; index < fInstructions.size(); ++index) {
+        SkAssertResult(get_slot_usage(fInstructions[index], &usages[index]));
+    }
+
+    // Slots which are ever accessed as part of the same range must stay contiguous, so they are
+    // grouped into blocks. Slots which are never accessed don't belong to any block.
+    std::vector<int> rangeEnd(fNumValueSlots, -1);
+    auto AddRange = [&](SlotRange range) {
+        if (range.count > 0) {
+            rangeEnd[range.index] = std::max(rangeEnd[range.index], range.index + range.count);
+        }
+    };
+    for (const SlotUsage& usage : usages) {
+        for (int r = 0; r < usage.numReads; ++r) {
+            AddRange(usage.reads[r]);
+        }
+        AddRange(usage.write);
+    }
+
+    struct Block {
+        Slot first;
+        int count;
+        int start = INT_MAX;  // the first instruction where the block is in use
+        int end = -1;         // the last instruction where the block is in use
+        Slot newIndex = NA;
+    };
+    std::vector<Block> blocks;
+    std::vector<int> blockOf(fNumValueSlots, -1);
+    int blockEnd = 0;
+    for (Slot slot = 0; slot < fNumValueSlots; ++slot) {
+        if (slot >= blockEnd) {
+            if (rangeEnd[slot] < 0) {
+                continue;
+            }
+            blocks.push_back({slot, 0});
+        }
+        blockEnd = std::max(blockEnd, rangeEnd[slot]);
+        blocks.back().count = blockEnd - blocks.back().first;
+        blockOf[slot] = blocks.size() - 1;
+    }
+
+    // Find the span of instructions over which each block is live or accessed.
+    std::vector<SlotSet> labelLive = compute_label_liveness(fInstructions, usages,
+                                                            fNumValueSlots, fNumLabels);
+    auto Touch = [&](Slot slot, int index) {
+        Block& block = blocks[blockOf[slot]];
+        block.start = std::min(block.start, index);
+        block.end = std::max(block.end, index);
+    };
+    SlotSet live(fNumValueSlots, false);
+    for (int index = fInstructions.size() - 1; index >= 0; --index) {
+        const Instruction& inst = fInstructions[index];
+        const SlotUsage& usage = usages[index];
+        for (Slot slot = 0; slot < fNumValueSlots; ++slot) {
+            if (live[slot]) {
+                Touch(slot, index);
+            }
+        }
+        for (int r = 0; r < usage.numReads; ++r) {
+            for (int offset = 0; offset < usage.reads[r].count; ++offset) {
+                Touch(usage.reads[r].index + offset, index);
+            }
+        }
+        for (int offset = 0; offset < usage.write.count; ++offset) {
+            Touch(usage.write.index + offset, index);
+        }
+        if (inst.fOp != BuilderOp::label) {
+            transfer_liveness(inst, usage, labelLive, &live);
+        }
+    }
+
+    // Assign new positions in order of first use. A block can take over the space of any block
+    // whose last use came strictly before its first use.
+    std::vector<Block*> order;
+    order.reserve(blocks.size());
+    for (Block& block : blocks) {
+        order.push_back(&block);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Block* a, const Block* b) {
+        return a->start < b->start;
+    });
+
+    std::vector<Block*> active;
+    std::vector<SlotRange> freeRanges;
+    int numSlots = 0;
+    for (Block* block : order) {
+        active.erase(std::remove_if(active.begin(), active.end(), [&](Block* other) {
+            if (other->end < block->start) {
+                freeRanges.push_back({other->newIndex, other->count});
+                return true;
+            }
+            return false;
+        }), active.end());
+
+        // Merge neighboring free ranges, then take the smallest one which fits.
+        std::sort(freeRanges.begin(), freeRanges.end(), [](SlotRange a, SlotRange b) {
+            return a.index < b.index;
+        });
+        int merged = 0;
+        for (const SlotRange& range : freeRanges) {
+            if (merged > 0 &&
+                freeRanges[merged - 1].index + freeRanges[merged - 1].count == range.index) {
+                freeRanges[merged - 1].count += range.count;
+            } else {
+                freeRanges[merged++] = range;
+            }
+        }
+        freeRanges.resize(merged);
+
+        SlotRange* best = nullptr;
+        for (SlotRange& range : freeRanges) {
+            if (range.count >= block->count && (!best || range.count < best->count)) {
+                best = &range;
+            }
+        }
+        if (best) {
+            block->newIndex = best->index;
+            best->index += block->count;
+            best->count -= block->count;
+        } else {
+            block->newIndex = numSlots;
+            numSlots += block->count;
+        }
+        active.push_back(block);
+    }
+
+    auto Remap = [&](Slot slot) {
+        const Block& block = blocks[blockOf[slot]];
+        return block.newIndex + (slot - block.first);
+    };
+    for (Instruction& inst : fInstructions) {
+        if (inst.fOp == BuilderOp::push_uniform) {
+            continue;
+        }
+        if (inst.fSlotA != NA) {
+            inst.fSlotA = Remap(inst.fSlotA);
+        }
+        if (inst.fSlotB != NA) {
+            inst.fSlotB = Remap(inst.fSlotB);
+        }
+    }
+    fNumValueSlots = numSlots;
+}
+
 Program::Program(SkTArray<Instruction> instrs,
                  int numValueSlots,
                  int numUniformSlots,
                  int numLabels,
-                 SkRPDebugTrace* debugTrace)
+                 SkRPDebugTrace* debugTrace,
+                 bool optimize)
         : fInstructions(std::move(instrs))
         , fNumValueSlots(numValueSlots)
         , fNumUniformSlots(numUniformSlots)
         , fNumLabels(numLabels)
         , fDebugTrace(debugTrace) {
-    this->optimize();
+    if (optimize) {
+        this->optimize();
+    }
 
     fTempStackMaxDepths = this->tempStackMaxDepths();
 
@@ -1245,6 +2043,13 @@ void Program::makeStages(SkTArray<Stage>* pipeline,
                                                       dst, src, inst.fImmA);
                 break;
             }
+            case ALL_IMMEDIATE_BINARY_OP_CASES: {
+                auto* ctx = alloc->make<SkRasterPipeline_ConstantCtx>();
+                ctx->dst = tempStackPtr - (1 * N);
+                ctx->value = inst.fImmA;
+                pipeline->push_back({(ProgramOp)inst.fOp, ctx});
+                break;
+            }
             case ALL_MULTI_SLOT_TERNARY_OP_CASES: {
                 float* src1 = tempStackPtr - (inst.fImmA * N);
                 float* src0 = tempStackPtr - (inst.fImmA * 2 * N);
@@ -1747,6 +2552,14 @@ void Program::dump(SkWStream* out) const {
                                    MultiImmCtx(ctx->src, numSlots));
         };
 
+        // Interpret the context value as a Constant structure (a single slot and an immediate).
+        auto ConstantCtx = [&](const void* v,
+                               bool showAsFloat) -> std::tuple<std::string, std::string> {
+            const auto* ctx = static_cast<const SkRasterPipeline_ConstantCtx*>(v);
+            return std::make_tuple(PtrCtx(ctx->dst, 1),
+                                   Imm(sk_bit_cast<float>(ctx->value), showAsFloat));
+        };
+
         // Interpret the context value as a BinaryOp structure (numSlots is inferred from the
         // distance between pointers).
         auto AdjacentBinaryOpCtx = [&](const void* v) -> std::tuple<std::string, std::string> {
@@ -1993,6 +2806,19 @@ void Program::dump(SkWStream* out) const {
                 std::tie(opArg1, opArg2, opArg3) = Adjacent3PtrCtx(stage.ctx, 1);
                 break;
 
+            case POp::add_imm_float:   case POp::mul_imm_float:
+            case POp::min_imm_float:   case POp::max_imm_float:
+            case POp::cmplt_imm_float: case POp::cmple_imm_float:
+            case POp::cmpeq_imm_float: case POp::cmpne_imm_float:
+                std::tie(opArg1, opArg2) = ConstantCtx(stage.ctx, /*showAsFloat=*/true);
+                break;
+
+            case POp::add_imm_int:   case POp::mul_imm_int:
+            case POp::cmplt_imm_int: case POp::cmple_imm_int:
+            case POp::cmpeq_imm_int: case POp::cmpne_imm_int:
+                std::tie(opArg1, opArg2) = ConstantCtx(stage.ctx, /*showAsFloat=*/false);
+                break;
+
             case POp::add_2_floats:   case POp::add_2_ints:
             case POp::sub_2_floats:   case POp::sub_2_ints:
             case POp::mul_2_floats:   case POp::mul_2_ints:
@@ -2326,6 +3152,7 @@ void Program::dump(SkWStream* out) const {
             case POp::add_3_floats: case POp::add_3_ints:
             case POp::add_4_floats: case POp::add_4_ints:
             case POp::add_n_floats: case POp::add_n_ints:
+            case POp::add_imm_float: case POp::add_imm_int:
                 opText = opArg1 + " += " + opArg2;
                 break;
 
@@ -2342,6 +3169,7 @@ void Program::dump(SkWStream* out) const {
             case POp::mul_3_floats: case POp::mul_3_ints:
             case POp::mul_4_floats: case POp::mul_4_ints:
             case POp::mul_n_floats: case POp::mul_n_ints:
+            case POp::mul_imm_float: case POp::mul_imm_int:
                 opText = opArg1 + " *= " + opArg2;
                 break;
 
@@ -2358,6 +3186,7 @@ void Program::dump(SkWStream* out) const {
             case POp::min_3_floats: case POp::min_3_ints: case POp::min_3_uints:
             case POp::min_4_floats: case POp::min_4_ints: case POp::min_4_uints:
             case POp::min_n_floats: case POp::min_n_ints: case POp::min_n_uints:
+            case POp::min_imm_float:
                 opText = opArg1 + " = min(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2366,6 +3195,7 @@ void Program::dump(SkWStream* out) const {
             case POp::max_3_floats: case POp::max_3_ints: case POp::max_3_uints:
             case POp::max_4_floats: case POp::max_4_ints: case POp::max_4_uints:
             case POp::max_n_floats: case POp::max_n_ints: case POp::max_n_uints:
+            case POp::max_imm_float:
                 opText = opArg1 + " = max(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2374,6 +3204,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmplt_3_floats: case POp::cmplt_3_ints: case POp::cmplt_3_uints:
             case POp::cmplt_4_floats: case POp::cmplt_4_ints: case POp::cmplt_4_uints:
             case POp::cmplt_n_floats: case POp::cmplt_n_ints: case POp::cmplt_n_uints:
+            case POp::cmplt_imm_float: case POp::cmplt_imm_int:
                 opText = opArg1 + " = lessThan(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2382,6 +3213,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmple_3_floats: case POp::cmple_3_ints: case POp::cmple_3_uints:
             case POp::cmple_4_floats: case POp::cmple_4_ints: case POp::cmple_4_uints:
             case POp::cmple_n_floats: case POp::cmple_n_ints: case POp::cmple_n_uints:
+            case POp::cmple_imm_float: case POp::cmple_imm_int:
                 opText = opArg1 + " = lessThanEqual(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2390,6 +3222,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmpeq_3_floats: case POp::cmpeq_3_ints:
             case POp::cmpeq_4_floats: case POp::cmpeq_4_ints:
             case POp::cmpeq_n_floats: case POp::cmpeq_n_ints:
+            case POp::cmpeq_imm_float: case POp::cmpeq_imm_int:
                 opText = opArg1 + " = equal(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2398,6 +3231,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmpne_3_floats: case POp::cmpne_3_ints:
             case POp::cmpne_4_floats: case POp::cmpne_4_ints:
             case POp::cmpne_n_floats: case POp::cmpne_n_ints:
+            case POp::cmpne_imm_float: case POp::cmpne_imm_int:
                 opText = opArg1 + " = notEqual(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -148,7 +148,8 @@ public:
             int numValueSlots,
             int numUniformSlots,
             int numLabels,
-            SkRPDebugTrace* debugTrace);
+            SkRPDebugTrace* debugTrace,
+            bool optimize = false);
 
 #if !defined(SKSL_STANDALONE)
     bool appendStages(SkRasterPipeline* pipeline,
@@ -176,9 +177,26 @@ private:
                     SkArenaAlloc* alloc,
                     SkSpan<const float> uniforms,
                     const SlotData& slots) const;
-    void optimize();
     StackDepthMap tempStackMaxDepths() const;
 
+    // Rewrites the instruction stream to do less work. This assumes that nothing outside of the
+    // program reads its value slots.
+    void optimize();
+    // Folds a pushed literal and the single-slot binary op which consumes it into one op which
+    // carries the literal as an immediate.
+    void foldImmediates();
+    // Forwards reads of a slot that was copied from another slot to the original. Returns true if
+    // the program changed.
+    bool propagateCopies();
+    // Removes (or trims) writes to value slots which are never read. Returns true if the program
+    // changed.
+    bool eliminateDeadStores();
+    // Removes stack computations whose results are discarded, and merges adjacent slot pushes.
+    // Returns true if the program changed.
+    bool simplifyStackOps();
+    // Renumbers value slots so that values which are never live at the same time share storage.
+    void reuseSlots();
+
     // These methods are used to split up large multi-slot operations into multiple ops as needed.
     void appendCopy(SkTArray<Stage>* pipeline, SkArenaAlloc* alloc,
                     ProgramOp baseStage,
@@ -244,10 +262,15 @@ private:
 
 class Builder {
 public:
-    /** Finalizes and optimizes the program. */
+    /**
+     * Finalizes the program. When `optimize` is set, the instruction stream is also rewritten to
+     * remove dead stores, forward copies, and reuse value slots; this assumes that the program's
+     * value slots are private to it.
+     */
     std::unique_ptr<Program> finish(int numValueSlots,
                                     int numUniformSlots,
-                                    SkRPDebugTrace* debugTrace = nullptr);
+                                    SkRPDebugTrace* debugTrace = nullptr,
+                                    bool optimize = false);
     /**
      * Peels off a label ID for use in the program. Set the label's position in the program with
      * the `label` instruction. Actually branch to the target with an instruction like
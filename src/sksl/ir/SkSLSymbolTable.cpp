@@ -33,6 +33,11 @@ const Symbol* SymbolTable::findBuiltinSymbol(std::string_view name) const {
 }
 
 Symbol* SymbolTable::lookup(const SymbolKey& key) const {
+    if (fFlattenedSymbols) {
+        // A flattened table already contains everything that our parents could find.
+        Symbol** symbolPPtr = fFlattenedSymbols->find(key);
+        return symbolPPtr ? *symbolPPtr : nullptr;
+    }
     Symbol** symbolPPtr = fSymbols.find(key);
     if (symbolPPtr) {
         return *symbolPPtr;
@@ -75,6 +80,9 @@ void SymbolTable::addWithoutOwnership(Symbol* symbol) {
             FunctionDeclaration* existingDecl = &existingSymbol->as<FunctionDeclaration>();
             symbol->as<FunctionDeclaration>().setNextOverload(existingDecl);
             fSymbols[key] = symbol;
+            if (fFlattenedSymbols) {
+                fFlattenedSymbols->set(key, symbol);
+            }
             return;
         }
     }
@@ -87,6 +95,9 @@ void SymbolTable::addWithoutOwnership(Symbol* symbol) {
 
         if (refInSymbolTable == nullptr) {
             refInSymbolTable = symbol;
+            if (fFlattenedSymbols) {
+                fFlattenedSymbols->set(key, symbol);
+            }
             return;
         }
     }
@@ -98,6 +109,27 @@ void SymbolTable::addWithoutOwnership(Symbol* symbol) {
 void SymbolTable::injectWithoutOwnership(Symbol* symbol) {
     auto key = MakeSymbolKey(symbol->name());
     fSymbols[key] = symbol;
+    if (fFlattenedSymbols) {
+        fFlattenedSymbols->set(key, symbol);
+    }
+}
+
+void SymbolTable::flatten() {
+    SkASSERT(this->isBuiltin());
+    if (fFlattenedSymbols) {
+        return;
+    }
+    auto flattened = std::make_unique<SkTHashMap<SymbolKey, Symbol*, SymbolKey::Hash>>();
+    // Visit the tables from innermost to outermost, so that symbols in inner tables hide any
+    // symbols with the same name in outer tables.
+    for (const SymbolTable* table = this; table; table = table->fParent.get()) {
+        table->fSymbols.foreach([&](const SymbolKey& key, Symbol* symbol) {
+            if (!flattened->find(key)) {
+                flattened->set(key, symbol);
+            }
+        });
+    }
+    fFlattenedSymbols = std::move(flattened);
 }
 
 const Type* SymbolTable::addArrayDimension(const Type* type, int arraySize) {
@@ -181,6 +181,15 @@ public:
         fAtModuleBoundary = true;
     }
 
+    /**
+     * Copies every symbol visible from this built-in symbol table, including the ones inherited
+     * from its parents, into a single lookup table. Programs look up most of their identifiers in
+     * the built-in modules, and this lets a lookup probe one table instead of one per module.
+     * Symbols added to this table afterward are still found, but its parents must not change.
+     * Does nothing if the table has already been flattened.
+     */
+    void flatten();
+
     std::shared_ptr<SymbolTable> fParent;
 
     std::vector<std::unique_ptr<const Symbol>> fOwnedSymbols;
@@ -207,6 +216,8 @@ private:
     bool fAtModuleBoundary = false;
     std::forward_list<std::string> fOwnedStrings;
     SkTHashMap<SymbolKey, Symbol*, SymbolKey::Hash> fSymbols;
+    // Set by flatten(). Holds fSymbols, plus every symbol visible in the parent tables.
+    std::unique_ptr<SkTHashMap<SymbolKey, Symbol*, SymbolKey::Hash>> fFlattenedSymbols;
 };
 
 }  // namespace SkSL
@@ -70,19 +70,7 @@ bool SDFMaskFilterImpl::filterMask(SkMask* dst, const SkMask& src,
         return false;
     }
 
-    if (src.fFormat == SkMask::kA8_Format) {
-        return SkGenerateDistanceFieldFromA8Image(dst->fImage, src.fImage,
-                                                  src.fBounds.width(), src.fBounds.height(),
-                                                  src.fRowBytes);
-    } else if (src.fFormat == SkMask::kLCD16_Format) {
-        return SkGenerateDistanceFieldFromLCD16Mask(dst->fImage, src.fImage,
-                                                     src.fBounds.width(), src.fBounds.height(),
-                                                     src.fRowBytes);
-    } else {
-        return SkGenerateDistanceFieldFromBWImage(dst->fImage, src.fImage,
-                                                  src.fBounds.width(), src.fBounds.height(),
-                                                  src.fRowBytes);
-    }
+    return SkGenerateDistanceFieldFromMask(dst->fImage, src);
 }
 
 void SDFMaskFilterImpl::computeFastBounds(const SkRect& src,
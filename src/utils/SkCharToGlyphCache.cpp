@@ -7,6 +7,8 @@
 
 #include "src/utils/SkCharToGlyphCache.h"
 
+#include "include/private/base/SkMalloc.h"
+
 SkCharToGlyphCache::SkCharToGlyphCache() {
     this->reset();
 }
@@ -14,6 +16,9 @@ SkCharToGlyphCache::SkCharToGlyphCache() {
 SkCharToGlyphCache::~SkCharToGlyphCache() {}
 
 void SkCharToGlyphCache::reset() {
+    fBMPPages.reset();
+    fBMPCount = 0;
+
     fK32.reset();
     fV16.reset();
 
@@ -93,6 +98,39 @@ static int find_with_slope(const SkUnichar base[], int count, SkUnichar value, d
 }
 
 int SkCharToGlyphCache::findGlyphIndex(SkUnichar unichar) const {
+    if (IsBMP(unichar)) {
+        SkGlyphID glyph;
+        return FindInPage(this->findPage(unichar), unichar, &glyph) ? glyph : ~0;
+    }
+    return this->findOtherGlyphIndex(unichar);
+}
+
+int SkCharToGlyphCache::findGlyphs(const SkUnichar chars[], int count, SkGlyphID glyphs[]) const {
+    // Neighbouring unichars mostly come from the same page, so only look it up when it changes
+    int pageIndex = -1;
+    const BMPPage* page = nullptr;
+    for (int i = 0; i < count; ++i) {
+        const SkUnichar c = chars[i];
+        if (IsBMP(c)) {
+            if ((c >> kBMPPageBits) != pageIndex) {
+                pageIndex = c >> kBMPPageBits;
+                page = this->findPage(c);
+            }
+            if (!FindInPage(page, c, &glyphs[i])) {
+                return i;
+            }
+        } else {
+            int index = this->findOtherGlyphIndex(c);
+            if (index < 0) {
+                return i;
+            }
+            glyphs[i] = SkToU16(index);
+        }
+    }
+    return count;
+}
+
+int SkCharToGlyphCache::findOtherGlyphIndex(SkUnichar unichar) const {
     const int count = fK32.size();
     int index;
     if (count <= kSmallCountLimit) {
@@ -107,6 +145,23 @@ int SkCharToGlyphCache::findGlyphIndex(SkUnichar unichar) const {
 }
 
 void SkCharToGlyphCache::insertCharAndGlyph(int index, SkUnichar unichar, SkGlyphID glyph) {
+    if (IsBMP(unichar)) {
+        if (!fBMPPages) {
+            fBMPPages = std::make_unique<std::unique_ptr<BMPPage>[]>(kBMPPageCount);
+        }
+        auto& page = fBMPPages[unichar >> kBMPPageBits];
+        if (!page) {
+            page = std::make_unique<BMPPage>();
+            sk_bzero(page->fCached, sizeof(page->fCached));
+        }
+        const int i = unichar & (kBMPPageSize - 1);
+        SkASSERT(!(page->fCached[i >> 5] & (1u << (i & 31))));
+        page->fGlyphs[i] = glyph;
+        page->fCached[i >> 5] |= 1u << (i & 31);
+        fBMPCount += 1;
+        return;
+    }
+
     SkASSERT(fK32.size() == fV16.size());
     SkASSERT(index < fK32.size());
     SkASSERT(unichar < fK32[index]);
@@ -13,6 +13,7 @@
 #include "include/private/base/SkTo.h"
 
 #include <cstdint>
+#include <memory>
 
 class SkCharToGlyphCache {
 public:
@@ -20,15 +21,21 @@ public:
     ~SkCharToGlyphCache();
 
     // return number of unichars cached
-    int count() const {
-        return fK32.size();
+    int count() const { return fBMPCount + this->otherCount(); }
+
+    // return number of unichars outside the BMP cached. Only these grow the sorted array, which
+    // costs memory per entry; the BMP pages are bounded by the BMP itself.
+    int otherCount() const {
+        // fK32 also holds the two sentinels
+        return fK32.size() - 2;
     }
 
     void reset();       // forget all cache entries (to save memory)
 
     /**
      *  Given a unichar, return its glyphID (if the return value is positive), else return
-     *  ~index of where to insert the computed glyphID.
+     *  ~index of where to insert the computed glyphID (the index does not matter for the BMP
+     *  unichars, which are direct-mapped).
      *
      *  int result = cache.charToGlyph(unichar);
      *  if (result >= 0) {
@@ -46,6 +53,12 @@ public:
      */
     void insertCharAndGlyph(int index, SkUnichar, SkGlyphID);
 
+    /**
+     *  Look up the glyphIDs of the unichars in order, stopping at the first one that is not
+     *  cached. Return the number of glyphIDs found (count if all of them were cached).
+     */
+    int findGlyphs(const SkUnichar chars[], int count, SkGlyphID glyphs[]) const;
+
     // helper to pre-seed an entry in the cache
     void addCharAndGlyph(SkUnichar unichar, SkGlyphID glyph) {
         int index = this->findGlyphIndex(unichar);
@@ -57,6 +70,37 @@ public:
     }
 
 private:
+    static constexpr int kBMPPageBits = 8;
+    static constexpr int kBMPPageSize = 1 << kBMPPageBits;
+    static constexpr int kBMPPageCount = 0x10000 >> kBMPPageBits;
+
+    // The BMP unichars are direct-mapped through pages allocated on demand
+    struct BMPPage {
+        SkGlyphID fGlyphs[kBMPPageSize];
+        uint32_t  fCached[kBMPPageSize / 32];
+    };
+
+    static bool IsBMP(SkUnichar c) { return (uint32_t)c < 0x10000; }
+
+    static bool FindInPage(const BMPPage* page, SkUnichar c, SkGlyphID* glyph) {
+        const int i = c & (kBMPPageSize - 1);
+        if (page && (page->fCached[i >> 5] & (1u << (i & 31)))) {
+            *glyph = page->fGlyphs[i];
+            return true;
+        }
+        return false;
+    }
+
+    const BMPPage* findPage(SkUnichar c) const {
+        return fBMPPages ? fBMPPages[c >> kBMPPageBits].get() : nullptr;
+    }
+
+    int findOtherGlyphIndex(SkUnichar c) const;
+
+    std::unique_ptr<std::unique_ptr<BMPPage>[]> fBMPPages;
+    int                  fBMPCount;
+
+    // All the other unichars are kept sorted
     SkTDArray<int32_t>   fK32;
     SkTDArray<uint16_t>  fV16;
     double               fDenom;
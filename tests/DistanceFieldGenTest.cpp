@@ -0,0 +1,180 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkRect.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkMask.h"
+#include "tests/Test.h"
+
+#include <memory>
+#include <vector>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+namespace {
+
+// A random mask of 'format', with solid runs and soft edges like a rasterized glyph.
+struct TestMask {
+    TestMask(SkRandom* rand, SkMask::Format format, int width, int height) {
+        fMask.fBounds = SkIRect::MakeWH(width, height);
+        fMask.fFormat = format;
+        switch (format) {
+            case SkMask::kBW_Format:     fMask.fRowBytes = (width + 7) / 8; break;
+            case SkMask::kLCD16_Format:  fMask.fRowBytes = width * 2;       break;
+            case SkMask::kARGB32_Format: fMask.fRowBytes = width * 4;       break;
+            default:                     fMask.fRowBytes = width;           break;
+        }
+        fStorage.resize(fMask.computeImageSize());
+        for (uint8_t& byte : fStorage) {
+            uint32_t r = rand->nextU();
+            byte = (r & 3) == 0 ? 0 : (r & 3) == 1 ? 0xFF : (uint8_t)(r >> 8);
+        }
+        fMask.fImage = fStorage.data();
+    }
+
+    SkMask fMask;
+    std::vector<uint8_t> fStorage;
+};
+
+std::vector<uint8_t> make_field(const SkMask& mask) {
+    return std::vector<uint8_t>((mask.fBounds.width() + 2 * SK_DistanceFieldPad) *
+                                (mask.fBounds.height() + 2 * SK_DistanceFieldPad), 0xCD);
+}
+
+}  // anonymous namespace
+
+DEF_TEST(DistanceFieldGen_FromMask, r) {
+    SkRandom rand;
+    for (SkMask::Format format : {SkMask::kA8_Format, SkMask::kBW_Format, SkMask::kLCD16_Format}) {
+        for (int size : {1, 7, 16, 33}) {
+            TestMask test(&rand, format, size, size + 3);
+            const SkMask& mask = test.fMask;
+            std::vector<uint8_t> expected = make_field(mask), actual = make_field(mask);
+            int w = mask.fBounds.width(), h = mask.fBounds.height();
+            switch (format) {
+                case SkMask::kA8_Format:
+                    SkGenerateDistanceFieldFromA8Image(expected.data(), mask.fImage, w, h,
+                                                       mask.fRowBytes);
+                    break;
+                case SkMask::kBW_Format:
+                    SkGenerateDistanceFieldFromBWImage(expected.data(), mask.fImage, w, h,
+                                                       mask.fRowBytes);
+                    break;
+                default:
+                    SkGenerateDistanceFieldFromLCD16Mask(expected.data(), mask.fImage, w, h,
+                                                         mask.fRowBytes);
+                    break;
+            }
+            REPORTER_ASSERT(r, SkGenerateDistanceFieldFromMask(actual.data(), mask));
+            REPORTER_ASSERT(r, expected == actual, "format %d size %d", format, size);
+        }
+    }
+
+    TestMask argb(&rand, SkMask::kARGB32_Format, 4, 4);
+    std::vector<uint8_t> field = make_field(argb.fMask);
+    REPORTER_ASSERT(r, !SkGenerateDistanceFieldFromMask(field.data(), argb.fMask));
+}
+
+// A small glyph's field matches the one the original per-texel edge search produced, so reworking
+// find_edges() and init_glyph_data() must keep their output the same. Only the two rightmost pad
+// columns differ, since the backward sweep now reaches them.
+DEF_TEST(DistanceFieldGen_Golden, r) {
+    static constexpr int kW = 6, kH = 5;
+    static const uint8_t kGlyph[kW * kH] = {
+          0,  64, 255, 255,  64,   0,
+         64, 255, 128,  32, 255,  64,
+        255, 255, 255, 255, 255, 255,
+        255,  96,   0,   0,  96, 255,
+        255,  32,   0,   0,   0, 200,
+    };
+    static constexpr int kFieldW = kW + 2 * SK_DistanceFieldPad;
+    static constexpr int kFieldH = kH + 2 * SK_DistanceFieldPad;
+    static const uint8_t kExpected[kFieldW * kFieldH] = {
+          0,   0,   0,   0,   5,  13,  13,  13,  13,   5,   0,   0,   0,   0,
+          0,   0,   0,  15,  34,  45,  45,  45,  45,  34,  15,   0,   0,   0,
+          0,   0,  15,  36,  61,  76,  77,  77,  76,  61,  36,  15,   0,   0,
+          0,  15,  36,  60,  79, 106, 108, 108, 106,  79,  60,  36,  15,   0,
+          5,  34,  61,  79, 105, 121, 146, 148, 121, 105,  79,  61,  34,   5,
+         13,  45,  76, 106, 121, 150, 128, 116, 149, 121, 106,  76,  45,  13,
+         13,  45,  77, 108, 146, 151, 151, 150, 147, 146, 108,  77,  45,  13,
+         16,  48,  80, 112, 150, 125, 109, 110, 125, 151, 111,  79,  47,  15,
+         15,  46,  77, 107, 148, 117,  86,  80, 106, 137, 107,  77,  46,  15,
+         15,  46,  77, 105, 111, 105,  78,  77, 105, 112, 105,  77,  46,  15,
+          6,  35,  60,  77,  79,  77,  60,  60,  77,  80,  77,  60,  35,   6,
+          0,  15,  35,  46,  47,  46,  34,  35,  46,  48,  46,  35,  15,   0,
+          0,   0,   6,  15,  15,  14,   6,   6,  15,  16,  15,   6,   0,   0,
+    };
+
+    uint8_t field[kFieldW * kFieldH];
+    REPORTER_ASSERT(r, SkGenerateDistanceFieldFromA8Image(field, kGlyph, kW, kH, kW));
+    for (int y = 0; y < kFieldH; ++y) {
+        for (int x = 0; x < kFieldW; ++x) {
+            int i = y * kFieldW + x;
+            REPORTER_ASSERT(r, field[i] == kExpected[i], "(%d, %d): %d != %d",
+                            x, y, field[i], kExpected[i]);
+        }
+    }
+}
+
+// The backward sweep covers every row up to its last texel, so the two rightmost pad columns of a
+// left-right symmetric glyph's field mirror the two leftmost ones.
+DEF_TEST(DistanceFieldGen_RightPadColumns, r) {
+    for (int w = 1; w <= 20; ++w) {
+        for (int h = 1; h <= 12; ++h) {
+            // a solid rect with a half-covered column down each side
+            std::vector<uint8_t> image(w * h, 0xFF);
+            for (int y = 0; y < h; ++y) {
+                image[y * w] = image[y * w + w - 1] = 0x80;
+            }
+            int fieldW = w + 2 * SK_DistanceFieldPad, fieldH = h + 2 * SK_DistanceFieldPad;
+            std::vector<uint8_t> field(fieldW * fieldH);
+            REPORTER_ASSERT(r, SkGenerateDistanceFieldFromA8Image(field.data(), image.data(),
+                                                                  w, h, w));
+            for (int y = 0; y < fieldH; ++y) {
+                const uint8_t* row = field.data() + y * fieldW;
+                for (int x = fieldW - 2; x < fieldW; ++x) {
+                    REPORTER_ASSERT(r, row[x] == row[fieldW - 1 - x],
+                                    "%dx%d at (%d, %d): %d != %d",
+                                    w, h, x, y, row[x], row[fieldW - 1 - x]);
+                }
+            }
+        }
+    }
+}
+
+// Generating a batch of fields, on an executor or not, matches generating them one at a time.
+DEF_TEST(DistanceFieldGen_Batch, r) {
+    SkRandom rand;
+    std::vector<TestMask> masks;
+    for (int i = 0; i < 40; ++i) {
+        masks.emplace_back(&rand, i % 3 ? SkMask::kA8_Format : SkMask::kBW_Format,
+                           1 + rand.nextULessThan(48), 1 + rand.nextULessThan(48));
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(3);
+    for (SkExecutor* exec : {(SkExecutor*)nullptr, executor.get()}) {
+        std::vector<std::vector<uint8_t>> fields;
+        std::vector<SkDistanceFieldJob> jobs;
+        for (const TestMask& test : masks) {
+            fields.push_back(make_field(test.fMask));
+        }
+        for (size_t i = 0; i < masks.size(); ++i) {
+            jobs.push_back({fields[i].data(), masks[i].fMask});
+        }
+        REPORTER_ASSERT(r, SkGenerateDistanceFields(jobs, exec));
+
+        for (size_t i = 0; i < masks.size(); ++i) {
+            std::vector<uint8_t> expected = make_field(masks[i].fMask);
+            SkGenerateDistanceFieldFromMask(expected.data(), masks[i].fMask);
+            REPORTER_ASSERT(r, fields[i] == expected, "mask %zu", i);
+        }
+    }
+}
+
+#endif // !defined(SK_DISABLE_SDF_TEXT)
@@ -5,12 +5,15 @@
 * found in the LICENSE file.
 */
 
+#include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/private/base/SkTDArray.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkIPoint16.h"
+#include "src/gpu/AtlasTypes.h"
 #include "src/gpu/Rectanizer.h"
+#include "src/gpu/RectanizerMaxRects.h"
 #include "src/gpu/RectanizerPow2.h"
 #include "src/gpu/RectanizerSkyline.h"
 #include "tests/CtsEnforcement.h"
@@ -64,6 +67,87 @@ static void test_pow2(skiatest::Reporter* reporter, const SkTDArray<SkISize>& re
     test_rectanizer_inserts(reporter, &pow2Rectanizer, rects);
 }
 
+static void test_maxrects(skiatest::Reporter* reporter, const SkTDArray<SkISize>& rects) {
+    RectanizerMaxRects maxRectsRectanizer(kWidth, kHeight);
+
+    test_rectanizer_basic(reporter, &maxRectsRectanizer);
+    test_rectanizer_inserts(reporter, &maxRectsRectanizer, rects);
+}
+
+// The placed rects must stay inside the rectanizer and never overlap. Mixed glyph-like sizes
+// should also pack at least as tightly as the skyline manages.
+DEF_TEST(RectanizerMaxRects, reporter) {
+    static constexpr int kSize = 256;
+    SkRandom rand;
+    SkTDArray<SkISize> sizes;
+    for (int i = 0; i < 2000; i++) {
+        sizes.push_back(SkISize::Make(rand.nextRangeU(4, 40), rand.nextRangeU(4, 40)));
+    }
+
+    RectanizerMaxRects maxRects(kSize, kSize);
+    SkTDArray<SkIRect> placed;
+    for (const SkISize& size : sizes) {
+        SkIPoint16 loc;
+        if (!maxRects.addRect(size.fWidth, size.fHeight, &loc)) {
+            continue;
+        }
+        SkIRect r = SkIRect::MakeXYWH(loc.fX, loc.fY, size.fWidth, size.fHeight);
+        REPORTER_ASSERT(reporter, SkIRect::MakeWH(kSize, kSize).contains(r));
+        for (const SkIRect& other : placed) {
+            REPORTER_ASSERT(reporter, !SkIRect::Intersects(r, other));
+        }
+        placed.push_back(r);
+    }
+
+    RectanizerSkyline skyline(kSize, kSize);
+    for (const SkISize& size : sizes) {
+        SkIPoint16 loc;
+        skyline.addRect(size.fWidth, size.fHeight, &loc);
+    }
+    REPORTER_ASSERT(reporter, maxRects.percentFull() >= skyline.percentFull(),
+                    "maxrects %f skyline %f", maxRects.percentFull(), skyline.percentFull());
+}
+
+// Glyph atlas plots can use MaxRects instead of the skyline, and keep it when they are cloned.
+DEF_TEST(PlotRectanizer, reporter) {
+    static constexpr int kSize = 128;
+    SkRandom rand;
+    SkTDArray<SkISize> sizes;
+    for (int i = 0; i < 500; i++) {
+        sizes.push_back(SkISize::Make(rand.nextRangeU(4, 40), rand.nextRangeU(4, 40)));
+    }
+    SkTDArray<uint8_t> image;
+    image.append(40 * 40);
+
+    AtlasGenerationCounter counter;
+    auto fill = [&](Plot* plot) {
+        int count = 0;
+        for (const SkISize& size : sizes) {
+            AtlasLocator locator;
+            count += plot->addSubImage(size.fWidth, size.fHeight, image.begin(), &locator);
+        }
+        return count;
+    };
+
+    sk_sp<Plot> skyline(new Plot(0, 0, &counter, 0, 0, kSize, kSize, kAlpha_8_SkColorType, 1));
+    sk_sp<Plot> maxRects(new Plot(0, 1, &counter, 1, 0, kSize, kSize, kAlpha_8_SkColorType, 1,
+                                  PlotRectanizer::kMaxRects));
+    int skylineCount = fill(skyline.get());
+    int maxRectsCount = fill(maxRects.get());
+    REPORTER_ASSERT(reporter, maxRects->percentFull() >= skyline->percentFull(),
+                    "maxrects %f skyline %f", maxRects->percentFull(), skyline->percentFull());
+
+    sk_sp<Plot> clone = maxRects->clone();
+    REPORTER_ASSERT(reporter, clone->percentFull() == 0);
+    REPORTER_ASSERT(reporter, fill(clone.get()) == maxRectsCount);
+    REPORTER_ASSERT(reporter, clone->percentFull() == maxRects->percentFull());
+
+    maxRects->resetRects();
+    REPORTER_ASSERT(reporter, maxRects->percentFull() == 0);
+    REPORTER_ASSERT(reporter, fill(maxRects.get()) == maxRectsCount);
+    REPORTER_ASSERT(reporter, skylineCount > 0);
+}
+
 DEF_GANESH_TEST(GpuRectanizer, reporter, factory, CtsEnforcement::kNever) {
     SkTDArray<SkISize> rects;
     SkRandom rand;
@@ -75,4 +159,5 @@ DEF_GANESH_TEST(GpuRectanizer, reporter, factory, CtsEnforcement::kNever) {
 
     test_skyline(reporter, rects);
     test_pow2(reporter, rects);
+    test_maxrects(reporter, rects);
 }
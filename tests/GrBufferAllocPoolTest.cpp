@@ -0,0 +1,61 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkRefCnt.h"
+#include "include/gpu/GrDirectContext.h"
+#include "src/gpu/ganesh/GrBuffer.h"
+#include "src/gpu/ganesh/GrBufferAllocPool.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+// Writes a few vertices into a fresh pool, as one flush would, and returns the buffer they went in.
+static sk_sp<const GrBuffer> flush_vertices(GrGpu* gpu,
+                                            sk_sp<GrBufferAllocPool::GpuBufferCache> cache) {
+    GrVertexBufferAllocPool pool(gpu, nullptr, std::move(cache));
+    sk_sp<const GrBuffer> buffer;
+    int startVertex;
+    if (!pool.makeSpace(sizeof(float), 16, &buffer, &startVertex)) {
+        return nullptr;
+    }
+    pool.unmap();
+    pool.reset();
+    return buffer;
+}
+
+DEF_GANESH_TEST_FOR_MOCK_CONTEXT(GrBufferAllocPoolGpuBufferCache, reporter, ctxInfo) {
+    GrGpu* gpu = ctxInfo.directContext()->priv().getGpu();
+    auto cache = GrBufferAllocPool::GpuBufferCache::Make(2);
+
+    sk_sp<const GrBuffer> first = flush_vertices(gpu, cache);
+    REPORTER_ASSERT(reporter, first && !first->isCpuBuffer());
+    const GrBuffer* firstID = first.get();
+    first.reset();
+
+    // Nothing else holds the buffer, so the next flush writes into it again.
+    sk_sp<const GrBuffer> second = flush_vertices(gpu, cache);
+    REPORTER_ASSERT(reporter, second.get() == firstID);
+
+    // While a flush is still using a buffer, later flushes must use another one.
+    sk_sp<const GrBuffer> third = flush_vertices(gpu, cache);
+    REPORTER_ASSERT(reporter, third && third != second);
+
+    // The ring is full, so this comes from the resource provider instead.
+    sk_sp<const GrBuffer> fourth = flush_vertices(gpu, cache);
+    REPORTER_ASSERT(reporter, fourth && fourth != second && fourth != third);
+
+    // Once the GPU is done with them, the ring's buffers are handed out oldest first.
+    second.reset();
+    third.reset();
+    sk_sp<const GrBuffer> fifth = flush_vertices(gpu, cache);
+    REPORTER_ASSERT(reporter, fifth.get() == firstID);
+
+    cache->releaseAll();
+    fifth.reset();
+    sk_sp<const GrBuffer> sixth = flush_vertices(gpu, cache);
+    REPORTER_ASSERT(reporter, sixth);
+}
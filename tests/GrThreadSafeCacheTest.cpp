@@ -79,6 +79,7 @@
 #include <memory>
 #include <thread>
 #include <utility>
+#include <vector>
 
 class GrDstProxyView;
 class GrProgramInfo;
@@ -1663,3 +1664,56 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrThreadSafeCache16Verts,
     helper.checkImage(reporter, std::move(ddl1));
     helper.checkImage(reporter, std::move(ddl2));
 }
+
+// Check that threads adding the same keys concurrently all end up sharing one entry per key, and
+// that purging finds every entry regardless of which shard it went to.
+DEF_TEST(GrThreadSafeCacheConcurrentAdds, reporter) {
+    static constexpr int kNumThreads = 4;
+    static constexpr int kNumKeys = 256;
+
+    GrThreadSafeCache threadSafeCache;
+    sk_sp<GrThreadSafeCache::VertexData> results[kNumThreads][kNumKeys];
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kNumKeys; ++i) {
+                // Walk the keys in a different order on each thread to vary who wins.
+                int id = (t & 1) ? kNumKeys - 1 - i : i;
+                skgpu::UniqueKey key;
+                create_vert_key(&key, id, kNoID);
+                void* vertices = sk_malloc_throw(sizeof(SkPoint));
+                auto [data, xtraData] = threadSafeCache.addVertsWithData(
+                        key,
+                        GrThreadSafeCache::MakeVertexData(vertices, 1, sizeof(SkPoint)),
+                        default_is_newer_better);
+                results[t][id] = std::move(data);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REPORTER_ASSERT(reporter, threadSafeCache.numEntries() == kNumKeys);
+    for (int i = 0; i < kNumKeys; ++i) {
+        skgpu::UniqueKey key;
+        create_vert_key(&key, i, kNoID);
+        auto [data, xtraData] = threadSafeCache.findVertsWithData(key);
+        for (int t = 0; t < kNumThreads; ++t) {
+            REPORTER_ASSERT(reporter, results[t][i] == data);
+        }
+    }
+
+    // Entries that are still referenced survive purging.
+    threadSafeCache.dropUniqueRefs(nullptr);
+    REPORTER_ASSERT(reporter, threadSafeCache.numEntries() == kNumKeys);
+
+    for (auto& threadResults : results) {
+        for (auto& data : threadResults) {
+            data.reset();
+        }
+    }
+    threadSafeCache.dropUniqueRefs(nullptr);
+    REPORTER_ASSERT(reporter, threadSafeCache.numEntries() == 0);
+}
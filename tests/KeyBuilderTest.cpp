@@ -0,0 +1,110 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkRandom.h"
+#include "src/gpu/KeyBuilder.h"
+#include "tests/Test.h"
+
+#include <cstdint>
+
+namespace {
+
+struct Field {
+    uint32_t fNumBits;
+    uint32_t fValue;
+};
+
+void add_fields(skgpu::KeyBuilder* b, const SkTArray<Field>& fields, int start, int end) {
+    for (int i = start; i < end; ++i) {
+        b->addBits(fields[i].fNumBits, fields[i].fValue, "field");
+    }
+}
+
+}  // anonymous namespace
+
+// Copying a run of bits that another builder packed must give the same key as adding them
+// directly, wherever they land in the current word.
+DEF_TEST(KeyBuilderAddBitString, r) {
+    SkRandom random;
+    for (int trial = 0; trial < 200; ++trial) {
+        SkTArray<Field> fields;
+        int count = random.nextRangeU(1, 40);
+        for (int i = 0; i < count; ++i) {
+            uint32_t numBits = random.nextRangeU(1, 32);
+            uint32_t value = random.nextU();
+            fields.push_back({numBits, numBits == 32 ? value : value & ((1u << numBits) - 1)});
+        }
+        int start = random.nextULessThan(count + 1);
+        int end = start + random.nextULessThan(count - start + 1);
+
+        SkTArray<uint32_t, true> expected;
+        {
+            skgpu::KeyBuilder b(&expected);
+            add_fields(&b, fields, 0, count);
+            b.flush();
+        }
+
+        SkTArray<uint32_t, true> run;
+        uint32_t runBits;
+        {
+            skgpu::KeyBuilder b(&run);
+            add_fields(&b, fields, start, end);
+            runBits = b.bitCount();
+            b.flush();
+        }
+
+        SkTArray<uint32_t, true> actual;
+        {
+            skgpu::KeyBuilder b(&actual);
+            add_fields(&b, fields, 0, start);
+            b.addBitString(run.data(), runBits, "run");
+            add_fields(&b, fields, end, count);
+            b.flush();
+        }
+
+        REPORTER_ASSERT(r, actual == expected, "trial %d", trial);
+    }
+}
+
+// Copying the bits added since some point gives the same run as packing those fields on their own.
+DEF_TEST(KeyBuilderCopyBitsSince, r) {
+    SkRandom random;
+    for (int trial = 0; trial < 200; ++trial) {
+        SkTArray<Field> fields;
+        int count = random.nextRangeU(1, 40);
+        for (int i = 0; i < count; ++i) {
+            uint32_t numBits = random.nextRangeU(1, 32);
+            uint32_t value = random.nextU();
+            fields.push_back({numBits, numBits == 32 ? value : value & ((1u << numBits) - 1)});
+        }
+        int start = random.nextULessThan(count + 1);
+
+        SkTArray<uint32_t, true> expected;
+        uint32_t expectedBits;
+        {
+            skgpu::KeyBuilder b(&expected);
+            add_fields(&b, fields, start, count);
+            expectedBits = b.bitCount();
+            b.flush();
+        }
+
+        SkTArray<uint32_t, true> key, copied;
+        uint32_t copiedBits;
+        {
+            skgpu::KeyBuilder b(&key);
+            add_fields(&b, fields, 0, start);
+            uint32_t startBit = b.bitCount();
+            add_fields(&b, fields, start, count);
+            copiedBits = b.copyBitsSince(startBit, &copied);
+            b.flush();
+        }
+
+        REPORTER_ASSERT(r, copiedBits == expectedBits, "trial %d", trial);
+        REPORTER_ASSERT(r, copied == expected, "trial %d", trial);
+    }
+}
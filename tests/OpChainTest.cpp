@@ -5,11 +5,19 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkGradientShader.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrDirectContext.h"
@@ -22,6 +30,7 @@
 #include "src/gpu/Swizzle.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRenderTargetProxy.h"
@@ -199,6 +208,43 @@ private:
 
     using INHERITED = GrOp;
 };
+
+// An op that merges with every other op of its class, or with none of them.
+template <bool kMergeable>
+class BoundsOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    static GrOp::Owner Make(GrRecordingContext* context, const SkRect& bounds) {
+        return GrOp::Make<BoundsOp>(context, bounds);
+    }
+
+    const char* name() const override { return "BoundsOp"; }
+
+private:
+    friend class ::GrOp;  // for ctor
+
+    BoundsOp(const SkRect& bounds) : INHERITED(ClassID()) {
+        this->setBounds(bounds, HasAABloat::kNo, IsHairline::kNo);
+    }
+
+    void onPrePrepare(GrRecordingContext*,
+                      const GrSurfaceProxyView& writeView,
+                      GrAppliedClip*,
+                      const GrDstProxyView&,
+                      GrXferBarrierFlags renderPassXferBarriers,
+                      GrLoadOp colorLoadOp) override {}
+
+    void onPrepare(GrOpFlushState*) override {}
+
+    void onExecute(GrOpFlushState*, const SkRect& chainBounds) override {}
+
+    CombineResult onCombineIfPossible(GrOp* t, SkArenaAlloc*, const GrCaps&) override {
+        return kMergeable ? CombineResult::kMerged : CombineResult::kCannotCombine;
+    }
+
+    using INHERITED = GrOp;
+};
 }  // namespace
 
 /**
@@ -300,3 +346,104 @@ DEF_GANESH_TEST(OpChainTest, reporter, /*ctxInfo*/, CtsEnforcement::kApiLevel_T)
         }
     }
 }
+
+/**
+ * Tests that ops combine with a chain of their class that is further back than the fixed lookback,
+ * as long as nothing in between overlaps them.
+ */
+DEF_GANESH_TEST(OpChainLongDistanceTest, reporter, /*ctxInfo*/, CtsEnforcement::kNever) {
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr);
+    SkASSERT(dContext);
+    const GrCaps* caps = dContext->priv().caps();
+    static constexpr int kNumPairs = 30;
+    static constexpr SkISize kDims = {2 * kNumPairs, 2};
+
+    const GrBackendFormat format = caps->getDefaultBackendFormat(GrColorType::kRGBA_8888,
+                                                                 GrRenderable::kYes);
+    auto proxy = dContext->priv().proxyProvider()->createProxy(format,
+                                                               kDims,
+                                                               GrRenderable::kYes,
+                                                               1,
+                                                               GrMipmapped::kNo,
+                                                               SkBackingFit::kExact,
+                                                               skgpu::Budgeted::kNo,
+                                                               GrProtected::kNo,
+                                                               /*label=*/"OpChainTest",
+                                                               GrInternalSurfaceFlags::kNone);
+    SkASSERT(proxy);
+    proxy->instantiate(dContext->priv().resourceProvider());
+    skgpu::Swizzle writeSwizzle = caps->getWriteSwizzle(format, GrColorType::kRGBA_8888);
+    GrDrawingManager* drawingMgr = dContext->priv().drawingManager();
+    sk_sp<GrArenas> arenas = sk_make_sp<GrArenas>();
+
+    // Records pairs of a mergeable op and an unmergeable op. If 'blockAt' is in range, that pair's
+    // unmergeable op covers all the others. Returns the number of chains left after closing.
+    auto countChains = [&](int blockAt) {
+        skgpu::v1::OpsTask opsTask(drawingMgr,
+                                   GrSurfaceProxyView(proxy, kTopLeft_GrSurfaceOrigin,
+                                                      writeSwizzle),
+                                   dContext->priv().auditTrail(),
+                                   arenas);
+        for (int i = 0; i < kNumPairs; ++i) {
+            SkRect bounds = SkRect::MakeXYWH(2 * i, 0, 1, 1);
+            opsTask.addOp(drawingMgr, BoundsOp<true>::Make(dContext.get(), bounds),
+                          GrTextureResolveManager(drawingMgr), *caps);
+            SkRect other = i == blockAt ? SkRect::Make(kDims) : bounds.makeOffset(1, 0);
+            opsTask.addOp(drawingMgr, BoundsOp<false>::Make(dContext.get(), other),
+                          GrTextureResolveManager(drawingMgr), *caps);
+        }
+        opsTask.makeClosed(dContext.get());
+        int numChains = 0;
+        for (int i = 0; i < opsTask.numOpChains(); ++i) {
+            numChains += SkToBool(opsTask.getChain(i));
+        }
+        opsTask.endFlush(drawingMgr);
+        opsTask.disown(drawingMgr);
+        return numChains;
+    };
+
+    // All the mergeable ops combine into one op.
+    REPORTER_ASSERT(reporter, countChains(-1) == kNumPairs + 1);
+    // Nothing can be reordered across the blocking op, so there is one op before it and one after.
+    REPORTER_ASSERT(reporter, countChains(kNumPairs / 2) == kNumPairs + 2);
+}
+
+/**
+ * Counts the draws of a scene that interleaves solid rects with rects that each have their own
+ * gradient. The gradient rects can't combine, and push the earlier solid rects out of the fixed
+ * lookback. Without long distance combining this took 36 draws.
+ */
+DEF_GANESH_TEST(OpChainInterleavedDrawCount, reporter, /*ctxInfo*/, CtsEnforcement::kNever) {
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr);
+    SkASSERT(dContext);
+    static constexpr int kNumGradients = 32;
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(8 * kNumGradients, 16);
+    sk_sp<SkSurface> surface =
+            SkSurface::MakeRenderTarget(dContext.get(), skgpu::Budgeted::kNo, info);
+    if (!surface) {
+        ERRORF(reporter, "Could not create surface");
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    dContext->flushAndSubmit();
+    dContext->priv().resetGpuStats();
+
+    SkPaint solid;
+    solid.setColor(SK_ColorBLUE);
+    for (int i = 0; i < kNumGradients; ++i) {
+        SkPoint pts[] = {{8.f * i, 0}, {8.f * i + 8, 0}};
+        SkColor colors[] = {SK_ColorRED, SkColorSetARGB(0xFF, 0, 8 * i, 0)};
+        SkPaint gradient;
+        gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                        SkTileMode::kClamp));
+        canvas->drawRect(SkRect::MakeXYWH(8 * i, 0, 8, 8), gradient);
+        canvas->drawRect(SkRect::MakeXYWH(8 * i, 8, 8, 8), solid);
+    }
+    dContext->flushAndSubmit();
+#if GR_GPU_STATS
+    // One draw for each gradient rect, and one for all the solid rects.
+    int numDraws = dContext->priv().getGpu()->stats()->numDraws();
+    REPORTER_ASSERT(reporter, numDraws == kNumGradients + 1, "%d draws", numDraws);
+#endif
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkPathPriv.h"
+#include "src/gpu/BufferWriter.h"
+#include "src/gpu/tessellate/AffineMatrix.h"
+#include "src/gpu/tessellate/LinearTolerances.h"
+#include "src/gpu/tessellate/PatchWriter.h"
+#include "src/gpu/tessellate/WangsFormula.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace skgpu;
+using namespace skgpu::tess;
+
+namespace {
+
+// Appends patches to CPU memory and records the worst case tolerances, like the GPU allocators.
+class CPUPatchAllocator {
+public:
+    CPUPatchAllocator(size_t stride, std::vector<char>* data, LinearTolerances* tolerances)
+            : fStride(stride), fData(data), fTolerances(tolerances) {}
+
+    VertexWriter append(const LinearTolerances& tolerances, int count = 1) {
+        fTolerances->accumulate(tolerances);
+        size_t offset = fData->size();
+        fData->resize(offset + fStride * count);
+        return {fData->data() + offset, fStride * count};
+    }
+
+private:
+    size_t fStride;
+    std::vector<char>* fData;
+    LinearTolerances* fTolerances;
+};
+
+using CurveWriter = PatchWriter<CPUPatchAllocator,
+                                Optional<PatchAttribs::kColor>,
+                                AddTrianglesWhenChopping,
+                                DiscardFlatCurves>;
+
+struct Patches {
+    std::vector<char> fData;
+    LinearTolerances fTolerances;
+
+    bool operator==(const Patches& o) const {
+        return fData == o.fData &&
+               fTolerances.numParametricSegments_p4() == o.fTolerances.numParametricSegments_p4();
+    }
+};
+
+// Writes every cubic of 'path' either one at a time or as runs of consecutive cubics.
+Patches write_cubics(const SkPath& path, const SkMatrix* matrix, bool asRuns) {
+    Patches patches;
+    {
+        CurveWriter writer(PatchAttribs::kColor, &patches.fData, &patches.fTolerances);
+        writer.setShaderTransform(wangs_formula::VectorXform{SkMatrix::Scale(1.5f, .75f)});
+        writer.updateColorAttrib(SK_PMColor4fWHITE);
+        AffineMatrix m(matrix ? *matrix : SkMatrix::I());
+        const SkPoint* run = nullptr;
+        int runCount = 0;
+        auto flushRun = [&]() {
+            if (matrix) {
+                writer.writeCubicRun(run, runCount, m);
+            } else {
+                writer.writeCubicRun(run, runCount);
+            }
+            runCount = 0;
+        };
+        for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+            if (verb != SkPathVerb::kCubic) {
+                continue;
+            }
+            if (!asRuns) {
+                if (matrix) {
+                    auto [p0, p1] = m.map2Points(pts);
+                    auto [p2, p3] = m.map2Points(pts + 2);
+                    writer.writeCubic(p0, p1, p2, p3);
+                } else {
+                    writer.writeCubic(pts);
+                }
+            } else {
+                if (pts != run + 3 * runCount) {
+                    flushRun();
+                    run = pts;
+                }
+                ++runCount;
+            }
+        }
+        flushRun();
+    }
+    return patches;
+}
+
+}  // anonymous namespace
+
+// Writing runs of cubics four at a time gives the same patches as writing them one by one.
+DEF_TEST(PatchWriter_CubicRun, r) {
+    SkRandom rand;
+    for (int i = 0; i < 50; ++i) {
+        SkPath path;
+        int contours = 1 + rand.nextULessThan(3);
+        for (int c = 0; c < contours; ++c) {
+            path.moveTo(rand.nextF() * 100, rand.nextF() * 100);
+            int cubics = rand.nextULessThan(20);
+            for (int j = 0; j < cubics; ++j) {
+                // Mix flat curves, curves that need a single patch, and curves that get chopped.
+                float scale = std::ldexp(1.f, (int)rand.nextRangeU(0, 16) - 6);
+                SkPoint p[3];
+                for (SkPoint& pt : p) {
+                    pt = {rand.nextF() * scale, rand.nextF() * scale};
+                }
+                path.cubicTo(p[0], p[1], p[2]);
+                if (rand.nextULessThan(8) == 0) {
+                    path.lineTo(rand.nextF() * scale, rand.nextF() * scale);
+                }
+            }
+        }
+
+        SkMatrix matrix = SkMatrix::MakeAll(1.25f, .1f, 7, -.2f, .8f, -3, 0, 0, 1);
+        REPORTER_ASSERT(r, write_cubics(path, nullptr, true) == write_cubics(path, nullptr, false));
+        REPORTER_ASSERT(r, write_cubics(path, &matrix, true) == write_cubics(path, &matrix, false));
+    }
+}
@@ -5,14 +5,19 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkRect.h"
 #include "include/pathops/SkPathOps.h"
 #include "include/private/base/SkFloatBits.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkRandom.h"
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/Test.h"
 
+#include <memory>
+
 DEF_TEST(PathOpsBuilder, reporter) {
     SkOpBuilder builder;
     SkPath result;
@@ -364,3 +369,68 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+static SkPath make_polygon(SkRandom* rand, SkScalar cx, SkScalar cy) {
+    SkPath path;
+    int sides = 4 + rand->nextULessThan(8);
+    for (int side = 0; side < sides; ++side) {
+        SkScalar angle = side * 2 * SK_ScalarPI / sides;
+        SkScalar radius = rand->nextRangeScalar(6, 14);
+        SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+        if (side == 0) {
+            path.moveTo(pt);
+        } else if (side & 1) {
+            path.quadTo(pt + SkVector{rand->nextRangeScalar(-4, 4),
+                                      rand->nextRangeScalar(-4, 4)}, pt);
+        } else {
+            path.lineTo(pt);
+        }
+    }
+    path.close();
+    return path;
+}
+
+DEF_TEST(SkOpBuilderResolveParallel, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkRandom rand;
+    SkTArray<SkPath> paths;
+    for (int i = 0; i < 36; ++i) {
+        paths.push_back(make_polygon(&rand, (i % 6) * 20 + rand.nextRangeScalar(-6, 6),
+                                            (i / 6) * 20 + rand.nextRangeScalar(-6, 6)));
+    }
+
+    // With a mix of operators, the paths are combined in order, exactly like resolve().
+    SkOpBuilder builder;
+    for (int i = 0; i < paths.size(); ++i) {
+        builder.add(paths[i], i % 5 == 3 ? kDifference_SkPathOp : kUnion_SkPathOp);
+    }
+    SkPath serial;
+    REPORTER_ASSERT(reporter, builder.resolve(&serial));
+    for (int i = 0; i < paths.size(); ++i) {
+        builder.add(paths[i], i % 5 == 3 ? kDifference_SkPathOp : kUnion_SkPathOp);
+    }
+    SkPath parallel;
+    REPORTER_ASSERT(reporter, builder.resolveParallel(&parallel, executor.get()));
+    REPORTER_ASSERT(reporter, serial == parallel);
+
+    // Overlapping unions are combined in a different order, so compare the areas.
+    for (const SkPath& path : paths) {
+        builder.add(path, kUnion_SkPathOp);
+    }
+    REPORTER_ASSERT(reporter, builder.resolve(&serial));
+    for (const SkPath& path : paths) {
+        builder.add(path, kUnion_SkPathOp);
+    }
+    REPORTER_ASSERT(reporter, builder.resolveParallel(&parallel, executor.get()));
+    SkPath difference;
+    REPORTER_ASSERT(reporter, Op(serial, parallel, kXOR_SkPathOp, &difference));
+    REPORTER_ASSERT(reporter, difference.isEmpty());
+
+    // The result doesn't depend on the number of threads.
+    for (const SkPath& path : paths) {
+        builder.add(path, kUnion_SkPathOp);
+    }
+    SkPath singleThreaded;
+    REPORTER_ASSERT(reporter, builder.resolveParallel(&singleThreaded));
+    REPORTER_ASSERT(reporter, singleThreaded == parallel);
+}
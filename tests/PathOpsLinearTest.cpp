@@ -0,0 +1,256 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/pathops/SkPathOps.h"
+#include "src/base/SkRandom.h"
+#include "src/pathops/SkPathOpsCommon.h"
+#include "src/pathops/SkPathOpsLinear.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cmath>
+
+static bool same_path_data(const SkPath& one, const SkPath& two) {
+    if (one.getFillType() != two.getFillType() || one.countVerbs() != two.countVerbs() ||
+        one.countPoints() != two.countPoints()) {
+        return false;
+    }
+    for (int i = 0; i < one.countPoints(); ++i) {
+        if (one.getPoint(i) != two.getPoint(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static SkScalar distance_to_edges(const SkPath& path, SkPoint pt) {
+    SkScalar best = SK_ScalarInfinity;
+    SkPath::Iter iter(path, true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        if (verb == SkPath::kLine_Verb) {
+            SkVector d = pts[1] - pts[0];
+            SkScalar len = d.dot(d);
+            SkScalar t = len > 0 ? std::clamp((pt - pts[0]).dot(d) / len, 0.f, 1.f) : 0;
+            best = std::min(best, SkPoint::Distance(pt, pts[0] + d * t));
+        }
+    }
+    return best;
+}
+
+static SkPath random_polygons(SkRandom* rand, int grid) {
+    SkPath path;
+    int contours = 1 + rand->nextULessThan(3);
+    for (int c = 0; c < contours; ++c) {
+        int count = 3 + rand->nextULessThan(6);
+        for (int i = 0; i < count; ++i) {
+            SkPoint pt = {(SkScalar)rand->nextULessThan(grid + 1),
+                          (SkScalar)rand->nextULessThan(grid + 1)};
+            if (i == 0) {
+                path.moveTo(pt);
+            } else {
+                path.lineTo(pt);
+            }
+        }
+        path.close();
+    }
+    path.setFillType((SkPathFillType)rand->nextULessThan(4));
+    return path;
+}
+
+DEF_TEST(PathOpsLinear, reporter) {
+    SkPath a, b;
+    a.addRect({0, 0, 4, 4});
+    b.addRect({2, 2, 6, 6}, SkPathDirection::kCCW);
+    SkPath result;
+    REPORTER_ASSERT(reporter, LinearOp(a, b, kUnion_SkPathOp, &result));
+    REPORTER_ASSERT(reporter, result.contains(1, 1) && result.contains(5, 5));
+    REPORTER_ASSERT(reporter, !result.contains(5, 1) && !result.contains(1, 5));
+    REPORTER_ASSERT(reporter, LinearOp(a, b, kIntersect_SkPathOp, &result));
+    REPORTER_ASSERT(reporter, result.getBounds() == SkRect::MakeLTRB(2, 2, 4, 4));
+    REPORTER_ASSERT(reporter, LinearOp(a, b, kXOR_SkPathOp, &result));
+    REPORTER_ASSERT(reporter, result.contains(1, 1) && !result.contains(3, 3));
+    REPORTER_ASSERT(reporter, LinearOp(a, b, kDifference_SkPathOp, &result));
+    REPORTER_ASSERT(reporter, result.contains(1, 1) && !result.contains(3, 3));
+    REPORTER_ASSERT(reporter, !result.contains(5, 5));
+
+    // Curves and non-finite points are left to the general engine.
+    SkPath curve;
+    curve.addOval({0, 0, 4, 4});
+    result.reset();
+    REPORTER_ASSERT(reporter, !LinearOp(a, curve, kUnion_SkPathOp, &result));
+    REPORTER_ASSERT(reporter, !LinearSimplify(curve, &result));
+    SkPath bad;
+    bad.moveTo(0, 0);
+    bad.lineTo(SK_ScalarInfinity, 1);
+    bad.lineTo(1, 1);
+    REPORTER_ASSERT(reporter, !LinearSimplify(bad, &result));
+    REPORTER_ASSERT(reporter, result.isEmpty());
+}
+
+// The result depends only on the input points, not on the order of the contours.
+DEF_TEST(PathOpsLinearContourOrder, reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 100; ++i) {
+        SkPath one = random_polygons(&rand, 8), two = random_polygons(&rand, 8);
+        SkPath forward(one), backward(two);
+        forward.addPath(two);
+        backward.addPath(one);
+        backward.setFillType(one.getFillType());
+        SkPath r1, r2;
+        REPORTER_ASSERT(reporter, LinearSimplify(forward, &r1));
+        REPORTER_ASSERT(reporter, LinearSimplify(backward, &r2));
+        REPORTER_ASSERT(reporter, same_path_data(r1, r2));
+    }
+}
+
+DEF_TEST(PathOpsLinearMatchesGeneral, reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 200; ++i) {
+        SkPath one = random_polygons(&rand, 16), two = random_polygons(&rand, 16);
+        SkPathOp op = (SkPathOp)rand.nextULessThan(kReverseDifference_SkPathOp + 1);
+        SkPath linear, general;
+        REPORTER_ASSERT(reporter, LinearOp(one, two, op, &linear));
+        if (!OpDebug(one, two, op, &general SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr))) {
+            continue;
+        }
+        // Both results lie on the input edges, up to rounding; away from those they must agree.
+        for (int j = 0; j < 200; ++j) {
+            SkPoint pt = {rand.nextRangeScalar(-1, 17), rand.nextRangeScalar(-1, 17)};
+            if (distance_to_edges(one, pt) < 0.01f || distance_to_edges(two, pt) < 0.01f) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, linear.contains(pt.fX, pt.fY) ==
+                                      general.contains(pt.fX, pt.fY), "case %d", i);
+        }
+    }
+}
+
+// The size of a grid unit for paths with these combined bounds; see Grid in SkPathOpsLinear.cpp.
+static SkScalar grid_unit(const SkPath& one, const SkPath& two) {
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    int exponent;
+    std::frexp(std::max(bounds.width(), bounds.height()), &exponent);
+    return std::ldexp(1.0f, exponent - 19);
+}
+
+// Like random_polygons(), but in a square of `size` at `origin`, and off the integer grid.
+static SkPath random_polygons_at(SkRandom* rand, SkPoint origin, SkScalar size) {
+    SkPath path;
+    int contours = 1 + rand->nextULessThan(3);
+    for (int c = 0; c < contours; ++c) {
+        int count = 3 + rand->nextULessThan(6);
+        for (int i = 0; i < count; ++i) {
+            SkPoint pt = {rand->nextULessThan(17) + rand->nextRangeScalar(0, 0.3f),
+                          rand->nextULessThan(17) + rand->nextRangeScalar(0, 0.3f)};
+            pt = origin + pt * (size / 16);
+            if (i == 0) {
+                path.moveTo(pt);
+            } else {
+                path.lineTo(pt);
+            }
+        }
+        path.close();
+    }
+    path.setFillType((SkPathFillType)rand->nextULessThan(4));
+    return path;
+}
+
+// Op() and Simplify() are not affected by the snap rounded engine, which must be asked for.
+DEF_TEST(PathOpsLinearOptIn, reporter) {
+    SkPath a, b;
+    a.addRect({100.7f, 0.3f, 200.2f, 50.9f});
+    b.addRect({150.1f, 20.6f, 250.45f, 80.05f}, SkPathDirection::kCCW);
+    for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+        SkPath result, legacy;
+        REPORTER_ASSERT(reporter, Op(a, b, (SkPathOp)op, &result));
+        REPORTER_ASSERT(reporter, OpDebug(a, b, (SkPathOp)op, &legacy
+                                          SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr)));
+        REPORTER_ASSERT(reporter, same_path_data(result, legacy), "op %d", op);
+    }
+    SkPath both(a);
+    both.addPath(b);
+    SkPath result, legacy;
+    REPORTER_ASSERT(reporter, Simplify(both, &result));
+    REPORTER_ASSERT(reporter, SimplifyDebug(both, &legacy
+                                            SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr)));
+    REPORTER_ASSERT(reporter, same_path_data(result, legacy));
+    REPORTER_ASSERT(reporter, result.getBounds() == SkRect::MakeLTRB(100.7f, 0.3f, 250.45f, 80.05f));
+
+    // The snap rounded engine moves the points by up to half a grid unit.
+    REPORTER_ASSERT(reporter, SnapRoundedSimplify(both, &result));
+    SkScalar unit = grid_unit(a, b);
+    SkRect bounds = result.getBounds(), expected = legacy.getBounds();
+    REPORTER_ASSERT(reporter, std::abs(bounds.fLeft - expected.fLeft) <= unit / 2 &&
+                              std::abs(bounds.fTop - expected.fTop) <= unit / 2 &&
+                              std::abs(bounds.fRight - expected.fRight) <= unit / 2 &&
+                              std::abs(bounds.fBottom - expected.fBottom) <= unit / 2);
+
+    // Features thinner than a grid unit may disappear, but so may they with the general engine.
+    // Here the grid unit is 2^-9; both engines keep slivers down to half of that.
+    SkPath square;
+    square.addRect({0, 0, 1000, 1000});
+    for (int shift = 4; shift <= 14; ++shift) {
+        SkPath sliver;
+        sliver.addRect({1001, 0, 1001 + std::ldexp(1.0f, -shift), 1000});
+        unit = grid_unit(square, sliver);
+        REPORTER_ASSERT(reporter, unit == 1 / 512.f);
+        REPORTER_ASSERT(reporter, Op(square, sliver, kUnion_SkPathOp, &legacy));
+        REPORTER_ASSERT(reporter, SnapRoundedOp(square, sliver, kUnion_SkPathOp, &result));
+        REPORTER_ASSERT(reporter,
+                        std::abs(result.getBounds().fRight - legacy.getBounds().fRight) <= unit / 2,
+                        "sliver 2^-%d: %g vs %g", shift, result.getBounds().fRight,
+                        legacy.getBounds().fRight);
+    }
+}
+
+// With fractional and large coordinates, the snap rounded engine matches the general engine up
+// to a grid unit of the edges.
+DEF_TEST(PathOpsLinearMatchesGeneralFractional, reporter) {
+    SkRandom rand;
+    const struct {
+        SkPoint origin;
+        SkScalar size;
+    } kCases[] = {
+        {{0.3f, 0.7f}, 1},
+        {{-100.7f, 200.3f}, 100},
+        {{1e5f + 0.5f, -1e5f - 0.25f}, 1000},
+        {{4e6f, 4e6f}, 1e6f},
+        {{-3e7f, 2e7f}, 3e7f},
+    };
+    for (const auto& [origin, size] : kCases) {
+        for (int i = 0; i < 50; ++i) {
+            SkPath one = random_polygons_at(&rand, origin, size);
+            SkPath two = random_polygons_at(&rand, origin, size);
+            SkPathOp op = (SkPathOp)rand.nextULessThan(kReverseDifference_SkPathOp + 1);
+            SkPath snapped, general;
+            REPORTER_ASSERT(reporter, SnapRoundedOp(one, two, op, &snapped));
+            if (!OpDebug(one, two, op, &general SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr))) {
+                continue;
+            }
+            SkScalar tolerance = 2 * grid_unit(one, two) + size * 1e-5f;
+            for (int j = 0; j < 200; ++j) {
+                SkPoint pt = {origin.fX + rand.nextRangeScalar(-0.1f, 1.1f) * size,
+                              origin.fY + rand.nextRangeScalar(-0.1f, 1.1f) * size};
+                if (distance_to_edges(one, pt) < tolerance ||
+                    distance_to_edges(two, pt) < tolerance) {
+                    continue;
+                }
+                REPORTER_ASSERT(reporter, snapped.contains(pt.fX, pt.fY) ==
+                                          general.contains(pt.fX, pt.fY),
+                                "size %g case %d", size, i);
+            }
+        }
+    }
+}
@@ -15,7 +15,9 @@
 #include "include/core/SkStrokeRec.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
+#include "include/core/SkData.h"
 #include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "include/gpu/GrTypes.h"
@@ -32,17 +34,17 @@
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/effects/GrPorterDuffXferProcessor.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
+#include "src/gpu/ganesh/geometry/GrTriangulationCache.h"
 #include "src/gpu/ganesh/ops/SoftwarePathRenderer.h"
 #include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
+#include "tools/gpu/MemoryCache.h"
 
 #include <functional>
 #include <memory>
 #include <utility>
 
-struct GrContextOptions;
-
 static SkPath create_concave_path() {
     SkPath path;
     path.moveTo(100, 0);
@@ -179,6 +181,107 @@ DEF_GANESH_TEST(TriangulatingPathRendererCacheTest,
     test_path(reporter, create_concave_path, createPR, kExpectedResources, false, GrAAType::kNone,
               style);
 }
+
+// Test that a second context finds the first context's triangulations in the persistent cache
+DEF_GANESH_TEST(TriangulatingPathRendererPersistentCacheTest,
+                reporter,
+                /* options */,
+                CtsEnforcement::kNever) {
+    sk_gpu_test::MemoryCache memoryCache;
+    GrContextOptions options;
+    options.fPersistentGeometryCache = &memoryCache;
+
+    auto drawPaths = [&]() {
+        sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr, options);
+        auto sdc = skgpu::v1::SurfaceDrawContext::Make(
+                dContext.get(), GrColorType::kRGBA_8888, nullptr, SkBackingFit::kApprox,
+                {800, 800}, SkSurfaceProps(), /*label=*/{}, 1, GrMipmapped::kNo, GrProtected::kNo,
+                kTopLeft_GrSurfaceOrigin);
+        if (!sdc) {
+            return false;
+        }
+        skgpu::v1::TriangulatingPathRenderer pathRenderer;
+        GrStyle style(SkStrokeRec::kFill_InitStyle);
+        draw_path(dContext.get(), sdc.get(), create_concave_path(), &pathRenderer,
+                  GrAAType::kNone, style);
+        draw_path(dContext.get(), sdc.get(), create_concave_path(), &pathRenderer,
+                  GrAAType::kCoverage, style);
+        dContext->flushAndSubmit();
+        return true;
+    };
+
+    if (!drawPaths()) {
+        return;
+    }
+    // One entry each for the non-AA and the AA triangulation.
+    REPORTER_ASSERT(reporter, memoryCache.numCacheMisses() == 2);
+    REPORTER_ASSERT(reporter, memoryCache.numCacheStores() == 2);
+
+    // The same paths, drawn by a new context, are loaded instead of triangulated again.
+    drawPaths();
+    REPORTER_ASSERT(reporter, memoryCache.numCacheMisses() == 2);
+    REPORTER_ASSERT(reporter, memoryCache.numCacheStores() == 2);
+}
+
+DEF_TEST(TriangulationCacheData, reporter) {
+    SkPath path = create_concave_path();
+    SkRect clip = SkRect::MakeWH(800, 800);
+    sk_sp<SkData> key = GrTriangulationCache::MakeKey(path, 0.25f, false, clip);
+    REPORTER_ASSERT(reporter, key->equals(GrTriangulationCache::MakeKey(path, 0.25f, false,
+                                                                        clip).get()));
+    REPORTER_ASSERT(reporter, !key->equals(GrTriangulationCache::MakeKey(path, 0.25f, true,
+                                                                         clip).get()));
+    SkPath moved = path;
+    moved.offset(1, 0);
+    REPORTER_ASSERT(reporter, !key->equals(GrTriangulationCache::MakeKey(moved, 0.25f, false,
+                                                                         clip).get()));
+
+    // Tolerances within a bucket share it, and never round up.
+    SkScalar bucket = GrTriangulationCache::BucketTolerance(0.25f);
+    REPORTER_ASSERT(reporter, bucket == 0.25f);
+    REPORTER_ASSERT(reporter, GrTriangulationCache::BucketTolerance(0.26f) == bucket);
+    for (float tol = 0.001f; tol < 100; tol *= 1.01f) {
+        REPORTER_ASSERT(reporter, GrTriangulationCache::BucketTolerance(tol) <= tol);
+        REPORTER_ASSERT(reporter, GrTriangulationCache::BucketTolerance(tol) > tol * 0.8f);
+    }
+
+    const SkPoint tris[] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 1}, {1, 2}};
+    sk_sp<SkData> data = GrTriangulationCache::PackVertices(*key, path, tris, 6, sizeof(SkPoint),
+                                                            true);
+    const void* vertices;
+    int vertexCount;
+    size_t vertexStride;
+    bool isLinear = false;
+    REPORTER_ASSERT(reporter, GrTriangulationCache::UnpackVertices(*data, *key, path, &vertices,
+                                                                   &vertexCount, &vertexStride,
+                                                                   &isLinear));
+    REPORTER_ASSERT(reporter, vertexCount == 6 && vertexStride == sizeof(SkPoint) && isLinear);
+    REPORTER_ASSERT(reporter, !memcmp(vertices, tris, sizeof(tris)));
+
+    // Truncated or partial triangle data is rejected, wherever it is cut off.
+    for (size_t size = 0; size < data->size(); ++size) {
+        sk_sp<SkData> truncated = SkData::MakeSubset(data.get(), 0, size);
+        REPORTER_ASSERT(reporter, !GrTriangulationCache::UnpackVertices(*truncated, *key, path,
+                                                                        &vertices, &vertexCount,
+                                                                        &vertexStride, &isLinear),
+                        "size %zu", size);
+    }
+    sk_sp<SkData> partial = GrTriangulationCache::PackVertices(*key, path, tris, 5,
+                                                               sizeof(SkPoint), false);
+    REPORTER_ASSERT(reporter, !GrTriangulationCache::UnpackVertices(*partial, *key, path,
+                                                                    &vertices, &vertexCount,
+                                                                    &vertexStride, &isLinear));
+
+    // Data stored for another path is rejected, even if it is found under the same key (as it
+    // would be after a hash collision).
+    REPORTER_ASSERT(reporter, !GrTriangulationCache::UnpackVertices(*data, *key, moved,
+                                                                    &vertices, &vertexCount,
+                                                                    &vertexStride, &isLinear));
+    sk_sp<SkData> otherKey = GrTriangulationCache::MakeKey(path, 0.5f, false, clip);
+    REPORTER_ASSERT(reporter, !GrTriangulationCache::UnpackVertices(*data, *otherKey, path,
+                                                                    &vertices, &vertexCount,
+                                                                    &vertexStride, &isLinear));
+}
 #endif
 
 // Test that deleting the original path invalidates the textures cached by the SW path renderer
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkColor.h"
 #include "include/core/SkStream.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkStringView.h"
@@ -13,6 +14,8 @@
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
 #include "tests/Test.h"
 
+#include <vector>
+
 static sk_sp<SkData> get_program_dump(SkSL::RP::Program& program) {
     SkDynamicMemoryWStream stream;
     program.dump(&stream);
@@ -762,3 +765,333 @@ DEF_TEST(RasterPipelineBuilderAutomaticStackRewinding, r) {
     REPORTER_ASSERT(r, skstd::contains(as_string_view(dump), "stack_rewind"));
 #endif
 }
+
+DEF_TEST(RasterPipelineBuilderOptimizer, r) {
+    using BuilderOp = SkSL::RP::BuilderOp;
+
+    // Create a program with a literal operand, a redundant copy, and slots with short lifetimes.
+    SkSL::RP::Builder builder;
+    builder.store_src_rg(two_slots_at(0));
+    builder.push_slots(one_slot_at(0));
+    builder.push_literal_f(2.0f);
+    builder.binary_op(BuilderOp::add_n_floats, 1);
+    builder.pop_slots_unmasked(one_slot_at(2));     // v2 = v0 + 2
+    builder.push_slots(one_slot_at(2));
+    builder.pop_slots_unmasked(one_slot_at(3));     // v3 = v2
+    builder.push_slots(one_slot_at(3));
+    builder.push_slots(one_slot_at(1));
+    builder.binary_op(BuilderOp::mul_n_floats, 1);
+    builder.pop_slots_unmasked(one_slot_at(4));     // v4 = v3 * v1
+    builder.push_literal_f(0.0f);
+    builder.pop_slots_unmasked(one_slot_at(5));     // v5 = 0
+    builder.push_slots(one_slot_at(4));
+    builder.push_literal_f(1.0f);
+    builder.binary_op(BuilderOp::min_n_floats, 1);
+    builder.pop_slots_unmasked(one_slot_at(6));     // v6 = min(v4, 1)
+    builder.load_src(four_slots_at(3));
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/7,
+                                                                /*numUniformSlots=*/0,
+                                                                /*debugTrace=*/nullptr,
+                                                                /*optimize=*/true);
+    check(r, *program,
+R"(    1. store_src_rg                   v0..1 = src.rg
+    2. copy_slot_unmasked             $0 = v0
+    3. add_imm_float                  $0 += 0x40000000 (2.0)
+    4. copy_slot_unmasked             v2 = $0
+    5. copy_slot_unmasked             $1 = v1
+    6. mul_float                      $0 *= $1
+    7. copy_slot_unmasked             v3 = $0
+    8. zero_slot_unmasked             v4 = 0
+    9. copy_slot_unmasked             $0 = v3
+   10. min_imm_float                  $0 = min($0, 0x3F800000 (1.0))
+   11. copy_slot_unmasked             v5 = $0
+   12. load_src                       src.rgba = v2..5
+)");
+}
+
+#if !defined(SKSL_STANDALONE)
+// Runs `program` over a row of pixels whose starting colors are `src`, and returns the results.
+static std::vector<SkColor4f> run(const SkSL::RP::Program& program,
+                                  const std::vector<SkColor4f>& src) {
+    std::vector<SkColor4f> dst(src.size());
+    SkRasterPipeline_MemoryCtx srcCtx{const_cast<SkColor4f*>(src.data()), /*stride=*/0};
+    SkRasterPipeline_MemoryCtx dstCtx{dst.data(), /*stride=*/0};
+
+    SkArenaAlloc alloc(/*firstHeapAllocation=*/1000);
+    SkRasterPipeline pipeline(&alloc);
+    pipeline.append(SkRasterPipelineOp::load_f32, &srcCtx);
+    program.appendStages(&pipeline, &alloc, /*callbacks=*/nullptr, /*uniforms=*/{});
+    pipeline.append(SkRasterPipelineOp::store_f32, &dstCtx);
+    pipeline.run(0, 0, src.size(), 1);
+    return dst;
+}
+
+static void check_results(skiatest::Reporter* r,
+                          const std::vector<SkColor4f>& actual,
+                          const std::vector<SkColor4f>& expected) {
+    for (size_t index = 0; index < expected.size(); ++index) {
+        REPORTER_ASSERT(r, actual[index] == expected[index],
+                        "pixel %zu: got (%g %g %g %g), expected (%g %g %g %g)", index,
+                        actual[index].fR, actual[index].fG, actual[index].fB, actual[index].fA,
+                        expected[index].fR, expected[index].fG, expected[index].fB,
+                        expected[index].fA);
+    }
+}
+
+DEF_TEST(RasterPipelineBuilderOptimizerBranches, r) {
+    using BuilderOp = SkSL::RP::BuilderOp;
+
+    // v2 is written before an `if` and read inside and after it. v3 is only written inside the
+    // `if`, under the condition mask, so its value from before the `if` must survive for the lanes
+    // which skip it. v4 is overwritten inside the `if` without the mask, so its value from before
+    // the `if` is only seen when every lane branches past it.
+    auto makeProgram = [](bool optimize) {
+        SkSL::RP::Builder builder;
+        int skipLabelID = builder.nextLabelID();
+        builder.store_src_rg(two_slots_at(0));
+        builder.init_lane_masks();
+        builder.enableExecutionMaskWrites();
+        builder.push_slots(one_slot_at(0));
+        builder.push_literal_f(1.0f);
+        builder.binary_op(BuilderOp::add_n_floats, 1);
+        builder.pop_slots_unmasked(one_slot_at(2));     // v2 = v0 + 1
+        builder.push_literal_f(-1.0f);
+        builder.pop_slots_unmasked(one_slot_at(3));     // v3 = -1
+        builder.push_literal_f(-2.0f);
+        builder.pop_slots_unmasked(one_slot_at(4));     // v4 = -2
+        builder.push_condition_mask();
+        builder.push_slots(one_slot_at(0));
+        builder.push_literal_f(0.5f);
+        builder.binary_op(BuilderOp::cmplt_n_floats, 1);
+        builder.merge_condition_mask();                 // if (v0 < 0.5) {
+        builder.branch_if_no_active_lanes(skipLabelID);
+        builder.push_slots(one_slot_at(1));
+        builder.push_literal_f(3.0f);
+        builder.binary_op(BuilderOp::mul_n_floats, 1);
+        builder.pop_slots_unmasked(one_slot_at(4));     //     v4 = v1 * 3 (in every lane)
+        builder.push_slots(one_slot_at(4));
+        builder.push_slots(one_slot_at(2));
+        builder.binary_op(BuilderOp::add_n_floats, 1);
+        builder.pop_slots(one_slot_at(3));              //     v3 = v4 + v2
+        builder.label(skipLabelID);                     // }
+        builder.discard_stack(1);
+        builder.pop_condition_mask();
+        builder.disableExecutionMaskWrites();
+        builder.push_slots(one_slot_at(2));
+        builder.push_slots(one_slot_at(3));
+        builder.push_slots(one_slot_at(4));
+        builder.push_literal_f(1.0f);
+        builder.pop_slots_unmasked(four_slots_at(5));   // v5..8 = (v2, v3, v4, 1)
+        builder.load_src(four_slots_at(5));
+        return builder.finish(/*numValueSlots=*/9,
+                              /*numUniformSlots=*/0,
+                              /*debugTrace=*/nullptr,
+                              optimize);
+    };
+    std::unique_ptr<SkSL::RP::Program> program = makeProgram(/*optimize=*/true);
+    check(r, *program,
+R"(    1. store_src_rg                   v0..1 = src.rg
+    2. init_lane_masks                CondMask = LoopMask = RetMask = true
+    3. copy_slot_unmasked             $0 = v0
+    4. add_imm_float                  $0 += 0x3F800000 (1.0)
+    5. copy_slot_unmasked             v2 = $0
+    6. copy_constant                  v3 = 0xBF800000 (-1.0)
+    7. copy_constant                  v4 = 0xC0000000 (-2.0)
+    8. store_condition_mask           $0 = CondMask
+    9. copy_slot_unmasked             $1 = v0
+   10. cmplt_imm_float                $1 = lessThan($1, 0x3F000000 (0.5))
+   11. merge_condition_mask           CondMask = $0 & $1
+   12. branch_if_no_active_lanes      branch_if_no_active_lanes +7 (label 0 at #19)
+   13. copy_slot_unmasked             $2 = v1
+   14. mul_imm_float                  $2 *= 0x40400000 (3.0)
+   15. copy_slot_unmasked             v4 = $2
+   16. copy_slot_unmasked             $3 = v2
+   17. add_float                      $2 += $3
+   18. copy_slot_masked               v3 = Mask($2)
+   19. label                          label 0x00000000
+   20. load_condition_mask            CondMask = $0
+   21. copy_3_slots_unmasked          v5..7 = v2..4
+   22. copy_constant                  v8 = 0x3F800000 (1.0)
+   23. load_src                       src.rgba = v5..8
+)");
+
+    // Run pixels which take the `if` and pixels which branch past it, one at a time.
+    std::vector<SkColor4f> src = {{0.25f, 0.5f, 0, 1}, {0.75f, 0.5f, 0, 1},
+                                  {0.0f, 0.25f, 0, 1}, {1.0f, 0.25f, 0, 1}};
+    std::vector<SkColor4f> expected = {{1.25f, 2.75f, 1.5f, 1}, {1.75f, -1.0f, -2.0f, 1},
+                                       {1.0f, 1.75f, 0.75f, 1}, {2.0f, -1.0f, -2.0f, 1}};
+    for (size_t index = 0; index < src.size(); ++index) {
+        check_results(r, run(*program, {src[index]}), {expected[index]});
+    }
+
+    // When lanes disagree, the result depends on how many pixels run together, so only compare
+    // against the unoptimized program.
+    check_results(r, run(*program, src), run(*makeProgram(/*optimize=*/false), src));
+}
+
+DEF_TEST(RasterPipelineBuilderOptimizerLoops, r) {
+    using BuilderOp = SkSL::RP::BuilderOp;
+
+    // v2 is written before the loop and only read after it, so it must stay live across the whole
+    // loop. v3 (the sum) and v6 (the counter) are carried around the back edge; v11 is written in
+    // the loop condition after the counter's last read there, so it must not take the counter's
+    // slot. v5 is written inside the loop and read after it. v4 is only used after the loop, so
+    // it can take over the slot of a value which is dead by then.
+    auto makeProgram = [](bool optimize) {
+        SkSL::RP::Builder builder;
+        int bodyLabelID = builder.nextLabelID();
+        int conditionLabelID = builder.nextLabelID();
+        builder.store_src_rg(two_slots_at(0));
+        builder.init_lane_masks();
+        builder.enableExecutionMaskWrites();
+        builder.zero_slots_unmasked(one_slot_at(6));    // v6 = 0
+        builder.push_slots(one_slot_at(0));
+        builder.push_literal_f(2.0f);
+        builder.binary_op(BuilderOp::mul_n_floats, 1);
+        builder.pop_slots_unmasked(one_slot_at(2));     // v2 = v0 * 2
+        builder.zero_slots_unmasked(one_slot_at(3));    // v3 = 0
+        builder.zero_slots_unmasked(one_slot_at(5));    // v5 = 0
+        builder.push_loop_mask();
+        builder.jump(conditionLabelID);                 // for (; v6 < v0 * 4; v6 += 1) {
+        builder.label(bodyLabelID);
+        builder.push_slots(one_slot_at(1));
+        builder.push_literal_f(0.25f);
+        builder.binary_op(BuilderOp::add_n_floats, 1);
+        builder.pop_slots(one_slot_at(5));              //     v5 = v1 + 0.25
+        builder.push_slots(one_slot_at(3));
+        builder.push_slots(one_slot_at(5));
+        builder.binary_op(BuilderOp::add_n_floats, 1);
+        builder.pop_slots(one_slot_at(3));              //     v3 += v5
+        builder.push_slots(one_slot_at(6));
+        builder.push_literal_f(1.0f);
+        builder.binary_op(BuilderOp::add_n_floats, 1);
+        builder.pop_slots(one_slot_at(6));              //     v6 += 1
+        builder.label(conditionLabelID);
+        builder.push_slots(one_slot_at(6));
+        builder.push_slots(one_slot_at(0));
+        builder.push_literal_f(4.0f);
+        builder.binary_op(BuilderOp::mul_n_floats, 1);
+        builder.pop_slots_unmasked(one_slot_at(11));    //     v11 = v0 * 4
+        builder.push_slots(one_slot_at(11));
+        builder.push_slots(one_slot_at(11));
+        builder.binary_op(BuilderOp::max_n_floats, 1);
+        builder.binary_op(BuilderOp::cmplt_n_floats, 1);
+        builder.merge_loop_mask();
+        builder.discard_stack(1);
+        builder.branch_if_any_active_lanes(bodyLabelID);
+        builder.pop_loop_mask();                        // }
+        builder.disableExecutionMaskWrites();
+        builder.push_slots(one_slot_at(0));
+        builder.push_slots(one_slot_at(1));
+        builder.binary_op(BuilderOp::add_n_floats, 1);
+        builder.pop_slots_unmasked(one_slot_at(4));     // v4 = v0 + v1
+        builder.push_slots(one_slot_at(2));
+        builder.push_slots(one_slot_at(3));
+        builder.push_slots(one_slot_at(5));
+        builder.push_slots(one_slot_at(4));
+        builder.pop_slots_unmasked(four_slots_at(7));   // v7..10 = (v2, v3, v5, v4)
+        builder.load_src(four_slots_at(7));
+        return builder.finish(/*numValueSlots=*/12,
+                              /*numUniformSlots=*/0,
+                              /*debugTrace=*/nullptr,
+                              optimize);
+    };
+#if SK_HAS_MUSTTAIL
+    static constexpr char kExpectation[] =
+R"(    1. store_src_rg                   v0..1 = src.rg
+    2. init_lane_masks                CondMask = LoopMask = RetMask = true
+    3. zero_slot_unmasked             v2 = 0
+    4. copy_slot_unmasked             $0 = v0
+    5. mul_imm_float                  $0 *= 0x40000000 (2.0)
+    6. copy_slot_unmasked             v3 = $0
+    7. zero_slot_unmasked             v4 = 0
+    8. zero_slot_unmasked             v5 = 0
+    9. store_loop_mask                $0 = LoopMask
+   10. jump                           jump +12 (label 1 at #22)
+   11. label                          label 0x00000000
+   12. copy_slot_unmasked             $1 = v1
+   13. add_imm_float                  $1 += 0x3E800000 (0.25)
+   14. copy_slot_masked               v5 = Mask($1)
+   15. copy_slot_unmasked             $1 = v4
+   16. copy_slot_unmasked             $2 = v5
+   17. add_float                      $1 += $2
+   18. copy_slot_masked               v4 = Mask($1)
+   19. copy_slot_unmasked             $1 = v2
+   20. add_imm_float                  $1 += 0x3F800000 (1.0)
+   21. copy_slot_masked               v2 = Mask($1)
+   22. label                          label 0x00000001
+   23. copy_slot_unmasked             $1 = v2
+   24. copy_slot_unmasked             $2 = v0
+   25. mul_imm_float                  $2 *= 0x40800000 (4.0)
+   26. copy_slot_unmasked             v6 = $2
+   27. copy_slot_unmasked             $3 = v6
+   28. max_float                      $2 = max($2, $3)
+   29. cmplt_float                    $1 = lessThan($1, $2)
+   30. merge_loop_mask                LoopMask &= $1
+   31. branch_if_any_active_lanes     branch_if_any_active_lanes -20 (label 0 at #11)
+   32. load_loop_mask                 LoopMask = $0
+   33. copy_2_slots_unmasked          $0..1 = v0..1
+   34. add_float                      $0 += $1
+   35. copy_slot_unmasked             v6 = $0
+   36. copy_2_slots_unmasked          v7..8 = v3..4
+   37. copy_slot_unmasked             v9 = v5
+   38. copy_slot_unmasked             v10 = v6
+   39. load_src                       src.rgba = v7..10
+)";
+#else
+    // We don't have guaranteed tail-calling, so the stack is rewound before the backward branch.
+    static constexpr char kExpectation[] =
+R"(    1. store_src_rg                   v0..1 = src.rg
+    2. init_lane_masks                CondMask = LoopMask = RetMask = true
+    3. zero_slot_unmasked             v2 = 0
+    4. copy_slot_unmasked             $0 = v0
+    5. mul_imm_float                  $0 *= 0x40000000 (2.0)
+    6. copy_slot_unmasked             v3 = $0
+    7. zero_slot_unmasked             v4 = 0
+    8. zero_slot_unmasked             v5 = 0
+    9. store_loop_mask                $0 = LoopMask
+   10. jump                           jump +12 (label 1 at #22)
+   11. label                          label 0x00000000
+   12. copy_slot_unmasked             $1 = v1
+   13. add_imm_float                  $1 += 0x3E800000 (0.25)
+   14. copy_slot_masked               v5 = Mask($1)
+   15. copy_slot_unmasked             $1 = v4
+   16. copy_slot_unmasked             $2 = v5
+   17. add_float                      $1 += $2
+   18. copy_slot_masked               v4 = Mask($1)
+   19. copy_slot_unmasked             $1 = v2
+   20. add_imm_float                  $1 += 0x3F800000 (1.0)
+   21. copy_slot_masked               v2 = Mask($1)
+   22. label                          label 0x00000001
+   23. copy_slot_unmasked             $1 = v2
+   24. copy_slot_unmasked             $2 = v0
+   25. mul_imm_float                  $2 *= 0x40800000 (4.0)
+   26. copy_slot_unmasked             v6 = $2
+   27. copy_slot_unmasked             $3 = v6
+   28. max_float                      $2 = max($2, $3)
+   29. cmplt_float                    $1 = lessThan($1, $2)
+   30. merge_loop_mask                LoopMask &= $1
+   31. stack_rewind
+   32. branch_if_any_active_lanes     branch_if_any_active_lanes -21 (label 0 at #11)
+   33. load_loop_mask                 LoopMask = $0
+   34. copy_2_slots_unmasked          $0..1 = v0..1
+   35. add_float                      $0 += $1
+   36. copy_slot_unmasked             v6 = $0
+   37. copy_2_slots_unmasked          v7..8 = v3..4
+   38. copy_slot_unmasked             v9 = v5
+   39. copy_slot_unmasked             v10 = v6
+   40. load_src                       src.rgba = v7..10
+)";
+#endif
+    std::unique_ptr<SkSL::RP::Program> program = makeProgram(/*optimize=*/true);
+    check(r, *program, kExpectation);
+
+    // The lanes run the loop 0, 1, 2 and 3 times.
+    std::vector<SkColor4f> src = {{0.0f, 0.5f, 0, 1}, {0.25f, 0.5f, 0, 1},
+                                  {0.5f, 0.25f, 0, 1}, {0.75f, 0.0f, 0, 1}};
+    std::vector<SkColor4f> expected = {{0.0f, 0.0f, 0.0f, 0.5f}, {0.5f, 0.75f, 0.75f, 0.75f},
+                                       {1.0f, 1.0f, 0.5f, 0.75f}, {1.5f, 0.75f, 0.25f, 0.75f}};
+    check_results(r, run(*program, src), expected);
+    check_results(r, run(*makeProgram(/*optimize=*/false), src), expected);
+}
+#endif
@@ -25,6 +25,7 @@
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrResourceAllocator.h"
 #include "src/gpu/ganesh/GrResourceCache.h"
@@ -545,3 +546,84 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ResourceAllocatorMemoryBudgetTest,
         }
     }
 }
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ResourceAllocatorPeakBytesTest,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    constexpr size_t  kRGBA64Bytes = 4 * 64 * 64;
+    const ProxyParams kProxy64     = {64, kRT, kRGBA, kE, 1, kB, kDeferred};
+
+    struct {
+        const char*        fName;
+        size_t             fPeakBytes;
+        SkTArray<Interval> fIntervals;
+    } tests[] = {
+        {"empty DAG", 0, {}},
+        {"single", kRGBA64Bytes, {{kProxy64, 0, 2}}},
+        {"overlapping", 2 * kRGBA64Bytes, {{kProxy64, 0, 2}, {kProxy64, 1, 3}}},
+        {"shared", kRGBA64Bytes, {{kProxy64, 0, 2}, {kProxy64, 3, 5}}},
+        {"shared pairs", 2 * kRGBA64Bytes,
+            {
+                {kProxy64, 0, 2},
+                {kProxy64, 1, 3},
+                {kProxy64, 4, 6},
+                {kProxy64, 5, 7},
+            }},
+    };
+    for (auto& test : tests) {
+        reporter->push(SkString(test.fName));
+        GrResourceAllocator alloc(dContext);
+        for (Interval& interval : test.fIntervals) {
+            interval.fProxy = make_proxy(dContext, interval.fParams);
+            for (int i = interval.fStart; i <= interval.fEnd; i++) {
+                alloc.incOps();
+            }
+            alloc.addInterval(interval.fProxy.get(), interval.fStart, interval.fEnd,
+                              GrResourceAllocator::ActualUse::kYes);
+        }
+        REPORTER_ASSERT(reporter, alloc.planAssignment());
+        REPORTER_ASSERT(reporter, alloc.peakBytes() == test.fPeakBytes,
+                        "%zu", alloc.peakBytes());
+        REPORTER_ASSERT(reporter, alloc.assign());
+        reporter->pop();
+    }
+}
+
+// Each flush reports its own peak, so a small flush after a large one is not hidden.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ResourceAllocatorFlushPeakBytesTest,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+#if GR_GPU_STATS
+    auto dContext = ctxInfo.directContext();
+    GrGpu::Stats* stats = dContext->priv().getGpu()->stats();
+
+    SkImageInfo ii = SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(dContext, skgpu::Budgeted::kYes, ii);
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    dContext->flushAndSubmit();
+    dContext->priv().resetGpuStats();
+
+    // A layer needs a deferred render target for the length of the flush.
+    canvas->saveLayer(nullptr, nullptr);
+    canvas->drawColor(SK_ColorRED);
+    canvas->restore();
+    dContext->flushAndSubmit();
+    // The surface itself is already instantiated, so it isn't counted.
+    canvas->drawColor(SK_ColorBLUE);
+    dContext->flushAndSubmit();
+
+    const GrGpu::Stats::FlushPeakBytes& peaks = stats->flushPeakBytes();
+    REPORTER_ASSERT(reporter, peaks.fFlushes == 2, "%d", peaks.fFlushes);
+    REPORTER_ASSERT(reporter, peaks.fMax > 0);
+    REPORTER_ASSERT(reporter, peaks.fLast == 0, "%zu", peaks.fLast);
+    REPORTER_ASSERT(reporter, peaks.fTotal == peaks.fMax);
+#endif
+}
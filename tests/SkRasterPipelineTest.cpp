@@ -1417,6 +1417,75 @@ DEF_TEST(SkRasterPipeline_CompareIntsWithHardcodedSlots, r) {
     }
 }
 
+DEF_TEST(SkRasterPipeline_BinaryOpsWithImmediates, r) {
+    // Allocate space for 2 slots; only the first one should be affected.
+    alignas(64) float slots[2 * SkRasterPipeline_kMaxStride_highp];
+    const int N = SkOpts::raster_pipeline_highp_stride;
+
+    struct ImmediateOp {
+        SkRasterPipelineOp stage;
+        bool isFloat;
+        std::function<int(int, int)> verify;
+    };
+
+    // Comparisons produce ~0 for true and 0 for false, so `-int(bool)` gives the expected mask.
+    auto f = [](int a) { return sk_bit_cast<float>(a); };
+    auto i = [](float a) { return sk_bit_cast<int>(a); };
+
+    const ImmediateOp kImmediateOps[] = {
+        {SkRasterPipelineOp::add_imm_float,   true,  [&](int a, int b) { return i(f(a) + f(b)); }},
+        {SkRasterPipelineOp::mul_imm_float,   true,  [&](int a, int b) { return i(f(a) * f(b)); }},
+        {SkRasterPipelineOp::min_imm_float,   true,  [&](int a, int b) {
+                                                         return i(std::min(f(a), f(b))); }},
+        {SkRasterPipelineOp::max_imm_float,   true,  [&](int a, int b) {
+                                                         return i(std::max(f(a), f(b))); }},
+        {SkRasterPipelineOp::cmplt_imm_float, true,  [&](int a, int b) {
+                                                         return -int(f(a) < f(b)); }},
+        {SkRasterPipelineOp::cmple_imm_float, true,  [&](int a, int b) {
+                                                         return -int(f(a) <= f(b)); }},
+        {SkRasterPipelineOp::cmpeq_imm_float, true,  [&](int a, int b) {
+                                                         return -int(f(a) == f(b)); }},
+        {SkRasterPipelineOp::cmpne_imm_float, true,  [&](int a, int b) {
+                                                         return -int(f(a) != f(b)); }},
+
+        {SkRasterPipelineOp::add_imm_int,     false, [&](int a, int b) { return a + b; }},
+        {SkRasterPipelineOp::mul_imm_int,     false, [&](int a, int b) { return a * b; }},
+        {SkRasterPipelineOp::cmplt_imm_int,   false, [&](int a, int b) { return -int(a <  b); }},
+        {SkRasterPipelineOp::cmple_imm_int,   false, [&](int a, int b) { return -int(a <= b); }},
+        {SkRasterPipelineOp::cmpeq_imm_int,   false, [&](int a, int b) { return -int(a == b); }},
+        {SkRasterPipelineOp::cmpne_imm_int,   false, [&](int a, int b) { return -int(a != b); }},
+    };
+
+    for (const ImmediateOp& op : kImmediateOps) {
+        for (int immValue : {-2, 0, 3}) {
+            // Initialize the slot values to -2,-1,0,1,2... (as floats, for the float ops).
+            for (int index = 0; index < 2 * N; ++index) {
+                int value = (index % 5) - 2;
+                slots[index] = op.isFloat ? (float)value : f(value);
+            }
+
+            SkRasterPipeline_ConstantCtx ctx;
+            ctx.dst = &slots[0];
+            ctx.value = op.isFloat ? i((float)immValue) : immValue;
+
+            // Run the op over our data.
+            SkArenaAlloc alloc(/*firstHeapAllocation=*/256);
+            SkRasterPipeline p(&alloc);
+            p.append(op.stage, &ctx);
+            p.run(0, 0, 1, 1);
+
+            // Verify that the first slot now contains "(-2,-1,0,1,2...) op imm", and the second
+            // slot is untouched.
+            for (int index = 0; index < 2 * N; ++index) {
+                int value = (index % 5) - 2;
+                int original = op.isFloat ? i((float)value) : value;
+                int expected = (index < N) ? op.verify(original, ctx.value) : original;
+                REPORTER_ASSERT(r, i(slots[index]) == expected);
+            }
+        }
+    }
+}
+
 static int to_float(int a) { return sk_bit_cast<int>((float)a); }
 
 DEF_TEST(SkRasterPipeline_UnaryIntOps, r) {
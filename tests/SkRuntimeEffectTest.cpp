@@ -14,6 +14,8 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
@@ -50,6 +52,7 @@
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/SurfaceFillContext.h"
 #include "src/gpu/ganesh/effects/GrSkSLFP.h"
+#include "src/sksl/SkSLModuleLoader.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
@@ -119,6 +122,55 @@ DEF_TEST(SkRuntimeEffectInvalid_SkCapsDisallowed, r) {
             "name 'sk_Caps' is reserved");
 }
 
+DEF_TEST(SkRuntimeEffect_Cache, r) {
+    const SkString sksl("half4 main(float2 p) { return half4(0.125, 0.25, 0.5, 1); }");
+
+    auto [first, firstError] = SkRuntimeEffect::MakeForShader(sksl);
+    REPORTER_ASSERT(r, first, "%s", firstError.c_str());
+    const int hits = SkRuntimeEffectPriv::GetCacheStats().fHits;
+
+    // The same source and options return the cached effect.
+    auto [second, secondError] = SkRuntimeEffect::MakeForShader(sksl);
+    REPORTER_ASSERT(r, second.get() == first.get());
+    REPORTER_ASSERT(r, SkRuntimeEffectPriv::GetCacheStats().fHits > hits);
+
+    // Different options or program kinds are compiled separately.
+    SkRuntimeEffect::Options options;
+    options.forceUnoptimized = true;
+    auto [unoptimized, unoptimizedError] = SkRuntimeEffect::MakeForShader(sksl, options);
+    REPORTER_ASSERT(r, unoptimized && unoptimized.get() != first.get());
+
+    // Failures are not cached.
+    auto [bad, badError] = SkRuntimeEffect::MakeForShader(SkString("half4 main() {}"));
+    REPORTER_ASSERT(r, !bad && !badError.isEmpty());
+}
+
+DEF_TEST(SkRuntimeEffect_WarmUpModules, r) {
+    // Once warm-up has finished (destroying the pool waits for it), a runtime effect compile on
+    // this thread finds every module it needs already loaded.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkGraphics::WarmUpSkSLModules(executor.get());
+    executor.reset();
+    int modulesCompiled = SkSL::ModuleLoader::ModulesCompiledOnThisThread();
+    auto [warmEffect, warmError] = SkRuntimeEffect::MakeForShader(SkString(
+            "half4 main(float2 p) { return half4(0, vec2(p), 1); }"));
+    REPORTER_ASSERT(r, warmEffect, "%s", warmError.c_str());
+    REPORTER_ASSERT(r, SkSL::ModuleLoader::ModulesCompiledOnThisThread() == modulesCompiled,
+                    "compiled %d modules after warm-up",
+                    SkSL::ModuleLoader::ModulesCompiledOnThisThread() - modulesCompiled);
+
+    // Compiles on this thread must be able to run while the modules are warming up on a pool.
+    executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkGraphics::WarmUpSkSLModules(executor.get());
+    auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(
+            "half4 main(float2 p) { return half4(vec2(p), 0, 1); }"));
+    REPORTER_ASSERT(r, effect, "%s", error.c_str());
+    executor.reset();
+
+    // A null executor loads them using the default (synchronous) executor.
+    SkGraphics::WarmUpSkSLModules(nullptr);
+}
+
 DEF_TEST(SkRuntimeEffect_DeadCodeEliminationStackOverflow, r) {
     // Verify that a deeply-nested loop does not cause stack overflow during SkVM dead-code
     // elimination.
@@ -1288,6 +1340,97 @@ DEF_TEST(SkRuntimeColorFilterSingleColor, r) {
     REPORTER_ASSERT(r, c.fA == 1.0f);
 }
 
+DEF_TEST(SkRuntimeEffectNativeKernel, r) {
+    // Native kernels are normally generated by skslc; these are written by hand, and deliberately
+    // produce a different color than their SkSL so that we can tell which one ran. The registry is
+    // global and kernels match on the exact SkSL text, so the comments keep these kernels from
+    // being picked up by effects in other tests that are running at the same time.
+    static const SkRuntimeEffectPriv::NativeKernel kShaderKernel = {
+        "// SkRuntimeEffectNativeKernel\n"
+        "half4 main(float2 p) { return half4(1, 0, 0, 1); }",
+        [](const float*, float* rgba, int count) {
+            for (int i = 0; i < count; ++i, rgba += 4) {
+                rgba[0] = 0; rgba[1] = 1; rgba[2] = 0; rgba[3] = 1;
+            }
+        },
+    };
+    static const SkRuntimeEffectPriv::NativeKernel kColorFilterKernel = {
+        "// SkRuntimeEffectNativeKernel\n"
+        "uniform half scale; half4 main(half4 c) { return c * scale; }",
+        [](const float* uniforms, float* rgba, int count) {
+            for (int i = 0; i < count; ++i, rgba += 4) {
+                rgba[0] = rgba[1] = rgba[2] = 0;
+                rgba[3] = uniforms[0];
+            }
+        },
+    };
+
+    // Registers a kernel for the lifetime of this object, so that it can't outlive the test even
+    // if the test bails out early.
+    class ScopedNativeKernel {
+    public:
+        explicit ScopedNativeKernel(const SkRuntimeEffectPriv::NativeKernel* kernel)
+                : fKernel(kernel) {
+            SkRuntimeEffectPriv::RegisterNativeKernel(fKernel);
+        }
+        ~ScopedNativeKernel() { SkRuntimeEffectPriv::UnregisterNativeKernel(fKernel); }
+
+    private:
+        const SkRuntimeEffectPriv::NativeKernel* fKernel;
+    };
+
+    sk_sp<SkSurface> surface = SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(2, 2));
+    auto draw = [&](const SkPaint& paint) {
+        surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+        surface->getCanvas()->drawPaint(paint);
+        SkColor color;
+        SkImageInfo info = SkImageInfo::Make(1, 1, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType);
+        surface->readPixels(info, &color, sizeof(color), 1, 1);
+        return color;
+    };
+
+    auto shaderEffect = SkRuntimeEffect::MakeForShader(SkString(kShaderKernel.fSkSL)).effect;
+    REPORTER_ASSERT(r, shaderEffect);
+    SkPaint shaderPaint;
+    shaderPaint.setShader(shaderEffect->makeShader(/*uniforms=*/nullptr, /*children=*/{}));
+
+    auto filterEffect =
+            SkRuntimeEffect::MakeForColorFilter(SkString(kColorFilterKernel.fSkSL)).effect;
+    REPORTER_ASSERT(r, filterEffect);
+    float scale = 1.0f;
+    SkPaint filterPaint;
+    // Use a shader so that the filter isn't folded into the paint color.
+    filterPaint.setShader(SkShaders::Color(SK_ColorWHITE));
+    filterPaint.setColorFilter(
+            filterEffect->makeColorFilter(SkData::MakeWithCopy(&scale, sizeof(scale))));
+
+    REPORTER_ASSERT(r, !SkRuntimeEffectPriv::FindNativeKernel(*shaderEffect));
+    REPORTER_ASSERT(r, draw(shaderPaint) == SK_ColorRED);
+    REPORTER_ASSERT(r, draw(filterPaint) == SK_ColorWHITE);
+
+    {
+        ScopedNativeKernel shaderKernel(&kShaderKernel);
+        ScopedNativeKernel colorFilterKernel(&kColorFilterKernel);
+        REPORTER_ASSERT(r, SkRuntimeEffectPriv::FindNativeKernel(*shaderEffect) == &kShaderKernel);
+        REPORTER_ASSERT(r, SkRuntimeEffectPriv::FindNativeKernel(*filterEffect) ==
+                           &kColorFilterKernel);
+        REPORTER_ASSERT(r, draw(shaderPaint) == SK_ColorGREEN);
+        REPORTER_ASSERT(r, draw(filterPaint) == SK_ColorBLACK);
+
+        // Effects with the same SkSL pick up the kernel; different SkSL does not.
+        auto sameEffect = SkRuntimeEffect::MakeForShader(SkString(kShaderKernel.fSkSL)).effect;
+        REPORTER_ASSERT(r, SkRuntimeEffectPriv::FindNativeKernel(*sameEffect) == &kShaderKernel);
+        auto otherEffect = SkRuntimeEffect::MakeForShader(SkStringPrintf("%s ",
+                                                                         kShaderKernel.fSkSL))
+                                   .effect;
+        REPORTER_ASSERT(r, !SkRuntimeEffectPriv::FindNativeKernel(*otherEffect));
+    }
+
+    REPORTER_ASSERT(r, !SkRuntimeEffectPriv::FindNativeKernel(*shaderEffect));
+    REPORTER_ASSERT(r, draw(shaderPaint) == SK_ColorRED);
+    REPORTER_ASSERT(r, draw(filterPaint) == SK_ColorWHITE);
+}
+
 static void test_RuntimeEffectStructNameReuse(skiatest::Reporter* r, GrRecordingContext* rContext) {
     // Test that two different runtime effects can reuse struct names in a single paint operation
     auto [childEffect, err] = SkRuntimeEffect::MakeForShader(SkString(
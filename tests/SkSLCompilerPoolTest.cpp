@@ -0,0 +1,54 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSpan.h"
+#include "include/private/SkSLProgramKind.h"
+#include "src/sksl/SkSLCompilerPool.h"
+#include "src/sksl/SkSLUtil.h"
+#include "tests/Test.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+DEF_TEST(SkSLCompilerPool_Batch, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkSL::CompilerPool pool(SkSL::ShaderCapsFactory::Default(), executor.get());
+
+    // A mix of valid and invalid programs; odd requests fail to compile.
+    std::vector<SkSL::CompileRequest> requests;
+    for (int i = 0; i < 16; ++i) {
+        std::string src = (i & 1) ? "half4 main(float2 p) { return undeclared; }"
+                                   : "uniform half4 c; half4 main(float2 p) { return c * " +
+                                             std::to_string(i) + "; }";
+        requests.push_back({SkSL::ProgramKind::kRuntimeShader,
+                            std::move(src),
+                            SkSL::CompileTarget::kRasterPipeline});
+    }
+
+    std::vector<std::future<SkSL::CompileResult>> futures = pool.compile(requests);
+    REPORTER_ASSERT(r, futures.size() == requests.size());
+    for (size_t i = 0; i < futures.size(); ++i) {
+        SkSL::CompileResult result = futures[i].get();
+        if (i & 1) {
+            REPORTER_ASSERT(r, !result.fSuccess);
+            REPORTER_ASSERT(r, result.fOutput.empty());
+            REPORTER_ASSERT(r, result.fErrors.find("undeclared") != std::string::npos,
+                            "%s", result.fErrors.c_str());
+        } else {
+            REPORTER_ASSERT(r, result.fSuccess, "%s", result.fErrors.c_str());
+            REPORTER_ASSERT(r, !result.fOutput.empty());
+        }
+    }
+
+    // A synchronous compile must match what the pool produced.
+    SkSL::CompileResult now = pool.compileNow(requests[0]);
+    REPORTER_ASSERT(r, now.fSuccess);
+    REPORTER_ASSERT(r, now.fOutput == pool.compile(requests[0]).get().fOutput);
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -12,6 +13,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypeface.h"
+#include "src/core/SkGlyph.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
@@ -19,6 +21,9 @@
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <cstdint>
+#include <cstring>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -57,6 +62,55 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
         REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
     }
     REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_SerializeStrikes, Reporter) {
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(SkTypeface::MakeDefault());
+    font.setSize(18);
 
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    SkPackedGlyphID packedIDs[26];
+    for (int i = 0; i < 26; ++i) {
+        packedIDs[i] = SkPackedGlyphID{font.unicharToGlyph('a' + i)};
+    }
+    const SkGlyph* glyphs[26];
+
+    SkStrikeCache cache;
+    strikeSpec.findOrCreateStrike(&cache)->prepareImages(packedIDs, glyphs);
+
+    sk_sp<SkData> data = cache.serializeStrikes(SIZE_MAX);
+    REPORTER_ASSERT(Reporter, data != nullptr);
+
+    // Truncated data is rejected.
+    SkStrikeCache truncatedCache;
+    REPORTER_ASSERT(Reporter, truncatedCache.prepopulate(data->data(), data->size() / 2) == -1);
+
+    // The default typeface may not be found by the font manager, in which case nothing is loaded.
+    SkStrikeCache loadedCache;
+    int strikeCount = loadedCache.prepopulate(data->data(), data->size());
+    REPORTER_ASSERT(Reporter, strikeCount == 0 || strikeCount == 1);
+    if (strikeCount == 1) {
+        REPORTER_ASSERT(Reporter, loadedCache.getCacheCountUsed() == 1);
+        const SkGlyph* loadedGlyphs[26];
+        strikeSpec.findOrCreateStrike(&loadedCache)->prepareImages(packedIDs, loadedGlyphs);
+        for (int i = 0; i < 26; ++i) {
+            REPORTER_ASSERT(Reporter, glyphs[i]->imageSize() == loadedGlyphs[i]->imageSize());
+            if (glyphs[i]->image() != nullptr &&
+                glyphs[i]->imageSize() == loadedGlyphs[i]->imageSize()) {
+                REPORTER_ASSERT(Reporter, 0 == memcmp(glyphs[i]->image(),
+                                                      loadedGlyphs[i]->image(),
+                                                      glyphs[i]->imageSize()));
+            }
+        }
+    }
 
+    // Nothing is written beyond the header when there is no room.
+    sk_sp<SkData> empty = cache.serializeStrikes(0);
+    REPORTER_ASSERT(Reporter, cache.prepopulate(empty->data(), empty->size()) == 0);
 }
@@ -18,6 +18,7 @@
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkZip.h"
 #include "src/core/SkEnumerate.h"
 #include "src/core/SkGlyph.h"
@@ -28,14 +29,17 @@
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/text/StrikeForGPU.h"
+#include "src/text/gpu/SDFMaskFilter.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
 #include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <vector>
 
 using namespace sktext;
 using namespace skglyph;
@@ -131,3 +135,164 @@ DEF_TEST(SkStrikeMultiThread, Reporter) {
         SkTaskGroup(*executor).batch(kThreadCount, perThread);
     }
 }
+
+DEF_TEST(SkStrikeParallelImages, Reporter) {
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Italic());
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+    font.setTypeface(typeface);
+    font.setSize(24);
+
+    SkPackedGlyphID packedIDs[2 * ('z' - ' ')];
+    int count = 0;
+    for (int c = ' '; c < 'z'; c++) {
+        SkGlyphID glyphID = font.unicharToGlyph(c);
+        packedIDs[count++] = SkPackedGlyphID{glyphID};
+        // Include a few duplicates.
+        if (c % 5 == 0) {
+            packedIDs[count++] = SkPackedGlyphID{glyphID};
+        }
+    }
+    SkSpan<const SkPackedGlyphID> glyphIDs{packedIDs, SkToSizeT(count)};
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    SkStrikeCache serialCache;
+    SkStrike serialStrike{&serialCache, strikeSpec, strikeSpec.createScalerContext(), nullptr,
+                          nullptr};
+    std::unique_ptr<const SkGlyph*[]> serialGlyphs{new const SkGlyph*[count]};
+    serialStrike.prepareImages(glyphIDs, serialGlyphs.get());
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkStrikeCache parallelCache;
+    parallelCache.setRasterExecutor(executor.get());
+    SkStrike parallelStrike{&parallelCache, strikeSpec, strikeSpec.createScalerContext(), nullptr,
+                            nullptr};
+    std::unique_ptr<const SkGlyph*[]> parallelGlyphs{new const SkGlyph*[count]};
+    parallelStrike.prepareImages(glyphIDs, parallelGlyphs.get());
+
+    for (int i = 0; i < count; ++i) {
+        const SkGlyph* serial = serialGlyphs[i];
+        const SkGlyph* parallel = parallelGlyphs[i];
+        REPORTER_ASSERT(Reporter, serial->imageSize() == parallel->imageSize());
+        REPORTER_ASSERT(Reporter, parallel->setImageHasBeenCalled());
+        if (serial->image() != nullptr && serial->imageSize() == parallel->imageSize()) {
+            REPORTER_ASSERT(Reporter, parallel->image() != nullptr);
+            REPORTER_ASSERT(Reporter,
+                            0 == memcmp(serial->image(), parallel->image(), serial->imageSize()));
+        }
+    }
+}
+
+#if (defined(SK_GANESH) || defined(SK_GRAPHITE)) && !defined(SK_DISABLE_SDF_TEXT)
+// A strike whose glyphs are distance fields generates all of a batch's fields at once on the
+// executor. They must match the fields getImage() makes one glyph at a time, as a strike without an
+// executor does.
+DEF_TEST(SkStrikeParallelDistanceFieldImages, Reporter) {
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal());
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(typeface);
+    font.setSize(32);
+
+    SkPackedGlyphID packedIDs['z' - ' '];
+    int count = 0;
+    for (int c = ' '; c < 'z'; c++) {
+        packedIDs[count++] = SkPackedGlyphID{font.unicharToGlyph(c)};
+    }
+    SkSpan<const SkPackedGlyphID> glyphIDs{packedIDs, SkToSizeT(count)};
+
+    SkPaint sdfPaint;
+    sdfPaint.setMaskFilter(sktext::gpu::SDFMaskFilter::Make());
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, sdfPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    SkArenaAlloc alloc{4096};
+    std::unique_ptr<SkScalerContext> context = strikeSpec.createScalerContext();
+    std::vector<SkGlyph> expected;
+    for (SkPackedGlyphID packedID : glyphIDs) {
+        SkGlyph& glyph = expected.emplace_back(context->makeGlyph(packedID, &alloc));
+        glyph.setImage(&alloc, context.get());
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkExecutor* exec : {(SkExecutor*)nullptr, executor.get()}) {
+        SkStrikeCache cache;
+        cache.setRasterExecutor(exec);
+        SkStrike strike{&cache, strikeSpec, strikeSpec.createScalerContext(), nullptr, nullptr};
+        std::unique_ptr<const SkGlyph*[]> glyphs{new const SkGlyph*[count]};
+        strike.prepareImages(glyphIDs, glyphs.get());
+
+        for (int i = 0; i < count; ++i) {
+            const SkGlyph* glyph = glyphs[i];
+            REPORTER_ASSERT(Reporter, glyph->maskFormat() == expected[i].maskFormat());
+            REPORTER_ASSERT(Reporter, glyph->imageSize() == expected[i].imageSize());
+            if (expected[i].isEmpty() || glyph->imageSize() != expected[i].imageSize()) {
+                continue;
+            }
+            REPORTER_ASSERT(Reporter, glyph->setImageHasBeenCalled());
+            REPORTER_ASSERT(Reporter, glyph->image() != nullptr);
+            REPORTER_ASSERT(Reporter,
+                            0 == memcmp(expected[i].image(), glyph->image(), glyph->imageSize()),
+                            "glyph %d", i);
+        }
+    }
+}
+#endif
+
+// Waiting on the executor may run other queued work on the waiting thread. When that work needs
+// the same strike, it must not find the strike locked.
+DEF_TEST(SkStrikeParallelImagesSharedExecutor, Reporter) {
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Normal());
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(typeface);
+    font.setSize(36);
+
+    SkPackedGlyphID packedIDs['z' - ' '];
+    int count = 0;
+    for (int c = ' '; c < 'z'; c++) {
+        packedIDs[count++] = SkPackedGlyphID{font.unicharToGlyph(c)};
+    }
+    SkSpan<const SkPackedGlyphID> glyphIDs{packedIDs, SkToSizeT(count)};
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    // A single thread, so the tasks queued below are still waiting when prepareImages() waits.
+    auto executor = SkExecutor::MakeFIFOThreadPool(1);
+    SkStrikeCache cache;
+    cache.setRasterExecutor(executor.get());
+    SkStrike strike{&cache, strikeSpec, strikeSpec.createScalerContext(), nullptr, nullptr};
+
+    static constexpr int kTaskCount = 4;
+    std::unique_ptr<const SkGlyph*[]> taskGlyphs{new const SkGlyph*[kTaskCount * count]};
+    SkTaskGroup group{*executor};
+    for (int i = 0; i < kTaskCount; ++i) {
+        group.add([&, i] { strike.prepareImages(glyphIDs, &taskGlyphs[i * count]); });
+    }
+
+    std::unique_ptr<const SkGlyph*[]> glyphs{new const SkGlyph*[count]};
+    strike.prepareImages(glyphIDs, glyphs.get());
+    group.wait();
+
+    for (int i = 0; i < count; ++i) {
+        REPORTER_ASSERT(Reporter, glyphs[i]->setImageHasBeenCalled());
+        for (int task = 0; task < kTaskCount; ++task) {
+            REPORTER_ASSERT(Reporter, taskGlyphs[task * count + i] == glyphs[i]);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTypes.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+#include <memory>
+
+static constexpr int kSize = 256;
+
+// A star with 'points' points. Each one is a different shape, so it gets its own distance field.
+static SkPath make_star(int points) {
+    SkPath path;
+    for (int i = 0; i < 2 * points; ++i) {
+        SkScalar radius = (i & 1) ? 12 : 30;
+        SkScalar angle = i * SK_ScalarPI / points;
+        SkPoint p = {32 + radius * SkScalarCos(angle), 32 + radius * SkScalarSin(angle)};
+        i ? path.lineTo(p) : path.moveTo(p);
+    }
+    path.close();
+    return path;
+}
+
+// Draws stars that are large enough on the device for SmallPathRenderer to use distance fields.
+static SkBitmap draw_stars(GrDirectContext* dContext) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(kSize, kSize);
+    sk_sp<SkSurface> surface =
+            SkSurface::MakeRenderTarget(dContext, skgpu::Budgeted::kNo, info);
+    SkBitmap bitmap;
+    if (!surface) {
+        return bitmap;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int points = 3; points < 11; ++points) {
+        paint.setColor(SkColorSetARGB(0xFF, 0x20 * points, 0, 0xFF - 0x18 * points));
+        canvas->save();
+        canvas->translate((points % 4) * 48.f, (points / 4) * 64.f);
+        canvas->scale(3, 3);
+        canvas->drawPath(make_star(points), paint);
+        canvas->restore();
+    }
+
+    bitmap.allocPixels(info);
+    if (!surface->readPixels(bitmap, 0, 0)) {
+        bitmap.reset();
+    }
+    return bitmap;
+}
+
+// With an executor, SmallPathRenderer generates the distance fields of all of an op's new shapes
+// up front, in parallel. The result must match generating them one at a time as they are drawn.
+DEF_GANESH_TEST(SmallPathRendererParallelDistanceFields, reporter, baseOptions,
+                CtsEnforcement::kNever) {
+    GrContextOptions serialOptions = baseOptions;
+    serialOptions.fGpuPathRenderers = GpuPathRenderers::kSmall;
+    serialOptions.fExecutor = nullptr;
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    GrContextOptions parallelOptions = serialOptions;
+    parallelOptions.fExecutor = executor.get();
+
+    for (int ct = 0; ct < sk_gpu_test::GrContextFactory::kContextTypeCnt; ++ct) {
+        auto contextType = static_cast<sk_gpu_test::GrContextFactory::ContextType>(ct);
+        if (!sk_gpu_test::GrContextFactory::IsRenderingContext(contextType)) {
+            continue;
+        }
+        sk_gpu_test::GrContextFactory serialFactory(serialOptions);
+        sk_gpu_test::GrContextFactory parallelFactory(parallelOptions);
+        GrDirectContext* serialContext = serialFactory.get(contextType);
+        GrDirectContext* parallelContext = parallelFactory.get(contextType);
+        if (!serialContext || !parallelContext) {
+            continue;
+        }
+
+        SkBitmap serial = draw_stars(serialContext);
+        SkBitmap parallel = draw_stars(parallelContext);
+        if (serial.drawsNothing() || parallel.drawsNothing()) {
+            continue;
+        }
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                if (serial.getColor(x, y) != parallel.getColor(x, y)) {
+                    ERRORF(reporter, "context %d: (%d, %d) is 0x%08x, expected 0x%08x",
+                           ct, x, y, parallel.getColor(x, y), serial.getColor(x, y));
+                    return;
+                }
+            }
+        }
+    }
+}
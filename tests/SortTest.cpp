@@ -43,6 +43,8 @@ DEF_TEST(Sort, reporter) {
     /** The random numbers are copied into this array, sorted by an SkSort,
         then this array is compared against the reference sort. */
     int workingArray[std::size(randomArray)];
+    /** Scratch space for the radix sort. */
+    int scratchArray[std::size(randomArray)];
     SkRandom    rand;
 
     for (int i = 0; i < 10000; i++) {
@@ -60,6 +62,18 @@ DEF_TEST(Sort, reporter) {
         memcpy(workingArray, randomArray, sizeof(randomArray));
         SkTQSort<int>(workingArray, workingArray + count);
         check_sort(reporter, "Quick", workingArray, sortedArray, count);
+
+        auto lessThan = [](int a, int b) { return a < b; };
+        memcpy(workingArray, randomArray, sizeof(randomArray));
+        SkTRadixSort(workingArray, scratchArray, count, [](int v) { return (uint32_t)v; },
+                     lessThan);
+        check_sort(reporter, "Radix", workingArray, sortedArray, count);
+
+        // A coarser digit leaves several values in each bucket.
+        memcpy(workingArray, randomArray, sizeof(randomArray));
+        SkTRadixSort(workingArray, scratchArray, count, [](int v) { return (uint32_t)v >> 4; },
+                     lessThan);
+        check_sort(reporter, "RadixBucket", workingArray, sortedArray, count);
     }
 }
 
@@ -348,3 +348,57 @@ DEF_TEST(chartoglyph_cache, reporter) {
         }
     }
 }
+
+DEF_TEST(chartoglyph_cache_findglyphs, reporter) {
+    SkCharToGlyphCache cache;
+
+    // A mix of unichars inside and outside of the BMP, spread over several pages.
+    SkUnichar chars[200];
+    SkGlyphID glyphs[200];
+    for (int i = 0; i < 200; ++i) {
+        chars[i] = (i & 1) ? 0x10000 + i * 97 : i * 331;
+        glyphs[i] = 0;
+    }
+
+    REPORTER_ASSERT(reporter, cache.findGlyphs(chars, 200, glyphs) == 0);
+    for (int i = 0; i < 200; ++i) {
+        cache.addCharAndGlyph(chars[i], hash_to_glyph(chars[i]));
+        REPORTER_ASSERT(reporter, cache.count() == i + 1);
+        REPORTER_ASSERT(reporter, cache.findGlyphs(chars, 200, glyphs) == i + 1);
+    }
+    for (int i = 0; i < 200; ++i) {
+        REPORTER_ASSERT(reporter, glyphs[i] == hash_to_glyph(chars[i]));
+        REPORTER_ASSERT(reporter, cache.findGlyphIndex(chars[i]) == hash_to_glyph(chars[i]));
+    }
+
+    cache.reset();
+    REPORTER_ASSERT(reporter, cache.count() == 0);
+    REPORTER_ASSERT(reporter, cache.findGlyphIndex(chars[0]) < 0);
+}
+
+// SkTypeface_FreeType resets its cache once otherCount() passes its cap of 512. A CJK working set
+// of thousands of BMP unichars must not count toward that, or the pages would keep being dropped.
+DEF_TEST(chartoglyph_cache_bmp_count, reporter) {
+    constexpr int kMaxOtherCount = 512;
+    SkCharToGlyphCache cache;
+
+    for (SkUnichar c = 0x4E00; c < 0x4E00 + 4000; ++c) {
+        cache.addCharAndGlyph(c, hash_to_glyph(c));
+    }
+    for (int i = 0; i < 100; ++i) {
+        cache.addCharAndGlyph(0x20000 + i, hash_to_glyph(0x20000 + i));
+    }
+    REPORTER_ASSERT(reporter, cache.count() == 4100);
+    REPORTER_ASSERT(reporter, cache.otherCount() == 100);
+    REPORTER_ASSERT(reporter, cache.otherCount() <= kMaxOtherCount);
+
+    SkUnichar chars[4000];
+    SkGlyphID glyphs[4000];
+    for (int i = 0; i < 4000; ++i) {
+        chars[i] = 0x4E00 + i;
+    }
+    REPORTER_ASSERT(reporter, cache.findGlyphs(chars, 4000, glyphs) == 4000);
+    for (int i = 0; i < 4000; ++i) {
+        REPORTER_ASSERT(reporter, glyphs[i] == hash_to_glyph(chars[i]));
+    }
+}
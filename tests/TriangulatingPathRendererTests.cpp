@@ -9,6 +9,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
@@ -51,12 +52,16 @@
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -1356,4 +1361,107 @@ DEF_TEST(TriangulatorBugs, r) {
     test_crbug_1262444(r);
 }
 
+static SkPath make_star_grid(SkRandom* rand, int count) {
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        SkScalar cx = (i % 20) * 40, cy = (i / 20) * 40;
+        int points = 5 + rand->nextULessThan(20);
+        for (int j = 0; j < points; ++j) {
+            SkScalar angle = j * 2 * SK_ScalarPI / points;
+            SkScalar radius = (j & 1) ? 8 : 16;
+            SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+            if (j == 0) {
+                path.moveTo(pt);
+            } else if (j % 3 == 0) {
+                path.quadTo(pt + SkVector{3, 3}, pt);
+            } else {
+                path.lineTo(pt);
+            }
+        }
+        path.close();
+        if (rand->nextBool()) {
+            path.addCircle(cx + 5, cy, 6);
+        }
+    }
+    return path;
+}
+
+static sk_sp<GrThreadSafeCache::VertexData> triangulate(const SkPath& path,
+                                                        const SkRect& clipBounds, bool aa,
+                                                        SkExecutor* executor) {
+    GrCpuVertexAllocator allocator;
+    bool isLinear;
+    int count = aa ? GrAATriangulator::PathToAATrianglesParallel(path, 0.25f, clipBounds,
+                                                                 &allocator, executor)
+                   : GrTriangulator::PathToTrianglesParallel(path, 0.25f, clipBounds,
+                                                             &allocator, &isLinear, executor);
+    return count ? allocator.detachVertexData() : nullptr;
+}
+
+static std::vector<std::array<SkPoint, 3>> sorted_triangles(
+        const GrThreadSafeCache::VertexData& data) {
+    std::vector<std::array<SkPoint, 3>> triangles(data.numVertices() / 3);
+    memcpy(triangles.data(), data.vertices(), triangles.size() * sizeof(triangles[0]));
+    std::sort(triangles.begin(), triangles.end(), [](const auto& a, const auto& b) {
+        return memcmp(a.data(), b.data(), sizeof(a)) < 0;
+    });
+    return triangles;
+}
+
+// Triangulating the disjoint components of a path concurrently gives the serial triangles, in an
+// order that does not depend on scheduling.
+DEF_TEST(TriangulatorParallel, r) {
+    SkRandom rand;
+    SkPath path = make_star_grid(&rand, 400);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (bool aa : {false, true}) {
+        const SkRect& clip = path.getBounds();
+        sk_sp<GrThreadSafeCache::VertexData> serial = triangulate(path, clip, aa, nullptr);
+        sk_sp<GrThreadSafeCache::VertexData> parallel =
+                triangulate(path, clip, aa, executor.get());
+        sk_sp<GrThreadSafeCache::VertexData> again = triangulate(path, clip, aa, executor.get());
+        if (!serial || !parallel || !again) {
+            ERRORF(r, "triangulation failed (aa: %d)", aa);
+            continue;
+        }
+        REPORTER_ASSERT(r, parallel->size() == again->size() &&
+                           !memcmp(parallel->vertices(), again->vertices(), parallel->size()));
+        if (!aa) {
+            // The alpha ramps of the AA triangulator may be split differently, so only compare
+            // the plain triangulations exactly.
+            REPORTER_ASSERT(r, sorted_triangles(*serial) == sorted_triangles(*parallel));
+        }
+    }
+
+    // A rotated path's bounds are left dirty by transform(), as TriangulatingPathRenderer leaves
+    // them. Nothing computes them before the parallel entry points, so only the calling thread may
+    // (TSAN reports it otherwise).
+    const SkMatrix rotate = SkMatrix::RotateDeg(30);
+    const SkRect clip = SkRect::MakeLTRB(-1000, -1000, 2000, 2000);
+    for (bool aa : {false, true}) {
+        SkPath rotated;
+        path.transform(rotate, &rotated);
+        sk_sp<GrThreadSafeCache::VertexData> parallel =
+                triangulate(rotated, clip, aa, executor.get());
+        path.transform(rotate, &rotated);
+        sk_sp<GrThreadSafeCache::VertexData> serial = triangulate(rotated, clip, aa, nullptr);
+        if (!serial || !parallel) {
+            ERRORF(r, "rotated triangulation failed (aa: %d)", aa);
+            continue;
+        }
+        if (!aa) {
+            REPORTER_ASSERT(r, sorted_triangles(*serial) == sorted_triangles(*parallel));
+        }
+    }
+
+    // Inverse fills are not split.
+    path.toggleInverseFillType();
+    const SkRect& inverseClip = path.getBounds();
+    sk_sp<GrThreadSafeCache::VertexData> serial = triangulate(path, inverseClip, false, nullptr);
+    sk_sp<GrThreadSafeCache::VertexData> parallel =
+            triangulate(path, inverseClip, false, executor.get());
+    REPORTER_ASSERT(r, serial && parallel && serial->size() == parallel->size() &&
+                       !memcmp(serial->vertices(), parallel->vertices(), serial->size()));
+}
+
 #endif // SK_ENABLE_OPTIMIZE_SIZE
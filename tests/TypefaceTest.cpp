@@ -38,6 +38,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include <utility>
 
 #if defined(SK_BUILD_FOR_WIN)
@@ -595,6 +596,48 @@ DEF_TEST(Typeface_glyph_to_char, reporter) {
     }
 }
 
+// The UTF-8 and UTF-16 decoding takes a vectorized path for runs of ASCII (or non-surrogate)
+// text, so mix those runs with multi-byte characters at every alignment.
+DEF_TEST(Typeface_textToGlyphs_encodings, reporter) {
+    SkFont font(ToolUtils::emoji_typeface(), 12);
+    const char* emoji = ToolUtils::emoji_sample_text();
+
+    SkString text;
+    for (int i = 0; i < 40; ++i) {
+        text.append("The quick brown fox ", i % 21);
+        text.append(emoji);
+        text.append("\xC3\xA9\xE2\x82\xAC");  // U+00E9 U+20AC
+    }
+
+    const int count = SkUTF::CountUTF8(text.c_str(), text.size());
+    REPORTER_ASSERT(reporter, count > 0);
+
+    std::vector<SkUnichar> utf32(count);
+    const char* ptr = text.c_str();
+    for (int i = 0; i < count; ++i) {
+        utf32[i] = SkUTF::NextUTF8(&ptr, text.c_str() + text.size());
+    }
+    std::vector<uint16_t> utf16;
+    for (SkUnichar c : utf32) {
+        uint16_t units[2];
+        size_t n = SkUTF::ToUTF16(c, units);
+        utf16.insert(utf16.end(), units, units + n);
+    }
+
+    std::vector<SkGlyphID> expected(count), glyphs(count);
+    font.unicharsToGlyphs(utf32.data(), count, expected.data());
+
+    REPORTER_ASSERT(reporter, count == font.textToGlyphs(text.c_str(), text.size(),
+                                                         SkTextEncoding::kUTF8,
+                                                         glyphs.data(), count));
+    REPORTER_ASSERT(reporter, glyphs == expected);
+
+    REPORTER_ASSERT(reporter, count == font.textToGlyphs(utf16.data(), utf16.size() * 2,
+                                                         SkTextEncoding::kUTF16,
+                                                         glyphs.data(), count));
+    REPORTER_ASSERT(reporter, glyphs == expected);
+}
+
 // This test makes sure the legacy typeface creation does not lose its specified
 // style. See https://bugs.chromium.org/p/skia/issues/detail?id=8447 for more
 // context.
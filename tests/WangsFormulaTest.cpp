@@ -322,6 +322,40 @@ DEF_TEST(wangs_formula_vectorXforms, r) {
     });
 }
 
+// Ensure the four-wide versions match evaluating each curve on its own.
+DEF_TEST(wangs_formula_x4, r) {
+    SkRandom rand;
+    for_random_matrices(&rand, [&](const SkMatrix& m) {
+        wangs_formula::VectorXform xform(m);
+        for (int numPoints : {3, 4}) {
+            SkPoint curves[4][4];
+            int n = 0;
+            for_random_beziers(numPoints, &rand, [&](const SkPoint pts[]) {
+                std::copy(pts, pts + numPoints, curves[n]);
+                if (++n < 4) {
+                    return;
+                }
+                n = 0;
+                skvx::float4 x[4], y[4];
+                for (int i = 0; i < numPoints; ++i) {
+                    x[i] = {curves[0][i].fX, curves[1][i].fX, curves[2][i].fX, curves[3][i].fX};
+                    y[i] = {curves[0][i].fY, curves[1][i].fY, curves[2][i].fY, curves[3][i].fY};
+                }
+                skvx::float4 n4 = numPoints == 4
+                        ? wangs_formula::cubic_p4(kPrecision, x, y, xform)
+                        : wangs_formula::quadratic_p4(kPrecision, x, y, xform);
+                for (int j = 0; j < 4; ++j) {
+                    float expected = numPoints == 4
+                            ? wangs_formula::cubic_p4(kPrecision, curves[j], xform)
+                            : wangs_formula::quadratic_p4(kPrecision, curves[j], xform);
+                    REPORTER_ASSERT(r, SkScalarNearlyEqual(n4[j], expected, expected * 1e-5f),
+                                    "%g != %g", n4[j], expected);
+                }
+            });
+        }
+    });
+}
+
 DEF_TEST(wangs_formula_worst_case_cubic, r) {
     {
         SkPoint worstP[] = {{0,0}, {100,100}, {0,0}, {0,0}};
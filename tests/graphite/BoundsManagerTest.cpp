@@ -7,6 +7,7 @@
 
 #include "tests/Test.h"
 
+#include "src/base/SkRandom.h"
 #include "src/gpu/graphite/geom/BoundsManager.h"
 
 namespace skgpu::graphite {
@@ -47,4 +48,35 @@ DEF_TEST(BoundsManager, r) {
     // TODO: Then test calls where the new value is not larger than the current max
 }
 
+// The hierarchical grid is exact, so it must always agree with the brute force search. Include
+// draws that span many cells, cover the whole device, or lie partly or fully off of it.
+DEF_TEST(BoundsManagerHierarchicalGrid, r) {
+    const SkISize deviceSize = {1000, 600};
+    std::unique_ptr<BoundsManager> grid = HierarchicalGridBoundsManager::Make(deviceSize, 16);
+    BruteForceBoundsManager bruteForce;
+
+    SkRandom rand;
+    for (int frame = 0; frame < 3; ++frame) {
+        for (int i = 0; i < 2000; ++i) {
+            float maxSize = rand.nextBool() ? 40.f : 1200.f;
+            Rect b = Rect::XYWH(rand.nextRangeF(-100, 1100), rand.nextRangeF(-100, 700),
+                                rand.nextRangeF(1, maxSize), rand.nextRangeF(1, maxSize));
+
+            CompressedPaintersOrder expected = bruteForce.getMostRecentDraw(b);
+            CompressedPaintersOrder actual = grid->getMostRecentDraw(b);
+            REPORTER_ASSERT(r, actual == expected, "draw %d: %u vs %u",
+                            i, actual.bits(), expected.bits());
+
+            // Sometimes record an order below the current max, as ClipStack may.
+            CompressedPaintersOrder order = rand.nextBool() ? expected.next() : expected;
+            grid->recordDraw(b, order);
+            bruteForce.recordDraw(b, order);
+        }
+        grid->reset();
+        bruteForce.reset();
+        REPORTER_ASSERT(r, grid->getMostRecentDraw(Rect::WH(1000, 600)) ==
+                           CompressedPaintersOrder::First());
+    }
+}
+
 }  // namespace skgpu::graphite
@@ -182,3 +182,36 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(KeyBlockReaderWorks, reporter, context) {
     REPORTER_ASSERT(reporter, readerBytesZ.size() == kCountZ);
     REPORTER_ASSERT(reporter, 0 == memcmp(readerBytesZ.data(), kDataZ, sizeof(kDataZ)));
 }
+
+// Keys built by different builders (e.g. on different Recorders) share one dictionary entry.
+DEF_TEST(KeyInterningAcrossBuilders, reporter) {
+    ShaderCodeDictionary dict;
+    static const int kBlockDataSize = 4;
+    static constexpr PaintParamsKey::DataPayloadField kDataFields[] = {
+            {"data", PaintParamsKey::DataPayloadType::kByte, kBlockDataSize},
+    };
+    int userSnippetID = dict.addUserDefinedSnippet("key", kDataFields);
+
+    static constexpr uint8_t kData [kBlockDataSize] = {1, 2, 3, 4};
+    static constexpr uint8_t kData2[kBlockDataSize] = {1, 2, 3, 99};
+
+    auto findOrCreate = [&](SkSpan<const uint8_t> data) {
+        PaintParamsKeyBuilder builder(&dict);
+        builder.beginBlock(userSnippetID);
+        builder.addBytes(data.size(), data.data());
+        builder.endBlock();
+        return dict.findOrCreate(&builder)->uniqueID();
+    };
+
+    UniquePaintParamsID idA = findOrCreate(kData);
+    UniquePaintParamsID idB = findOrCreate(kData);
+    UniquePaintParamsID idC = findOrCreate(kData2);
+    REPORTER_ASSERT(reporter, idA.isValid() && idC.isValid());
+    REPORTER_ASSERT(reporter, idA == idB);
+    REPORTER_ASSERT(reporter, idA != idC);
+    REPORTER_ASSERT(reporter, dict.lookup(idA)->uniqueID() == idA);
+
+    ShaderCodeDictionary::Stats stats = dict.stats();
+    REPORTER_ASSERT(reporter, stats.fHits == 1);
+    REPORTER_ASSERT(reporter, stats.fMisses == 2);
+}
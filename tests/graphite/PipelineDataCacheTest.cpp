@@ -68,3 +68,58 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(PipelineDataCacheTest, reporter, context) {
 
     // TODO(robertphillips): expand this test to exercise all the UDB comparison failure modes
 }
+
+// Caches backed by the same SharedUniformDataCache (e.g. on different Recorders) share blocks
+// until the shared budget runs out, and the shared blocks are freed once every cache is gone.
+DEF_TEST(PipelineDataCacheSharedTest, reporter) {
+    static const int kSize = 16;
+    static const char kMemory1[kSize] = {
+            7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22
+    };
+    static const char kMemory2[kSize] = {
+            6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21
+    };
+    UniformDataBlock udb1(SkSpan(kMemory1, kSize));
+    UniformDataBlock udb2(SkSpan(kMemory2, kSize));
+
+    // Room for exactly one block
+    SharedUniformDataCache shared(/*maxBytes=*/sizeof(UniformDataBlock) + kSize);
+    {
+        UniformDataCache cacheA(&shared);
+        UniformDataCache cacheB(&shared);
+
+        const UniformDataBlock* idA1 = cacheA.insert(udb1);
+        REPORTER_ASSERT(reporter, idA1 && *idA1 == udb1);
+        REPORTER_ASSERT(reporter, cacheA.insert(udb1) == idA1);  // found locally, not in 'shared'
+
+        const UniformDataBlock* idB1 = cacheB.insert(udb1);
+        REPORTER_ASSERT(reporter, idB1 == idA1);
+        REPORTER_ASSERT(reporter, !shared.isSaturated());
+
+        // The second block does not fit, so each cache keeps its own copy. The first miss
+        // saturates 'shared', so the second cache does not look it up at all.
+        const UniformDataBlock* idA2 = cacheA.insert(udb2);
+        REPORTER_ASSERT(reporter, shared.isSaturated());
+        const UniformDataBlock* idB2 = cacheB.insert(udb2);
+        REPORTER_ASSERT(reporter, idA2 && *idA2 == udb2);
+        REPORTER_ASSERT(reporter, idB2 && *idB2 == udb2);
+        REPORTER_ASSERT(reporter, idA2 != idB2);
+        REPORTER_ASSERT(reporter, cacheA.count() == 2 && cacheB.count() == 2);
+
+        SharedUniformDataCache::Stats stats = shared.stats();
+        REPORTER_ASSERT(reporter, stats.fHits == 1);
+        REPORTER_ASSERT(reporter, stats.fMisses == 2);
+        REPORTER_ASSERT(reporter, shared.count() == 1);
+        REPORTER_ASSERT(reporter, shared.bytes() == sizeof(UniformDataBlock) + kSize);
+    }
+
+    // Both caches released the shared block, which frees it and makes room again.
+    REPORTER_ASSERT(reporter, shared.count() == 0);
+    REPORTER_ASSERT(reporter, shared.bytes() == 0);
+    REPORTER_ASSERT(reporter, !shared.isSaturated());
+
+    UniformDataCache cacheC(&shared);
+    const UniformDataBlock* idC2 = cacheC.insert(udb2);
+    REPORTER_ASSERT(reporter, idC2 && *idC2 == udb2);
+    REPORTER_ASSERT(reporter, shared.count() == 1);
+}
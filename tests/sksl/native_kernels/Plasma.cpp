@@ -0,0 +1,112 @@
+/*
+ * This file was autogenerated by skslc. Do not edit.
+ */
+
+#include "src/base/SkVx.h"
+#include "src/core/SkRuntimeEffectPriv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+using F = skvx::Vec<8, float>;
+using I = skvx::Vec<8, int32_t>;
+
+F sk_cos(F x) { return skvx::map([](float v) { return std::cos(v); }, x); }
+
+F sk_sin(F x) { return skvx::map([](float v) { return std::sin(v); }, x); }
+
+constexpr char kSkSL[] = R"SkSL(uniform float time;
+uniform half4 colorA;
+uniform half4 colorB;
+
+half4 main(float2 p) {
+    float v = 0;
+    for (int i = 1; i <= 4; i++) {
+        float scale = 0.02 * float(i);
+        v += sin(p.x * scale + time) * cos(p.y * scale - time);
+    }
+    v = v * 0.125 + 0.5;
+    return mix(colorA, colorB, half(v));
+}
+)SkSL";
+
+void run(const float* uniforms, float* rgba, int count) {
+    const auto t0 = F(*(uniforms + 0));
+    const auto t1 = F(*(uniforms + 1));
+    const auto t2 = F(*(uniforms + 2));
+    const auto t3 = F(*(uniforms + 3));
+    const auto t4 = F(*(uniforms + 4));
+    const auto t5 = F(*(uniforms + 5));
+    const auto t6 = F(*(uniforms + 6));
+    const auto t7 = F(*(uniforms + 7));
+    const auto t8 = F(*(uniforms + 8));
+    for (int start = 0; start < count; start += 8) {
+        const int n = std::min(8, count - start);
+        float px[4 * 8] = {};
+        memcpy(px, rgba + 4 * start, 4 * n * sizeof(float));
+        F r, g, b, a;
+        skvx::strided_load4(px, r, g, b, a);
+        const auto t9 = skvx::cast<float>(I(1));
+        const auto t10 = F(0.0199999996f) * t9;
+        const auto t11 = r * t10;
+        const auto t12 = t11 + t0;
+        const auto t13 = sk_sin(t12);
+        const auto t14 = g * t10;
+        const auto t15 = t14 - t0;
+        const auto t16 = sk_cos(t15);
+        const auto t17 = t13 * t16;
+        const auto t18 = F(0.0f) + t17;
+        const auto t19 = skvx::cast<float>(I(2));
+        const auto t20 = F(0.0199999996f) * t19;
+        const auto t21 = r * t20;
+        const auto t22 = t21 + t0;
+        const auto t23 = sk_sin(t22);
+        const auto t24 = g * t20;
+        const auto t25 = t24 - t0;
+        const auto t26 = sk_cos(t25);
+        const auto t27 = t23 * t26;
+        const auto t28 = t18 + t27;
+        const auto t29 = skvx::cast<float>(I(3));
+        const auto t30 = F(0.0199999996f) * t29;
+        const auto t31 = r * t30;
+        const auto t32 = t31 + t0;
+        const auto t33 = sk_sin(t32);
+        const auto t34 = g * t30;
+        const auto t35 = t34 - t0;
+        const auto t36 = sk_cos(t35);
+        const auto t37 = t33 * t36;
+        const auto t38 = t28 + t37;
+        const auto t39 = skvx::cast<float>(I(4));
+        const auto t40 = F(0.0199999996f) * t39;
+        const auto t41 = r * t40;
+        const auto t42 = t41 + t0;
+        const auto t43 = sk_sin(t42);
+        const auto t44 = g * t40;
+        const auto t45 = t44 - t0;
+        const auto t46 = sk_cos(t45);
+        const auto t47 = t43 * t46;
+        const auto t48 = t38 + t47;
+        const auto t49 = t48 * F(0.125f);
+        const auto t50 = t49 + F(0.5f);
+        const auto t51 = t1 + (t5 - t1) * t50;
+        const auto t52 = t2 + (t6 - t2) * t50;
+        const auto t53 = t3 + (t7 - t3) * t50;
+        const auto t54 = t4 + (t8 - t4) * t50;
+        for (int i = 0; i < 8; ++i) {
+            px[4 * i + 0] = t51[i];
+            px[4 * i + 1] = t52[i];
+            px[4 * i + 2] = t53[i];
+            px[4 * i + 3] = t54[i];
+        }
+        memcpy(rgba + 4 * start, px, 4 * n * sizeof(float));
+    }
+}
+
+}  // namespace
+
+extern const SkRuntimeEffectPriv::NativeKernel gNativeKernel_Plasma;
+const SkRuntimeEffectPriv::NativeKernel gNativeKernel_Plasma = {kSkSL, run};
@@ -0,0 +1,90 @@
+/*
+ * This file was autogenerated by skslc. Do not edit.
+ */
+
+#include "src/base/SkVx.h"
+#include "src/core/SkRuntimeEffectPriv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+using F = skvx::Vec<8, float>;
+using I = skvx::Vec<8, int32_t>;
+
+constexpr char kSkSL[] = R"SkSL(uniform half levels;
+
+half4 main(half4 color) {
+    if (color.a == 0) {
+        return half4(0);
+    }
+    half3 rgb = color.rgb / color.a;
+    rgb = floor(rgb * levels + 0.5) / levels;
+    half luma = dot(rgb, half3(0.2126, 0.7152, 0.0722));
+    rgb = luma < 0.25 ? rgb * 0.5 : rgb;
+    return half4(rgb * color.a, color.a);
+}
+)SkSL";
+
+void run(const float* uniforms, float* rgba, int count) {
+    const auto t0 = F(*(uniforms + 0));
+    for (int start = 0; start < count; start += 8) {
+        const int n = std::min(8, count - start);
+        float px[4 * 8] = {};
+        memcpy(px, rgba + 4 * start, 4 * n * sizeof(float));
+        F r, g, b, a;
+        skvx::strided_load4(px, r, g, b, a);
+        const auto t1 = a == F(0.0f);
+        const auto t2 = r / a;
+        const auto t3 = g / a;
+        const auto t4 = b / a;
+        const auto t5 = t2 * t0;
+        const auto t6 = t3 * t0;
+        const auto t7 = t4 * t0;
+        const auto t8 = t5 + F(0.5f);
+        const auto t9 = t6 + F(0.5f);
+        const auto t10 = t7 + F(0.5f);
+        const auto t11 = skvx::floor(t8);
+        const auto t12 = skvx::floor(t9);
+        const auto t13 = skvx::floor(t10);
+        const auto t14 = t11 / t0;
+        const auto t15 = t12 / t0;
+        const auto t16 = t13 / t0;
+        const auto t17 = skvx::if_then_else(~t1, t14, t2);
+        const auto t18 = skvx::if_then_else(~t1, t15, t3);
+        const auto t19 = skvx::if_then_else(~t1, t16, t4);
+        const auto t20 = t17 * F(0.212599993f) + t18 * F(0.715200007f) + t19 * F(0.0722000003f);
+        const auto t21 = t20 < F(0.25f);
+        const auto t22 = t17 * F(0.5f);
+        const auto t23 = t18 * F(0.5f);
+        const auto t24 = t19 * F(0.5f);
+        const auto t25 = skvx::if_then_else(t21, t22, t17);
+        const auto t26 = skvx::if_then_else(t21, t23, t18);
+        const auto t27 = skvx::if_then_else(t21, t24, t19);
+        const auto t28 = skvx::if_then_else(~t1, t25, t17);
+        const auto t29 = skvx::if_then_else(~t1, t26, t18);
+        const auto t30 = skvx::if_then_else(~t1, t27, t19);
+        const auto t31 = t28 * a;
+        const auto t32 = t29 * a;
+        const auto t33 = t30 * a;
+        const auto t34 = skvx::if_then_else(~t1, t31, F(0.0f));
+        const auto t35 = skvx::if_then_else(~t1, t32, F(0.0f));
+        const auto t36 = skvx::if_then_else(~t1, t33, F(0.0f));
+        const auto t37 = skvx::if_then_else(~t1, a, F(0.0f));
+        for (int i = 0; i < 8; ++i) {
+            px[4 * i + 0] = t34[i];
+            px[4 * i + 1] = t35[i];
+            px[4 * i + 2] = t36[i];
+            px[4 * i + 3] = t37[i];
+        }
+        memcpy(rgba + 4 * start, px, 4 * n * sizeof(float));
+    }
+}
+
+}  // namespace
+
+extern const SkRuntimeEffectPriv::NativeKernel gNativeKernel_Posterize;
+const SkRuntimeEffectPriv::NativeKernel gNativeKernel_Posterize = {kSkSL, run};
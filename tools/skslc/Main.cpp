@@ -6,14 +6,18 @@
  */
 
 #define SK_OPTS_NS skslc_standalone
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "src/base/SkStringView.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkOSFile.h"
 #include "src/core/SkOpts.h"
 #include "src/opts/SkChecksum_opts.h"
 #include "src/opts/SkVM_opts.h"
 #include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLCompilerPool.h"
 #include "src/sksl/SkSLFileOutputStream.h"
 #include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/SkSLStringStream.h"
@@ -27,17 +31,25 @@
 #include "src/sksl/ir/SkSLVarDeclarations.h"
 #include "src/sksl/tracing/SkRPDebugTrace.h"
 #include "src/sksl/tracing/SkVMDebugTrace.h"
+#include "src/utils/SkOSPath.h"
 #include "src/utils/SkShaderUtils.h"
 #include "src/utils/SkVMVisualizer.h"
+#include "tools/skslc/NativeKernelCodeGenerator.h"
 #include "tools/skslc/ProcessWorklist.h"
 
 #include "spirv-tools/libspirv.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <limits.h>
 #include <optional>
 #include <stdarg.h>
 #include <stdio.h>
+#include <thread>
 
 void SkDebugf(const char format[], ...) {
     va_list args;
@@ -464,10 +476,19 @@ static bool detect_shader_settings(const std::string& text,
 static void show_usage() {
     printf("usage: skslc <input> <output> <flags>\n"
            "       skslc <worklist>\n"
+           "       skslc --dir <input directory> <output directory> <extension> <flags>\n"
            "\n"
            "Allowed flags:\n"
            "--settings:   honor embedded /*#pragma settings*/ comments.\n"
-           "--nosettings: ignore /*#pragma settings*/ comments\n");
+           "--nosettings: ignore /*#pragma settings*/ comments\n"
+           "--threads=N:  (--dir only) compile on N threads; defaults to one per core\n"
+           "\n"
+           "--dir compiles every input in the directory in parallel, writing <name>.<extension>\n"
+           "to the output directory. Supported extensions are glsl, metal, hlsl, wgsl, spirv and\n"
+           "skrp.\n"
+           "\n"
+           "An output path ending in .cpp produces a native kernel for a runtime shader or color\n"
+           "filter, for registration with SkRuntimeEffectPriv::RegisterNativeKernel.\n");
 }
 
 static bool set_flag(std::optional<bool>* flag, const char* name, bool value) {
@@ -479,6 +500,51 @@ static bool set_flag(std::optional<bool>* flag, const char* name, bool value) {
     return true;
 }
 
+/**
+ * Derives a C++ identifier for a native kernel from its output file name: "out/my-effect.cpp"
+ * becomes "my_effect".
+ */
+static std::string native_kernel_name(const std::string& outputPath) {
+    SkString baseName = SkOSPath::Basename(outputPath.c_str());
+    std::string name(baseName.c_str(), baseName.size() - strlen(".cpp"));
+    for (char& c : name) {
+        if (!isalnum(static_cast<unsigned char>(c))) {
+            c = '_';
+        }
+    }
+    return name;
+}
+
+/**
+ * Determines the program kind from the input file's extension.
+ */
+static std::optional<SkSL::ProgramKind> kind_for_input_path(const std::string& inputPath) {
+    if (skstd::ends_with(inputPath, ".vert")) {
+        return SkSL::ProgramKind::kVertex;
+    } else if (skstd::ends_with(inputPath, ".frag") || skstd::ends_with(inputPath, ".sksl")) {
+        return SkSL::ProgramKind::kFragment;
+    } else if (skstd::ends_with(inputPath, ".compute")) {
+        return SkSL::ProgramKind::kCompute;
+    } else if (skstd::ends_with(inputPath, ".rtb")) {
+        return SkSL::ProgramKind::kRuntimeBlender;
+    } else if (skstd::ends_with(inputPath, ".rtcf")) {
+        return SkSL::ProgramKind::kRuntimeColorFilter;
+    } else if (skstd::ends_with(inputPath, ".rts")) {
+        return SkSL::ProgramKind::kRuntimeShader;
+    }
+    return std::nullopt;
+}
+
+static void emit_compile_error(const std::string& outputPath, const char* errorText) {
+    // Overwrite the compiler output, if any, with an error message.
+    SkSL::FileOutputStream errorStream(outputPath.c_str());
+    errorStream.writeText("### Compilation failed:\n\n");
+    errorStream.writeText(errorText);
+    errorStream.close();
+    // Also emit the error directly to stdout.
+    puts(errorText);
+}
+
 /**
  * Handle a single input.
  */
@@ -513,24 +579,13 @@ static ResultCode process_command(SkSpan<std::string> args) {
 
     const std::string& inputPath = paths[0];
     const std::string& outputPath = paths[1];
-    SkSL::ProgramKind kind;
-    if (skstd::ends_with(inputPath, ".vert")) {
-        kind = SkSL::ProgramKind::kVertex;
-    } else if (skstd::ends_with(inputPath, ".frag") || skstd::ends_with(inputPath, ".sksl")) {
-        kind = SkSL::ProgramKind::kFragment;
-    } else if (skstd::ends_with(inputPath, ".compute")) {
-        kind = SkSL::ProgramKind::kCompute;
-    } else if (skstd::ends_with(inputPath, ".rtb")) {
-        kind = SkSL::ProgramKind::kRuntimeBlender;
-    } else if (skstd::ends_with(inputPath, ".rtcf")) {
-        kind = SkSL::ProgramKind::kRuntimeColorFilter;
-    } else if (skstd::ends_with(inputPath, ".rts")) {
-        kind = SkSL::ProgramKind::kRuntimeShader;
-    } else {
+    std::optional<SkSL::ProgramKind> inputKind = kind_for_input_path(inputPath);
+    if (!inputKind.has_value()) {
         printf("input filename must end in '.vert', '.frag', '.rtb', '.rtcf', "
                "'.rts' or '.sksl'\n");
         return ResultCode::kInputError;
     }
+    SkSL::ProgramKind kind = *inputKind;
 
     std::ifstream in(inputPath);
     std::string text((std::istreambuf_iterator<char>(in)),
@@ -557,13 +612,7 @@ static ResultCode process_command(SkSpan<std::string> args) {
     settings.fRTFlipBinding = 0;
 
     auto emitCompileError = [&](const char* errorText) {
-        // Overwrite the compiler output, if any, with an error message.
-        SkSL::FileOutputStream errorStream(outputPath.c_str());
-        errorStream.writeText("### Compilation failed:\n\n");
-        errorStream.writeText(errorText);
-        errorStream.close();
-        // Also emit the error directly to stdout.
-        puts(errorText);
+        emit_compile_error(outputPath, errorText);
     };
 
     auto compileProgram = [&](const auto& writeFn) -> ResultCode {
@@ -679,6 +728,22 @@ static ResultCode process_command(SkSpan<std::string> args) {
                     rasterProg->dump(as_SkWStream(out).get());
                     return true;
                 });
+    } else if (skstd::ends_with(outputPath, ".cpp")) {
+        if (kind != SkSL::ProgramKind::kRuntimeShader &&
+            kind != SkSL::ProgramKind::kRuntimeColorFilter) {
+            emitCompileError("Native kernels are only supported for .rts and .rtcf inputs\n");
+            return ResultCode::kCompileError;
+        }
+        return compileProgram(
+                [&](SkSL::Compiler& compiler, SkSL::Program& program, SkSL::OutputStream& out) {
+                    const SkSL::FunctionDeclaration* main = program.getFunction("main");
+                    if (!main) {
+                        compiler.errorReporter().error({}, "code has no entrypoint");
+                        return false;
+                    }
+                    return SkSL::ToNativeKernel(program, *main->definition(),
+                                                native_kernel_name(outputPath), out);
+                });
     } else if (skstd::ends_with(outputPath, ".stage")) {
         return compileProgram(
                 [](SkSL::Compiler&, SkSL::Program& program, SkSL::OutputStream& out) {
@@ -776,14 +841,165 @@ static ResultCode process_command(SkSpan<std::string> args) {
             });
     } else {
         printf("expected output path to end with one of: .glsl, .html, .metal, .hlsl, .wgsl, "
-               ".spirv, .asm.vert, .asm.frag, .skrp, .skvm, .stage (got '%s')\n",
+               ".spirv, .asm.vert, .asm.frag, .skrp, .skvm, .stage, .cpp (got '%s')\n",
                outputPath.c_str());
         return ResultCode::kConfigurationError;
     }
     return ResultCode::kSuccess;
 }
 
+/**
+ * Compile every input in a directory, spreading the work across a thread pool, and report the
+ * throughput.
+ */
+static ResultCode process_directory(SkSpan<std::string> args) {
+    std::optional<bool> honorSettings;
+    int threads = 0;
+    std::vector<std::string> paths;
+    for (size_t i = 2; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "--settings") {
+            if (!set_flag(&honorSettings, "settings", true)) {
+                return ResultCode::kInputError;
+            }
+        } else if (arg == "--nosettings") {
+            if (!set_flag(&honorSettings, "settings", false)) {
+                return ResultCode::kInputError;
+            }
+        } else if (skstd::starts_with(arg, "--threads=")) {
+            threads = atoi(arg.c_str() + strlen("--threads="));
+        } else if (!skstd::starts_with(arg, "--")) {
+            paths.push_back(arg);
+        } else {
+            show_usage();
+            return ResultCode::kInputError;
+        }
+    }
+    if (paths.size() != 3 || threads < 0) {
+        show_usage();
+        return ResultCode::kInputError;
+    }
+    if (!honorSettings.has_value()) {
+        honorSettings = true;
+    }
+
+    const std::string& inputDir = paths[0];
+    const std::string& outputDir = paths[1];
+    const std::string& extension = paths[2];
+    SkSL::CompileTarget target;
+    if (extension == "glsl") {
+        target = SkSL::CompileTarget::kGLSL;
+    } else if (extension == "metal") {
+        target = SkSL::CompileTarget::kMetal;
+    } else if (extension == "hlsl") {
+        target = SkSL::CompileTarget::kHLSL;
+    } else if (extension == "wgsl") {
+        target = SkSL::CompileTarget::kWGSL;
+    } else if (extension == "spirv") {
+        target = SkSL::CompileTarget::kSPIRV;
+    } else if (extension == "skrp") {
+        target = SkSL::CompileTarget::kRasterPipeline;
+    } else {
+        printf("unsupported extension for --dir: '%s'\n", extension.c_str());
+        return ResultCode::kConfigurationError;
+    }
+
+    std::vector<SkSL::CompileRequest> requests;
+    std::vector<std::string> outputPaths;
+    SkOSFile::Iter iter(inputDir.c_str());
+    for (SkString name; iter.next(&name); ) {
+        std::string inputPath = SkOSPath::Join(inputDir.c_str(), name.c_str()).c_str();
+        std::optional<SkSL::ProgramKind> kind = kind_for_input_path(inputPath);
+        if (!kind.has_value()) {
+            continue;
+        }
+
+        std::ifstream in(inputPath);
+        std::string text((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+        if (in.rdstate()) {
+            printf("error reading '%s'\n", inputPath.c_str());
+            return ResultCode::kInputError;
+        }
+
+        SkSL::CompileRequest request{*kind, std::move(text), target};
+        request.fCaps = SkSL::ShaderCapsFactory::Standalone();
+        std::unique_ptr<SkSL::SkVMDebugTrace> skvmDebugTrace;
+        if (*honorSettings && !detect_shader_settings(request.fSource, &request.fSettings,
+                                                      &request.fCaps, &skvmDebugTrace)) {
+            return ResultCode::kInputError;
+        }
+        // See process_command.
+        request.fSettings.fRTFlipOffset  = 16384;
+        request.fSettings.fRTFlipSet     = 0;
+        request.fSettings.fRTFlipBinding = 0;
+        if (target == SkSL::CompileTarget::kRasterPipeline) {
+            if (request.fKind == SkSL::ProgramKind::kVertex) {
+                continue;
+            }
+            if (request.fKind == SkSL::ProgramKind::kFragment) {
+                request.fKind = SkSL::ProgramKind::kPrivateRuntimeShader;
+            }
+            request.fSettings.fMaxVersionAllowed = SkSL::Version::k300;
+        }
+
+        SkString baseName = SkOSPath::Basename(inputPath.c_str());
+        const char* dot = strrchr(baseName.c_str(), '.');
+        std::string outputName(baseName.c_str(), dot - baseName.c_str());
+        outputName += "." + extension;
+        outputPaths.push_back(SkOSPath::Join(outputDir.c_str(), outputName.c_str()).c_str());
+        requests.push_back(std::move(request));
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(threads);
+    SkSL::CompilerPool pool(SkSL::ShaderCapsFactory::Standalone(), executor.get());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<SkSL::CompileResult>> futures = pool.compile(requests);
+    std::vector<SkSL::CompileResult> results;
+    results.reserve(futures.size());
+    for (std::future<SkSL::CompileResult>& future : futures) {
+        results.push_back(future.get());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    auto resultCode = ResultCode::kSuccess;
+    int failures = 0;
+    for (size_t index = 0; index < results.size(); ++index) {
+        const SkSL::CompileResult& result = results[index];
+        const std::string& outputPath = outputPaths[index];
+        if (!result.fSuccess) {
+            emit_compile_error(outputPath, result.fErrors.c_str());
+            resultCode = std::max(resultCode, ResultCode::kCompileError);
+            ++failures;
+            continue;
+        }
+        SkSL::FileOutputStream out(outputPath.c_str());
+        if (!out.isValid()) {
+            printf("error writing '%s'\n", outputPath.c_str());
+            return ResultCode::kOutputError;
+        }
+        out.write(result.fOutput.data(), result.fOutput.size());
+        if (!out.close()) {
+            printf("error writing '%s'\n", outputPath.c_str());
+            return ResultCode::kOutputError;
+        }
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    printf("compiled %zu programs (%d failed) in %.1f ms on %d threads: %.1f programs/sec\n",
+           results.size(), failures, elapsed.count() * 1000, threads,
+           elapsed.count() > 0 ? results.size() / elapsed.count() : 0.0);
+    return resultCode;
+}
+
 int main(int argc, const char** argv) {
+    if (argc >= 2 && !strcmp(argv[1], "--dir")) {
+        std::vector<std::string> args(argv, argv + argc);
+        return (int)process_directory(args);
+    }
     if (argc == 2) {
         // Worklists are the only two-argument case for skslc, and we don't intend to support
         // nested worklists, so we can process them here.
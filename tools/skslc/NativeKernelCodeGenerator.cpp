@@ -0,0 +1,1564 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tools/skslc/NativeKernelCodeGenerator.h"
+
+#include "include/core/SkTypes.h"
+#include "include/private/SkSLDefines.h"
+#include "include/private/SkSLLayout.h"
+#include "include/private/SkSLModifiers.h"
+#include "include/private/SkSLProgramElement.h"
+#include "include/private/SkSLStatement.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTPin.h"
+#include "include/sksl/SkSLErrorReporter.h"
+#include "include/sksl/SkSLOperator.h"
+#include "include/sksl/SkSLPosition.h"
+#include "src/core/SkTHash.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLConstantFolder.h"
+#include "src/sksl/SkSLContext.h"
+#include "src/sksl/SkSLIntrinsicList.h"
+#include "src/sksl/SkSLOutputStream.h"
+#include "src/sksl/ir/SkSLBinaryExpression.h"
+#include "src/sksl/ir/SkSLBlock.h"
+#include "src/sksl/ir/SkSLConstructor.h"
+#include "src/sksl/ir/SkSLConstructorArrayCast.h"
+#include "src/sksl/ir/SkSLConstructorDiagonalMatrix.h"
+#include "src/sksl/ir/SkSLConstructorMatrixResize.h"
+#include "src/sksl/ir/SkSLConstructorSplat.h"
+#include "src/sksl/ir/SkSLExpression.h"
+#include "src/sksl/ir/SkSLExpressionStatement.h"
+#include "src/sksl/ir/SkSLFieldAccess.h"
+#include "src/sksl/ir/SkSLForStatement.h"
+#include "src/sksl/ir/SkSLFunctionCall.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLIfStatement.h"
+#include "src/sksl/ir/SkSLIndexExpression.h"
+#include "src/sksl/ir/SkSLLiteral.h"
+#include "src/sksl/ir/SkSLPostfixExpression.h"
+#include "src/sksl/ir/SkSLPrefixExpression.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "src/sksl/ir/SkSLReturnStatement.h"
+#include "src/sksl/ir/SkSLSwitchCase.h"
+#include "src/sksl/ir/SkSLSwitchStatement.h"
+#include "src/sksl/ir/SkSLSwizzle.h"
+#include "src/sksl/ir/SkSLTernaryExpression.h"
+#include "src/sksl/ir/SkSLType.h"
+#include "src/sksl/ir/SkSLVarDeclarations.h"
+#include "src/sksl/ir/SkSLVariable.h"
+#include "src/sksl/ir/SkSLVariableReference.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SkSL {
+
+namespace {
+
+// The number of pixels the generated kernel processes at once.
+constexpr int kLanes = 8;
+
+// Each slot of a Value holds a C++ expression of type F (for float slots) or I (for int and bool
+// slots). Apart from literals, these are always the names of const temporaries, so the generated
+// code is in SSA form and a Value can be referenced any number of times.
+using Value = std::vector<std::string>;
+
+// Helper functions, which are only emitted into the generated file if the program uses them.
+const std::map<std::string, std::string>& helper_definitions() {
+    static const auto* kHelpers = new std::map<std::string, std::string>{
+        {"sk_sin",   "F sk_sin(F x) { return skvx::map([](float v) { return std::sin(v); }, x); }"},
+        {"sk_cos",   "F sk_cos(F x) { return skvx::map([](float v) { return std::cos(v); }, x); }"},
+        {"sk_tan",   "F sk_tan(F x) { return skvx::map([](float v) { return std::tan(v); }, x); }"},
+        {"sk_asin",  "F sk_asin(F x) { return skvx::map([](float v) { return std::asin(v); }, x); }"},
+        {"sk_acos",  "F sk_acos(F x) { return skvx::map([](float v) { return std::acos(v); }, x); }"},
+        {"sk_atan",  "F sk_atan(F x) { return skvx::map([](float v) { return std::atan(v); }, x); }"},
+        {"sk_exp",   "F sk_exp(F x) { return skvx::map([](float v) { return std::exp(v); }, x); }"},
+        {"sk_log",   "F sk_log(F x) { return skvx::map([](float v) { return std::log(v); }, x); }"},
+        {"sk_exp2",  "F sk_exp2(F x) { return skvx::map([](float v) { return std::exp2(v); }, x); }"},
+        {"sk_log2",  "F sk_log2(F x) { return skvx::map([](float v) { return std::log2(v); }, x); }"},
+        {"sk_atan2", "F sk_atan2(F y, F x) {\n"
+                     "    return skvx::map([](float v, float u) { return std::atan2(v, u); }, y, x);\n"
+                     "}"},
+        {"sk_pow",   "F sk_pow(F x, F y) {\n"
+                     "    return skvx::map([](float v, float u) { return std::pow(v, u); }, x, y);\n"
+                     "}"},
+        {"sk_load_int", "I sk_load_int(const float* p) {\n"
+                        "    int32_t v;\n"
+                        "    memcpy(&v, p, sizeof(v));\n"
+                        "    return I(v);\n"
+                        "}"},
+    };
+    return *kHelpers;
+}
+
+Type::NumberKind base_number_kind(const Type& type) {
+    if (type.typeKind() == Type::TypeKind::kMatrix || type.typeKind() == Type::TypeKind::kVector) {
+        return base_number_kind(type.componentType());
+    }
+    return type.numberKind();
+}
+
+bool is_uniform(const Variable& var) {
+    return var.modifiers().fFlags & Modifiers::kUniform_Flag;
+}
+
+// Appends one entry per slot of `type`: true for float slots, false for int and bool slots.
+void append_slot_kinds(const Type& type, std::vector<bool>* kinds) {
+    switch (type.typeKind()) {
+        case Type::TypeKind::kArray:
+            for (int i = 0; i < type.columns(); ++i) {
+                append_slot_kinds(type.componentType(), kinds);
+            }
+            break;
+        case Type::TypeKind::kStruct:
+            for (const Type::Field& field : type.fields()) {
+                append_slot_kinds(*field.fType, kinds);
+            }
+            break;
+        default:
+            kinds->insert(kinds->end(), type.slotCount(),
+                          base_number_kind(type) == Type::NumberKind::kFloat);
+            break;
+    }
+}
+
+std::string float_literal(float value) {
+    if (std::isnan(value)) {
+        return "F(NAN)";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "F(INFINITY)" : "F(-INFINITY)";
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.9g", value);
+    std::string text = buffer;
+    if (text.find_first_of(".e") == std::string::npos) {
+        text += ".0";
+    }
+    return "F(" + text + "f)";
+}
+
+std::string int_literal(int32_t value) {
+    return "I(" + std::to_string(value) + ")";
+}
+
+std::string zero_literal(bool isFloat) {
+    return isFloat ? "F(0.0f)" : "I(0)";
+}
+
+// Adds the names of any temporaries (t0, t1, ...) referenced by `expr` to `names`.
+void add_referenced_temps(std::string_view expr, std::set<std::string>* names) {
+    for (size_t i = 0; i < expr.size(); ++i) {
+        bool startsIdentifier = (i == 0 || !(isalnum(expr[i - 1]) || expr[i - 1] == '_'));
+        if (expr[i] != 't' || !startsIdentifier) {
+            continue;
+        }
+        size_t end = i + 1;
+        while (end < expr.size() && isdigit(expr[end])) {
+            ++end;
+        }
+        if (end > i + 1 && (end == expr.size() || !(isalnum(expr[end]) || expr[end] == '_'))) {
+            names->emplace(expr.substr(i, end - i));
+        }
+        i = end;
+    }
+}
+
+class NativeKernelGenerator {
+public:
+    NativeKernelGenerator(const Program& program) : fProgram(program) {}
+
+    bool writeProgram(const FunctionDefinition& function, std::string_view name, OutputStream& out);
+
+private:
+    struct Slot {
+        std::string fVal;
+        bool        fIsFloat;
+    };
+
+    void error(Position pos, std::string_view msg) {
+        fProgram.fContext->fErrors->error(pos, msg);
+    }
+
+    /** Emits `const auto tN = expr;` into the current code block, and returns `tN`. */
+    std::string temp(const std::string& expr);
+
+    /**
+     * Masks are held as C++ expressions of type I. An empty condition or loop mask means that
+     * every lane is active; an empty continue mask or return mask means that no lane is.
+     */
+    std::string andMasks(const std::string& a, const std::string& b) {
+        if (a.empty()) {
+            return b;
+        }
+        if (b.empty()) {
+            return a;
+        }
+        return this->temp(a + " & " + b);
+    }
+    std::string orMasks(const std::string& a, const std::string& b) {
+        if (a.empty()) {
+            return b;
+        }
+        if (b.empty()) {
+            return a;
+        }
+        return this->temp(a + " | " + b);
+    }
+    static std::string explicitMask(const std::string& mask) {
+        return mask.empty() ? "I(-1)" : mask;
+    }
+    static std::string invertMask(const std::string& mask) {
+        return mask.empty() ? "I(0)" : "~" + mask;
+    }
+
+    /** The lanes which are currently executing. Empty if every lane is. */
+    std::string mask() {
+        std::string result = this->andMasks(fConditionMask, fLoopMask);
+        if (!fFunctionStack.empty() && !currentFunction().fReturned.empty()) {
+            result = this->andMasks(result, "~" + currentFunction().fReturned);
+        }
+        return result;
+    }
+
+    size_t createSlot(const Type& type);
+    size_t getSlot(const Variable& v);
+    size_t getFunctionSlot(const IRNode& callSite, const FunctionDefinition& fn);
+    Value getSlotValue(size_t slot, size_t nslots);
+    std::string conditionalStore(const std::string& lhs,
+                                 const std::string& rhs,
+                                 const std::string& mask);
+
+    void setupGlobals();
+    size_t writeFunction(const IRNode& caller,
+                         const FunctionDefinition& function,
+                         SkSpan<std::string> arguments);
+
+    Value unary(const Value& v, const std::function<std::string(const std::string&)>& fn);
+    Value binary(const Value& x,
+                 const Value& y,
+                 const std::function<std::string(const std::string&, const std::string&)>& fn);
+    Value ternary(const Value& x,
+                  const Value& y,
+                  const Value& z,
+                  const std::function<std::string(const std::string&,
+                                                  const std::string&,
+                                                  const std::string&)>& fn);
+    std::string dot(const Value& x, const Value& y);
+
+    bool evaluateIndex(const Expression& expr, double* value);
+    size_t indexSlotOffset(const IndexExpression& expr);
+
+    Value writeExpression(const Expression& expr);
+    Value writeBinaryExpression(const BinaryExpression& b);
+    Value writeAggregationConstructor(const AnyConstructor& c);
+    Value writeConstructorDiagonalMatrix(const ConstructorDiagonalMatrix& c);
+    Value writeConstructorMatrixResize(const ConstructorMatrixResize& c);
+    Value writeConstructorCast(const AnyConstructor& c);
+    Value writeConstructorSplat(const ConstructorSplat& c);
+    Value writeFunctionCall(const FunctionCall& c);
+    Value writeFieldAccess(const FieldAccess& expr);
+    Value writeLiteral(const Literal& l);
+    Value writeIndexExpression(const IndexExpression& expr);
+    Value writeIntrinsicCall(const FunctionCall& c);
+    Value writePostfixExpression(const PostfixExpression& p);
+    Value writePrefixExpression(const PrefixExpression& p);
+    Value writeSwizzle(const Swizzle& swizzle);
+    Value writeTernaryExpression(const TernaryExpression& t);
+    Value writeVariableExpression(const VariableReference& expr);
+
+    Value writeTypeConversion(const Value& src, Type::NumberKind srcKind, Type::NumberKind dstKind);
+    Value writeComparison(const BinaryExpression& b, const Value& lVal, const Value& rVal);
+
+    void writeStatement(const Statement& s);
+    void writeBlock(const Block& b);
+    void writeBreakStatement();
+    void writeContinueStatement();
+    void writeForStatement(const ForStatement& f);
+    void writeIfStatement(const IfStatement& stmt);
+    void writeReturnStatement(const ReturnStatement& r);
+    void writeSwitchStatement(const SwitchStatement& s);
+    void writeVarDeclaration(const VarDeclaration& decl);
+
+    Value writeStore(const Expression& lhs, const Value& rhs);
+
+    const Program& fProgram;
+
+    // Temporaries are emitted into `fCode`, which points at either the prologue (code that only
+    // depends on uniforms, and runs once per call) or the body (code that runs once per
+    // kLanes pixels).
+    struct Temp {
+        std::string fName;
+        std::string fExpr;
+    };
+    std::vector<Temp> fPrologue;
+    std::vector<Temp> fBody;
+    std::vector<Temp>* fCode = &fPrologue;
+
+    static void WriteTemps(const std::vector<Temp>& temps,
+                           const std::set<std::string>& live,
+                           const char* indent,
+                           OutputStream& out);
+    int fTempCount = 0;
+
+    std::vector<Slot> fSlots;
+    SkTHashMap<const IRNode*, size_t> fSlotMap;
+    size_t fUniformOffset = 0;
+
+    // The value of each loop index, for the loop iteration currently being unrolled.
+    SkTHashMap<const Variable*, double> fLoopIndexValues;
+
+    std::string fConditionMask;
+    std::string fLoopMask;
+    std::string fContinueMask;
+
+    struct Function {
+        size_t      fReturnSlot;
+        std::string fReturned;
+    };
+    std::vector<Function> fFunctionStack;
+    Function& currentFunction() { return fFunctionStack.back(); }
+
+    class ScopedCondition {
+    public:
+        ScopedCondition(NativeKernelGenerator* generator, const std::string& mask)
+                : fGenerator(generator), fOldConditionMask(fGenerator->fConditionMask) {
+            fGenerator->fConditionMask = fGenerator->andMasks(fOldConditionMask, mask);
+        }
+
+        ~ScopedCondition() { fGenerator->fConditionMask = fOldConditionMask; }
+
+    private:
+        NativeKernelGenerator* fGenerator;
+        std::string fOldConditionMask;
+    };
+};
+
+std::string NativeKernelGenerator::temp(const std::string& expr) {
+    std::string name = "t" + std::to_string(fTempCount++);
+    fCode->push_back({name, expr});
+    return name;
+}
+
+void NativeKernelGenerator::WriteTemps(const std::vector<Temp>& temps,
+                                       const std::set<std::string>& live,
+                                       const char* indent,
+                                       OutputStream& out) {
+    for (const Temp& temp : temps) {
+        if (live.count(temp.fName)) {
+            out.writeString(indent + ("const auto " + temp.fName + " = " + temp.fExpr + ";\n"));
+        }
+    }
+}
+
+size_t NativeKernelGenerator::createSlot(const Type& type) {
+    size_t slot = fSlots.size();
+    std::vector<bool> kinds;
+    append_slot_kinds(type, &kinds);
+    SkASSERT(kinds.size() == type.slotCount());
+    for (bool isFloat : kinds) {
+        fSlots.push_back(Slot{zero_literal(isFloat), isFloat});
+    }
+    return slot;
+}
+
+size_t NativeKernelGenerator::getSlot(const Variable& v) {
+    if (size_t* entry = fSlotMap.find(&v)) {
+        return *entry;
+    }
+    size_t slot = this->createSlot(v.type());
+    fSlotMap.set(&v, slot);
+    return slot;
+}
+
+size_t NativeKernelGenerator::getFunctionSlot(const IRNode& callSite, const FunctionDefinition& fn) {
+    if (size_t* entry = fSlotMap.find(&callSite)) {
+        return *entry;
+    }
+    size_t slot = this->createSlot(fn.declaration().returnType());
+    fSlotMap.set(&callSite, slot);
+    return slot;
+}
+
+Value NativeKernelGenerator::getSlotValue(size_t slot, size_t nslots) {
+    Value val(nslots);
+    for (size_t i = 0; i < nslots; ++i) {
+        val[i] = fSlots[slot + i].fVal;
+    }
+    return val;
+}
+
+std::string NativeKernelGenerator::conditionalStore(const std::string& lhs,
+                                                    const std::string& rhs,
+                                                    const std::string& mask) {
+    if (mask.empty() || lhs == rhs) {
+        return rhs;
+    }
+    return this->temp("skvx::if_then_else(" + mask + ", " + rhs + ", " + lhs + ")");
+}
+
+void NativeKernelGenerator::setupGlobals() {
+    for (const ProgramElement* e : fProgram.elements()) {
+        if (!e->is<GlobalVarDeclaration>()) {
+            continue;
+        }
+        const VarDeclaration& decl = e->as<GlobalVarDeclaration>().varDeclaration();
+        const Variable* var = decl.var();
+        if (var->type().isEffectChild()) {
+            this->error(decl.fPosition, "native kernels do not support child effects");
+            continue;
+        }
+        if (var->modifiers().fLayout.fBuiltin >= 0) {
+            // The only builtin exposed to runtime effects is sk_FragCoord; the kernel only
+            // receives local coordinates.
+            this->error(decl.fPosition, "native kernels do not support '" +
+                                        std::string(var->name()) + "'");
+            continue;
+        }
+
+        size_t slot = this->getSlot(*var),
+               nslots = var->type().slotCount();
+
+        // Uniforms are tightly packed, in declaration order, matching SkRuntimeEffect::uniforms().
+        if (is_uniform(*var)) {
+            for (size_t i = 0; i < nslots; ++i) {
+                std::string src = "uniforms + " + std::to_string(fUniformOffset++);
+                fSlots[slot + i].fVal = fSlots[slot + i].fIsFloat
+                                                ? this->temp("F(*(" + src + "))")
+                                                : this->temp("sk_load_int(" + src + ")");
+            }
+            continue;
+        }
+
+        if (decl.value()) {
+            Value val = this->writeExpression(*decl.value());
+            for (size_t i = 0; i < nslots; ++i) {
+                fSlots[slot + i].fVal = val[i];
+            }
+        }
+    }
+}
+
+size_t NativeKernelGenerator::writeFunction(const IRNode& caller,
+                                            const FunctionDefinition& function,
+                                            SkSpan<std::string> arguments) {
+    const FunctionDeclaration& decl = function.declaration();
+
+    size_t returnSlot = this->getFunctionSlot(caller, function);
+    fFunctionStack.push_back({/*fReturnSlot=*/returnSlot, /*fReturned=*/""});
+
+    // Parameters take on the incoming argument values.
+    size_t argIdx = 0;
+    for (const Variable* p : decl.parameters()) {
+        size_t paramSlot = this->getSlot(*p),
+               nslots    = p->type().slotCount();
+        for (size_t i = 0; i < nslots; ++i) {
+            fSlots[paramSlot + i].fVal = arguments[argIdx + i];
+        }
+        argIdx += nslots;
+    }
+    SkASSERT(argIdx == arguments.size());
+
+    this->writeBlock(function.body()->as<Block>());
+
+    // Copy 'out' and 'inout' parameters back to the caller's argument values.
+    argIdx = 0;
+    for (const Variable* p : decl.parameters()) {
+        size_t nslots = p->type().slotCount();
+        if (p->modifiers().fFlags & Modifiers::kOut_Flag) {
+            size_t paramSlot = this->getSlot(*p);
+            for (size_t i = 0; i < nslots; ++i) {
+                arguments[argIdx + i] = fSlots[paramSlot + i].fVal;
+            }
+        }
+        argIdx += nslots;
+    }
+
+    fFunctionStack.pop_back();
+    return returnSlot;
+}
+
+Value NativeKernelGenerator::unary(const Value& v,
+                                   const std::function<std::string(const std::string&)>& fn) {
+    Value result(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        result[i] = this->temp(fn(v[i]));
+    }
+    return result;
+}
+
+Value NativeKernelGenerator::binary(
+        const Value& x,
+        const Value& y,
+        const std::function<std::string(const std::string&, const std::string&)>& fn) {
+    // Binary operations are (vecN, vecN), (vecN, scalar), or (scalar, vecN).
+    size_t nslots = std::max(x.size(), y.size());
+    SkASSERT(x.size() == nslots || x.size() == 1);
+    SkASSERT(y.size() == nslots || y.size() == 1);
+    Value result(nslots);
+    for (size_t i = 0; i < nslots; ++i) {
+        result[i] = this->temp(fn(x[x.size() == 1 ? 0 : i], y[y.size() == 1 ? 0 : i]));
+    }
+    return result;
+}
+
+Value NativeKernelGenerator::ternary(const Value& x,
+                                     const Value& y,
+                                     const Value& z,
+                                     const std::function<std::string(const std::string&,
+                                                                     const std::string&,
+                                                                     const std::string&)>& fn) {
+    size_t nslots = std::max({x.size(), y.size(), z.size()});
+    Value result(nslots);
+    for (size_t i = 0; i < nslots; ++i) {
+        result[i] = this->temp(fn(x[x.size() == 1 ? 0 : i],
+                                  y[y.size() == 1 ? 0 : i],
+                                  z[z.size() == 1 ? 0 : i]));
+    }
+    return result;
+}
+
+std::string NativeKernelGenerator::dot(const Value& x, const Value& y) {
+    SkASSERT(x.size() == y.size());
+    std::string sum = x[0] + " * " + y[0];
+    for (size_t i = 1; i < x.size(); ++i) {
+        sum += " + " + x[i] + " * " + y[i];
+    }
+    return this->temp(sum);
+}
+
+bool NativeKernelGenerator::evaluateIndex(const Expression& expr, double* value) {
+    // ES2 only allows constant-index-expressions: constants, loop indices, and arithmetic on
+    // them. Since every loop is unrolled, each of these has a known value.
+    switch (expr.kind()) {
+        case Expression::Kind::kVariableReference:
+            if (const double* index =
+                        fLoopIndexValues.find(expr.as<VariableReference>().variable())) {
+                *value = *index;
+                return true;
+            }
+            break;
+
+        case Expression::Kind::kPrefix: {
+            const PrefixExpression& p = expr.as<PrefixExpression>();
+            if (p.getOperator().kind() == Operator::Kind::MINUS &&
+                this->evaluateIndex(*p.operand(), value)) {
+                *value = -*value;
+                return true;
+            }
+            break;
+        }
+        case Expression::Kind::kBinary: {
+            const BinaryExpression& b = expr.as<BinaryExpression>();
+            double left, right;
+            if (!this->evaluateIndex(*b.left(), &left) ||
+                !this->evaluateIndex(*b.right(), &right)) {
+                break;
+            }
+            switch (b.getOperator().kind()) {
+                case Operator::Kind::PLUS:  *value = left + right; return true;
+                case Operator::Kind::MINUS: *value = left - right; return true;
+                case Operator::Kind::STAR:  *value = left * right; return true;
+                case Operator::Kind::SLASH:
+                    if (right == 0) {
+                        break;
+                    }
+                    *value = left / right;
+                    if (expr.type().isInteger()) {
+                        *value = std::trunc(*value);
+                    }
+                    return true;
+                default:
+                    break;
+            }
+            break;
+        }
+        case Expression::Kind::kConstructorScalarCast: {
+            const Expression& arg = *expr.asAnyConstructor().argumentSpan().front();
+            if (this->evaluateIndex(arg, value)) {
+                if (expr.type().isInteger()) {
+                    *value = std::trunc(*value);
+                }
+                return true;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return ConstantFolder::GetConstantValue(expr, value);
+}
+
+size_t NativeKernelGenerator::indexSlotOffset(const IndexExpression& expr) {
+    double index;
+    if (!this->evaluateIndex(*expr.index(), &index)) {
+        this->error(expr.index()->fPosition, "index expression is not constant");
+        return 0;
+    }
+
+    // The GLSL spec leaves out-of-bounds access undefined; clamp it, like SkVM does.
+    int indexValue = SkTPin(static_cast<int>(index), 0, expr.base()->type().columns() - 1);
+    return indexValue * expr.type().slotCount();
+}
+
+Value NativeKernelGenerator::writeComparison(const BinaryExpression& b,
+                                             const Value& lVal,
+                                             const Value& rVal) {
+    std::string op(b.getOperator().tightOperatorName());
+    Value result = this->binary(lVal, rVal, [&](const std::string& x, const std::string& y) {
+        return x + " " + op + " " + y;
+    });
+
+    // Equality of vectors, matrices, structs and arrays folds down to a single bool.
+    if (b.getOperator().isEquality() && result.size() > 1) {
+        const char* fold = b.getOperator().kind() == Operator::Kind::NEQ ? " | " : " & ";
+        std::string folded = result[0];
+        for (size_t i = 1; i < result.size(); ++i) {
+            folded += fold + result[i];
+        }
+        return {this->temp(folded)};
+    }
+    return result;
+}
+
+Value NativeKernelGenerator::writeBinaryExpression(const BinaryExpression& b) {
+    const Expression& left = *b.left();
+    const Expression& right = *b.right();
+    Operator op = b.getOperator();
+    if (op.kind() == Operator::Kind::EQ) {
+        return this->writeStore(left, this->writeExpression(right));
+    }
+
+    const Type& lType = left.type();
+    const Type& rType = right.type();
+    bool lVecOrMtx = (lType.isVector() || lType.isMatrix());
+    bool rVecOrMtx = (rType.isVector() || rType.isMatrix());
+    bool isAssignment = op.isAssignment();
+    if (isAssignment) {
+        op = op.removeAssignment();
+    }
+    Type::NumberKind nk = base_number_kind(lType);
+
+    // A few ops require special treatment:
+    switch (op.kind()) {
+        case Operator::Kind::LOGICALAND: {
+            Value lVal = this->writeExpression(left);
+            ScopedCondition shortCircuit(this, lVal[0]);
+            Value rVal = this->writeExpression(right);
+            return {this->temp(lVal[0] + " & " + rVal[0])};
+        }
+        case Operator::Kind::LOGICALOR: {
+            Value lVal = this->writeExpression(left);
+            ScopedCondition shortCircuit(this, "~" + lVal[0]);
+            Value rVal = this->writeExpression(right);
+            return {this->temp(lVal[0] + " | " + rVal[0])};
+        }
+        case Operator::Kind::COMMA:
+            this->writeExpression(left);
+            return this->writeExpression(right);
+        default:
+            break;
+    }
+
+    // All of the other ops always evaluate both sides of the expression.
+    Value lVal = this->writeExpression(left),
+          rVal = this->writeExpression(right);
+
+    // Special case for M*V, V*M, M*M (but not V*V!)
+    if (op.kind() == Operator::Kind::STAR &&
+        lVecOrMtx && rVecOrMtx && !(lType.isVector() && rType.isVector())) {
+        int rCols = rType.columns(),
+            rRows = rType.rows(),
+            lCols = lType.columns(),
+            lRows = lType.rows();
+        // M*V treats the vector as a column
+        if (rType.isVector()) {
+            std::swap(rCols, rRows);
+        }
+        SkASSERT(lCols == rRows);
+        Value result(lRows * rCols);
+        size_t resultIdx = 0;
+        for (int c = 0; c < rCols; ++c) {
+            for (int r = 0; r < lRows; ++r) {
+                std::string sum;
+                for (int j = 0; j < lCols; ++j) {
+                    sum += (j ? " + " : "") + lVal[j*lRows + r] + " * " + rVal[c*rRows + j];
+                }
+                result[resultIdx++] = this->temp(sum);
+            }
+        }
+        return isAssignment ? this->writeStore(left, result) : result;
+    }
+
+    Value result;
+    switch (op.kind()) {
+        case Operator::Kind::EQEQ:
+        case Operator::Kind::NEQ:
+        case Operator::Kind::GT:
+        case Operator::Kind::GTEQ:
+        case Operator::Kind::LT:
+        case Operator::Kind::LTEQ:
+            return this->writeComparison(b, lVal, rVal);
+
+        case Operator::Kind::PLUS:
+        case Operator::Kind::MINUS:
+        case Operator::Kind::STAR:
+        case Operator::Kind::BITWISEXOR:
+        case Operator::Kind::LOGICALXOR:
+        case Operator::Kind::BITWISEAND:
+        case Operator::Kind::BITWISEOR: {
+            std::string opName = op.kind() == Operator::Kind::LOGICALXOR
+                                         ? "^"
+                                         : std::string(op.tightOperatorName());
+            result = this->binary(lVal, rVal, [&](const std::string& x, const std::string& y) {
+                return x + " " + opName + " " + y;
+            });
+            break;
+        }
+        case Operator::Kind::SLASH:
+            if (nk == Type::NumberKind::kFloat) {
+                result = this->binary(lVal, rVal, [](const std::string& x, const std::string& y) {
+                    return x + " / " + y;
+                });
+            } else {
+                // Like SkVM, integer division is performed in floating point and truncated.
+                result = this->binary(lVal, rVal, [](const std::string& x, const std::string& y) {
+                    return "skvx::cast<int32_t>(skvx::cast<float>(" + x + ") / "
+                                               "skvx::cast<float>(" + y + "))";
+                });
+            }
+            break;
+
+        default:
+            this->error(b.fPosition, "unsupported operator '" +
+                                     std::string(op.operatorName()) + "'");
+            return Value(b.type().slotCount(), zero_literal(true));
+    }
+    return isAssignment ? this->writeStore(left, result) : result;
+}
+
+Value NativeKernelGenerator::writeAggregationConstructor(const AnyConstructor& c) {
+    Value result;
+    for (const std::unique_ptr<Expression>& arg : c.argumentSpan()) {
+        Value tmp = this->writeExpression(*arg);
+        result.insert(result.end(), tmp.begin(), tmp.end());
+    }
+    return result;
+}
+
+Value NativeKernelGenerator::writeTypeConversion(const Value& src,
+                                                 Type::NumberKind srcKind,
+                                                 Type::NumberKind dstKind) {
+    // Conversion among "similar" types (floatN <-> halfN), (shortN <-> intN), etc. is a no-op.
+    if (srcKind == dstKind) {
+        return src;
+    }
+    switch (dstKind) {
+        case Type::NumberKind::kFloat:
+            if (srcKind == Type::NumberKind::kBoolean) {
+                return this->unary(src, [](const std::string& x) {
+                    return "skvx::if_then_else(" + x + ", F(1.0f), F(0.0f))";
+                });
+            }
+            return this->unary(src, [](const std::string& x) {
+                return "skvx::cast<float>(" + x + ")";
+            });
+
+        case Type::NumberKind::kSigned:
+        case Type::NumberKind::kUnsigned:
+            if (srcKind == Type::NumberKind::kBoolean) {
+                return this->unary(src, [](const std::string& x) {
+                    return "skvx::if_then_else(" + x + ", I(1), I(0))";
+                });
+            }
+            if (srcKind == Type::NumberKind::kFloat) {
+                // skvx::cast truncates towards zero, like SkVM.
+                return this->unary(src, [](const std::string& x) {
+                    return "skvx::cast<int32_t>(" + x + ")";
+                });
+            }
+            return src;
+
+        case Type::NumberKind::kBoolean:
+            if (srcKind == Type::NumberKind::kFloat) {
+                return this->unary(src, [](const std::string& x) { return x + " != F(0.0f)"; });
+            }
+            return this->unary(src, [](const std::string& x) { return x + " != I(0)"; });
+
+        default:
+            SkUNREACHABLE;
+    }
+}
+
+Value NativeKernelGenerator::writeConstructorCast(const AnyConstructor& c) {
+    const Expression& argument = *c.argumentSpan().front();
+    Value src = this->writeExpression(argument);
+    return this->writeTypeConversion(src, base_number_kind(argument.type()),
+                                     base_number_kind(c.type()));
+}
+
+Value NativeKernelGenerator::writeConstructorSplat(const ConstructorSplat& c) {
+    Value src = this->writeExpression(*c.argument());
+    return Value(c.type().columns(), src[0]);
+}
+
+Value NativeKernelGenerator::writeConstructorDiagonalMatrix(const ConstructorDiagonalMatrix& c) {
+    const Type& dstType = c.type();
+    Value src = this->writeExpression(*c.argument());
+    Value dst;
+    for (int col = 0; col < dstType.columns(); ++col) {
+        for (int row = 0; row < dstType.rows(); ++row) {
+            dst.push_back(col == row ? src[0] : zero_literal(true));
+        }
+    }
+    return dst;
+}
+
+Value NativeKernelGenerator::writeConstructorMatrixResize(const ConstructorMatrixResize& c) {
+    const Type& srcType = c.argument()->type();
+    const Type& dstType = c.type();
+    Value src = this->writeExpression(*c.argument());
+
+    // Matrix-from-matrix uses src where it overlaps, and fills in missing fields with identity.
+    Value dst;
+    for (int col = 0; col < dstType.columns(); ++col) {
+        for (int row = 0; row < dstType.rows(); ++row) {
+            if (col < srcType.columns() && row < srcType.rows()) {
+                dst.push_back(src[col * srcType.rows() + row]);
+            } else {
+                dst.push_back(float_literal(col == row ? 1.0f : 0.0f));
+            }
+        }
+    }
+    return dst;
+}
+
+Value NativeKernelGenerator::writeFieldAccess(const FieldAccess& expr) {
+    Value base = this->writeExpression(*expr.base());
+    size_t offset = expr.initialSlot();
+    return Value(base.begin() + offset, base.begin() + offset + expr.type().slotCount());
+}
+
+Value NativeKernelGenerator::writeIndexExpression(const IndexExpression& expr) {
+    Value base = this->writeExpression(*expr.base());
+    size_t offset = this->indexSlotOffset(expr);
+    return Value(base.begin() + offset, base.begin() + offset + expr.type().slotCount());
+}
+
+Value NativeKernelGenerator::writeVariableExpression(const VariableReference& expr) {
+    size_t slot = this->getSlot(*expr.variable());
+    return this->getSlotValue(slot, expr.type().slotCount());
+}
+
+Value NativeKernelGenerator::writeIntrinsicCall(const FunctionCall& c) {
+    IntrinsicKind intrinsicKind = c.function().intrinsicKind();
+    SkASSERT(intrinsicKind != kNotIntrinsic);
+
+    const size_t nargs = c.arguments().size();
+    const size_t kMaxArgs = 3;  // eg: clamp, mix, smoothstep
+    Value args[kMaxArgs];
+    SkASSERT(nargs >= 1 && nargs <= std::size(args));
+    for (size_t i = 0; i < nargs; ++i) {
+        args[i] = this->writeExpression(*c.arguments()[i]);
+    }
+    Type::NumberKind nk = base_number_kind(c.arguments()[0]->type());
+
+    auto call = [](const char* fn) {
+        return [fn](const std::string& x) { return std::string(fn) + "(" + x + ")"; };
+    };
+    auto call2 = [](const char* fn) {
+        return [fn](const std::string& x, const std::string& y) {
+            return std::string(fn) + "(" + x + ", " + y + ")";
+        };
+    };
+    auto vx = [](const char* fn) {
+        return [fn](const std::string& x) { return std::string("skvx::") + fn + "(" + x + ")"; };
+    };
+    auto compare = [&](const char* op) {
+        return this->binary(args[0], args[1], [op](const std::string& x, const std::string& y) {
+            return x + " " + op + " " + y;
+        });
+    };
+
+    switch (intrinsicKind) {
+        case k_radians_IntrinsicKind:
+            return this->unary(args[0], [](const std::string& x) {
+                return x + " * " + float_literal(SK_FloatPI / 180);
+            });
+        case k_degrees_IntrinsicKind:
+            return this->unary(args[0], [](const std::string& x) {
+                return x + " * " + float_literal(180 / SK_FloatPI);
+            });
+
+        case k_sin_IntrinsicKind:  return this->unary(args[0], call("sk_sin"));
+        case k_cos_IntrinsicKind:  return this->unary(args[0], call("sk_cos"));
+        case k_tan_IntrinsicKind:  return this->unary(args[0], call("sk_tan"));
+        case k_asin_IntrinsicKind: return this->unary(args[0], call("sk_asin"));
+        case k_acos_IntrinsicKind: return this->unary(args[0], call("sk_acos"));
+        case k_atan_IntrinsicKind:
+            return nargs == 1 ? this->unary(args[0], call("sk_atan"))
+                              : this->binary(args[0], args[1], call2("sk_atan2"));
+
+        case k_pow_IntrinsicKind:  return this->binary(args[0], args[1], call2("sk_pow"));
+        case k_exp_IntrinsicKind:  return this->unary(args[0], call("sk_exp"));
+        case k_log_IntrinsicKind:  return this->unary(args[0], call("sk_log"));
+        case k_exp2_IntrinsicKind: return this->unary(args[0], call("sk_exp2"));
+        case k_log2_IntrinsicKind: return this->unary(args[0], call("sk_log2"));
+
+        case k_sqrt_IntrinsicKind: return this->unary(args[0], vx("sqrt"));
+        case k_inversesqrt_IntrinsicKind:
+            return this->unary(args[0], [](const std::string& x) {
+                return "F(1.0f) / skvx::sqrt(" + x + ")";
+            });
+
+        case k_abs_IntrinsicKind:
+            if (nk == Type::NumberKind::kFloat) {
+                return this->unary(args[0], vx("abs"));
+            }
+            return this->unary(args[0], [](const std::string& x) {
+                return "skvx::if_then_else(" + x + " < I(0), -" + x + ", " + x + ")";
+            });
+        case k_sign_IntrinsicKind: {
+            std::string zero = zero_literal(nk == Type::NumberKind::kFloat),
+                        one  = nk == Type::NumberKind::kFloat ? float_literal(1) : int_literal(1);
+            return this->unary(args[0], [&](const std::string& x) {
+                return "skvx::if_then_else(" + x + " < " + zero + ", -" + one + ", "
+                       "skvx::if_then_else(" + x + " > " + zero + ", " + one + ", " + zero + "))";
+            });
+        }
+        case k_floor_IntrinsicKind: return this->unary(args[0], vx("floor"));
+        case k_ceil_IntrinsicKind:  return this->unary(args[0], vx("ceil"));
+        case k_fract_IntrinsicKind: return this->unary(args[0], vx("fract"));
+        case k_mod_IntrinsicKind:
+            return this->binary(args[0], args[1], [](const std::string& x, const std::string& y) {
+                return x + " - " + y + " * skvx::floor(" + x + " / " + y + ")";
+            });
+
+        case k_min_IntrinsicKind:
+            return this->binary(args[0], args[1], [](const std::string& x, const std::string& y) {
+                return "skvx::min(" + x + ", " + y + ")";
+            });
+        case k_max_IntrinsicKind:
+            return this->binary(args[0], args[1], [](const std::string& x, const std::string& y) {
+                return "skvx::max(" + x + ", " + y + ")";
+            });
+        case k_clamp_IntrinsicKind:
+            return this->ternary(args[0], args[1], args[2],
+                                 [](const std::string& x, const std::string& lo,
+                                    const std::string& hi) {
+                return "skvx::min(skvx::max(" + x + ", " + lo + "), " + hi + ")";
+            });
+        case k_saturate_IntrinsicKind:
+            return this->unary(args[0], [](const std::string& x) {
+                return "skvx::min(skvx::max(" + x + ", F(0.0f)), F(1.0f))";
+            });
+        case k_mix_IntrinsicKind:
+            if (base_number_kind(c.arguments()[2]->type()) == Type::NumberKind::kBoolean) {
+                return this->ternary(args[0], args[1], args[2],
+                                     [](const std::string& x, const std::string& y,
+                                        const std::string& t) {
+                    return "skvx::if_then_else(" + t + ", " + y + ", " + x + ")";
+                });
+            }
+            return this->ternary(args[0], args[1], args[2],
+                                 [](const std::string& x, const std::string& y,
+                                    const std::string& t) {
+                return x + " + (" + y + " - " + x + ") * " + t;
+            });
+        case k_step_IntrinsicKind:
+            return this->binary(args[0], args[1], [](const std::string& edge,
+                                                     const std::string& x) {
+                return "skvx::if_then_else(" + x + " < " + edge + ", F(0.0f), F(1.0f))";
+            });
+        case k_smoothstep_IntrinsicKind: {
+            Value t = this->ternary(args[0], args[1], args[2],
+                                    [](const std::string& edge0, const std::string& edge1,
+                                       const std::string& x) {
+                return "skvx::min(skvx::max((" + x + " - " + edge0 + ") / (" +
+                       edge1 + " - " + edge0 + "), F(0.0f)), F(1.0f))";
+            });
+            return this->unary(t, [](const std::string& x) {
+                return x + " * " + x + " * (F(3.0f) - F(2.0f) * " + x + ")";
+            });
+        }
+
+        case k_length_IntrinsicKind:
+            return {this->temp("skvx::sqrt(" + this->dot(args[0], args[0]) + ")")};
+        case k_distance_IntrinsicKind: {
+            Value vec = this->binary(args[0], args[1],
+                                     [](const std::string& x, const std::string& y) {
+                return x + " - " + y;
+            });
+            return {this->temp("skvx::sqrt(" + this->dot(vec, vec) + ")")};
+        }
+        case k_dot_IntrinsicKind:
+            return {this->dot(args[0], args[1])};
+        case k_cross_IntrinsicKind: {
+            const Value& a = args[0];
+            const Value& b = args[1];
+            return {this->temp(a[1] + " * " + b[2] + " - " + a[2] + " * " + b[1]),
+                    this->temp(a[2] + " * " + b[0] + " - " + a[0] + " * " + b[2]),
+                    this->temp(a[0] + " * " + b[1] + " - " + a[1] + " * " + b[0])};
+        }
+        case k_normalize_IntrinsicKind: {
+            std::string invLen = this->temp("F(1.0f) / skvx::sqrt(" +
+                                            this->dot(args[0], args[0]) + ")");
+            return this->unary(args[0], [&](const std::string& x) { return x + " * " + invLen; });
+        }
+        case k_faceforward_IntrinsicKind: {
+            std::string dotNrefI = this->dot(args[2], args[1]);
+            return this->unary(args[0], [&](const std::string& n) {
+                return "skvx::if_then_else(" + dotNrefI + " < F(0.0f), " + n + ", -" + n + ")";
+            });
+        }
+        case k_reflect_IntrinsicKind: {
+            std::string dotNI = this->dot(args[1], args[0]);
+            return this->binary(args[0], args[1], [&](const std::string& i, const std::string& n) {
+                return i + " - F(2.0f) * " + dotNI + " * " + n;
+            });
+        }
+        case k_refract_IntrinsicKind: {
+            const std::string& eta = args[2][0];
+            std::string dotNI = this->dot(args[1], args[0]);
+            std::string k = this->temp("F(1.0f) - " + eta + " * " + eta + " * (F(1.0f) - " +
+                                       dotNI + " * " + dotNI + ")");
+            return this->binary(args[0], args[1], [&](const std::string& i, const std::string& n) {
+                return "skvx::if_then_else(" + k + " < F(0.0f), F(0.0f), " + eta + " * " + i +
+                       " - (" + eta + " * " + dotNI + " + skvx::sqrt(" + k + ")) * " + n + ")";
+            });
+        }
+
+        case k_matrixCompMult_IntrinsicKind:
+            return this->binary(args[0], args[1], [](const std::string& x, const std::string& y) {
+                return x + " * " + y;
+            });
+
+        case k_lessThan_IntrinsicKind:         return compare("<");
+        case k_lessThanEqual_IntrinsicKind:    return compare("<=");
+        case k_greaterThan_IntrinsicKind:      return compare(">");
+        case k_greaterThanEqual_IntrinsicKind: return compare(">=");
+        case k_equal_IntrinsicKind:            return compare("==");
+        case k_notEqual_IntrinsicKind:         return compare("!=");
+
+        case k_any_IntrinsicKind:
+        case k_all_IntrinsicKind: {
+            const char* fold = intrinsicKind == k_any_IntrinsicKind ? " | " : " & ";
+            std::string result = args[0][0];
+            for (size_t i = 1; i < args[0].size(); ++i) {
+                result += fold + args[0][i];
+            }
+            return {this->temp(result)};
+        }
+        case k_not_IntrinsicKind:
+            return this->unary(args[0], [](const std::string& x) { return "~" + x; });
+
+        default:
+            this->error(c.fPosition, "native kernels do not support '" +
+                                     c.function().description() + "'");
+            return Value(c.type().slotCount(), zero_literal(true));
+    }
+}
+
+Value NativeKernelGenerator::writeFunctionCall(const FunctionCall& call) {
+    if (call.function().isIntrinsic() && !call.function().definition()) {
+        return this->writeIntrinsicCall(call);
+    }
+
+    const FunctionDeclaration& decl = call.function();
+    const FunctionDefinition& funcDef = *decl.definition();
+
+    // Evaluate all arguments, gathering the results into a contiguous list.
+    std::vector<std::string> argVals;
+    for (const std::unique_ptr<Expression>& arg : call.arguments()) {
+        Value v = this->writeExpression(*arg);
+        argVals.insert(argVals.end(), v.begin(), v.end());
+    }
+
+    size_t returnSlot;
+    {
+        // Lanes that conditionally returned in the current function must not resume execution
+        // within the callee.
+        std::string returned = currentFunction().fReturned;
+        ScopedCondition m(this, returned.empty() ? "" : "~" + returned);
+        returnSlot = this->writeFunction(call, funcDef, SkSpan(argVals));
+    }
+
+    // Propagate new values of any 'out' params back to the original arguments.
+    const std::unique_ptr<Expression>* argIter = call.arguments().begin();
+    size_t valIdx = 0;
+    for (const Variable* p : decl.parameters()) {
+        size_t nslots = p->type().slotCount();
+        if (p->modifiers().fFlags & Modifiers::kOut_Flag) {
+            Value v(argVals.begin() + valIdx, argVals.begin() + valIdx + nslots);
+            this->writeStore(**argIter, v);
+        }
+        valIdx += nslots;
+        argIter++;
+    }
+
+    return this->getSlotValue(returnSlot, call.type().slotCount());
+}
+
+Value NativeKernelGenerator::writeLiteral(const Literal& l) {
+    if (l.type().isFloat()) {
+        return {float_literal(l.floatValue())};
+    }
+    if (l.type().isInteger()) {
+        return {int_literal(static_cast<int32_t>(l.intValue()))};
+    }
+    SkASSERT(l.type().isBoolean());
+    return {l.boolValue() ? "I(-1)" : "I(0)"};
+}
+
+Value NativeKernelGenerator::writePrefixExpression(const PrefixExpression& p) {
+    Value val = this->writeExpression(*p.operand());
+    bool isFloat = base_number_kind(p.type()) == Type::NumberKind::kFloat;
+
+    switch (p.getOperator().kind()) {
+        case Operator::Kind::PLUSPLUS:
+        case Operator::Kind::MINUSMINUS: {
+            const char* op = p.getOperator().kind() == Operator::Kind::PLUSPLUS ? " + " : " - ";
+            std::string one = isFloat ? float_literal(1) : int_literal(1);
+            val = this->unary(val, [&](const std::string& x) { return x + op + one; });
+            return this->writeStore(*p.operand(), val);
+        }
+        case Operator::Kind::MINUS:
+            return this->unary(val, [](const std::string& x) { return "-" + x; });
+        case Operator::Kind::LOGICALNOT:
+        case Operator::Kind::BITWISENOT:
+            return this->unary(val, [](const std::string& x) { return "~" + x; });
+        default:
+            SkUNREACHABLE;
+    }
+}
+
+Value NativeKernelGenerator::writePostfixExpression(const PostfixExpression& p) {
+    Value old = this->writeExpression(*p.operand());
+    bool isFloat = base_number_kind(p.type()) == Type::NumberKind::kFloat;
+    const char* op = p.getOperator().kind() == Operator::Kind::PLUSPLUS ? " + " : " - ";
+    std::string one = isFloat ? float_literal(1) : int_literal(1);
+    this->writeStore(*p.operand(),
+                     this->unary(old, [&](const std::string& x) { return x + op + one; }));
+    return old;
+}
+
+Value NativeKernelGenerator::writeSwizzle(const Swizzle& s) {
+    Value base = this->writeExpression(*s.base());
+    Value swizzled;
+    for (int8_t component : s.components()) {
+        swizzled.push_back(base[component]);
+    }
+    return swizzled;
+}
+
+Value NativeKernelGenerator::writeTernaryExpression(const TernaryExpression& t) {
+    std::string test = this->writeExpression(*t.test())[0];
+    Value ifTrue, ifFalse;
+    {
+        ScopedCondition m(this, test);
+        ifTrue = this->writeExpression(*t.ifTrue());
+    }
+    {
+        ScopedCondition m(this, "~" + test);
+        ifFalse = this->writeExpression(*t.ifFalse());
+    }
+
+    Value result(ifTrue.size());
+    for (size_t i = 0; i < ifTrue.size(); ++i) {
+        result[i] = this->temp("skvx::if_then_else(" + test + ", " + ifTrue[i] + ", " +
+                               ifFalse[i] + ")");
+    }
+    return result;
+}
+
+Value NativeKernelGenerator::writeExpression(const Expression& e) {
+    switch (e.kind()) {
+        case Expression::Kind::kBinary:
+            return this->writeBinaryExpression(e.as<BinaryExpression>());
+        case Expression::Kind::kConstructorArray:
+        case Expression::Kind::kConstructorCompound:
+        case Expression::Kind::kConstructorStruct:
+            return this->writeAggregationConstructor(e.asAnyConstructor());
+        case Expression::Kind::kConstructorArrayCast:
+            return this->writeExpression(*e.as<ConstructorArrayCast>().argument());
+        case Expression::Kind::kConstructorDiagonalMatrix:
+            return this->writeConstructorDiagonalMatrix(e.as<ConstructorDiagonalMatrix>());
+        case Expression::Kind::kConstructorMatrixResize:
+            return this->writeConstructorMatrixResize(e.as<ConstructorMatrixResize>());
+        case Expression::Kind::kConstructorScalarCast:
+        case Expression::Kind::kConstructorCompoundCast:
+            return this->writeConstructorCast(e.asAnyConstructor());
+        case Expression::Kind::kConstructorSplat:
+            return this->writeConstructorSplat(e.as<ConstructorSplat>());
+        case Expression::Kind::kFieldAccess:
+            return this->writeFieldAccess(e.as<FieldAccess>());
+        case Expression::Kind::kIndex:
+            return this->writeIndexExpression(e.as<IndexExpression>());
+        case Expression::Kind::kVariableReference:
+            return this->writeVariableExpression(e.as<VariableReference>());
+        case Expression::Kind::kLiteral:
+            return this->writeLiteral(e.as<Literal>());
+        case Expression::Kind::kFunctionCall:
+            return this->writeFunctionCall(e.as<FunctionCall>());
+        case Expression::Kind::kPrefix:
+            return this->writePrefixExpression(e.as<PrefixExpression>());
+        case Expression::Kind::kPostfix:
+            return this->writePostfixExpression(e.as<PostfixExpression>());
+        case Expression::Kind::kSwizzle:
+            return this->writeSwizzle(e.as<Swizzle>());
+        case Expression::Kind::kTernary:
+            return this->writeTernaryExpression(e.as<TernaryExpression>());
+        case Expression::Kind::kChildCall:
+            this->error(e.fPosition, "native kernels do not support child effects");
+            return Value(e.type().slotCount(), zero_literal(true));
+        default:
+            this->error(e.fPosition, "unsupported expression");
+            return Value(e.type().slotCount(), zero_literal(true));
+    }
+}
+
+Value NativeKernelGenerator::writeStore(const Expression& lhs, const Value& rhs) {
+    // Peel off each Swizzle, FieldAccess and IndexExpression wrapped around the underlying
+    // VariableReference, mapping the rhs values onto the variable's slots. (See SkVMGenerator.)
+    SkSTArray<4, size_t, true> slots;
+    slots.resize(rhs.size());
+    for (int i = 0; i < slots.size(); ++i) {
+        slots[i] = i;
+    }
+
+    const Expression* expr = &lhs;
+    while (!expr->is<VariableReference>()) {
+        switch (expr->kind()) {
+            case Expression::Kind::kFieldAccess: {
+                const FieldAccess& fld = expr->as<FieldAccess>();
+                size_t offset = fld.initialSlot();
+                for (size_t& s : slots) {
+                    s += offset;
+                }
+                expr = fld.base().get();
+            } break;
+            case Expression::Kind::kIndex: {
+                const IndexExpression& idx = expr->as<IndexExpression>();
+                size_t offset = this->indexSlotOffset(idx);
+                for (size_t& s : slots) {
+                    s += offset;
+                }
+                expr = idx.base().get();
+            } break;
+            case Expression::Kind::kSwizzle: {
+                const Swizzle& swz = expr->as<Swizzle>();
+                for (size_t& s : slots) {
+                    s = swz.components()[s];
+                }
+                expr = swz.base().get();
+            } break;
+            default:
+                SkDEBUGFAIL("Invalid expression type");
+                return rhs;
+        }
+    }
+
+    size_t varSlot = this->getSlot(*expr->as<VariableReference>().variable());
+    std::string mask = this->mask();
+    for (size_t i = 0; i < rhs.size(); ++i) {
+        Slot& slot = fSlots[varSlot + slots[i]];
+        slot.fVal = this->conditionalStore(slot.fVal, rhs[i], mask);
+    }
+    return rhs;
+}
+
+void NativeKernelGenerator::writeBlock(const Block& b) {
+    for (const std::unique_ptr<Statement>& stmt : b.children()) {
+        this->writeStatement(*stmt);
+    }
+}
+
+void NativeKernelGenerator::writeBreakStatement() {
+    // Any active lanes stop executing for the duration of the current loop.
+    fLoopMask = this->andMasks(fLoopMask, invertMask(this->mask()));
+}
+
+void NativeKernelGenerator::writeContinueStatement() {
+    // Any active lanes stop executing for the current iteration. Remember them in fContinueMask,
+    // to be re-enabled later.
+    std::string mask = explicitMask(this->mask());
+    fLoopMask = this->andMasks(fLoopMask, invertMask(mask));
+    fContinueMask = this->orMasks(fContinueMask, mask);
+}
+
+void NativeKernelGenerator::writeForStatement(const ForStatement& f) {
+    // We require that all loops be ES2-compliant (unrollable), and unroll them here.
+    if (!f.unrollInfo()) {
+        this->error(f.fPosition, "native kernels require loops to be unrollable");
+        return;
+    }
+    const LoopUnrollInfo& loop = *f.unrollInfo();
+    size_t indexSlot = this->getSlot(*loop.fIndex);
+    bool indexIsFloat = base_number_kind(loop.fIndex->type()) == Type::NumberKind::kFloat;
+
+    std::string oldLoopMask     = fLoopMask,
+                oldContinueMask = fContinueMask;
+
+    double val = loop.fStart;
+    for (int i = 0; i < loop.fCount; ++i) {
+        fSlots[indexSlot].fVal = indexIsFloat ? float_literal(static_cast<float>(val))
+                                              : int_literal(static_cast<int32_t>(val));
+        fLoopIndexValues.set(loop.fIndex, val);
+
+        fContinueMask = "";
+        this->writeStatement(*f.statement());
+        if (!fLoopMask.empty()) {
+            fLoopMask = this->orMasks(fLoopMask, fContinueMask);
+        }
+        val += loop.fDelta;
+    }
+    fLoopIndexValues.remove(loop.fIndex);
+
+    fLoopMask     = oldLoopMask;
+    fContinueMask = oldContinueMask;
+}
+
+void NativeKernelGenerator::writeIfStatement(const IfStatement& i) {
+    std::string test = this->writeExpression(*i.test())[0];
+    {
+        ScopedCondition ifTrue(this, test);
+        this->writeStatement(*i.ifTrue());
+    }
+    if (i.ifFalse()) {
+        ScopedCondition ifFalse(this, "~" + test);
+        this->writeStatement(*i.ifFalse());
+    }
+}
+
+void NativeKernelGenerator::writeReturnStatement(const ReturnStatement& r) {
+    std::string returnsHere = this->mask();
+
+    if (r.expression()) {
+        Value val = this->writeExpression(*r.expression());
+        size_t slot = currentFunction().fReturnSlot;
+        for (size_t i = 0; i < val.size(); ++i) {
+            fSlots[slot + i].fVal =
+                    this->conditionalStore(fSlots[slot + i].fVal, val[i], returnsHere);
+        }
+    }
+
+    std::string& returned = currentFunction().fReturned;
+    returned = this->orMasks(returned, explicitMask(returnsHere));
+}
+
+void NativeKernelGenerator::writeSwitchStatement(const SwitchStatement& s) {
+    // Breaks mask off lanes for the rest of the switch, just like they do in a loop.
+    std::string oldLoopMask = fLoopMask;
+    std::string switchFallthrough = "I(0)";
+    std::string switchValue = this->writeExpression(*s.value())[0];
+
+    for (const std::unique_ptr<Statement>& stmt : s.cases()) {
+        const SwitchCase& c = stmt->as<SwitchCase>();
+        if (!c.isDefault()) {
+            // Execute this case if we're falling through from a previous case, or if the case
+            // value matches.
+            ScopedCondition conditionalCaseBlock(
+                    this,
+                    this->temp(switchFallthrough + " | (" + switchValue + " == " +
+                               int_literal(static_cast<int32_t>(c.value())) + ")"));
+            this->writeStatement(*c.statement());
+            switchFallthrough = this->conditionalStore(switchFallthrough, "I(-1)", this->mask());
+        } else {
+            // This is the default case. Since it's always last, we can just dump in the code.
+            this->writeStatement(*c.statement());
+        }
+    }
+
+    fLoopMask = oldLoopMask;
+}
+
+void NativeKernelGenerator::writeVarDeclaration(const VarDeclaration& decl) {
+    size_t slot   = this->getSlot(*decl.var()),
+           nslots = decl.var()->type().slotCount();
+
+    Value val = decl.value() ? this->writeExpression(*decl.value()) : Value{};
+    for (size_t i = 0; i < nslots; ++i) {
+        fSlots[slot + i].fVal = decl.value() ? val[i] : zero_literal(fSlots[slot + i].fIsFloat);
+    }
+}
+
+void NativeKernelGenerator::writeStatement(const Statement& s) {
+    switch (s.kind()) {
+        case Statement::Kind::kBlock:
+            this->writeBlock(s.as<Block>());
+            break;
+        case Statement::Kind::kBreak:
+            this->writeBreakStatement();
+            break;
+        case Statement::Kind::kContinue:
+            this->writeContinueStatement();
+            break;
+        case Statement::Kind::kExpression:
+            this->writeExpression(*s.as<ExpressionStatement>().expression());
+            break;
+        case Statement::Kind::kFor:
+            this->writeForStatement(s.as<ForStatement>());
+            break;
+        case Statement::Kind::kIf:
+            this->writeIfStatement(s.as<IfStatement>());
+            break;
+        case Statement::Kind::kReturn:
+            this->writeReturnStatement(s.as<ReturnStatement>());
+            break;
+        case Statement::Kind::kSwitch:
+            this->writeSwitchStatement(s.as<SwitchStatement>());
+            break;
+        case Statement::Kind::kVarDeclaration:
+            this->writeVarDeclaration(s.as<VarDeclaration>());
+            break;
+        case Statement::Kind::kNop:
+            break;
+        default:
+            this->error(s.fPosition, "unsupported control flow");
+            break;
+    }
+}
+
+bool NativeKernelGenerator::writeProgram(const FunctionDefinition& function,
+                                         std::string_view name,
+                                         OutputStream& out) {
+    const ErrorReporter& errors = *fProgram.fContext->fErrors;
+    int initialErrors = errors.errorCount();
+
+    // Uniforms and globals only need to be computed once per call.
+    fCode = &fPrologue;
+    this->setupGlobals();
+
+    // main() receives local coordinates (shaders) or the input color (color filters) in the
+    // de-interleaved r, g, b and a vectors.
+    fCode = &fBody;
+    std::vector<std::string> args;
+    for (const Variable* param : function.declaration().parameters()) {
+        switch (param->modifiers().fLayout.fBuiltin) {
+            case SK_MAIN_COORDS_BUILTIN:
+                args.insert(args.end(), {"r", "g"});
+                break;
+            case SK_INPUT_COLOR_BUILTIN:
+                args.insert(args.end(), {"r", "g", "b", "a"});
+                break;
+            default:
+                this->error(param->fPosition, "native kernels are only supported for runtime "
+                                              "shaders and color filters");
+                return false;
+        }
+    }
+    size_t returnSlot = this->writeFunction(function, function, SkSpan(args));
+    Value result = this->getSlotValue(returnSlot, 4);
+
+    if (errors.errorCount() != initialErrors) {
+        return false;
+    }
+
+    const std::string& source = *fProgram.fSource;
+    if (source.find(")SkSL\"") != std::string::npos) {
+        this->error({}, "program source cannot be embedded in a raw string literal");
+        return false;
+    }
+
+    // Every temporary is a pure expression, so any that the result doesn't depend on can be
+    // dropped. The code is in SSA form, so a single backwards pass finds all of them.
+    std::set<std::string> live;
+    for (const std::string& slot : result) {
+        add_referenced_temps(slot, &live);
+    }
+    std::vector<const std::string*> liveExprs;
+    for (const std::vector<Temp>* temps : {&fBody, &fPrologue}) {
+        for (auto iter = temps->rbegin(); iter != temps->rend(); ++iter) {
+            if (live.count(iter->fName)) {
+                add_referenced_temps(iter->fExpr, &live);
+                liveExprs.push_back(&iter->fExpr);
+            }
+        }
+    }
+
+    auto isReferenced = [&](const std::string& name) {
+        return std::any_of(liveExprs.begin(), liveExprs.end(), [&](const std::string* expr) {
+            return expr->find(name) != std::string::npos;
+        });
+    };
+
+    std::string lanes = std::to_string(kLanes);
+    out.writeText(
+"/*\n"
+" * This file was autogenerated by skslc. Do not edit.\n"
+" */\n"
+"\n"
+"#include \"src/base/SkVx.h\"\n"
+"#include \"src/core/SkRuntimeEffectPriv.h\"\n"
+"\n"
+"#include <algorithm>\n"
+"#include <cmath>\n"
+"#include <cstdint>\n"
+"#include <cstring>\n"
+"\n"
+"namespace {\n"
+"\n");
+    out.writeString("using F = skvx::Vec<" + lanes + ", float>;\n");
+    out.writeString("using I = skvx::Vec<" + lanes + ", int32_t>;\n\n");
+    for (const auto& [helperName, definition] : helper_definitions()) {
+        if (isReferenced(helperName + "(")) {
+            out.writeString(definition + "\n\n");
+        }
+    }
+    out.writeString("constexpr char kSkSL[] = R\"SkSL(" + source + ")SkSL\";\n\n");
+    out.writeText("void run(const float* uniforms, float* rgba, int count) {\n");
+    if (!isReferenced("uniforms")) {
+        out.writeText("    (void)uniforms;\n");
+    }
+    WriteTemps(fPrologue, live, "    ", out);
+    out.writeString("    for (int start = 0; start < count; start += " + lanes + ") {\n"
+                    "        const int n = std::min(" + lanes + ", count - start);\n"
+                    "        float px[4 * " + lanes + "] = {};\n"
+                    "        memcpy(px, rgba + 4 * start, 4 * n * sizeof(float));\n"
+                    "        F r, g, b, a;\n"
+                    "        skvx::strided_load4(px, r, g, b, a);\n");
+    WriteTemps(fBody, live, "        ", out);
+    out.writeString("        for (int i = 0; i < " + lanes + "; ++i) {\n"
+                    "            px[4 * i + 0] = " + result[0] + "[i];\n"
+                    "            px[4 * i + 1] = " + result[1] + "[i];\n"
+                    "            px[4 * i + 2] = " + result[2] + "[i];\n"
+                    "            px[4 * i + 3] = " + result[3] + "[i];\n"
+                    "        }\n"
+                    "        memcpy(rgba + 4 * start, px, 4 * n * sizeof(float));\n"
+                    "    }\n"
+                    "}\n"
+                    "\n"
+                    "}  // namespace\n"
+                    "\n");
+    std::string symbol = "gNativeKernel_" + std::string(name);
+    out.writeString("extern const SkRuntimeEffectPriv::NativeKernel " + symbol + ";\n");
+    out.writeString("const SkRuntimeEffectPriv::NativeKernel " + symbol + " = {kSkSL, run};\n");
+    return true;
+}
+
+}  // namespace
+
+bool ToNativeKernel(const Program& program,
+                    const FunctionDefinition& function,
+                    std::string_view name,
+                    OutputStream& out) {
+    NativeKernelGenerator generator(program);
+    return generator.writeProgram(function, name, out);
+}
+
+}  // namespace SkSL
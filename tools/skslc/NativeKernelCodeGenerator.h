@@ -0,0 +1,35 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_NATIVEKERNELCODEGENERATOR
+#define SKSL_NATIVEKERNELCODEGENERATOR
+
+#include <string_view>
+
+namespace SkSL {
+
+class FunctionDefinition;
+class OutputStream;
+struct Program;
+
+// Converts a runtime shader or color filter into a C++ source file which implements `function`
+// with skvx vectors, ahead of time. The file defines a SkRuntimeEffectPriv::NativeKernel named
+// `gNativeKernel_<name>`; once registered, SkRuntimeEffect uses it in place of the interpreted
+// Raster Pipeline program whenever an effect is created with matching SkSL.
+//
+// Like SkVM, the generated code scalarizes every value, unrolls every loop, and inlines every
+// function call; control flow is expressed with lane masks. Effects with children, and the few
+// features that depend on the destination (sk_FragCoord, toLinearSrgb/fromLinearSrgb), are
+// reported as errors.
+bool ToNativeKernel(const Program& program,
+                    const FunctionDefinition& function,
+                    std::string_view name,
+                    OutputStream& out);
+
+}  // namespace SkSL
+
+#endif